@@ -4,6 +4,7 @@
 #include "../devices/lensdevice.h"
 #include "../models/systemstatemodel.h"
 #include "../devices/cameravideostreamdevice.h" // Include the new processor header
+#include "../devices/cameraregistry.h"
 
 #include <QDebug>
 #include <QMetaObject> // For invokeMethod
@@ -29,15 +30,18 @@ CameraController::CameraController(DayCameraControlDevice* dayControl,
 {
     // Connect to system state changes - IMPORTANT!
     if (m_stateModel) {
-        // Connect to the main dataChanged signal, or specific signals if SystemStateModel provides them
-        // (e.g., activeCameraChanged(bool), trackingActiveChanged(bool))
-        connect(m_stateModel, &SystemStateModel::dataChanged,
-                this, &CameraController::onSystemStateChanged, Qt::QueuedConnection); // Queued connection is safer
+        // Active camera (optics), tracking and operational mode only
+        const StateGroups usedGroups = StateGroup::Optics | StateGroup::Tracking | StateGroup::Modes;
+        connect(m_stateModel, &SystemStateModel::stateGroupsChanged, this, [this, usedGroups](StateGroups changed) {
+            if (changed & usedGroups) onSystemStateChanged(m_stateModel->snapshot());
+        }, Qt::QueuedConnection); // Queued connection is safer
 
         // Initialize internal state from the model
         //m_stateModel->data() = m_stateModel->data();
         m_isDayCameraActive = m_stateModel->data().activeCameraIsDay;
+        m_activeCameraIndex = m_stateModel->data().activeCameraIndex;
         qInfo() << "CameraController initialized. Active camera is:" << (m_isDayCameraActive ? "Day" : "Night");
+        applyProcessorStandby();
     } else {
         qWarning() << "CameraController created without a SystemStateModel!";
     }
@@ -72,6 +76,23 @@ bool CameraController::initialize()
 }
 
 
+void CameraController::setCameraRegistry(CameraRegistry *registry)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cameraRegistry = registry;
+    applyProcessorStandby();
+}
+
+CameraVideoStreamDevice* CameraController::getCameraProcessor(int cameraIndex) const
+{
+    if (m_cameraRegistry) {
+        return m_cameraRegistry->device(cameraIndex);
+    }
+    if (cameraIndex == 0) return m_dayProcessor;
+    if (cameraIndex == 1) return m_nightProcessor;
+    return nullptr;
+}
+
 CameraVideoStreamDevice* CameraController::getDayCameraProcessor() const
 {
     return m_dayProcessor;
@@ -84,8 +105,8 @@ CameraVideoStreamDevice* CameraController::getNightCameraProcessor() const
 
 CameraVideoStreamDevice* CameraController::getActiveCameraProcessor() const
 {
-    // Use the cached m_isDayCameraActive flag for immediate response
-    return m_isDayCameraActive ? m_dayProcessor : m_nightProcessor;
+    // Use the cached active camera for immediate response
+    return getCameraProcessor(m_activeCameraIndex);
 }
 
 bool CameraController::isDayCameraActive() const
@@ -99,7 +120,8 @@ void CameraController::onSystemStateChanged(const SystemStateData &newData)
 {
     QMutexLocker locker(&m_mutex); // Lock if modifying shared member data
 
-    bool cameraChanged = (m_cachedState.activeCameraIsDay != newData.activeCameraIsDay);
+    bool cameraChanged = (m_cachedState.activeCameraIsDay != newData.activeCameraIsDay ||
+                          m_cachedState.activeCameraIndex != newData.activeCameraIndex);
     //bool trackingChanged = (m_cachedState.trackingActive != newData.trackingActive);
     //bool opModeChanged = (m_cachedState.opMode != newData.opMode);
     // ... check other relevant state changes using m_cachedState vs newData ...
@@ -114,10 +136,10 @@ void CameraController::onSystemStateChanged(const SystemStateData &newData)
 
     // 1. Active Camera Changed
     if (cameraChanged) {
-        setActiveCamera(newData.activeCameraIsDay); // Update internal flag AND handle side effects
+        setActiveCamera(newData.activeCameraIsDay, newData.activeCameraIndex); // Update internal flag AND handle side effects
 
         // Stop tracking on the camera that just became *inactive*
-        CameraVideoStreamDevice* oldProcessor = oldStateBeforeUpdate.activeCameraIsDay ? m_dayProcessor : m_nightProcessor;
+        CameraVideoStreamDevice* oldProcessor = getCameraProcessor(oldStateBeforeUpdate.activeCameraIndex);
         if (oldProcessor && oldStateBeforeUpdate.trackingActive) // Check if tracking WAS active on the old camera
         {
             qInfo() << "CameraController: Camera switched, stopping tracking on inactive processor:" << oldProcessor->property("cameraIndex").toInt();
@@ -145,16 +167,34 @@ void CameraController::onSystemStateChanged(const SystemStateData &newData)
 }
 
 // Internal helper to update active camera flag
-void CameraController::setActiveCamera(bool isDay)
+void CameraController::setActiveCamera(bool isDay, int cameraIndex)
 {
     // Assumes mutex is already locked if called from onSystemStateChanged
-    if (m_isDayCameraActive != isDay) {
+    if (m_isDayCameraActive != isDay || m_activeCameraIndex != cameraIndex) {
         m_isDayCameraActive = isDay;
-        qInfo() << "CameraController: Active camera set internally to:" << (isDay ? "Day" : "Night");
+        m_activeCameraIndex = cameraIndex;
+        qInfo() << "CameraController: Active camera set internally to:" << (isDay ? "Day" : "Night")
+                << "optics, camera" << cameraIndex;
+        applyProcessorStandby();
         // Don't emit stateChanged here, let onSystemStateChanged handle it after all checks
     }
 }
 
+// Keeps all pipelines running but only lets the active one convert and emit frames.
+// setStandby() only flips an atomic, so it is safe to call directly across threads.
+void CameraController::applyProcessorStandby()
+{
+    if (m_cameraRegistry) {
+        m_cameraRegistry->applyStandby(m_activeCameraIndex);
+        return;
+    }
+    CameraVideoStreamDevice* activeProcessor = m_isDayCameraActive ? m_dayProcessor : m_nightProcessor;
+    CameraVideoStreamDevice* inactiveProcessor = m_isDayCameraActive ? m_nightProcessor : m_dayProcessor;
+    // Promote first so there is never a frame period with both processors idle
+    if (activeProcessor) activeProcessor->setStandby(false);
+    if (inactiveProcessor) inactiveProcessor->setStandby(true);
+}
+
 // --- Tracking Control ---
 
 bool CameraController::startTracking()
@@ -10,6 +10,7 @@
 class DayCameraControlDevice;
 class NightCameraControlDevice;
 class CameraVideoStreamDevice; // Replaces pipeline devices
+class CameraRegistry;
 class LensDevice;
 class SystemStateModel;
  
@@ -30,6 +31,11 @@ public:
 
     bool initialize(); // Simplified initialization
 
+    /**
+     * @brief Manages standby across all cameras of @p registry instead of the day/night pair.
+     */
+    void setCameraRegistry(CameraRegistry *registry);
+
     // --- Camera Control Methods (Remain Largely the Same) ---
     Q_INVOKABLE virtual void zoomIn();
     Q_INVOKABLE virtual void zoomOut();
@@ -51,6 +57,7 @@ public:
     CameraVideoStreamDevice* getDayCameraProcessor() const;   // Changed name/type
     CameraVideoStreamDevice* getNightCameraProcessor() const; // Changed name/type
     CameraVideoStreamDevice* getActiveCameraProcessor() const; // Changed name/type
+    CameraVideoStreamDevice* getCameraProcessor(int cameraIndex) const; // Any registry camera
     bool isDayCameraActive() const;
 
 signals:
@@ -66,7 +73,8 @@ public slots:
 
 private:
     void updateStatus(const QString& message);
-    void setActiveCamera(bool isDay); // Internal helper to manage state on change
+    void setActiveCamera(bool isDay, int cameraIndex); // Internal helper to manage state on change
+    void applyProcessorStandby();     // Puts the inactive processors in standby, promotes the active one
 
     // --- Dependencies ---
     QPointer<DayCameraControlDevice>    m_dayControl;
@@ -75,10 +83,12 @@ private:
     QPointer<CameraVideoStreamDevice>            m_nightProcessor; // Changed
     QPointer<LensDevice>                m_lensDevice;
     QPointer<SystemStateModel>          m_stateModel;
+    CameraRegistry *m_cameraRegistry = nullptr; // Optional; outlives the controller
 
     // --- Internal State ---
     QMutex m_mutex; // For thread safety if needed, although most action is on state model signals
     bool m_isDayCameraActive = true; // Cache the active camera flag
+    int m_activeCameraIndex = 0;     // Registry index of the active camera
     SystemStateData m_cachedState;   // Cache the last known state from the model
 
     /*
@@ -58,8 +58,12 @@ GimbalController::GimbalController(ServoDriverDevice* azServo,
     setMotionMode(MotionMode::Idle);
 
     if (m_stateModel) {
-        connect(m_stateModel, &SystemStateModel::dataChanged,
-                this,         &GimbalController::onSystemStateChanged);
+        // Modes, scan selection and no-traverse flag, tracker target, optics and gimbal position
+        const StateGroups usedGroups = StateGroup::Modes | StateGroup::Zones | StateGroup::Tracking |
+                                       StateGroup::Optics | StateGroup::GimbalPose;
+        connect(m_stateModel, &SystemStateModel::stateGroupsChanged, this, [this, usedGroups](StateGroups changed) {
+            if (changed & usedGroups) onSystemStateChanged(m_stateModel->snapshot());
+        });
     }
 
     connect(m_azServo, &ServoDriverDevice::alarmDetected, this, &GimbalController::onAzAlarmDetected);
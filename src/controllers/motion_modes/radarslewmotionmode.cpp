@@ -65,10 +65,10 @@ void RadarSlewMotionMode::update(GimbalController* controller)
         m_currentTargetId = data.selectedRadarTrackId;
 
         // Find the full plot data for the commanded target ID
-        auto it = std::find_if(data.radarPlots.begin(), data.radarPlots.end(),
+        auto it = std::find_if(data.radarPlots.cbegin(), data.radarPlots.cend(),
                                [&](const SimpleRadarPlot& p){ return p.id == m_currentTargetId; });
 
-        if (it != data.radarPlots.end()) {
+        if (it != data.radarPlots.cend()) {
             m_targetAz = it->azimuth;
             m_targetEl = atan2(-SYSTEM_HEIGHT_METERS, it->range) * (180.0 / M_PI);
 
@@ -15,8 +15,11 @@ WeaponController::WeaponController(SystemStateModel* m_stateModel,
     m_plc42(plc42)
 {
     if (m_stateModel) {
-        connect(m_stateModel, &SystemStateModel::dataChanged,
-                this, &WeaponController::onSystemStateChanged);
+        // Ammo, fire mode and arming (station), dead man switch (controls), engagement (modes)
+        const StateGroups usedGroups = StateGroup::Station | StateGroup::Controls | StateGroup::Modes;
+        connect(m_stateModel, &SystemStateModel::stateGroupsChanged, this, [this, usedGroups](StateGroups changed) {
+            if (changed & usedGroups) onSystemStateChanged(m_stateModel->snapshot());
+        });
     }
 
     m_ballisticsProcessor = new BallisticsProcessor();
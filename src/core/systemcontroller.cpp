@@ -1,8 +1,10 @@
 #include "systemcontroller.h"
+#include <QCoreApplication>
 
 /* INclude Devices */
 #include "../devices/daycameracontroldevice.h"
 #include "../devices/cameravideostreamdevice.h"
+#include "../devices/cameraregistry.h"
 #include "../devices/imudevice.h"
 #include "../devices/joystickdevice.h"
 #include "../devices/lensdevice.h"
@@ -39,12 +41,7 @@ SystemController::SystemController(QObject *parent)
 
 SystemController::~SystemController()
 {
-    if (m_dayVideoProcessor && m_dayVideoProcessor->isRunning()) m_dayVideoProcessor->stop();
-    if (m_nightVideoProcessor && m_nightVideoProcessor->isRunning()) m_nightVideoProcessor->stop();
-    bool stopped1 = m_dayVideoProcessor ? m_dayVideoProcessor->wait(2000) : true;
-    bool stopped2 = m_nightVideoProcessor ? m_nightVideoProcessor->wait(2000) : true;
-    if (!stopped1) qWarning() << "CameraVideoStreamDevice Cam 1 did not stop gracefully.";
-    if (!stopped2) qWarning() << "CameraVideoStreamDevice Cam 2 did not stop gracefully.";
+    if (m_cameraRegistry) m_cameraRegistry->stopAll(2000);
 
     if (m_servoAzThread && m_servoAzThread->isRunning()) {
         m_servoAzThread->quit();
@@ -66,10 +63,10 @@ SystemController::~SystemController()
 void SystemController::initializeSystem()
 {
     // 1) Create devices
-    const int sourceWidth = 1280;
-    const int sourceHeight = 720;
-    const QString dayDevicePath = "/dev/video0";
-    const QString nightDevicePath = "/dev/video1";
+    // Day and night cameras, unless replaced by --day-source=<spec> / --night-source=<spec> (e.g. test:ball,
+    // mjpeg:/dev/video2, rtp-h264:5000 or file:/clips/day.mp4); --camera=<name>,<spec>[,crop=T/B/L/R]...
+    // overrides one of them or adds an auxiliary camera (see CameraRegistry)
+    const QVector<CameraConfig> cameras = CameraRegistry::configFromArguments(QCoreApplication::arguments());
 
    m_dayCamControl = new DayCameraControlDevice(this);
     m_gyroDevice = new ImuDevice("/dev/ttyUSB2" , 115200, 1, this);
@@ -145,8 +142,10 @@ void SystemController::initializeSystem()
 
     // 4) Create m_stateModel
     m_systemStateModel = new SystemStateModel(this);
-    m_dayVideoProcessor = new CameraVideoStreamDevice(0, dayDevicePath, sourceWidth, sourceHeight, m_systemStateModel,  nullptr); // index 0 for day
-    m_nightVideoProcessor = new CameraVideoStreamDevice(1, nightDevicePath, sourceWidth, sourceHeight, m_systemStateModel, nullptr); // index 1 for night
+    m_cameraRegistry = new CameraRegistry(this);
+    m_cameraRegistry->create(cameras, m_systemStateModel);
+    m_dayVideoProcessor = m_cameraRegistry->device(0);   // index 0 for day
+    m_nightVideoProcessor = m_cameraRegistry->device(1); // index 1 for night
 
     // 5) Connect sub-models to m_stateModel
     connect(m_dayCamControlModel, &DayCameraDataModel::dataChanged,
@@ -188,16 +187,60 @@ void SystemController::initializeSystem()
     connect(m_servoElModel, &ServoDriverDataModel::dataChanged,
             m_systemStateModel, &SystemStateModel::onServoElDataChanged);
 
-            if (m_systemStateModel && m_dayVideoProcessor) {
-                connect(m_systemStateModel, &SystemStateModel::dataChanged,
-                        m_dayVideoProcessor, &CameraVideoStreamDevice::onSystemStateChanged,
-                        Qt::QueuedConnection); // Queued connection is crucial
-            }
-             if (m_systemStateModel && m_nightVideoProcessor) {
-                connect(m_systemStateModel, &SystemStateModel::dataChanged,
-                        m_nightVideoProcessor, &CameraVideoStreamDevice::onSystemStateChanged,
-                        Qt::QueuedConnection); // Queued connection is crucial
+    // Cameras read the OSD and tracker inputs from SystemStateModel::snapshot() on their own threads
+    for (CameraVideoStreamDevice *processor : m_cameraRegistry->devices()) {
+        // Pipeline health is reported from the camera threads
+        connect(processor, &CameraVideoStreamDevice::streamHealthChanged,
+                m_systemStateModel, &SystemStateModel::onVideoStreamHealthChanged,
+                Qt::QueuedConnection);
+    }
+
+    // --coalesce-ms=<n> merges the state updates arriving within n ms into one publish
+    const QString coalescePrefix = QStringLiteral("--coalesce-ms=");
+    for (const QString &argument : QCoreApplication::arguments()) {
+        if (argument.startsWith(coalescePrefix)) {
+            m_systemStateModel->setCoalescingWindow(argument.mid(coalescePrefix.size()).toInt());
+        }
+    }
+    // --signal-stats logs the state notification and coalescing statistics every 10 s
+    if (QCoreApplication::arguments().contains(QStringLiteral("--signal-stats"))) {
+        m_systemStateModel->setSignalStatsEnabled(true);
+    }
+
+    // --record-dir=<dir> adds a rolling recorder to every camera; an emergency stop saves an event clip.
+    // Given more than once, the last one wins.
+    const QString recordDirPrefix = QStringLiteral("--record-dir=");
+    QString recordDir;
+    for (const QString &argument : QCoreApplication::arguments()) {
+        if (argument.startsWith(recordDirPrefix)) {
+            recordDir = argument.mid(recordDirPrefix.size());
+        }
+    }
+    if (!recordDir.isEmpty()) {
+        VideoRecorderConfig recorderConfig;
+        recorderConfig.directory = recordDir;
+        bool recording = false;
+        for (CameraVideoStreamDevice *processor : m_cameraRegistry->devices()) {
+            if (processor->setRecorderConfig(recorderConfig)) {
+                recording = true;
             }
+        }
+        if (recording) {
+            connect(m_systemStateModel, &SystemStateModel::stateGroupsChanged, this,
+                    [this, emergencyStopWasActive = false](StateGroups changed) mutable {
+                if (!(changed & StateGroup::Station)) {
+                    return;
+                }
+                const SystemStateData data = m_systemStateModel->snapshot();
+                if (data.emergencyStopActive && !emergencyStopWasActive) {
+                    for (CameraVideoStreamDevice *processor : m_cameraRegistry->devices()) {
+                        processor->triggerRecordingEvent("emergency_stop");
+                    }
+                }
+                emergencyStopWasActive = data.emergencyStopActive;
+            });
+        }
+    }
     //stateMachine->initialize();
 
     // 6) Create controllers
@@ -209,6 +252,7 @@ void SystemController::initializeSystem()
                                               m_nightVideoProcessor,
                                               m_lensDevice,
                                               m_systemStateModel);
+    m_cameraController->setCameraRegistry(m_cameraRegistry);
 
  
 
@@ -244,8 +288,6 @@ void SystemController::initializeSystem()
     m_dayCamControl->zoomStop(); // i added this to get initial zoom position and calculate FOV !!!
     m_nightCamControl->setDigitalZoom(0);
     //m_joystickDevice->printJoystickGUIDs();
-    if (m_dayVideoProcessor) m_dayVideoProcessor->start();
-    if (m_nightVideoProcessor) m_nightVideoProcessor->start();
     m_gimbalController->clearAlarms(); // Clear any existing alarms on startup
 
 }
@@ -258,8 +300,11 @@ void SystemController::showMainWindow()
                                   m_cameraController,
                                   m_joystickController,
                                   m_systemStateModel,
-                                  m_dayVideoProcessor,
-                                  m_nightVideoProcessor);
+                                  m_cameraRegistry);
+    // The pipelines are built at the size the display asks for: start them from the video
+    // widget's first resize event, not when showFullScreen() returns (the window manager
+    // applies the full-screen geometry asynchronously)
+    connect(m_mainWindow, &MainWindow::videoDisplaySized, m_cameraRegistry, &CameraRegistry::startAll);
     //m_mainWindow->show();
     m_mainWindow->showFullScreen();
 }
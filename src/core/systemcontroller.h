@@ -9,6 +9,7 @@
 // Forward declares
 class DayCameraControlDevice;
 class CameraVideoStreamDevice;
+class CameraRegistry;
 class ImuDevice;
 class JoystickDevice;
 class LensDevice;
@@ -55,12 +56,13 @@ public:
 private:
     // Devices
     DayCameraControlDevice* m_dayCamControl = nullptr;
-    CameraVideoStreamDevice* m_dayVideoProcessor = nullptr;
+    CameraRegistry* m_cameraRegistry = nullptr;               // One video pipeline per configured camera
+    CameraVideoStreamDevice* m_dayVideoProcessor = nullptr;   // Registry camera 0
     ImuDevice* m_gyroDevice = nullptr;
     JoystickDevice* m_joystickDevice = nullptr;
     LensDevice* m_lensDevice = nullptr;
     LRFDevice* m_lrfDevice = nullptr;
-    CameraVideoStreamDevice* m_nightVideoProcessor = nullptr;
+    CameraVideoStreamDevice* m_nightVideoProcessor = nullptr; // Registry camera 1
     NightCameraControlDevice* m_nightCamControl = nullptr;
     Plc21Device* m_plc21Device = nullptr;
     Plc42Device* m_plc42Device = nullptr;
@@ -0,0 +1,252 @@
+#include "cameraregistry.h"
+#include "cameravideostreamdevice.h"
+
+#include <QDebug>
+
+namespace {
+const char *const DAY_SOURCE_PREFIX = "--day-source=";
+const char *const NIGHT_SOURCE_PREFIX = "--night-source=";
+const char *const CAMERA_PREFIX = "--camera=";
+
+bool parseCrop(const QString &value, CropProfile &crop)
+{
+    const QStringList parts = value.split('/');
+    if (parts.size() != 4) {
+        return false;
+    }
+    int margins[4];
+    for (int i = 0; i < 4; ++i) {
+        bool ok = false;
+        margins[i] = parts.at(i).toInt(&ok);
+        if (!ok || margins[i] < 0) {
+            return false;
+        }
+    }
+    crop = CropProfile{margins[0], margins[1], margins[2], margins[3]};
+    return true;
+}
+
+bool parseSize(const QString &value, int &width, int &height)
+{
+    const QStringList parts = value.split('x');
+    bool widthOk = false;
+    bool heightOk = false;
+    if (parts.size() != 2) {
+        return false;
+    }
+    const int parsedWidth = parts.at(0).toInt(&widthOk);
+    const int parsedHeight = parts.at(1).toInt(&heightOk);
+    if (!widthOk || !heightOk || parsedWidth <= 0 || parsedHeight <= 0 || parsedWidth % 2 != 0) {
+        return false; // YUY2 needs an even width
+    }
+    width = parsedWidth;
+    height = parsedHeight;
+    return true;
+}
+} // namespace
+
+bool CameraConfig::fromSpec(const QString &spec, CameraConfig &config, QString *errorMessage)
+{
+    const QStringList fields = spec.split(',');
+    if (fields.size() < 2 || fields.at(0).isEmpty()) {
+        if (errorMessage) *errorMessage = QString("Camera '%1' needs <name>,<source>").arg(spec);
+        return false;
+    }
+
+    CameraConfig parsed = config;
+    parsed.name = fields.at(0);
+    QString sourceError;
+    if (!VideoSourceConfig::fromSpec(fields.at(1), parsed.source, &sourceError)) {
+        if (errorMessage) *errorMessage = QString("Camera '%1': %2").arg(parsed.name, sourceError);
+        return false;
+    }
+    for (int i = 2; i < fields.size(); ++i) {
+        const QString &field = fields.at(i);
+        const QString value = field.mid(field.indexOf('=') + 1);
+        bool ok = false;
+        if (field.startsWith(QLatin1String("crop="))) {
+            ok = parseCrop(value, parsed.crop);
+        } else if (field.startsWith(QLatin1String("size="))) {
+            ok = parseSize(value, parsed.sourceWidth, parsed.sourceHeight);
+        } else if (field.startsWith(QLatin1String("label="))) {
+            parsed.osdLabel = value;
+            ok = !value.isEmpty();
+        }
+        if (!ok) {
+            if (errorMessage) *errorMessage = QString("Camera '%1': bad option '%2'").arg(parsed.name, field);
+            return false;
+        }
+    }
+    if (parsed.osdLabel.isEmpty()) {
+        parsed.osdLabel = parsed.name.toUpper();
+    }
+    config = parsed;
+    return true;
+}
+
+CameraRegistry::CameraRegistry(QObject *parent)
+    : QObject(parent)
+{
+}
+
+CameraRegistry::~CameraRegistry()
+{
+    stopAll();
+    for (Entry &entry : m_entries) {
+        delete entry.device;
+        entry.device = nullptr;
+    }
+}
+
+QVector<CameraConfig> CameraRegistry::defaultCameras()
+{
+    CameraConfig day;
+    day.name = QStringLiteral("day");
+    day.osdLabel = QStringLiteral("DAY");
+    day.source = VideoSourceConfig::v4l2(QStringLiteral("/dev/video0"));
+    // Sony (day): no cropping
+
+    CameraConfig night;
+    night.name = QStringLiteral("night");
+    night.osdLabel = QStringLiteral("THERMAL");
+    night.source = VideoSourceConfig::v4l2(QStringLiteral("/dev/video1"));
+    night.crop = CropProfile{28, 60, 116, 116}; // FLIR (night): sensor area of the analog frame
+
+    return {day, night};
+}
+
+QVector<CameraConfig> CameraRegistry::configFromArguments(const QStringList &arguments, QVector<CameraConfig> cameras)
+{
+    for (const QString &argument : arguments) {
+        const int sourceCamera = argument.startsWith(QLatin1String(DAY_SOURCE_PREFIX)) ? 0
+                                 : argument.startsWith(QLatin1String(NIGHT_SOURCE_PREFIX)) ? 1 : -1;
+        QString errorMessage;
+        if (sourceCamera >= 0 && sourceCamera < cameras.size()) {
+            VideoSourceConfig &source = cameras[sourceCamera].source;
+            if (!VideoSourceConfig::fromSpec(argument.mid(argument.indexOf('=') + 1), source, &errorMessage)) {
+                qWarning() << errorMessage << "- keeping" << source.toSpec();
+            }
+        } else if (argument.startsWith(QLatin1String(CAMERA_PREFIX))) {
+            const QString spec = argument.mid(static_cast<int>(qstrlen(CAMERA_PREFIX)));
+            int index = 0;
+            while (index < cameras.size() && cameras.at(index).name != spec.section(',', 0, 0)) {
+                ++index;
+            }
+            CameraConfig camera = index < cameras.size() ? cameras.at(index) : CameraConfig();
+            if (!CameraConfig::fromSpec(spec, camera, &errorMessage)) {
+                qWarning() << errorMessage << "- ignored";
+            } else if (index < cameras.size()) {
+                cameras[index] = camera;
+            } else {
+                cameras.append(camera);
+            }
+        }
+    }
+    return cameras;
+}
+
+void CameraRegistry::create(const QVector<CameraConfig> &cameras, SystemStateModel *stateModel)
+{
+    if (!m_entries.isEmpty()) {
+        qWarning() << "CameraRegistry: Cameras already created.";
+        return;
+    }
+    for (const CameraConfig &camera : cameras) {
+        Entry entry;
+        entry.config = camera;
+        entry.device = new CameraVideoStreamDevice(m_entries.size(), camera.source, camera.sourceWidth,
+                                                   camera.sourceHeight, stateModel, nullptr);
+        const CropProfile &crop = camera.crop;
+        entry.device->setCrop(crop.top, crop.bottom, crop.left, crop.right);
+        qInfo() << "CameraRegistry: Cam" << m_entries.size() << camera.name << camera.source.toSpec()
+                << camera.sourceWidth << "x" << camera.sourceHeight
+                << "crop" << crop.top << crop.bottom << crop.left << crop.right;
+        m_entries.append(entry);
+    }
+}
+
+void CameraRegistry::startAll()
+{
+    for (const Entry &entry : m_entries) {
+        entry.device->start();
+    }
+}
+
+void CameraRegistry::stopAll(unsigned long timeoutMs)
+{
+    for (const Entry &entry : m_entries) {
+        if (entry.device && entry.device->isRunning()) {
+            entry.device->stop();
+        }
+    }
+    for (const Entry &entry : m_entries) {
+        if (entry.device && !entry.device->wait(timeoutMs)) {
+            qWarning() << "CameraVideoStreamDevice" << entry.config.name << "did not stop gracefully.";
+        }
+    }
+}
+
+CameraVideoStreamDevice *CameraRegistry::device(int index) const
+{
+    return (index >= 0 && index < m_entries.size()) ? m_entries.at(index).device : nullptr;
+}
+
+const CameraConfig &CameraRegistry::config(int index) const
+{
+    return m_entries.at(index).config;
+}
+
+QVector<CameraVideoStreamDevice *> CameraRegistry::devices() const
+{
+    QVector<CameraVideoStreamDevice *> result;
+    result.reserve(m_entries.size());
+    for (const Entry &entry : m_entries) {
+        result.append(entry.device);
+    }
+    return result;
+}
+
+int CameraRegistry::indexOf(const QString &name) const
+{
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries.at(i).config.name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void CameraRegistry::applyStandby(int activeIndex)
+{
+    // Promote first so there is never a frame period with every camera idle
+    if (CameraVideoStreamDevice *active = device(activeIndex)) {
+        active->setStandby(false);
+    }
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (i != activeIndex) {
+            m_entries.at(i).device->setStandby(true);
+        }
+    }
+}
+
+QString CameraRegistry::report() const
+{
+    QStringList lines;
+    for (int i = 0; i < m_entries.size(); ++i) {
+        const CameraVideoStreamDevice *camera = m_entries.at(i).device;
+        lines << QString("Cam %1 (%2)%3: %4 frames produced, %5 presented, %6 dropped as stale, capture CPU %7 %")
+                     .arg(i)
+                     .arg(m_entries.at(i).config.name)
+                     .arg(camera->isStandby() ? QStringLiteral(" standby") : QString())
+                     .arg(camera->framesProduced())
+                     .arg(camera->framesTaken())
+                     .arg(camera->framesDropped())
+                     .arg(camera->cpuLoadPercent(), 0, 'f', 1);
+        if (camera->insetsProduced() > 0) {
+            lines.last() += QString(", %1 picture-in-picture insets, %2 us CPU each")
+                                .arg(camera->insetsProduced())
+                                .arg(camera->insetCostUs(), 0, 'f', 1);
+        }
+    }
+    return lines.join('\n');
+}
@@ -0,0 +1,118 @@
+#ifndef CAMERAREGISTRY_H
+#define CAMERAREGISTRY_H
+
+// --- Qt Includes ---
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// --- Project Includes ---
+#include "videosourceconfig.h"
+
+class CameraVideoStreamDevice;
+class SystemStateModel;
+
+/**
+ * @brief videocrop margins of one camera, in source pixels.
+ */
+struct CropProfile {
+    int top = 0;
+    int bottom = 0;
+    int left = 0;
+    int right = 0;
+};
+
+/**
+ * @brief Everything that differs between two cameras of the registry.
+ */
+struct CameraConfig {
+    QString name;             // Unique key, e.g. "day", "night" or a name given with --camera
+    QString osdLabel;         // Camera type shown on the OSD
+    VideoSourceConfig source;
+    int sourceWidth = 1280;
+    int sourceHeight = 720;
+    CropProfile crop;
+
+    /**
+     * @brief Parses "<name>,<source spec>[,crop=T/B/L/R][,size=WxH][,label=TEXT]".
+     *
+     * The source spec is as in VideoSourceConfig::fromSpec(). Options not given keep
+     * their value in @p config, so an existing camera can be partly overridden.
+     * @return False (and @p config untouched) on a malformed spec.
+     */
+    static bool fromSpec(const QString &spec, CameraConfig &config, QString *errorMessage = nullptr);
+};
+
+/**
+ * @brief Owns one CameraVideoStreamDevice per configured video source.
+ *
+ * Cameras are addressed by their index in the registry, which is also the device's
+ * cameraIndex, SystemStateData::activeCameraIndex and FrameData::cameraIndex. Index 0
+ * is the day camera and index 1 the night camera, which the day/night camera control
+ * devices and optics in the state model refer to; any further cameras are auxiliary
+ * sensors. Every device runs its own capture thread and keeps its own crop profile,
+ * pool and metrics, while colour conversion stripes of all cameras share one worker
+ * pool (Yuy2Converter::sharedPool()), so each added sensor costs a thread, not a pool.
+ * Only the active camera runs at full rate, the others idle in standby.
+ */
+class CameraRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CameraRegistry(QObject *parent = nullptr);
+    ~CameraRegistry() override;
+
+    /**
+     * @brief The day (Sony, /dev/video0) and night (FLIR, /dev/video1, cropped) cameras.
+     */
+    static QVector<CameraConfig> defaultCameras();
+
+    /**
+     * @brief Applies the command line to @p cameras.
+     *
+     * --day-source=<spec> / --night-source=<spec> replace the source of the first two
+     * cameras. --camera=<camera spec> (see CameraConfig::fromSpec(), repeatable)
+     * overrides the camera of that name or adds a new one.
+     */
+    static QVector<CameraConfig> configFromArguments(const QStringList &arguments,
+                                                     QVector<CameraConfig> cameras = defaultCameras());
+
+    /**
+     * @brief Creates (but does not start) a device per camera; call once.
+     */
+    void create(const QVector<CameraConfig> &cameras, SystemStateModel *stateModel);
+
+    void startAll();
+
+    /**
+     * @brief Stops every capture thread and waits up to @p timeoutMs for each.
+     */
+    void stopAll(unsigned long timeoutMs = 2000);
+
+    int count() const { return m_entries.size(); }
+    CameraVideoStreamDevice *device(int index) const; // Null if out of range
+    const CameraConfig &config(int index) const;
+    QVector<CameraVideoStreamDevice *> devices() const;
+    int indexOf(const QString &name) const;           // -1 if unknown
+
+    /**
+     * @brief Promotes the camera at @p activeIndex and puts every other one in standby.
+     */
+    void applyStandby(int activeIndex);
+
+    /**
+     * @brief One line per camera: frames produced/taken/dropped and capture thread CPU load.
+     */
+    QString report() const;
+
+private:
+    struct Entry {
+        CameraConfig config;
+        CameraVideoStreamDevice *device = nullptr;
+    };
+    QVector<Entry> m_entries;
+};
+
+#endif // CAMERAREGISTRY_H
@@ -3,12 +3,70 @@
 
 #include <QDebug>
 #include <QElapsedTimer>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
 #include <stdexcept>
+#include <thread>
+#include <utility> // For std::move
 
 #include <opencv2/imgcodecs.hpp>
 
+namespace {
+// Interval over which per-camera CPU load is averaged and logged
+constexpr qint64 CPU_REPORT_INTERVAL_NS = 5000000000LL;
+// Capture timestamps older than this at the appsink are assumed to come from another clock
+constexpr qint64 MAX_CAPTURE_AGE_NS = 10000000000LL;
+
+// Output frames keep a 4:3 geometry, sized from the display (or the source until it reports)
+constexpr int OUTPUT_ASPECT_W = 4;
+constexpr int OUTPUT_ASPECT_H = 3;
+constexpr int MIN_OUTPUT_WIDTH = 160;
+constexpr int MIN_OUTPUT_HEIGHT = 120;
+
+// Pipeline supervision: watchdog period, frame gap treated as a stall, restart backoff bounds
+constexpr guint WATCHDOG_INTERVAL_MS = 250;
+constexpr qint64 FRAME_STALL_TIMEOUT_NS = 2000000000LL;
+constexpr qint64 RESTART_BACKOFF_INITIAL_MS = 250;
+constexpr qint64 RESTART_BACKOFF_MAX_MS = 8000;
+
+// Recorder branch: frames the encoder may fall behind by before its queue leaks, key frame interval
+constexpr int RECORDER_QUEUE_BUFFERS = 8;
+constexpr int RECORDER_KEY_FRAME_SECONDS = 1;
+
+// User data of one on_thread_cpu_probe: each probe keeps its own previous sample, so probes
+// sharing a streaming thread, or a thread GStreamer moves to another queue, are not mixed up
+struct ThreadCpuProbeState {
+    std::atomic<qint64> *accumulator = nullptr;
+    std::thread::id thread; // Thread the last sample was taken on
+    qint64 lastCpuNs = 0;
+};
+
+quint32 packSize(int width, int height)
+{
+    return (static_cast<quint32>(width) << 16) | static_cast<quint32>(height & 0xFFFF);
+}
+
+int packedWidth(quint32 packed) { return static_cast<int>(packed >> 16); }
+int packedHeight(quint32 packed) { return static_cast<int>(packed & 0xFFFF); }
+
+qint64 monotonicNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time consumed by the calling thread (the GStreamer streaming thread in the sample callback)
+qint64 threadCpuNowNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+} // namespace
+
 CameraVideoStreamDevice::CameraVideoStreamDevice(int cameraIndex,
-                               const QString &deviceName,
+                               const VideoSourceConfig &sourceConfig,
                                int sourceWidth,
                                int sourceHeight,
                                SystemStateModel* stateModel,
@@ -16,27 +74,17 @@ CameraVideoStreamDevice::CameraVideoStreamDevice(int cameraIndex,
     : QThread(parent), // Base class first
     // Configuration & Identification (in declaration order)
     m_cameraIndex(cameraIndex),
-    m_deviceName(deviceName),
+    m_sourceConfig(sourceConfig),
     m_sourceWidth(sourceWidth),
     m_sourceHeight(sourceHeight),
-    m_outputWidth(1024),
-    m_outputHeight(768),
+    m_outputWidth(outputSizeForDisplay(sourceWidth, sourceHeight).width()),  // Native size until the display reports
+    m_outputHeight(outputSizeForDisplay(sourceWidth, sourceHeight).height()),
     m_stateModel(stateModel),
     m_maxTrackedTargets(1),     // const int - declared early
     m_abortRequest(false),      // atomic<bool> - declared after maxTrackedTargets
     
     // State variables in declaration order
-    m_stabEnabled(false),
-    m_currentAzimuth(0.0f),
-    m_currentElevation(0.0f),
-    m_cameraFOV(10.4f),
-    m_lrfDistance(0.0f),
-    
-    m_sysCharged(true),
-    m_sysArmed(false),
-    m_sysReady(true),           // bool - declared before other atomics
-    m_speed(0.0f),
-    m_trackingEnabled(false),   // atomic<bool> - declared after m_sysReady
+    m_trackingEnabled(false),   // atomic<bool>
     m_trackerInitialized(false),
     m_detectionEnabled(false),  // atomic<bool> - declared last among detection flags
     
@@ -61,37 +109,10 @@ CameraVideoStreamDevice::CameraVideoStreamDevice(int cameraIndex,
     m_lastTargetCenterX_px(0.0f),
     m_lastTargetCenterY_px(0.0f),
     
-    // OpenCV Buffers
-    m_yuy2_host_buffer(),       // cv::Mat
-    
-    // State Variables (in declaration order from header)
-    m_currentMode(OperationalMode::Surveillance),
-    m_motionMode(MotionMode::Manual),
-    m_currentZeroingModeActive(false),
-    m_currentZeroingApplied(false),
-    m_currentZeroingAzOffset(0.0f),
-    m_currentZeroingElOffset(0.0f),
-    
-    m_currentWindageModeActive(false),
-    m_currentWindageApplied(false),
-    m_currentWindageSpeed(0.0f),
-    m_currentIsReticleInNoFireZone(false),
-    m_currentGimbalStoppedAtNTZLimit(false),
-    m_currentReticleAimpointImageX_px(0),
-    m_currentReticleAimpointImageY_px(0),
-    m_currentLeadStatusText(""),
-    m_currentScanName(""),
-    m_currentTrackingPhase(TrackingPhase::Off), // Assuming default value
-    m_trackerHasValidTarget(false),
-    m_currentAcquisitionBoxX_px(0),
-    m_currentAcquisitionBoxY_px(0),
-    m_currentAcquisitionBoxW_px(0),
-    m_currentAcquisitionBoxH_px(0),
-    m_currentActiveCameraIsDay(true),
-    m_fireMode(FireMode::SingleShot),
-    m_reticleType(ReticleType::BoxCrosshair),
-    m_colorStyle(70, 226, 165),
-    m_isLacActiveForReticle(false),
+    // Frame Buffers
+    m_framePool(m_outputWidth, m_outputHeight),
+    m_converter(0, Yuy2Converter::sharedPool()),
+    m_detectionBgrBuffer(),
     
     // YoloInference Engine (last member)
     m_inference("/home/rapit/yolov8s.onnx",
@@ -101,48 +122,22 @@ CameraVideoStreamDevice::CameraVideoStreamDevice(int cameraIndex,
     
     // Frame counter
     m_frameCount(0)
-    // m_stateMutex is default constructed (no initialization needed)
 {
 
     memset(&m_currentTarget, 0, sizeof(m_currentTarget));
     m_currentTarget.state = VPI_TRACKING_STATE_LOST;
 
-        // Sanity check calculated width (should be even for YUY2)
-        if (m_outputWidth % 2 != 0) {
-            qWarning() << "Calculated output width" << m_outputWidth << "is odd, adjusting to" << m_outputWidth - 1;
-            m_outputWidth--;
-        }
         qInfo() << "Cam" << cameraIndex << ": Source Dim=" << m_sourceWidth << "x" << m_sourceHeight
                 << ", Output Dim=" << m_outputWidth << "x" << m_outputHeight;
+    m_requestedOutputSize.store(packSize(m_outputWidth, m_outputHeight)); // Until the display reports its size
+    qRegisterMetaType<VideoStreamHealth>("VideoStreamHealth");
 
 
-    // Initialize OSD state variables
-    m_currentMode = OperationalMode::Idle; // Uses OpMode from osdrenderer.h via cameravideostreamdevice.h
-    m_motionMode = MotionMode::Manual;
-    m_stabEnabled = false;
-    m_lrfDistance = 0.0f;
-    m_sysCharged = false;
-    m_sysArmed = false;
-    m_sysReady = false;
-    m_speed = 0.0;
-    m_fireMode = FireMode::SingleShot; // Assuming this is defined in osdrenderer.h
-
-    m_cameraFOV = 45.0f;
-    m_currentAzimuth = 0.0f;
-    m_currentElevation = 0.0f;
-
-    if (m_cameraIndex == 0) {                // Sony (day)
-        m_cropTop = 0;
-        m_cropBottom = 0;
-        m_cropLeft = 0;
-        m_cropRight = 0; // No cropping for Sony day camera
-    } else {                                 // FLIR (night)  videocrop top=28 left=54  bottom=24  right=46
-        m_cropTop = 28;
-        m_cropBottom = 60;
-        m_cropLeft = 116;
-        m_cropRight = 116; // Cropping for FLIR night camera
-
-    }
+    // Uncropped until setCrop(); the per-camera crop profiles live in CameraRegistry
+    m_cropTop = 0;
+    m_cropBottom = 0;
+    m_cropLeft = 0;
+    m_cropRight = 0;
 
 
 }
@@ -194,6 +189,124 @@ void CameraVideoStreamDevice::setTrackingEnabled(bool enabled)
     }
 }
 
+void CameraVideoStreamDevice::setStandby(bool standby)
+{
+    if (m_standby.load() == standby) {
+        return;
+    }
+    if (!standby) {
+        // Publish the request time before leaving standby so the first full frame can measure latency
+        m_switchRequestedNs.store(monotonicNowNs());
+        m_switchPending.store(true);
+    }
+    m_standby.store(standby);
+    qInfo() << "Cam" << m_cameraIndex << (standby ? ": Entering standby (pipeline kept warm)."
+                                                   : ": Leaving standby, resuming full processing.");
+}
+
+void CameraVideoStreamDevice::setInset(int step, int intervalMs)
+{
+    const int insetStep = qMax(0, step);
+    m_insetIntervalNs.store(static_cast<qint64>(qMax(0, intervalMs)) * 1000000LL, std::memory_order_relaxed);
+    if (m_insetStep.exchange(insetStep, std::memory_order_relaxed) == insetStep) {
+        return;
+    }
+    if (insetStep > 0) {
+        qInfo() << "Cam" << m_cameraIndex << ": Picture-in-picture inset on, 1 /" << insetStep
+                << "decimation every" << intervalMs << "ms.";
+    } else {
+        QMutexLocker locker(&m_insetMutex);
+        m_latestInset = QImage(); // Not shown any more; a later inset starts fresh
+        qInfo() << "Cam" << m_cameraIndex << ": Picture-in-picture inset off.";
+    }
+}
+
+QImage CameraVideoStreamDevice::latestInset() const
+{
+    QMutexLocker locker(&m_insetMutex);
+    return m_latestInset;
+}
+
+QSize CameraVideoStreamDevice::outputSizeForDisplay(int width, int height)
+{
+    // Largest 4:3 size that fits, rounded down to even dimensions (YUY2 pairs, NV12 rows)
+    int outWidth = width;
+    int outHeight = width * OUTPUT_ASPECT_H / OUTPUT_ASPECT_W;
+    if (outHeight > height) {
+        outHeight = height;
+        outWidth = height * OUTPUT_ASPECT_W / OUTPUT_ASPECT_H;
+    }
+    return QSize(std::max(MIN_OUTPUT_WIDTH, outWidth & ~1), std::max(MIN_OUTPUT_HEIGHT, outHeight & ~1));
+}
+
+void CameraVideoStreamDevice::setDisplaySize(int width, int height)
+{
+    const QSize outputSize = outputSizeForDisplay(width, height);
+    const int outWidth = outputSize.width();
+    const int outHeight = outputSize.height();
+
+    const quint32 packed = packSize(outWidth, outHeight);
+    if (m_requestedOutputSize.exchange(packed) != packed) {
+        m_reconfigRequestedNs.store(monotonicNowNs(), std::memory_order_relaxed);
+        qInfo() << "Cam" << m_cameraIndex << ": Display" << width << "x" << height
+                << "-> requesting output" << outWidth << "x" << outHeight;
+    }
+}
+
+bool CameraVideoStreamDevice::setCrop(int top, int bottom, int left, int right)
+{
+    QMutexLocker locker(&m_reconfigMutex);
+    if (top < 0 || bottom < 0 || left < 0 || right < 0 ||
+        m_sourceWidth - left - right < MIN_OUTPUT_WIDTH || m_sourceHeight - top - bottom < MIN_OUTPUT_HEIGHT) {
+        qWarning() << "Cam" << m_cameraIndex << ": Rejecting crop" << top << bottom << left << right
+                   << "for source" << m_sourceWidth << "x" << m_sourceHeight;
+        return false;
+    }
+    const qint64 requestedNs = monotonicNowNs();
+    m_cropTop = top;
+    m_cropBottom = bottom;
+    m_cropLeft = left;
+    m_cropRight = right;
+    if (!m_cropElement) {
+        return true; // Not running: used when the pipeline is built
+    }
+
+    // videocrop reconfigures its source pad on property changes; the output caps stay the same
+    g_object_set(G_OBJECT(m_cropElement), "top", top, "bottom", bottom, "left", left, "right", right, nullptr);
+    qInfo() << "Cam" << m_cameraIndex << ": Crop set to top" << top << "bottom" << bottom
+            << "left" << left << "right" << right;
+    markReconfigurationApplied(requestedNs);
+    return true;
+}
+
+VideoSourceConfig CameraVideoStreamDevice::sourceConfig() const
+{
+    QMutexLocker locker(&m_reconfigMutex);
+    return m_sourceConfig;
+}
+
+bool CameraVideoStreamDevice::setRecorderConfig(const VideoRecorderConfig &config)
+{
+    if (!config.enabled()) {
+        return false;
+    }
+    if (isRunning()) {
+        qWarning() << "Cam" << m_cameraIndex << ": Recorder can only be added before start.";
+        return false;
+    }
+    m_recorder.reset(new VideoRecorder(m_cameraIndex, config));
+    return true;
+}
+
+void CameraVideoStreamDevice::triggerRecordingEvent(const QString &reason)
+{
+    if (!m_recorder) {
+        qDebug() << "Cam" << m_cameraIndex << ": Recording event" << reason << "ignored, no recorder.";
+        return;
+    }
+    m_recorder->triggerEvent(reason);
+}
+
 void CameraVideoStreamDevice::setDetectionEnabled(bool enabled)
 {
     qInfo() << "Cam" << m_cameraIndex << ": Setting detection enabled state to:" << enabled;
@@ -220,13 +333,15 @@ void CameraVideoStreamDevice::run()
         if (!vpiInitialized) throw std::runtime_error("VPI initialization failed.");
         qInfo() << "VPI initialized successfully for Camera" << m_cameraIndex;
 
-        m_yuy2_host_buffer.create(m_sourceHeight, m_sourceWidth, CV_8UC2);
-
         emit statusUpdate(m_cameraIndex, "Starting GStreamer pipeline...");
+        m_pipelineStartNs = monotonicNowNs();
         if (gst_element_set_state(m_pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
-            throw std::runtime_error("Failed to set GStreamer pipeline to PLAYING state.");
+            // Camera missing or busy: keep the thread and let the watchdog retry
+            qWarning() << "Cam" << m_cameraIndex << ": Failed to set GStreamer pipeline to PLAYING state.";
+            scheduleRestart("failed to start");
+        } else {
+            qInfo() << "GStreamer pipeline is PLAYING for Camera" << m_cameraIndex;
         }
-        qInfo() << "GStreamer pipeline is PLAYING for Camera" << m_cameraIndex;
 
         emit statusUpdate(m_cameraIndex, "Processing video...");
         qInfo() << "Running GStreamer main loop for Camera" << m_cameraIndex;
@@ -268,59 +383,6 @@ void CameraVideoStreamDevice::run()
     qInfo() << "CameraVideoStreamDevice thread finished for Camera" << m_cameraIndex;
 }
 
-void CameraVideoStreamDevice::onSystemStateChanged(const SystemStateData &newState)
-{
-    // Lock the mutex to safely update member variables
-    // These members will be read by processFrame in the same thread,
-    // but locking ensures atomicity if multiple signals arrive quickly
-    // or if you were to access these members from other slots/threads.
-  QMutexLocker locker(&m_stateMutex);
-
-    // Update members based on the new state data
-    m_currentMode = newState.opMode;
-    m_motionMode = newState.motionMode;
-    m_stabEnabled = newState.enableStabilization;
-    m_currentAzimuth = newState.gimbalAz;         // Assuming gimbalAz is the display value
-    m_currentElevation = newState.gimbalEl;       // Assuming gimbalEl is the display value
-    m_lrfDistance = newState.lrfDistance;
-    m_sysCharged = newState.ammoLoaded; // Map SystemStateData fields to your OSD needs
-    m_sysArmed = newState.gunArmed;
-    m_sysReady = newState.isReady();      // Use the helper function? Or specific flags
-    m_cameraFOV = newState.activeCameraIsDay ? newState.dayCurrentHFOV : newState.nightCurrentHFOV; // Example: Get FOV based on active cam
-    m_speed = newState.gimbalSpeed; // Assuming gimbalSpeed is the speed value
-    m_fireMode = newState.fireMode; // Assuming fireMode is the rate mode
-    m_reticleType = newState.reticleType; // Assuming reticleType is the type
-    m_colorStyle = newState.colorStyle; // Assuming colorStyle is the color style
-     m_currentZeroingModeActive  = newState.zeroingModeActive  ;  
-     m_currentZeroingApplied = newState.zeroingAppliedToBallistics;
-     m_currentZeroingAzOffset = newState.zeroingAzimuthOffset;
-     m_currentZeroingElOffset = newState.zeroingElevationOffset;   
-
-     m_currentWindageModeActive  = newState.windageModeActive;
-     m_currentWindageApplied = newState.windageAppliedToBallistics;
-    m_currentWindageSpeed = newState.windageSpeedKnots; // Assuming this is the windage speed in knots  
- 
-    m_currentIsReticleInNoFireZone  = newState.isReticleInNoFireZone; // Assuming this is the no-fire zone status
-    // Update the gimbal stopped at NTZ limit status
-    m_currentGimbalStoppedAtNTZLimit = newState.isReticleInNoTraverseZone; // Assuming this is the NTZ limit status
-    m_isLacActiveForReticle = newState.leadAngleCompensationActive; // Assuming this is the LAC status
-    m_currentReticleAimpointImageX_px= newState.reticleAimpointImageX_px; // Assuming these are the reticle aimpoint positions in pixels
-    m_currentReticleAimpointImageY_px= newState.reticleAimpointImageY_px; // Assuming these are the reticle aimpoint positions in pixels
-     m_currentLeadStatusText= newState.leadStatusText; // Assuming this is the lead status text
-    m_currentScanName = newState.currentScanName; // Assuming this is the current scan name
-    // Note: Don't update m_trackingEnabled here directly from newState.trackingActive.
-    // m_trackingEnabled is the *command* given via setTrackingEnabled slot.
-    // The actual tracking status displayed on OSD should come from newState.trackingActive
-    // which will be put into FrameData inside processFrame.
-    m_currentActiveCameraIsDay = newState.activeCameraIsDay;
-    m_currentTrackingPhase = newState.currentTrackingPhase;
-    m_currentAcquisitionBoxX_px = newState.acquisitionBoxX_px;
-    m_currentAcquisitionBoxY_px = newState.acquisitionBoxY_px;
-    m_currentAcquisitionBoxW_px = newState.acquisitionBoxW_px;
-    m_currentAcquisitionBoxH_px = newState.acquisitionBoxH_px;
-}
-
-
 // --- GStreamer Handling --- (No changes needed based on errors)
 bool CameraVideoStreamDevice::initializeGStreamer()
 {
@@ -338,33 +400,44 @@ bool CameraVideoStreamDevice::initializeGStreamer()
                               "video/x-raw,width=1024,height=768 ! "
                               "queue max-size-buffers=2 leaky=downstream ! "
                               "appsink name=mysink emit-signals=true max-buffers=2 drop=true sync=false"
-                              ).arg(m_deviceName).arg(m_sourceWidth).arg(m_sourceHeight);*/
-
-    QString pipelineStr = QString("v4l2src device=%1 do-timestamp=true ! "
-        "video/x-raw,format=YUY2,width=%2,height=%3,framerate=30/1 ! "
-        "videocrop top=%4 left= %6 bottom=%5  right=%7 ! "
+                              ).arg(m_sourceConfig.location).arg(m_sourceWidth).arg(m_sourceHeight);*/
+
+    // Scale once, straight to the size the display asked for; later changes go through applyOutputCaps().
+    // The crop is named so setCrop() can change it live.
+    // The source stage (camera, stream, file or test pattern) always hands YUY2 to videocrop.
+    QMutexLocker reconfigLocker(&m_reconfigMutex);
+    m_appliedOutputSize = m_requestedOutputSize.load();
+    if (packedWidth(m_appliedOutputSize) != m_outputWidth || packedHeight(m_appliedOutputSize) != m_outputHeight) {
+        // Display size reported before start: size the pool for it before the first sample
+        applyOutputGeometry(packedWidth(m_appliedOutputSize), packedHeight(m_appliedOutputSize));
+    }
+    QString pipelineStr = m_sourceConfig.pipelineDescription(m_sourceWidth, m_sourceHeight) + QString(" ! "
+        "videocrop name=crop top=%1 left=%3 bottom=%2 right=%4 ! "
+        "%5"
         "videoscale ! "
-        "video/x-raw,width=1024,height=768 ! "
+        "capsfilter name=outcaps caps=video/x-raw,width=%6,height=%7 ! "
         "queue max-size-buffers=2 leaky=downstream ! "
         "appsink name=mysink emit-signals=true max-buffers=2 drop=true sync=false")
-        .arg(m_deviceName)
-        .arg(m_sourceWidth)
-        .arg(m_sourceHeight)
         .arg(m_cropTop)
         .arg(m_cropBottom)
         .arg(m_cropLeft)
-        .arg(m_cropRight);
-
-    /*QString pipelineStr = QString(
-                              "v4l2src device=%1 do-timestamp=true ! "
-                              "image/jpeg,width=%2,height=%3,framerate=30/1 ! jpegdec ! video/x-raw ! "
-                              "aspectratiocrop aspect-ratio=4/3 ! "
-                              "videoscale  ! "
-                              "video/x-raw,width=1024,height=768 ! "
-                              "videoconvert ! video/x-raw,format=YUY2 ! " // Explicit conversion
-                              "queue max-size-buffers=2 leaky=downstream ! "
-                              "appsink name=mysink emit-signals=true max-buffers=2 drop=true sync=false"
-                              ).arg(m_deviceName).arg(m_sourceWidth).arg(m_sourceHeight);*/
+        .arg(m_cropRight)
+        .arg(m_recorder ? QStringLiteral("tee name=rectee ! ") : QString())
+        .arg(packedWidth(m_appliedOutputSize))
+        .arg(packedHeight(m_appliedOutputSize));
+    if (m_recorder) {
+        // Recorder branch: the leaky queue decouples the encoder thread from the display path
+        pipelineStr += QString(" rectee. ! "
+            "queue name=recqueue leaky=downstream max-size-buffers=%1 max-size-bytes=0 max-size-time=0 ! "
+            "videoconvert ! "
+            "x264enc tune=zerolatency speed-preset=ultrafast threads=1 bitrate=%2 key-int-max=%3 ! "
+            "h264parse config-interval=-1 ! "
+            "video/x-h264,stream-format=byte-stream,alignment=au ! "
+            "appsink name=recsink max-buffers=%1 drop=true sync=false")
+            .arg(RECORDER_QUEUE_BUFFERS)
+            .arg(m_recorder->config().bitrateKbps)
+            .arg(m_sourceConfig.framerate * RECORDER_KEY_FRAME_SECONDS);
+    }
 
     qInfo() << "Cam" << m_cameraIndex << " GStreamer Pipeline:" << pipelineStr;
     GError *error = nullptr;
@@ -383,6 +456,34 @@ bool CameraVideoStreamDevice::initializeGStreamer()
         qCritical() << "Cam" << m_cameraIndex << ": Failed to get appsink element.";
         gst_object_unref(m_pipeline); m_pipeline = nullptr; return false;
     }
+    m_outputCapsFilter = gst_bin_get_by_name(GST_BIN(m_pipeline), "outcaps");
+    if (!m_outputCapsFilter) {
+        qWarning() << "Cam" << m_cameraIndex << ": No output caps filter, display size changes will be ignored.";
+    }
+    m_cropElement = gst_bin_get_by_name(GST_BIN(m_pipeline), "crop");
+    if (!m_cropElement) {
+        qWarning() << "Cam" << m_cameraIndex << ": No crop element, crop changes will apply on the next restart.";
+    }
+    // Compressed sources decode on the thread behind this queue; its CPU time is the decode cost
+    if (GstElement *decodeQueue = gst_bin_get_by_name(GST_BIN(m_pipeline), "decodequeue")) {
+        addThreadCpuProbe(decodeQueue, "src", &m_decodeCpuAccumNs);
+        gst_object_unref(decodeQueue);
+    }
+    m_recorderQueue = gst_bin_get_by_name(GST_BIN(m_pipeline), "recqueue");
+    m_recorderSink = gst_bin_get_by_name(GST_BIN(m_pipeline), "recsink");
+    if (m_recorderQueue && m_recorderSink) {
+        // Likewise the encoder runs behind the recorder queue; buffers in minus out minus queued were leaked
+        addPadProbe(m_recorderQueue, "sink", &CameraVideoStreamDevice::on_buffer_count_probe, &m_recorderBuffersIn);
+        addPadProbe(m_recorderQueue, "src", &CameraVideoStreamDevice::on_buffer_count_probe, &m_recorderBuffersOut);
+        addThreadCpuProbe(m_recorderQueue, "src", &m_encodeCpuAccumNs);
+        GstAppSinkCallbacks recorderCallbacks = {};
+        recorderCallbacks.new_sample = &CameraVideoStreamDevice::on_new_recorded_sample;
+        gst_app_sink_set_callbacks(GST_APP_SINK(m_recorderSink), &recorderCallbacks, this, nullptr);
+        m_recorder->start();
+    } else if (m_recorder) {
+        qWarning() << "Cam" << m_cameraIndex << ": Recorder branch missing, recording disabled.";
+    }
+    reconfigLocker.unlock();
     g_object_set(G_OBJECT(m_appSink), "emit-signals", TRUE, nullptr);
     /*GstAppSinkCallbacks callbacks = {
         nullptr,                                        // eos
@@ -395,17 +496,42 @@ bool CameraVideoStreamDevice::initializeGStreamer()
     callbacks.new_sample = &CameraVideoStreamDevice::on_new_sample_from_sink;
     //GstAppSinkCallbacks callbacks = {nullptr, nullptr, &CameraVideoStreamDevice::on_new_sample_from_sink, nullptr};
     gst_app_sink_set_callbacks(GST_APP_SINK(m_appSink), &callbacks, this, nullptr);
-    m_gstLoop = g_main_loop_new(nullptr, FALSE);
+    // Each camera thread runs its own context; loops sharing the default one would block each other
+    m_gstContext = g_main_context_new();
+    m_gstLoop = g_main_loop_new(m_gstContext, FALSE);
     if (!m_gstLoop) {
         qCritical() << "Cam" << m_cameraIndex << ": Failed to create GStreamer main loop.";
+        g_main_context_unref(m_gstContext); m_gstContext = nullptr;
+        releasePipelineElements();
         gst_object_unref(m_pipeline); m_pipeline = nullptr; m_appSink = nullptr; return false;
     }
+
+    GstBus *bus = gst_element_get_bus(m_pipeline);
+    m_busWatch = gst_bus_create_watch(bus);
+    g_source_set_callback(m_busWatch, reinterpret_cast<GSourceFunc>(&CameraVideoStreamDevice::on_bus_message), this, nullptr);
+    g_source_attach(m_busWatch, m_gstContext);
+    gst_object_unref(bus);
+
+    m_watchdogSource = g_timeout_source_new(WATCHDOG_INTERVAL_MS);
+    g_source_set_callback(m_watchdogSource, &CameraVideoStreamDevice::on_watchdog_tick, this, nullptr);
+    g_source_attach(m_watchdogSource, m_gstContext);
     return true;
 }
 
 void CameraVideoStreamDevice::cleanupGStreamer()
 {
     qInfo() << "Cam" << m_cameraIndex << ": Cleaning up GStreamer...";
+    if (m_recorder && m_recorder->isRunning()) {
+        m_recorder->stop(); // Writes out what is queued, closes the open segment and event clip
+        m_recorder->wait();
+    }
+    for (GSource **source : {&m_busWatch, &m_watchdogSource}) {
+        if (*source) {
+            g_source_destroy(*source);
+            g_source_unref(*source);
+            *source = nullptr;
+        }
+    }
     if (m_gstLoop) {
         if (g_main_loop_is_running(m_gstLoop)) {
              qWarning() << "Cam" << m_cameraIndex << ": GStreamer main loop still running during cleanup!";
@@ -413,6 +539,10 @@ void CameraVideoStreamDevice::cleanupGStreamer()
         g_main_loop_unref(m_gstLoop); m_gstLoop = nullptr;
          qInfo() << "Cam" << m_cameraIndex << ": Unreferenced GStreamer main loop.";
     }
+    if (m_gstContext) {
+        g_main_context_unref(m_gstContext); m_gstContext = nullptr;
+    }
+    releasePipelineElements();
     if (m_pipeline) {
         gst_object_unref(m_pipeline); m_pipeline = nullptr; m_appSink = nullptr;
          qInfo() << "Cam" << m_cameraIndex << ": Unreferenced GStreamer pipeline.";
@@ -421,6 +551,17 @@ void CameraVideoStreamDevice::cleanupGStreamer()
     }
 }
 
+void CameraVideoStreamDevice::releasePipelineElements()
+{
+    QMutexLocker locker(&m_reconfigMutex);
+    for (GstElement **element : {&m_outputCapsFilter, &m_cropElement, &m_recorderQueue, &m_recorderSink}) {
+        if (*element) {
+            gst_object_unref(*element);
+            *element = nullptr;
+        }
+    }
+}
+
 GstFlowReturn CameraVideoStreamDevice::on_new_sample_from_sink(GstAppSink *sink, gpointer user_data)
 {
     CameraVideoStreamDevice *processor = static_cast<CameraVideoStreamDevice *>(user_data);
@@ -431,13 +572,84 @@ GstFlowReturn CameraVideoStreamDevice::on_new_sample_from_sink(GstAppSink *sink,
     return processor->handleNewSample(sink);
 }
 
+GstFlowReturn CameraVideoStreamDevice::on_new_recorded_sample(GstAppSink *sink, gpointer user_data)
+{
+    CameraVideoStreamDevice *processor = static_cast<CameraVideoStreamDevice *>(user_data);
+    GstSample *sample = gst_app_sink_pull_sample(sink);
+    if (!sample) {
+        return gst_app_sink_is_eos(sink) ? GST_FLOW_EOS : GST_FLOW_OK;
+    }
+    GstBuffer *buffer = gst_sample_get_buffer(sample);
+    GstMapInfo map;
+    if (buffer && processor->m_recorder && gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+        // Clock time like FrameTimestamps::captureNs, so lengths stay right across restarts and loops
+        const qint64 ptsNs = GST_BUFFER_PTS_IS_VALID(buffer)
+                                 ? static_cast<qint64>(GST_BUFFER_PTS(buffer) + gst_element_get_base_time(processor->m_pipeline))
+                                 : monotonicNowNs();
+        processor->m_recorder->pushAccessUnit(QByteArray(reinterpret_cast<const char *>(map.data), static_cast<int>(map.size)),
+                                              ptsNs, !GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT));
+        gst_buffer_unmap(buffer, &map);
+    }
+    gst_sample_unref(sample);
+    return GST_FLOW_OK;
+}
+
+GstPadProbeReturn CameraVideoStreamDevice::on_thread_cpu_probe(GstPad *pad, GstPadProbeInfo *info, gpointer probeState)
+{
+    Q_UNUSED(pad);
+    Q_UNUSED(info);
+    // Runs on the streaming thread behind a queue; the pad's stream lock serialises calls per probe
+    ThreadCpuProbeState *state = static_cast<ThreadCpuProbeState *>(probeState);
+    const std::thread::id thread = std::this_thread::get_id();
+    const qint64 cpuNs = threadCpuNowNs();
+    // A sample from another thread's CPU clock is no baseline: start over on this one
+    if (state->lastCpuNs != 0 && state->thread == thread) {
+        state->accumulator->fetch_add(cpuNs - state->lastCpuNs, std::memory_order_relaxed);
+    }
+    state->thread = thread;
+    state->lastCpuNs = cpuNs;
+    return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn CameraVideoStreamDevice::on_buffer_count_probe(GstPad *pad, GstPadProbeInfo *info, gpointer counter)
+{
+    Q_UNUSED(pad);
+    Q_UNUSED(info);
+    static_cast<std::atomic<quint64> *>(counter)->fetch_add(1, std::memory_order_relaxed);
+    return GST_PAD_PROBE_OK;
+}
+
+void CameraVideoStreamDevice::addPadProbe(GstElement *element, const char *padName, GstPadProbeCallback callback,
+                                          gpointer data, GDestroyNotify destroyData)
+{
+    GstPad *pad = gst_element_get_static_pad(element, padName);
+    if (!pad) {
+        qWarning() << "Cam" << m_cameraIndex << ": No pad" << padName << "for a statistics probe.";
+        if (destroyData) {
+            destroyData(data);
+        }
+        return;
+    }
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, callback, data, destroyData);
+    gst_object_unref(pad);
+}
+
+void CameraVideoStreamDevice::addThreadCpuProbe(GstElement *element, const char *padName, std::atomic<qint64> *accumulator)
+{
+    // The probe owns its state; GStreamer frees it with the probe (pipeline teardown)
+    ThreadCpuProbeState *state = new ThreadCpuProbeState;
+    state->accumulator = accumulator;
+    addPadProbe(element, padName, &CameraVideoStreamDevice::on_thread_cpu_probe, state,
+                [](gpointer data) { delete static_cast<ThreadCpuProbeState *>(data); });
+}
+
 GstFlowReturn CameraVideoStreamDevice::handleNewSample(GstAppSink *sink)
 {
+    const qint64 appsinkNs = monotonicNowNs();
     GstSample *sample = gst_app_sink_pull_sample(sink);
     if (!sample) {
         if (gst_app_sink_is_eos(sink)) {
-            qInfo() << "Cam" << m_cameraIndex << ": EOS received.";
-             if (m_gstLoop && g_main_loop_is_running(m_gstLoop)) g_main_loop_quit(m_gstLoop);
+            qInfo() << "Cam" << m_cameraIndex << ": EOS received."; // Restart is handled by the bus watch
             return GST_FLOW_EOS;
         } else if (m_abortRequest.load()) {
              qDebug() << "Cam" << m_cameraIndex << ": Sample pull failed after abort request.";
@@ -453,7 +665,40 @@ GstFlowReturn CameraVideoStreamDevice::handleNewSample(GstAppSink *sink)
         gst_sample_unref(sample); return GST_FLOW_ERROR;
     }
 
+    // Display size changed: renegotiate videoscale (takes effect a few buffers later)
+    const quint32 requestedSize = m_requestedOutputSize.load(std::memory_order_relaxed);
+    if (requestedSize != m_appliedOutputSize) {
+        applyOutputCaps(requestedSize);
+    }
+    // Follow the size of the buffers actually delivered (old-size buffers may still be queued)
+    if (GstCaps *sampleCaps = gst_sample_get_caps(sample)) {
+        const GstStructure *structure = gst_caps_get_structure(sampleCaps, 0);
+        int width = 0;
+        int height = 0;
+        if (structure && gst_structure_get_int(structure, "width", &width) &&
+            gst_structure_get_int(structure, "height", &height) &&
+            (width != m_outputWidth || height != m_outputHeight)) {
+            applyOutputGeometry(width, height);
+        }
+    }
+
+    // The pipeline runs on the (monotonic) system clock: PTS + base time is the capture time on our clock
+    m_sampleTimestamps = FrameTimestamps();
+    m_sampleTimestamps.appsinkNs = appsinkNs;
+    if (GST_BUFFER_PTS_IS_VALID(buffer) && m_pipeline) {
+        const qint64 captureNs = static_cast<qint64>(GST_BUFFER_PTS(buffer) + gst_element_get_base_time(m_pipeline));
+        // Discard stamps from a foreign clock instead of reporting nonsense
+        if (captureNs <= appsinkNs && appsinkNs - captureNs < MAX_CAPTURE_AGE_NS) {
+            m_sampleTimestamps.captureNs = captureNs;
+        }
+    }
+    checkReconfigurationDone(appsinkNs);
+    m_lastSampleNs.store(appsinkNs, std::memory_order_relaxed);
+    qint64 noSampleYet = 0;
+    m_firstSampleNs.compare_exchange_strong(noSampleYet, appsinkNs, std::memory_order_relaxed);
+
     bool success = false;
+    const qint64 cpuStartNs = threadCpuNowNs();
     try {
         success = processFrame(buffer);
     } catch (const std::exception &e) {
@@ -466,6 +711,7 @@ GstFlowReturn CameraVideoStreamDevice::handleNewSample(GstAppSink *sink)
         success = false;
     }
     gst_sample_unref(sample);
+    updateCpuLoad(threadCpuNowNs() - cpuStartNs);
     if (m_abortRequest.load(std::memory_order_relaxed)) {
         qDebug() << "Cam" << m_cameraIndex << ": Abort requested during frame processing.";
         return GST_FLOW_EOS;
@@ -473,6 +719,307 @@ GstFlowReturn CameraVideoStreamDevice::handleNewSample(GstAppSink *sink)
     return success ? GST_FLOW_OK : GST_FLOW_ERROR;
 }
 
+gboolean CameraVideoStreamDevice::on_bus_message(GstBus *bus, GstMessage *message, gpointer user_data)
+{
+    Q_UNUSED(bus);
+    static_cast<CameraVideoStreamDevice *>(user_data)->handleBusMessage(message);
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean CameraVideoStreamDevice::on_watchdog_tick(gpointer user_data)
+{
+    CameraVideoStreamDevice *processor = static_cast<CameraVideoStreamDevice *>(user_data);
+    if (processor->m_abortRequest.load(std::memory_order_relaxed)) {
+        return G_SOURCE_REMOVE;
+    }
+    processor->superviseStream();
+    return G_SOURCE_CONTINUE;
+}
+
+void CameraVideoStreamDevice::handleBusMessage(GstMessage *message)
+{
+    const QString sourceName = GST_MESSAGE_SRC(message) ? QString::fromUtf8(GST_MESSAGE_SRC_NAME(message)) : QString("?");
+    switch (GST_MESSAGE_TYPE(message)) {
+    case GST_MESSAGE_ERROR: {
+        GError *error = nullptr;
+        gchar *debugInfo = nullptr;
+        gst_message_parse_error(message, &error, &debugInfo);
+        const QString errorText = error ? QString::fromUtf8(error->message) : QString("Unknown error");
+        qCritical() << "Cam" << m_cameraIndex << ": Pipeline error from" << sourceName << ":" << errorText
+                    << "|" << (debugInfo ? debugInfo : "");
+        if (error) g_error_free(error);
+        g_free(debugInfo);
+        ++m_health.busErrors;
+        emit processingError(m_cameraIndex, QString("Pipeline error from %1: %2").arg(sourceName, errorText));
+        scheduleRestart(QString("error from %1").arg(sourceName));
+        break;
+    }
+    case GST_MESSAGE_WARNING: {
+        GError *warning = nullptr;
+        gchar *debugInfo = nullptr;
+        gst_message_parse_warning(message, &warning, &debugInfo);
+        qWarning() << "Cam" << m_cameraIndex << ": Pipeline warning from" << sourceName << ":"
+                   << (warning ? warning->message : "Unknown warning");
+        if (warning) g_error_free(warning);
+        g_free(debugInfo);
+        ++m_health.busWarnings;
+        break;
+    }
+    case GST_MESSAGE_EOS:
+        // Recorded clips loop; a live source never ends, so EOS means it went away
+        if (sourceConfig().isFile() &&
+            gst_element_seek_simple(m_pipeline, GST_FORMAT_TIME,
+                                    static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT), 0)) {
+            qInfo() << "Cam" << m_cameraIndex << ": End of file, looping.";
+            break;
+        }
+        qWarning() << "Cam" << m_cameraIndex << ": Pipeline reached end of stream.";
+        scheduleRestart("reached end of stream");
+        break;
+    case GST_MESSAGE_QOS: {
+        GstFormat format = GST_FORMAT_UNDEFINED;
+        guint64 processed = 0;
+        guint64 dropped = 0;
+        gst_message_parse_qos_stats(message, &format, &processed, &dropped);
+        ++m_health.qosMessages;
+        if (format == GST_FORMAT_BUFFERS || format == GST_FORMAT_DEFAULT) {
+            // Each element reports its own running total
+            m_qosDroppedBySource[sourceName.toStdString()] = dropped;
+            quint64 total = m_qosDroppedBeforeRestart;
+            for (const auto &entry : m_qosDroppedBySource) {
+                total += entry.second;
+            }
+            m_health.qosDroppedBuffers = total;
+            qDebug() << "Cam" << m_cameraIndex << ": QoS from" << sourceName << "- processed" << processed
+                     << "dropped" << dropped;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void CameraVideoStreamDevice::superviseStream()
+{
+    const qint64 nowNs = monotonicNowNs();
+    const qint64 lastSampleNs = m_lastSampleNs.load(std::memory_order_relaxed);
+    const qint64 quietNs = nowNs - std::max(lastSampleNs, m_pipelineStartNs);
+
+    if (m_restartDueNs != 0) {
+        if (nowNs >= m_restartDueNs) {
+            restartPipeline();
+        }
+    } else if (m_failureDetectedNs != 0 && m_restartAttempts > 0 &&
+               m_firstSampleNs.load(std::memory_order_relaxed) != 0) {
+        // First frame since the last restart: the outage is over
+        const double recoveryMs = (m_firstSampleNs.load(std::memory_order_relaxed) - m_failureDetectedNs) / 1.0e6;
+        m_lastRecoveryMs.store(recoveryMs, std::memory_order_relaxed);
+        m_health.lastRecoveryMs = recoveryMs;
+        qInfo() << "Cam" << m_cameraIndex << ": Pipeline recovered in" << QString::number(recoveryMs, 'f', 1)
+                << "ms after" << m_restartAttempts << "restart(s)";
+        emit statusUpdate(m_cameraIndex, QString("Recovered in %1 ms").arg(recoveryMs, 0, 'f', 1));
+        m_failureDetectedNs = 0;
+        m_restartAttempts = 0;
+    } else if (quietNs >= FRAME_STALL_TIMEOUT_NS) {
+        scheduleRestart(QString("stalled (no frames for %1 ms)").arg(quietNs / 1000000));
+    }
+
+    m_health.streaming = lastSampleNs >= m_pipelineStartNs && quietNs < FRAME_STALL_TIMEOUT_NS;
+    m_health.recovering = m_failureDetectedNs != 0;
+    publishHealth();
+}
+
+void CameraVideoStreamDevice::scheduleRestart(const QString &reason)
+{
+    if (m_abortRequest.load(std::memory_order_relaxed) || m_restartDueNs != 0) {
+        return; // Stopping, or a restart is already due
+    }
+    const qint64 nowNs = monotonicNowNs();
+    if (m_failureDetectedNs == 0) {
+        m_failureDetectedNs = nowNs;
+    }
+    const qint64 delayMs = std::min(RESTART_BACKOFF_MAX_MS, RESTART_BACKOFF_INITIAL_MS << std::min(m_restartAttempts, 16));
+    m_restartDueNs = nowNs + delayMs * 1000000LL;
+    m_health.recovering = true;
+    qWarning() << "Cam" << m_cameraIndex << ": Pipeline" << reason << "- restarting in" << delayMs
+               << "ms (attempt" << m_restartAttempts + 1 << ")";
+    emit statusUpdate(m_cameraIndex, QString("Pipeline %1, restarting in %2 ms").arg(reason).arg(delayMs));
+}
+
+void CameraVideoStreamDevice::restartPipeline()
+{
+    // Serialised with setCrop(), which also changes element properties
+    QMutexLocker locker(&m_reconfigMutex);
+    m_restartDueNs = 0;
+    ++m_restartAttempts;
+    ++m_health.restarts;
+    qInfo() << "Cam" << m_cameraIndex << ": Restarting pipeline on" << m_sourceConfig.toSpec()
+            << "(attempt" << m_restartAttempts << ")";
+
+    gst_element_set_state(m_pipeline, GST_STATE_NULL);
+    // Elements start their QoS totals from zero again
+    for (const auto &entry : m_qosDroppedBySource) {
+        m_qosDroppedBeforeRestart += entry.second;
+    }
+    m_qosDroppedBySource.clear();
+
+    m_firstSampleNs.store(0, std::memory_order_relaxed);
+    m_pipelineStartNs = monotonicNowNs();
+    if (gst_element_set_state(m_pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        locker.unlock();
+        scheduleRestart("failed to restart");
+    }
+}
+
+void CameraVideoStreamDevice::publishHealth()
+{
+    if (m_health == m_reportedHealth) {
+        return;
+    }
+    m_reportedHealth = m_health;
+    emit streamHealthChanged(m_cameraIndex, m_health);
+}
+
+void CameraVideoStreamDevice::applyOutputCaps(quint32 packedSize)
+{
+    m_appliedOutputSize = packedSize;
+    if (!m_outputCapsFilter) {
+        return;
+    }
+    GstCaps *caps = gst_caps_new_simple("video/x-raw",
+                                        "width", G_TYPE_INT, packedWidth(packedSize),
+                                        "height", G_TYPE_INT, packedHeight(packedSize),
+                                        nullptr);
+    g_object_set(G_OBJECT(m_outputCapsFilter), "caps", caps, nullptr);
+    gst_caps_unref(caps);
+    qInfo() << "Cam" << m_cameraIndex << ": Output caps set to" << packedWidth(packedSize) << "x" << packedHeight(packedSize);
+    markReconfigurationApplied(m_reconfigRequestedNs.load(std::memory_order_relaxed));
+}
+
+void CameraVideoStreamDevice::markReconfigurationApplied(qint64 requestedNs)
+{
+    const qint64 appliedNs = monotonicNowNs();
+    m_reconfigRequestedNs.store(requestedNs, std::memory_order_relaxed);
+    m_reconfigAppliedNs.store(appliedNs, std::memory_order_release);
+}
+
+void CameraVideoStreamDevice::checkReconfigurationDone(qint64 appsinkNs)
+{
+    qint64 appliedNs = m_reconfigAppliedNs.load(std::memory_order_acquire);
+    if (appliedNs == 0) {
+        return;
+    }
+    // Done with the first frame captured after the change (frames already queued still show the old setup)
+    const qint64 sampleNs = m_sampleTimestamps.captureNs > 0 ? m_sampleTimestamps.captureNs : appsinkNs;
+    if (sampleNs < appliedNs || !m_reconfigAppliedNs.compare_exchange_strong(appliedNs, 0)) {
+        return;
+    }
+    const qint64 requestedNs = m_reconfigRequestedNs.load(std::memory_order_relaxed);
+    const double elapsedMs = (appsinkNs - requestedNs) / 1.0e6;
+    m_lastReconfigMs.store(elapsedMs, std::memory_order_relaxed);
+    qInfo() << "Cam" << m_cameraIndex << ": Live reconfiguration took" << QString::number(elapsedMs, 'f', 1)
+            << "ms (request to first new frame; applied after" << QString::number((appliedNs - requestedNs) / 1.0e6, 'f', 1)
+            << "ms)";
+    emit statusUpdate(m_cameraIndex, QString("Reconfigured in %1 ms").arg(elapsedMs, 0, 'f', 1));
+}
+
+void CameraVideoStreamDevice::applyOutputGeometry(int width, int height)
+{
+    qInfo() << "Cam" << m_cameraIndex << ": Output geometry" << m_outputWidth << "x" << m_outputHeight
+            << "->" << width << "x" << height;
+    m_outputWidth = width;
+    m_outputHeight = height;
+
+    // Frames still held by the UI keep their own buffers; new ones come at the new size
+    m_framePool.reset(width, height);
+
+    // The tracker works in output pixels: reallocate its frame and drop the old target
+    if (m_vpiStream) {
+        vpiStreamSync(m_vpiStream);
+        VPI_SAFE_DESTROY(vpiImageDestroy, m_vpiFrameNV12);
+        const VPIStatus status = vpiImageCreate(width, height, VPI_IMAGE_FORMAT_NV12_ER, 0, &m_vpiFrameNV12);
+        if (status != VPI_SUCCESS) {
+            qWarning() << "Cam" << m_cameraIndex << ": Failed to reallocate tracker frame:" << vpiStatusGetName(status);
+            m_vpiFrameNV12 = nullptr;
+        }
+    }
+    m_trackerInitialized = false;
+    m_currentTarget = {};
+    m_currentTarget.state = VPI_TRACKING_STATE_LOST;
+}
+
+void CameraVideoStreamDevice::updateCpuLoad(qint64 cpuNs)
+{
+    const qint64 nowNs = monotonicNowNs();
+    if (m_cpuWindowStartNs == 0) {
+        m_cpuWindowStartNs = nowNs;
+    }
+    m_cpuWindowAccumNs += cpuNs;
+
+    const qint64 windowNs = nowNs - m_cpuWindowStartNs;
+    if (windowNs >= CPU_REPORT_INTERVAL_NS) {
+        const double loadPercent = 100.0 * static_cast<double>(m_cpuWindowAccumNs) / static_cast<double>(windowNs);
+        m_cpuLoadPercent.store(loadPercent, std::memory_order_relaxed);
+        qInfo() << "Cam" << m_cameraIndex << ": Frame callback CPU" << QString::number(loadPercent, 'f', 1) << "%"
+                << (m_standby.load(std::memory_order_relaxed) ? "(standby, skipped" : "(active, skipped")
+                << m_standbyFramesSkipped << "frames total)";
+        const qint64 decodeNs = m_decodeCpuAccumNs.exchange(0, std::memory_order_relaxed);
+        if (decodeNs > 0) {
+            const double decodePercent = 100.0 * static_cast<double>(decodeNs) / static_cast<double>(windowNs);
+            m_decodeCpuPercent.store(decodePercent, std::memory_order_relaxed);
+            qInfo() << "Cam" << m_cameraIndex << ": Decode thread CPU" << QString::number(decodePercent, 'f', 1) << "%";
+        }
+        if (m_recorderQueue && m_recorder) {
+            const double encodePercent = 100.0 * static_cast<double>(m_encodeCpuAccumNs.exchange(0, std::memory_order_relaxed))
+                                         / static_cast<double>(windowNs);
+            m_encodeCpuPercent.store(encodePercent, std::memory_order_relaxed);
+            guint queued = 0;
+            g_object_get(G_OBJECT(m_recorderQueue), "current-level-buffers", &queued, nullptr);
+            const quint64 buffersIn = m_recorderBuffersIn.load(std::memory_order_relaxed);
+            const quint64 buffersOut = m_recorderBuffersOut.load(std::memory_order_relaxed) + queued;
+            m_recorderQueueDrops.store(buffersIn > buffersOut ? buffersIn - buffersOut : 0, std::memory_order_relaxed);
+            qInfo() << "Cam" << m_cameraIndex << ": Recorder encode CPU" << QString::number(encodePercent, 'f', 1)
+                    << "%, queue drops" << m_recorderQueueDrops.load(std::memory_order_relaxed) << ","
+                    << m_recorder->takeReport();
+        }
+        if (m_insetWindowCount > 0) {
+            const double insetUs = m_insetWindowCpuNs / 1000.0 / static_cast<double>(m_insetWindowCount);
+            m_insetCostUs.store(insetUs, std::memory_order_relaxed);
+            qInfo() << "Cam" << m_cameraIndex << ": Picture-in-picture" << m_insetWindowCount << "insets,"
+                    << QString::number(insetUs, 'f', 1) << "us CPU each";
+        } else {
+            m_insetCostUs.store(0.0, std::memory_order_relaxed);
+        }
+        m_insetWindowCpuNs = 0;
+        m_insetWindowCount = 0;
+        m_cpuWindowStartNs = nowNs;
+        m_cpuWindowAccumNs = 0;
+    }
+}
+
+void CameraVideoStreamDevice::produceInset(GstBuffer *buffer, int step)
+{
+    const qint64 cpuStartNs = threadCpuNowNs();
+    GstMapInfo mapInfo = GST_MAP_INFO_INIT;
+    if (!gst_buffer_map(buffer, &mapInfo, GST_MAP_READ)) {
+        return;
+    }
+    const size_t expectedSize = static_cast<size_t>(m_outputWidth) * m_outputHeight * 2;
+    // A new image per inset: the GUI thread may still be drawing the previous one
+    QImage inset(m_outputWidth / step, m_outputHeight / step, QImage::Format_ARGB32_Premultiplied);
+    if (mapInfo.size >= expectedSize && !inset.isNull()) {
+        // Only the sampled pixels are read, the full frame is never converted
+        Yuy2Converter::convertDecimated(mapInfo.data, m_outputWidth * 2, m_outputWidth, m_outputHeight, step,
+                                        inset.bits(), inset.bytesPerLine());
+        QMutexLocker locker(&m_insetMutex);
+        m_latestInset = inset;
+    }
+    gst_buffer_unmap(buffer, &mapInfo);
+    m_insetsProduced.fetch_add(1, std::memory_order_relaxed);
+    m_insetWindowCpuNs += threadCpuNowNs() - cpuStartNs;
+    ++m_insetWindowCount;
+}
 
 // --- VPI Handling --- (No changes needed based on errors)
 bool CameraVideoStreamDevice::initializeVPI()
@@ -526,13 +1073,34 @@ void CameraVideoStreamDevice::cleanupVPI()
 // processFrame: Populate FrameData, including data.trackingBbox (should compile now)
 bool CameraVideoStreamDevice::processFrame(GstBuffer *buffer)
 {
+    // Standby: the sample is released untouched (apart from a picture-in-picture inset now
+    // and then), only the tracker state is kept consistent
+    if (m_standby.load(std::memory_order_acquire)) {
+        if (m_trackerInitialized) {
+            qDebug() << "[CAM" << m_cameraIndex << "] Standby, resetting local tracker state.";
+            m_trackerInitialized = false;
+            m_currentTarget = {};
+            m_currentTarget.state = VPI_TRACKING_STATE_LOST;
+        }
+        ++m_standbyFramesSkipped;
+        const int insetStep = m_insetStep.load(std::memory_order_relaxed);
+        if (insetStep > 0) {
+            const qint64 nowNs = monotonicNowNs();
+            if (nowNs - m_lastInsetNs >= m_insetIntervalNs.load(std::memory_order_relaxed)) {
+                m_lastInsetNs = nowNs;
+                produceInset(buffer, insetStep);
+            }
+        }
+        return true;
+    }
+
     GstMapInfo mapInfo = GST_MAP_INFO_INIT;
     VPIImage vpiImgInput_wrapped = nullptr;
     cv::Mat cvFrameBGRA;
     cv::Mat cvFrameBGR;
 
     try {
-        // 1. Map GStreamer Buffer & Copy YUY2
+        // 1. Map GStreamer Buffer (read in place, no host copy)
         if (!gst_buffer_map(buffer, &mapInfo, GST_MAP_READ)) {
             qWarning() << "Cam" << m_cameraIndex << ": Failed to map GStreamer buffer"; return false;
         }
@@ -542,39 +1110,42 @@ bool CameraVideoStreamDevice::processFrame(GstBuffer *buffer)
                         << ") smaller than expected YUY2 size (" << expected_size << ")!";
              gst_buffer_unmap(buffer, &mapInfo); return false;
         }
-        // Ensure host buffer is allocated
-        if (m_yuy2_host_buffer.empty() || m_yuy2_host_buffer.total() * m_yuy2_host_buffer.elemSize() != expected_size) {
-            m_yuy2_host_buffer.create(m_outputHeight, m_outputWidth, CV_8UC2);
+        const int yuy2Stride = m_outputWidth * 2;
+
+        // 2. Convert YUY2 straight into a pooled BGRA buffer that is later shared with the UI.
+        // BGRA with alpha 255 has the same memory layout as ARGB32_Premultiplied on little-endian.
+        QImage frameBuffer = m_framePool.acquire();
+        if (frameBuffer.isNull()) {
+            gst_buffer_unmap(buffer, &mapInfo);
+            throw std::runtime_error("No frame buffer available.");
+        }
+
+        // When detection is on, the packed BGR input for YOLO is produced in the same pass
+        bool detection_this_frame = m_detectionEnabled.load(std::memory_order_relaxed);
+        if (detection_this_frame) {
+            m_detectionBgrBuffer.create(m_outputHeight, m_outputWidth, CV_8UC3);
+            cvFrameBGR = m_detectionBgrBuffer;
         }
-        memcpy(m_yuy2_host_buffer.data, mapInfo.data, expected_size);
+
+        m_converter.convert(mapInfo.data, yuy2Stride, m_outputWidth, m_outputHeight,
+                            frameBuffer.bits(), frameBuffer.bytesPerLine(),
+                            detection_this_frame ? cvFrameBGR.data : nullptr,
+                            detection_this_frame ? static_cast<int>(cvFrameBGR.step) : 0);
         gst_buffer_unmap(buffer, &mapInfo);
+        m_sampleTimestamps.convertedNs = monotonicNowNs();
 
-        // 2. Convert YUY2 host buffer to BGRA
-        cv::cvtColor(m_yuy2_host_buffer, cvFrameBGRA, cv::COLOR_YUV2BGRA_YUY2);
-        if (cvFrameBGRA.empty()) throw std::runtime_error("cv::cvtColor failed YUY2->BGRA.");
+        cvFrameBGRA = cv::Mat(m_outputHeight, m_outputWidth, CV_8UC4,
+                              frameBuffer.bits(), static_cast<size_t>(frameBuffer.bytesPerLine()));
 
         // --- Object Detection Start ---
         std::vector<YoloDetection> detections;
-        bool detection_this_frame = m_detectionEnabled.load(std::memory_order_relaxed);
 
-        if (detection_this_frame) {
-            // The YoloInference class expects a BGR cv::Mat by default (due to blobFromImage swapRB=true)
-            // Or it might handle BGRA if you modify it. Let's assume BGR for now.
-            if (cvFrameBGRA.channels() == 4) {
-                cv::cvtColor(cvFrameBGRA, cvFrameBGR, cv::COLOR_BGRA2BGR);
-            } else if (cvFrameBGRA.channels() == 3) { // If it was already BGR for some reason
-                cvFrameBGR = cvFrameBGRA;
-            } else {
-                qWarning() << "Cam" << m_cameraIndex << "Unsupported channel count for detection input:" << cvFrameBGRA.channels();
-                // Potentially skip detection or handle error
-            }
-
-            if (!cvFrameBGR.empty()) {
-                QElapsedTimer detectionTimer;
-                detectionTimer.start();
-                detections = m_inference.runInference(cvFrameBGR); // Pass the BGR frame
-                qDebug() << "Cam" << m_cameraIndex << "Inference time:" << detectionTimer.elapsed() << "ms, Detections:" << detections.size();
-            }
+        if (detection_this_frame && !cvFrameBGR.empty()) {
+            // The YoloInference class expects a BGR cv::Mat (blobFromImage swapRB=true)
+            QElapsedTimer detectionTimer;
+            detectionTimer.start();
+            detections = m_inference.runInference(cvFrameBGR); // Pass the BGR frame
+            qDebug() << "Cam" << m_cameraIndex << "Inference time:" << detectionTimer.elapsed() << "ms, Detections:" << detections.size();
         }
         // --- Object Detection End ---
 
@@ -582,8 +1153,10 @@ bool CameraVideoStreamDevice::processFrame(GstBuffer *buffer)
         CHECK_VPI_STATUS(vpiImageCreateWrapperOpenCVMat(cvFrameBGRA, 0, &vpiImgInput_wrapped));
 
         // 4. Tracking Logic (State-Driven)
-        TrackingPhase currentPhase = m_currentTrackingPhase; // Use local cached copy
-        bool amITheActiveCamera = (m_cameraIndex == 0) ? m_currentActiveCameraIsDay : !m_currentActiveCameraIsDay;
+        // One consistent state for the whole frame, read without locking the model
+        const SystemStateData state = m_stateModel ? m_stateModel->snapshot() : SystemStateData();
+        TrackingPhase currentPhase = state.currentTrackingPhase;
+        bool amITheActiveCamera = (m_cameraIndex == state.activeCameraIndex);
 
         // Action 1: Handle turning tracking OFF
         if (currentPhase == TrackingPhase::Off) {
@@ -600,7 +1173,7 @@ bool CameraVideoStreamDevice::processFrame(GstBuffer *buffer)
                 switch (currentPhase) {
                     case TrackingPhase::Acquisition:
                         // In Acquisition phase, we don't initialize or run the VPI tracker.
-                        // The OSD will draw the acquisition box based on m_currentAcquisitionBoxX_px etc.
+                        // The OSD will draw the acquisition box from the snapshot's acquisitionBoxX_px etc.
                         // Ensure m_trackerInitialized is false and m_currentTarget is LOST.
                         if (m_trackerInitialized) {
                             qDebug() << "[CAM" << m_cameraIndex << "] In Acquisition, resetting local tracker state.";
@@ -615,8 +1188,8 @@ bool CameraVideoStreamDevice::processFrame(GstBuffer *buffer)
                         if (!m_trackerInitialized) {
                             qDebug() << "[CAM" << m_cameraIndex << "] Initializing tracker with acquisition box...";
                             if (initializeFirstTarget(vpiImgInput_wrapped,
-                                                    m_currentAcquisitionBoxX_px, m_currentAcquisitionBoxY_px,
-                                                    m_currentAcquisitionBoxW_px, m_currentAcquisitionBoxH_px))
+                                                    state.acquisitionBoxX_px, state.acquisitionBoxY_px,
+                                                    state.acquisitionBoxW_px, state.acquisitionBoxH_px))
                             {
                                 m_trackerInitialized = true;
                             } else {
@@ -731,8 +1304,8 @@ bool CameraVideoStreamDevice::processFrame(GstBuffer *buffer)
         // 6. Prepare FrameData
         FrameData data;
         data.cameraIndex = m_cameraIndex;
-        data.baseImage = cvMatToQImage(cvFrameBGRA);
-        if (data.baseImage.isNull()) qWarning() << "Cam" << m_cameraIndex << ": Failed convert cv::Mat to QImage";
+        data.baseImage = std::move(frameBuffer); // Sole reference: the pool gets the buffer back when the last copy goes
+        if (data.baseImage.isNull()) qWarning() << "Cam" << m_cameraIndex << ": Pooled frame buffer is null";
 
         //data.trackingEnabled = tracking_this_frame;
         data.trackerInitialized = m_trackerInitialized;
@@ -743,46 +1316,66 @@ bool CameraVideoStreamDevice::processFrame(GstBuffer *buffer)
                                                             m_currentTarget.bbox.top,
                                                             m_currentTarget.bbox.width,
                                                             m_currentTarget.bbox.height);
-        data.cameraFOV = m_cameraFOV;
-        data.currentOpMode = m_currentMode;
-        data.motionMode = m_motionMode;
-        data.stabEnabled = m_stabEnabled;
-        data.azimuth = m_currentAzimuth;
-        data.elevation = m_currentElevation;
-
-        data.speed = m_speed;
-        data.lrfDistance = m_lrfDistance;
-        data.sysCharged = m_sysCharged;
-        data.sysArmed = m_sysArmed;
-        data.sysReady = m_sysReady;
-        data.fireMode = m_fireMode;
-        data.reticleType = m_reticleType;
-        data.colorStyle = m_colorStyle;
+        data.cameraFOV = state.activeCameraIsDay ? state.dayCurrentHFOV : state.nightCurrentHFOV;
+        data.currentOpMode = state.opMode;
+        data.motionMode = state.motionMode;
+        data.stabEnabled = state.enableStabilization;
+        data.azimuth = state.gimbalAz;
+        data.elevation = state.gimbalEl;
+
+        data.speed = state.gimbalSpeed;
+        data.lrfDistance = state.lrfDistance;
+        data.sysCharged = state.ammoLoaded;
+        data.sysArmed = state.gunArmed;
+        data.sysReady = state.isReady();
+        data.fireMode = state.fireMode;
+        data.reticleType = state.reticleType;
+        data.colorStyle = state.colorStyle;
         data.detectionEnabled = detection_this_frame;
         data.detections = detections;
-        data.zeroingModeActive = m_currentZeroingModeActive;
-        data.zeroingAppliedToBallistics = m_currentZeroingApplied;
-        data.zeroingAzimuthOffset = m_currentZeroingAzOffset;
-        data.zeroingElevationOffset = m_currentZeroingElOffset;
-
-        data.windageModeActive = m_currentWindageModeActive;
-        data.windageAppliedToBallistics = m_currentWindageApplied;
-        data.windageSpeedKnots = m_currentWindageSpeed;
-        data.isReticleInNoFireZone = m_currentIsReticleInNoFireZone;
-        data.gimbalStoppedAtNTZLimit = m_currentGimbalStoppedAtNTZLimit;
-        data.leadAngleActive = m_isLacActiveForReticle; // Assuming this is the LAC status
-        data.reticleAimpointImageX_px = m_currentReticleAimpointImageX_px; // Assuming these are the reticle aimpoint positions in pixels
-        data.reticleAimpointImageY_px = m_currentReticleAimpointImageY_px; // Assuming these are the reticle aimpoint positions in pixels
-        data.leadStatusText = m_currentLeadStatusText; // Assuming this is the lead status text
-        data.currentScanName = m_currentScanName; // Assuming this is the current scan name
-        data.currentTrackingPhase = m_currentTrackingPhase;
-        data.acquisitionBoxX_px = m_currentAcquisitionBoxX_px;
-        data.acquisitionBoxY_px = m_currentAcquisitionBoxY_px ;
-        data.acquisitionBoxW_px = m_currentAcquisitionBoxW_px  ;
-        data.acquisitionBoxH_px = m_currentAcquisitionBoxH_px  ;
+        data.zeroingModeActive = state.zeroingModeActive;
+        data.zeroingAppliedToBallistics = state.zeroingAppliedToBallistics;
+        data.zeroingAzimuthOffset = state.zeroingAzimuthOffset;
+        data.zeroingElevationOffset = state.zeroingElevationOffset;
+
+        data.windageModeActive = state.windageModeActive;
+        data.windageAppliedToBallistics = state.windageAppliedToBallistics;
+        data.windageSpeedKnots = state.windageSpeedKnots;
+        data.isReticleInNoFireZone = state.isReticleInNoFireZone;
+        data.gimbalStoppedAtNTZLimit = state.isReticleInNoTraverseZone;
+        data.leadAngleActive = state.leadAngleCompensationActive;
+        data.reticleAimpointImageX_px = static_cast<int>(state.reticleAimpointImageX_px);
+        data.reticleAimpointImageY_px = static_cast<int>(state.reticleAimpointImageY_px);
+        data.leadStatusText = state.leadStatusText;
+        data.currentScanName = state.currentScanName;
+        data.currentTrackingPhase = state.currentTrackingPhase;
+        data.acquisitionBoxX_px = state.acquisitionBoxX_px;
+        data.acquisitionBoxY_px = state.acquisitionBoxY_px;
+        data.acquisitionBoxW_px = state.acquisitionBoxW_px;
+        data.acquisitionBoxH_px = state.acquisitionBoxH_px;
         data.trackerHasValidTarget = true;
-        // 7. Emit FrameData
-        if (!data.baseImage.isNull()) emit frameDataReady(data);
+        data.timestamps = m_sampleTimestamps;
+        data.timestamps.publishedNs = monotonicNowNs();
+        // 7. Publish FrameData (replaces a frame the UI has not taken yet) and wake the UI once
+        if (!data.baseImage.isNull() && m_frameMailbox.publish(std::move(data))) {
+            emit frameAvailable(m_cameraIndex);
+        }
+
+        if (m_switchPending.exchange(false)) {
+            const double latencyMs = (monotonicNowNs() - m_switchRequestedNs.load()) / 1.0e6;
+            m_lastSwitchLatencyMs.store(latencyMs, std::memory_order_relaxed);
+            qInfo() << "Cam" << m_cameraIndex << ": Standby -> active switch latency"
+                    << QString::number(latencyMs, 'f', 1) << "ms";
+        }
+
+        if (++m_frameCount % 300 == 0) {
+            qDebug() << "Cam" << m_cameraIndex << ": Frame pool buffers:" << m_framePool.bufferCount()
+                     << "reused:" << m_framePool.reuseCount()
+                     << "overflow:" << m_framePool.overflowCount();
+            qDebug() << "Cam" << m_cameraIndex << ": Frames produced:" << framesProduced()
+                     << "taken:" << framesTaken()
+                     << "dropped as stale:" << framesDropped();
+        }
 
     } catch (const std::exception &e) {
         qCritical() << "Cam" << m_cameraIndex << ": Exception in processFrame loop:" << e.what();
@@ -977,37 +1570,3 @@ bool CameraVideoStreamDevice::runTrackingCycle(VPIImage vpiFrameInput)
     }
     return true;
 }
-
-
-// --- Helper Functions --- (No changes needed based on errors)
-QImage CameraVideoStreamDevice::cvMatToQImage(const cv::Mat &inMat)
-{
-    switch (inMat.type()) {
-        case CV_8UC4: { // BGRA
-            QImage image(inMat.data, inMat.cols, inMat.rows, static_cast<int>(inMat.step), QImage::Format_ARGB32);
-            return image.copy();
-        }
-        case CV_8UC3: { // BGR
-            QImage image(inMat.data, inMat.cols, inMat.rows, static_cast<int>(inMat.step), QImage::Format_RGB888);
-            return image.rgbSwapped().copy();
-        }
-        case CV_8UC1: { // Grayscale
-             #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-                 QImage image(inMat.data, inMat.cols, inMat.rows, static_cast<int>(inMat.step), QImage::Format_Grayscale8);
-             #else
-                 static QVector<QRgb> sColorTable; // Fallback for older Qt
-                 if (sColorTable.isEmpty()) {
-                     sColorTable.resize(256);
-                     for (int i = 0; i < 256; ++i) sColorTable[i] = qRgb(i, i, i);
-                 }
-                 QImage image(inMat.data, inMat.cols, inMat.rows, static_cast<int>(inMat.step), QImage::Format_Indexed8);
-                 image.setColorTable(sColorTable);
-            #endif
-            return image.copy();
-        }
-        default:
-            qWarning("cvMatToQImage() - Unsupported CV type: %d for cam %d", inMat.type(), m_cameraIndex);
-            break;
-    }
-    return QImage();
-}
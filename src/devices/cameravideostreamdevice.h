@@ -3,7 +3,9 @@
 
 // --- Standard Library Includes ---
 #include <atomic>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector> // For FrameData::detections
 
 // --- Qt Includes ---
@@ -35,8 +37,14 @@
 
 // --- Project Includes ---
 #include "osdrenderer.h" // For OperationalMode, MotionMode, FireMode, ReticleType
+#include "framebufferpool.h" // Recycled frame buffers shared with the UI
 #include "../utils/inference.h" // For Detection struct used in FrameData
-#include "../models/systemstatemodel.h" // For SystemStateData used in onSystemStateChanged slot
+#include "../utils/yuy2converter.h" // SIMD YUY2 -> BGRA/BGR conversion
+#include "../utils/latestvaluemailbox.h" // Newest-frame handoff to the UI
+#include "framelatency.h" // Per-frame timestamp trail
+#include "videosourceconfig.h" // Source stage of the pipeline
+#include "videorecorder.h" // Optional rolling recorder branch
+#include "../models/systemstatemodel.h" // SystemStateModel::snapshot(), read once per frame
 
 // --- Data Structure Definition ---
 
@@ -45,7 +53,8 @@
  */
 struct FrameData {
     int cameraIndex = -1;
-    QImage baseImage;
+    QImage baseImage; // Pooled buffer; written after emission only by a sole holder (OsdRenderMode::InPlace)
+
     bool trackingEnabled = false;
     bool trackerInitialized = false;
     VPITrackingState trackingState = VPI_TRACKING_STATE_LOST;
@@ -98,6 +107,8 @@ struct FrameData {
     float acquisitionBoxY_px = 0.0f;
     float acquisitionBoxW_px = 0.0f;
     float acquisitionBoxH_px = 0.0f;
+
+    FrameTimestamps timestamps; // Filled up to publishedNs here, completed by the UI
 };
 
 // --- Class Definition ---
@@ -107,7 +118,12 @@ struct FrameData {
  *
  * This class runs in a separate thread to avoid blocking the main GUI thread.
  * It receives video frames, performs VPI operations (like tracking), gathers system state,
- * and emits the combined data in a FrameData struct.
+ * and publishes the combined data in a FrameData struct to a latest-frame mailbox.
+ *
+ * The pipeline is supervised from the thread's own GLib main context: a bus watch counts
+ * errors, warnings and QoS drops, and a watchdog restarts the pipeline (NULL -> PLAYING,
+ * with exponential backoff) when frames stop arriving or the bus reports an error or EOS.
+ * The result is published as VideoStreamHealth through streamHealthChanged().
  */
 class CameraVideoStreamDevice : public QThread
 {
@@ -116,7 +132,7 @@ class CameraVideoStreamDevice : public QThread
 public:
     // --- Constructor & Destructor ---
     explicit CameraVideoStreamDevice(int cameraIndex,
-                            const QString &deviceName,
+                            const VideoSourceConfig &sourceConfig,
                             int sourceWidth, // Output width expected after processing (e.g., crop/scale)
                             int sourceHeight, // Output height expected
                             SystemStateModel* stateModel,
@@ -129,6 +145,127 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Puts the processor into or out of standby.
+     *
+     * In standby the GStreamer pipeline keeps running (so the camera stays warm and
+     * switching back is instant), but samples are released without conversion,
+     * tracking or emission. Thread-safe; takes effect on the next frame.
+     * @param standby True to idle the processor, false to resume full processing.
+     */
+    void setStandby(bool standby);
+    bool isStandby() const { return m_standby.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Produces a picture-in-picture inset of this camera while it is in standby.
+     *
+     * Every @p intervalMs the capture thread samples every @p step-th pixel of the raw
+     * YUY2 frame (Yuy2Converter::convertDecimated()) into a small BGRA image, read with
+     * latestInset(); the other standby frames are still released untouched. Thread-safe;
+     * @p step 0 stops the insets and drops the last one.
+     */
+    void setInset(int step, int intervalMs);
+
+    /**
+     * @brief The newest inset (shared, not copied), or a null image.
+     */
+    QImage latestInset() const;
+
+    // --- Inset Statistics (thread-safe) ---
+    quint64 insetsProduced() const { return m_insetsProduced.load(std::memory_order_relaxed); }
+    double insetCostUs() const { return m_insetCostUs.load(std::memory_order_relaxed); } // Mean per inset, last reporting window
+
+    /**
+     * @brief Requests output frames sized for a display of @p width x @p height.
+     *
+     * The pipeline's single videoscale is renegotiated to the largest 4:3 size (even
+     * dimensions) that fits the display, so frames reach the UI at display resolution
+     * and are shown without a second scale. Thread-safe; the new caps are applied from
+     * the streaming thread on the next sample, without restarting the thread. The time
+     * the change took is reported like other reconfigurations (lastReconfigurationMs()).
+     */
+    void setDisplaySize(int width, int height);
+
+    /**
+     * @brief Output frame size setDisplaySize() requests for a @p width x @p height display.
+     *
+     * Also the size frames start at when the display has not reported yet (from the source).
+     */
+    static QSize outputSizeForDisplay(int width, int height);
+
+    /**
+     * @brief Changes the videocrop margins (source pixels) on the live pipeline.
+     *
+     * Thread-safe. videocrop renegotiates in place and videoscale keeps the output size,
+     * so the thread, main loop and VPI resources are untouched. Before start() the values
+     * are only stored for the pipeline that is built then.
+     * @return False if the crop leaves less than the minimum output size.
+     */
+    bool setCrop(int top, int bottom, int left, int right);
+
+    /**
+     * @brief The source stage (type and location) the pipeline is built from.
+     */
+    VideoSourceConfig sourceConfig() const;
+
+    /**
+     * @brief Adds a rolling recorder branch to the pipeline; call before start().
+     *
+     * The cropped source frames are teed into a leaky queue feeding a software H.264
+     * encoder on its own thread, whose output goes to a VideoRecorder. A slow encoder or
+     * disk drops recorder frames but never delays the display path.
+     * @return False if the thread is already running or @p config is disabled.
+     */
+    bool setRecorderConfig(const VideoRecorderConfig &config);
+    VideoRecorder *recorder() const { return m_recorder.get(); } // Null without a recorder
+
+    // --- Recorder Statistics (thread-safe, updated every reporting window) ---
+    double recorderEncodeCpuPercent() const { return m_encodeCpuPercent.load(std::memory_order_relaxed); }
+    quint64 recorderQueueDrops() const { return m_recorderQueueDrops.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Duration of the last live reconfiguration (crop or output size), in ms:
+     * from the request to the first frame captured after it was applied.
+     */
+    double lastReconfigurationMs() const { return m_lastReconfigMs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Duration of the last automatic recovery, in ms: from detecting the stall or
+     * error to the first frame after the restart that fixed it.
+     */
+    double lastRecoveryMs() const { return m_lastRecoveryMs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief CPU time spent in the frame callback as a percentage of wall time,
+     * measured over the last reporting window.
+     */
+    double cpuLoadPercent() const { return m_cpuLoadPercent.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief CPU time of the decode thread (decoder and colour conversion of compressed
+     * sources) as a percentage of wall time over the last reporting window; 0 for raw sources.
+     */
+    double decodeCpuPercent() const { return m_decodeCpuPercent.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Time from the last promotion out of standby to the first emitted frame, in ms.
+     */
+    double lastSwitchLatencyMs() const { return m_lastSwitchLatencyMs.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Moves the newest processed frame into @p data.
+     *
+     * Call from the (single) consumer thread after frameAvailable(). Frames published
+     * since the previous call are dropped in favour of the newest one.
+     * @return False if no frame was published since the last call.
+     */
+    bool takeLatestFrame(FrameData &data) { return m_frameMailbox.take(data); }
+
+    // --- Frame Delivery Statistics (thread-safe) ---
+    quint64 framesProduced() const { return m_frameMailbox.producedCount(); }
+    quint64 framesTaken() const { return m_frameMailbox.takenCount(); }
+    quint64 framesDropped() const { return m_frameMailbox.droppedCount(); } // Overwritten before being taken
+
 public slots:
     // --- Public Slots ---
     /**
@@ -144,18 +281,21 @@ public slots:
     void setDetectionEnabled(bool enabled);
 
     /**
-     * @brief Updates the internal state based on system-wide changes.
-     * @param newState The latest system state data.
+     * @brief Saves the recorder's pre-event buffer and what follows as an event clip.
+     * @param reason Short tag for the clip name, e.g. "operator" or "emergency_stop".
      */
-    void onSystemStateChanged(const SystemStateData &newState);
+    void triggerRecordingEvent(const QString &reason);
 
 signals:
     // --- Signals ---
     /**
-     * @brief Emitted when a new frame has been processed and its data is ready.
-     * @param data The structure containing the image and associated metadata.
+     * @brief Emitted when a processed frame lands in an empty mailbox.
+     *
+     * Coalesced: while the consumer has not called takeLatestFrame() yet, further
+     * frames replace the pending one without emitting again.
+     * @param cameraIndex The index of the camera that produced the frame.
      */
-    void frameDataReady(const FrameData &data);
+    void frameAvailable(int cameraIndex);
 
     /**
      * @brief Emitted when a processing error occurs.
@@ -171,6 +311,15 @@ signals:
      */
     void statusUpdate(int cameraIndex, const QString &statusMessage);
 
+    /**
+     * @brief Emitted from the processing thread when the pipeline health changes.
+     *
+     * Checked on every watchdog tick (at most four times per second).
+     * @param cameraIndex The index of the camera the report belongs to.
+     * @param health Streaming state, bus/QoS counters and restart statistics.
+     */
+    void streamHealthChanged(int cameraIndex, const VideoStreamHealth &health);
+
 protected:
     // --- QThread Reimplementation ---
     /**
@@ -191,51 +340,66 @@ private:
     void cleanupGStreamer();
     static GstFlowReturn on_new_sample_from_sink(GstAppSink *sink, gpointer user_data);
     GstFlowReturn handleNewSample(GstAppSink *sink);
+    static GstFlowReturn on_new_recorded_sample(GstAppSink *sink, gpointer user_data);
+    static GstPadProbeReturn on_thread_cpu_probe(GstPad *pad, GstPadProbeInfo *info, gpointer probeState);
+    static GstPadProbeReturn on_buffer_count_probe(GstPad *pad, GstPadProbeInfo *info, gpointer counter);
+    void addPadProbe(GstElement *element, const char *padName, GstPadProbeCallback callback, gpointer data,
+                     GDestroyNotify destroyData = nullptr);
+    void addThreadCpuProbe(GstElement *element, const char *padName, std::atomic<qint64> *accumulator);
+
+    // Pipeline Supervision (main loop thread)
+    static gboolean on_bus_message(GstBus *bus, GstMessage *message, gpointer user_data);
+    static gboolean on_watchdog_tick(gpointer user_data);
+    void handleBusMessage(GstMessage *message);
+    void superviseStream();
+    void scheduleRestart(const QString &reason);
+    void restartPipeline();
+    void publishHealth();
 
     // VPI Management & Processing
     bool initializeVPI();
     void cleanupVPI();
     bool processFrame(GstBuffer *buffer);
+    void produceInset(GstBuffer *buffer, int step);
+    void applyOutputCaps(quint32 packedSize);
+    void markReconfigurationApplied(qint64 requestedNs);
+    void checkReconfigurationDone(qint64 appsinkNs);
+    void releasePipelineElements();
+    void applyOutputGeometry(int width, int height);
+    void updateCpuLoad(qint64 cpuNs);
     bool initializeFirstTarget(VPIImage vpiFrameInput, float boxX, float boxY, float boxW, float boxH);
     bool runTrackingCycle(VPIImage vpiFrameInput);
 
-    // Utility Methods
-    QImage cvMatToQImage(const cv::Mat &inMat);
-
     // --- Member Variables ---
 
     // Thread Control
 
     // Configuration & Identification
     int m_cameraIndex;          // Identifier for this processor instance
-    QString m_deviceName;       // e.g., /dev/video0
+    VideoSourceConfig m_sourceConfig; // e.g., v4l2:/dev/video0 (guarded by m_reconfigMutex, like the source size and crop)
     int m_sourceWidth;          // Width from the GStreamer source (e.g., v4l2src)
     int m_sourceHeight;         // Height from the GStreamer source
-    int m_outputWidth;          // Target width after VPI processing (e.g., crop/scale)
-    int m_outputHeight;         // Target height after VPI processing
-    SystemStateModel* m_stateModel;
+    int m_outputWidth;          // Width of the delivered frames (negotiated from the display size)
+    int m_outputHeight;         // Height of the delivered frames (streaming thread only after start)
+    SystemStateModel* m_stateModel; // OSD and tracker inputs come from its snapshot(), read once per frame
     const int m_maxTrackedTargets; // Max targets for VPI arrays
     std::atomic<bool> m_abortRequest; // Flag to signal thread termination
 
 
-    bool m_stabEnabled;
-    float m_currentAzimuth;
-    float m_currentElevation;
-    float m_cameraFOV;
-    float m_lrfDistance;
-
-
-    bool m_sysCharged;
-    bool m_sysArmed;
-    bool m_sysReady;
-    float m_speed;
     std::atomic<bool> m_trackingEnabled; // Control flag for enabling/disabling tracking
     bool m_trackerInitialized;  // Flag indicating if the tracker has an initial target
     std::atomic<bool> m_detectionEnabled; // Control flag for enabling/disabling detection
     // GStreamer Components
     GstElement *m_pipeline;     // The GStreamer pipeline
     GstElement *m_appSink;      // Sink element to grab frames from
+    GstElement *m_outputCapsFilter = nullptr; // Caps after videoscale, sets the output size
+    GstElement *m_cropElement = nullptr;      // videocrop (guarded by m_reconfigMutex)
+    GstElement *m_recorderQueue = nullptr;    // Leaky queue in front of the recorder encoder
+    GstElement *m_recorderSink = nullptr;     // Encoded access units for m_recorder
     GMainLoop *m_gstLoop;       // GStreamer main loop for event handling
+    GMainContext *m_gstContext = nullptr; // Per-device context for the loop, bus watch and watchdog
+    GSource *m_busWatch = nullptr;
+    GSource *m_watchdogSource = nullptr;
 
     // VPI Components & State
     VPIBackend m_vpiBackend;    // VPI backend (e.g., VPI_BACKEND_CUDA)
@@ -254,39 +418,12 @@ private:
     float m_lastTargetCenterY_px;
 
 
-    // OpenCV Buffers (if needed for intermediate steps)
-    cv::Mat m_yuy2_host_buffer; // Example buffer for format conversion
-
-    // State Variables (synchronized via mutex or atomic where needed)
-    QMutex m_stateMutex;        // Mutex to protect access to shared state variables below
-    OperationalMode m_currentMode;
-    MotionMode m_motionMode;
-    bool m_currentZeroingModeActive;  
-    bool m_currentZeroingApplied;
-    float m_currentZeroingAzOffset;
-    float m_currentZeroingElOffset;
-    //TrackingPhase m_currentTrackingState; // Current tracking state (e.g., VPI_TRACKING_STATE_LOST)
-
-    bool m_currentWindageModeActive;
-    bool m_currentWindageApplied;
-    float m_currentWindageSpeed;
-    bool m_currentIsReticleInNoFireZone;
-    bool m_currentGimbalStoppedAtNTZLimit;
-    int m_currentReticleAimpointImageX_px;
-    int m_currentReticleAimpointImageY_px;
-    QString m_currentLeadStatusText; 
-    QString m_currentScanName; // Name of the current scan (if applicable)
-    TrackingPhase m_currentTrackingPhase; // Current tracking phase (e.g., acquisition, tracking)
-    bool m_trackerHasValidTarget;
-    int m_currentAcquisitionBoxX_px; // X position of the acquisition box in pixels
-    int m_currentAcquisitionBoxY_px; // Y position of the acquisition box in pixels
-    int m_currentAcquisitionBoxW_px; // Width of the acquisition box in pixels
-    int m_currentAcquisitionBoxH_px; // Height of the acquisition box in pixels
-    bool m_currentActiveCameraIsDay; // Flag indicating if the active camera is a day camera
-    FireMode m_fireMode;
-    ReticleType m_reticleType;
-    QColor m_colorStyle;
-    bool m_isLacActiveForReticle; // Flag for LAC reticle mode
+    // Frame Buffers
+    FrameBufferPool m_framePool; // BGRA output buffers, recycled once the UI releases them
+    Yuy2Converter m_converter;   // Striped SIMD colour conversion (workers shared by all cameras)
+    LatestValueMailbox<FrameData> m_frameMailbox; // Streaming thread publishes, UI thread takes
+    FrameTimestamps m_sampleTimestamps;           // Stamps of the sample being processed (streaming thread only)
+    cv::Mat m_detectionBgrBuffer; // BGR side output for YOLO, reused across frames
 
     // YoloInference Engine
     YoloInference m_inference;      // Object detection inference handler
@@ -294,6 +431,60 @@ private:
 
     int m_frameCount = 0;
 
+    // Standby & Load Accounting
+    std::atomic<bool> m_standby{false};
+    std::atomic<bool> m_switchPending{false};       // Set on promotion, cleared by the first emitted frame
+    std::atomic<qint64> m_switchRequestedNs{0};      // Monotonic time of the last promotion
+    std::atomic<double> m_lastSwitchLatencyMs{0.0};
+    std::atomic<double> m_cpuLoadPercent{0.0};
+    std::atomic<double> m_decodeCpuPercent{0.0};
+    std::atomic<qint64> m_decodeCpuAccumNs{0};       // Added by the decode thread, taken per window
+
+    // Rolling Recorder
+    std::unique_ptr<VideoRecorder> m_recorder;
+    std::atomic<qint64> m_encodeCpuAccumNs{0};       // Added by the encoder thread, taken per window
+    std::atomic<double> m_encodeCpuPercent{0.0};
+    std::atomic<quint64> m_recorderBuffersIn{0};     // Entering the recorder queue
+    std::atomic<quint64> m_recorderBuffersOut{0};    // Leaving it towards the encoder
+    std::atomic<quint64> m_recorderQueueDrops{0};
+    qint64 m_cpuWindowStartNs = 0;                   // Streaming thread only
+    qint64 m_cpuWindowAccumNs = 0;                   // Streaming thread only
+    quint64 m_standbyFramesSkipped = 0;              // Streaming thread only
+
+    // Picture-in-Picture Inset (produced in standby)
+    std::atomic<int> m_insetStep{0};                 // 0: no inset
+    std::atomic<qint64> m_insetIntervalNs{0};
+    qint64 m_lastInsetNs = 0;                        // Streaming thread only
+    mutable QMutex m_insetMutex;                     // Guards m_latestInset
+    QImage m_latestInset;
+    std::atomic<quint64> m_insetsProduced{0};
+    std::atomic<double> m_insetCostUs{0.0};
+    qint64 m_insetWindowCpuNs = 0;                   // Streaming thread only
+    quint64 m_insetWindowCount = 0;                  // Streaming thread only
+
+    // Output Size Negotiation (width << 16 | height)
+    std::atomic<quint32> m_requestedOutputSize;      // Set by setDisplaySize()
+    quint32 m_appliedOutputSize = 0;                 // Last size set on the caps filter (streaming thread only)
+
+    // Live Reconfiguration
+    mutable QMutex m_reconfigMutex;                        // Serialises setCrop() with restarts; guards source and crop settings
+    std::atomic<qint64> m_reconfigRequestedNs{0};    // Monotonic time of the last reconfiguration request
+    std::atomic<qint64> m_reconfigAppliedNs{0};      // Set once applied, cleared by the first frame captured after it
+    std::atomic<double> m_lastReconfigMs{0.0};
+
+    // Pipeline Supervision (main loop thread unless atomic)
+    std::atomic<qint64> m_lastSampleNs{0};           // Appsink time of the newest sample
+    std::atomic<qint64> m_firstSampleNs{0};          // First sample since the last (re)start
+    std::atomic<double> m_lastRecoveryMs{0.0};
+    qint64 m_pipelineStartNs = 0;                    // Last time the pipeline was set to PLAYING
+    qint64 m_failureDetectedNs = 0;                  // Start of the current outage, 0 while healthy
+    qint64 m_restartDueNs = 0;                       // Scheduled restart, 0 if none
+    int m_restartAttempts = 0;                       // Restarts in the current outage
+    std::unordered_map<std::string, quint64> m_qosDroppedBySource; // Running totals from QoS messages
+    quint64 m_qosDroppedBeforeRestart = 0;           // Totals of elements reset by earlier restarts
+    VideoStreamHealth m_health;
+    VideoStreamHealth m_reportedHealth;
+
     int m_cropTop;
     int m_cropBottom;
     int m_cropLeft;
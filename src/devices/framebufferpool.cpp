@@ -0,0 +1,133 @@
+#include "framebufferpool.h"
+
+#include <QDebug>
+
+#include <memory>
+
+// =================================
+// FrameCopyStats
+// =================================
+
+std::atomic<qint64> FrameCopyStats::s_bytesCopied{0};
+std::atomic<qint64> FrameCopyStats::s_framesPresented{0};
+
+double FrameCopyStats::bytesPerFrame()
+{
+    const qint64 frames = framesPresented();
+    if (frames <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(bytesCopied()) / static_cast<double>(frames);
+}
+
+void FrameCopyStats::reset()
+{
+    s_bytesCopied.store(0, std::memory_order_relaxed);
+    s_framesPresented.store(0, std::memory_order_relaxed);
+}
+
+// =================================
+// FrameBufferPool
+// =================================
+
+// Pixel memory plus its owners: the pool, and the image currently lent out (if any).
+// Whichever lets go last frees it.
+struct FrameBufferPool::Buffer {
+    explicit Buffer(size_t bytes) : pixels(new uchar[bytes]) {}
+
+    std::unique_ptr<uchar[]> pixels;
+    std::atomic<int> owners{1};
+};
+
+FrameBufferPool::FrameBufferPool(int width, int height, QImage::Format format,
+                                 int initialBuffers, int maxBuffers)
+    : m_width(width),
+      m_height(height),
+      m_format(format),
+      m_bytesPerLine(((width * QImage::toPixelFormat(format).bitsPerPixel() + 31) / 32) * 4),
+      m_initialBuffers(qMax(1, initialBuffers)),
+      m_maxBuffers(qMax(initialBuffers, maxBuffers))
+{
+    m_buffers.reserve(static_cast<size_t>(m_maxBuffers));
+    allocateBuffers(m_initialBuffers);
+}
+
+FrameBufferPool::~FrameBufferPool()
+{
+    releaseBuffers();
+}
+
+void FrameBufferPool::allocateBuffers(int count)
+{
+    if (m_width <= 0 || m_height <= 0) {
+        qWarning() << "FrameBufferPool: Invalid geometry" << m_width << "x" << m_height;
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        m_buffers.push_back(new Buffer(static_cast<size_t>(m_bytesPerLine) * static_cast<size_t>(m_height)));
+        ++m_allocationCount;
+    }
+}
+
+void FrameBufferPool::releaseBuffers()
+{
+    for (Buffer *buffer : m_buffers) {
+        returnBuffer(buffer);
+    }
+    m_buffers.clear();
+}
+
+QImage FrameBufferPool::lend(Buffer *buffer)
+{
+    buffer->owners.fetch_add(1, std::memory_order_relaxed);
+    return QImage(buffer->pixels.get(), m_width, m_height, m_bytesPerLine, m_format,
+                  &FrameBufferPool::returnBuffer, buffer);
+}
+
+void FrameBufferPool::returnBuffer(void *info)
+{
+    Buffer *buffer = static_cast<Buffer *>(info);
+    // Release: the image's pixel writes happen before the pool hands the buffer out again
+    if (buffer->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete buffer;
+    }
+}
+
+QImage FrameBufferPool::acquire()
+{
+    const size_t count = m_buffers.size();
+    for (size_t i = 0; i < count; ++i) {
+        const size_t index = (m_nextIndex + i) % count;
+        Buffer *candidate = m_buffers[index];
+        // Only the pool owns it -> the last image over it has been destroyed
+        if (candidate->owners.load(std::memory_order_acquire) == 1) {
+            m_nextIndex = (index + 1) % count;
+            ++m_reuseCount;
+            return lend(candidate);
+        }
+    }
+
+    // Every buffer is still in flight (slow consumer). Grow within bounds.
+    if (static_cast<int>(count) < m_maxBuffers) {
+        allocateBuffers(1);
+        if (m_buffers.size() > count) {
+            qDebug() << "FrameBufferPool: Grew to" << m_buffers.size() << "buffers";
+            m_nextIndex = 0;
+            return lend(m_buffers.back());
+        }
+    }
+
+    // Pool exhausted: fall back to a one-off allocation so the producer never blocks.
+    ++m_overflowCount;
+    return QImage(m_width, m_height, m_format);
+}
+
+void FrameBufferPool::reset(int width, int height)
+{
+    releaseBuffers(); // Buffers still in flight live on until their last image goes
+    m_width = width;
+    m_height = height;
+    m_bytesPerLine = ((width * QImage::toPixelFormat(m_format).bitsPerPixel() + 31) / 32) * 4;
+    m_nextIndex = 0;
+    allocateBuffers(m_initialBuffers);
+}
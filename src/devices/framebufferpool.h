@@ -0,0 +1,110 @@
+#ifndef FRAMEBUFFERPOOL_H
+#define FRAMEBUFFERPOOL_H
+
+// --- Standard Library Includes ---
+#include <atomic>
+#include <vector>
+
+// --- Qt Includes ---
+#include <QImage>
+#include <QSize>
+
+/**
+ * @brief Process-wide counters used to verify the video path does not copy pixel data.
+ *
+ * Every stage that still has to duplicate a frame (or a frame-sized region) calls
+ * recordCopy() with the number of bytes it touched. The display side calls
+ * recordFrame() once per presented frame, so bytesPerFrame() gives the average
+ * number of bytes copied between the GstBuffer and the paint call.
+ */
+class FrameCopyStats
+{
+public:
+    static void recordCopy(qint64 bytes) { s_bytesCopied.fetch_add(bytes, std::memory_order_relaxed); }
+    static void recordFrame() { s_framesPresented.fetch_add(1, std::memory_order_relaxed); }
+
+    static qint64 bytesCopied() { return s_bytesCopied.load(std::memory_order_relaxed); }
+    static qint64 framesPresented() { return s_framesPresented.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Average bytes copied per presented frame since the last reset.
+     */
+    static double bytesPerFrame();
+
+    static void reset();
+
+private:
+    static std::atomic<qint64> s_bytesCopied;
+    static std::atomic<qint64> s_framesPresented;
+};
+
+/**
+ * @brief Recycles fixed-size QImage buffers across frames.
+ *
+ * The pool owns the pixel memory but keeps no QImage reference to it. acquire()
+ * wraps a free buffer in a QImage whose cleanup function hands the memory back,
+ * so the caller holds the only reference: QImage::isDetached() is true, and a
+ * consumer that is passed the image by move (OsdRenderMode::InPlace) can paint
+ * into it without a copy. Shallow copies share the buffer as usual; it returns to
+ * the pool when the last of them is destroyed, on whatever thread that happens.
+ *
+ * acquire() and reset() must only be called from the thread that owns the pool.
+ * Buffers still in flight when the pool is reset or destroyed are freed by their
+ * last image.
+ */
+class FrameBufferPool
+{
+public:
+    FrameBufferPool(int width, int height,
+                    QImage::Format format = QImage::Format_ARGB32_Premultiplied,
+                    int initialBuffers = 3, int maxBuffers = 6);
+    ~FrameBufferPool();
+
+    FrameBufferPool(const FrameBufferPool &) = delete;
+    FrameBufferPool &operator=(const FrameBufferPool &) = delete;
+
+    /**
+     * @brief Returns an image over a buffer no consumer is referencing any more.
+     *
+     * Grows the pool up to maxBuffers when every buffer is still in flight. If the
+     * limit is reached, a one-off image is allocated and counted as an overflow.
+     * @return Writable image the caller holds the only reference to.
+     */
+    QImage acquire();
+
+    /**
+     * @brief Drops all buffers and reallocates them for a new frame geometry.
+     */
+    void reset(int width, int height);
+
+    QSize size() const { return QSize(m_width, m_height); }
+    int bufferCount() const { return static_cast<int>(m_buffers.size()); }
+
+    // --- Statistics ---
+    quint64 reuseCount() const { return m_reuseCount; }
+    quint64 allocationCount() const { return m_allocationCount; }
+    quint64 overflowCount() const { return m_overflowCount; }
+
+private:
+    struct Buffer;
+
+    void allocateBuffers(int count);
+    void releaseBuffers();
+    QImage lend(Buffer *buffer);
+    static void returnBuffer(void *buffer); // QImageCleanupFunction
+
+    int m_width;
+    int m_height;
+    QImage::Format m_format;
+    int m_bytesPerLine;
+    int m_initialBuffers;
+    int m_maxBuffers;
+    std::vector<Buffer *> m_buffers;
+    size_t m_nextIndex = 0;    // Round-robin start point so a just-released buffer is not always picked first
+
+    quint64 m_reuseCount = 0;
+    quint64 m_allocationCount = 0;
+    quint64 m_overflowCount = 0;
+};
+
+#endif // FRAMEBUFFERPOOL_H
@@ -0,0 +1,155 @@
+#include "framelatency.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// =================================
+// FrameTimestamps
+// =================================
+
+qint64 FrameTimestamps::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// =================================
+// FrameLatencyStats
+// =================================
+
+std::array<FrameLatencyStats::Histogram, FrameLatencyStats::StageCount> FrameLatencyStats::s_histograms;
+
+void FrameLatencyStats::record(const FrameTimestamps &ts)
+{
+    add(CaptureToAppsink, ts.captureNs, ts.appsinkNs);
+    add(AppsinkToConverted, ts.appsinkNs, ts.convertedNs);
+    add(ConvertedToPublished, ts.convertedNs, ts.publishedNs);
+    add(PublishedToDequeued, ts.publishedNs, ts.dequeuedNs);
+    add(DequeuedToOsdDone, ts.dequeuedNs, ts.osdDoneNs);
+    add(OsdDoneToPresented, ts.osdDoneNs, ts.presentedNs);
+    add(PresentedToPainted, ts.presentedNs, ts.paintedNs);
+    add(EndToEnd, ts.captureNs > 0 ? ts.captureNs : ts.appsinkNs, ts.paintedNs);
+}
+
+void FrameLatencyStats::add(Stage stage, qint64 fromNs, qint64 toNs)
+{
+    if (fromNs <= 0 || toNs <= 0) {
+        return; // Stage not reached (or no PTS)
+    }
+    const qint64 ns = std::max<qint64>(0, toNs - fromNs);
+    Histogram &histogram = s_histograms[stage];
+    histogram.buckets[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+
+    qint64 previousMax = histogram.maxNs.load(std::memory_order_relaxed);
+    while (ns > previousMax
+           && !histogram.maxNs.compare_exchange_weak(previousMax, ns, std::memory_order_relaxed)) {
+    }
+}
+
+int FrameLatencyStats::bucketIndex(qint64 ns)
+{
+    const double us = static_cast<double>(ns) / 1000.0;
+    if (us < 1.0) {
+        return 0;
+    }
+    const int index = static_cast<int>(std::floor(std::log2(us) * SUB_BUCKETS_PER_OCTAVE));
+    return std::min(index, BUCKET_COUNT - 1);
+}
+
+double FrameLatencyStats::bucketUpperMs(int index)
+{
+    return std::exp2(static_cast<double>(index + 1) / SUB_BUCKETS_PER_OCTAVE) / 1000.0;
+}
+
+double FrameLatencyStats::percentileMs(const Histogram &histogram, quint64 total, double fraction, double maxMs)
+{
+    const quint64 rank = std::max<quint64>(1, static_cast<quint64>(std::ceil(fraction * static_cast<double>(total))));
+    quint64 cumulative = 0;
+    for (int i = 0; i < BUCKET_COUNT - 1; ++i) {
+        cumulative += histogram.buckets[i].load(std::memory_order_relaxed);
+        if (cumulative >= rank) {
+            return std::min(bucketUpperMs(i), maxMs);
+        }
+    }
+    return maxMs; // Overflow bucket
+}
+
+FrameLatencyStats::Summary FrameLatencyStats::summary(Stage stage)
+{
+    Summary result;
+    if (stage < 0 || stage >= StageCount) {
+        return result;
+    }
+    const Histogram &histogram = s_histograms[stage];
+    result.count = histogram.count.load(std::memory_order_relaxed);
+    if (result.count == 0) {
+        return result;
+    }
+    result.maxMs = histogram.maxNs.load(std::memory_order_relaxed) / 1.0e6;
+    result.p50Ms = percentileMs(histogram, result.count, 0.50, result.maxMs);
+    result.p95Ms = percentileMs(histogram, result.count, 0.95, result.maxMs);
+    result.p99Ms = percentileMs(histogram, result.count, 0.99, result.maxMs);
+    return result;
+}
+
+QString FrameLatencyStats::stageName(Stage stage)
+{
+    switch (stage) {
+    case CaptureToAppsink: return "capture->appsink";
+    case AppsinkToConverted: return "appsink->converted";
+    case ConvertedToPublished: return "converted->published";
+    case PublishedToDequeued: return "published->dequeued";
+    case DequeuedToOsdDone: return "dequeued->osd";
+    case OsdDoneToPresented: return "osd->presented";
+    case PresentedToPainted: return "presented->painted";
+    case EndToEnd: return "end-to-end";
+    default: return "unknown";
+    }
+}
+
+QString FrameLatencyStats::report()
+{
+    QString text;
+    QTextStream out(&text);
+    out << QString("%1 %2 %3 %4 %5 %6\n")
+               .arg("stage", -22).arg("count", 8)
+               .arg("p50 ms", 9).arg("p95 ms", 9).arg("p99 ms", 9).arg("max ms", 9);
+    for (int i = 0; i < StageCount; ++i) {
+        const Stage stage = static_cast<Stage>(i);
+        const Summary s = summary(stage);
+        out << QString("%1 %2 %3 %4 %5 %6\n")
+                   .arg(stageName(stage), -22).arg(s.count, 8)
+                   .arg(s.p50Ms, 9, 'f', 2).arg(s.p95Ms, 9, 'f', 2)
+                   .arg(s.p99Ms, 9, 'f', 2).arg(s.maxMs, 9, 'f', 2);
+    }
+    out.flush();
+    return text;
+}
+
+bool FrameLatencyStats::dumpToFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "FrameLatencyStats: Cannot write latency report to" << filePath << ":" << file.errorString();
+        return false;
+    }
+    QTextStream(&file) << report();
+    return true;
+}
+
+void FrameLatencyStats::reset()
+{
+    for (Histogram &histogram : s_histograms) {
+        for (std::atomic<quint64> &bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.maxNs.store(0, std::memory_order_relaxed);
+    }
+}
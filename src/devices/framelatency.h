@@ -0,0 +1,104 @@
+#ifndef FRAMELATENCY_H
+#define FRAMELATENCY_H
+
+// --- Standard Library Includes ---
+#include <array>
+#include <atomic>
+
+// --- Qt Includes ---
+#include <QMetaType>
+#include <QString>
+
+/**
+ * @brief Monotonic timestamp trail of one video frame, in nanoseconds.
+ *
+ * All stamps use the same clock as std::chrono::steady_clock (CLOCK_MONOTONIC), which is
+ * also the GStreamer system clock, so captureNs can be derived from the buffer PTS. A
+ * stamp of 0 means the stage was not reached or is unknown.
+ */
+struct FrameTimestamps {
+    qint64 captureNs = 0;   // Buffer PTS + pipeline base time (do-timestamp on the source)
+    qint64 appsinkNs = 0;   // Appsink new-sample callback entered
+    qint64 convertedNs = 0; // YUY2 -> BGRA conversion finished
+    qint64 publishedNs = 0; // Frame published to the UI mailbox
+    qint64 dequeuedNs = 0;  // Frame taken by the GUI thread
+    qint64 osdDoneNs = 0;   // OSD composed onto the frame
+    qint64 presentedNs = 0; // Frame handed to the display widget
+    qint64 paintedNs = 0;   // Display widget finished painting the frame
+
+    static qint64 nowNs();
+};
+
+Q_DECLARE_METATYPE(FrameTimestamps)
+
+/**
+ * @brief Process-wide per-stage latency histograms fed from FrameTimestamps.
+ *
+ * The display calls record() once per painted frame. Every stage keeps a log-linear
+ * histogram (8 buckets per octave, ~9% resolution, 1 us to ~16 s) in relaxed atomics,
+ * so summaries can be queried from any thread while frames are recorded.
+ */
+class FrameLatencyStats
+{
+public:
+    enum Stage {
+        CaptureToAppsink = 0,  // Driver/queue/videoscale until our callback runs
+        AppsinkToConverted,    // Map + colour conversion
+        ConvertedToPublished,  // Detection, VPI tracking, FrameData assembly
+        PublishedToDequeued,   // Waiting for the GUI thread
+        DequeuedToOsdDone,     // OSD state build + composition (incl. worker hop)
+        OsdDoneToPresented,    // Back to the GUI thread, handed to the widget
+        PresentedToPainted,    // Waiting for and running the paint event
+        EndToEnd,              // Capture (or appsink, if no PTS) to painted
+        StageCount
+    };
+
+    struct Summary {
+        quint64 count = 0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /**
+     * @brief Adds every stage for which both end stamps are set. Thread-safe.
+     */
+    static void record(const FrameTimestamps &timestamps);
+
+    static Summary summary(Stage stage);
+    static QString stageName(Stage stage);
+
+    /**
+     * @brief One line per stage with count, p50, p95, p99 and max in milliseconds.
+     */
+    static QString report();
+
+    /**
+     * @brief Writes report() to @p filePath (overwriting it).
+     * @return False if the file could not be written.
+     */
+    static bool dumpToFile(const QString &filePath);
+
+    static void reset();
+
+private:
+    static constexpr int SUB_BUCKETS_PER_OCTAVE = 8;
+    static constexpr int OCTAVES = 24; // 1 us .. 2^24 us (~16.8 s)
+    static constexpr int BUCKET_COUNT = SUB_BUCKETS_PER_OCTAVE * OCTAVES + 1; // Last bucket: overflow
+
+    struct Histogram {
+        std::array<std::atomic<quint64>, BUCKET_COUNT> buckets{};
+        std::atomic<quint64> count{0};
+        std::atomic<qint64> maxNs{0};
+    };
+
+    static void add(Stage stage, qint64 fromNs, qint64 toNs);
+    static int bucketIndex(qint64 ns);
+    static double bucketUpperMs(int index);
+    static double percentileMs(const Histogram &histogram, quint64 total, double fraction, double maxMs);
+
+    static std::array<Histogram, StageCount> s_histograms;
+};
+
+#endif // FRAMELATENCY_H
@@ -0,0 +1,79 @@
+#include "framepacing.h"
+
+#include <algorithm>
+#include <cmath>
+
+// =================================
+// FramePacingStats::IntervalStats
+// =================================
+
+void FramePacingStats::IntervalStats::add(double ms)
+{
+    ++count;
+    const double delta = ms - meanMs;
+    meanMs += delta / static_cast<double>(count);
+    m2 += delta * (ms - meanMs);
+    maxMs = std::max(maxMs, ms);
+}
+
+double FramePacingStats::IntervalStats::stddevMs() const
+{
+    return std::sqrt(varianceMs2());
+}
+
+// =================================
+// FramePacingStats
+// =================================
+
+void FramePacingStats::recordRefresh(qint64 swapNs, bool newFrame)
+{
+    ++m_refreshes;
+    if (m_lastSwapNs > 0) {
+        m_refreshIntervals.add((swapNs - m_lastSwapNs) / 1.0e6);
+    }
+    m_lastSwapNs = swapNs;
+
+    if (!newFrame) {
+        ++m_repeatedFrames;
+        return;
+    }
+    ++m_presentedFrames;
+    if (m_lastNewFrameSwapNs > 0) {
+        m_frameTimes.add((swapNs - m_lastNewFrameSwapNs) / 1.0e6);
+    }
+    m_lastNewFrameSwapNs = swapNs;
+}
+
+void FramePacingStats::breakSequence()
+{
+    m_lastSwapNs = 0;
+    m_lastNewFrameSwapNs = 0;
+}
+
+QString FramePacingStats::report() const
+{
+    const double refreshHz = m_refreshIntervals.meanMs > 0.0 ? 1000.0 / m_refreshIntervals.meanMs : 0.0;
+    return QString("%1 refreshes (%2 Hz, stddev %3 ms), %4 frames shown: frame time %5 ms "
+                   "(stddev %6 ms, variance %7 ms^2, max %8 ms), %9 repeated, %10 skipped")
+        .arg(m_refreshes)
+        .arg(refreshHz, 0, 'f', 1)
+        .arg(m_refreshIntervals.stddevMs(), 0, 'f', 2)
+        .arg(m_presentedFrames)
+        .arg(m_frameTimes.meanMs, 0, 'f', 2)
+        .arg(m_frameTimes.stddevMs(), 0, 'f', 2)
+        .arg(m_frameTimes.varianceMs2(), 0, 'f', 2)
+        .arg(m_frameTimes.maxMs, 0, 'f', 2)
+        .arg(m_repeatedFrames)
+        .arg(m_skippedFrames);
+}
+
+void FramePacingStats::reset()
+{
+    // Keep the last swap stamps: the next interval still belongs to the same sequence
+    m_refreshes = 0;
+    m_presentedFrames = 0;
+    m_repeatedFrames = 0;
+    m_skippedFrames = 0;
+    m_refreshIntervals = IntervalStats();
+    m_frameTimes = IntervalStats();
+}
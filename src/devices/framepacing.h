@@ -0,0 +1,80 @@
+#ifndef FRAMEPACING_H
+#define FRAMEPACING_H
+
+// --- Qt Includes ---
+#include <QString>
+
+/**
+ * @brief Frame pacing of one display: how evenly new frames reach the screen.
+ *
+ * Fed once per display refresh (buffer swap) on the GUI thread. Between reset() calls it
+ * accumulates the refresh interval and the on-screen time of every frame (swap of a new
+ * frame to the swap of the next new frame) as mean and standard deviation, plus the
+ * refreshes that repeated the previous frame and the frames that were replaced before any
+ * refresh showed them. An evenly paced 30 fps feed on a 60 Hz display shows every frame
+ * for exactly two refreshes, so judder appears as frame-time deviation and repeat/skip
+ * counts.
+ */
+class FramePacingStats
+{
+public:
+    /**
+     * @brief Running mean / variance (Welford) of a series of intervals in milliseconds.
+     */
+    struct IntervalStats {
+        quint64 count = 0;
+        double meanMs = 0.0;
+        double m2 = 0.0; // Sum of squared deviations from the mean
+        double maxMs = 0.0;
+
+        void add(double ms);
+        double varianceMs2() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0; }
+        double stddevMs() const;
+    };
+
+    /**
+     * @brief Records one buffer swap at @p swapNs (FrameTimestamps::nowNs() clock).
+     * @param newFrame True if the swap showed a frame not shown before, false if it repeated one.
+     */
+    void recordRefresh(qint64 swapNs, bool newFrame);
+
+    /**
+     * @brief Counts @p frames replaced by newer ones before a refresh could show them.
+     */
+    void recordSkipped(quint64 frames) { m_skippedFrames += frames; }
+
+    /**
+     * @brief Forgets the last swap, so the gap after an idle period is not taken as judder.
+     */
+    void breakSequence();
+
+    quint64 refreshes() const { return m_refreshes; }
+    quint64 presentedFrames() const { return m_presentedFrames; }
+    quint64 repeatedFrames() const { return m_repeatedFrames; }
+    quint64 skippedFrames() const { return m_skippedFrames; }
+    const IntervalStats &refreshIntervals() const { return m_refreshIntervals; }
+    const IntervalStats &frameTimes() const { return m_frameTimes; }
+
+    /**
+     * @brief One line with refresh rate, frame time mean/stddev/max, repeats and skips.
+     */
+    QString report() const;
+
+    /**
+     * @brief Starts a new measurement window.
+     */
+    void reset();
+
+private:
+    qint64 m_lastSwapNs = 0;
+    qint64 m_lastNewFrameSwapNs = 0;
+
+    quint64 m_refreshes = 0;
+    quint64 m_presentedFrames = 0;
+    quint64 m_repeatedFrames = 0;
+    quint64 m_skippedFrames = 0;
+    IntervalStats m_refreshIntervals;
+    IntervalStats m_frameTimes;
+};
+
+#endif // FRAMEPACING_H
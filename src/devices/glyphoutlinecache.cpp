@@ -0,0 +1,100 @@
+#include "glyphoutlinecache.h"
+
+#include <QFontMetricsF>
+#include <QMutexLocker>
+
+namespace {
+// Default bound: a few hundred glyphs of a bold OSD font
+constexpr int DEFAULT_MAX_PATH_ELEMENTS = 64 * 1024;
+} // namespace
+
+GlyphOutlineCache &GlyphOutlineCache::instance()
+{
+    static GlyphOutlineCache cache;
+    return cache;
+}
+
+GlyphOutlineCache::GlyphOutlineCache()
+    : m_glyphs(DEFAULT_MAX_PATH_ELEMENTS)
+{
+}
+
+quint32 GlyphOutlineCache::fontIdLocked(const QFont &font)
+{
+    const QString key = font.key();
+    auto it = m_fontIds.constFind(key);
+    if (it != m_fontIds.constEnd()) {
+        return it.value();
+    }
+    const quint32 id = static_cast<quint32>(m_fontIds.size());
+    m_fontIds.insert(key, id);
+    return id;
+}
+
+QPainterPath GlyphOutlineCache::textPath(const QFont &font, const QString &text)
+{
+    QPainterPath result;
+    if (text.isEmpty()) {
+        return result;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    const quint32 fontId = fontIdLocked(font);
+    const QFontMetricsF metrics(font);
+
+    qreal penX = 0.0;
+    for (const QChar ch : text) {
+        const quint64 key = glyphKey(fontId, ch.unicode());
+        GlyphOutline *glyph = m_glyphs.object(key);
+        if (glyph) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            glyph = new GlyphOutline;
+            glyph->path.addText(0, 0, font, QString(ch));
+            glyph->advance = metrics.horizontalAdvance(ch);
+            const int cost = qMax(1, glyph->path.elementCount());
+            if (!m_glyphs.insert(key, glyph, cost)) {
+                // Larger than the whole cache: QCache already deleted it, build a one-off outline
+                QPainterPath oneOff;
+                oneOff.addText(penX, 0, font, QString(ch));
+                result.addPath(oneOff);
+                penX += metrics.horizontalAdvance(ch);
+                continue;
+            }
+        }
+
+        if (!glyph->path.isEmpty()) {
+            result.addPath(glyph->path.translated(penX, 0));
+        }
+        penX += glyph->advance;
+    }
+    return result;
+}
+
+void GlyphOutlineCache::setMaxCost(int maxPathElements)
+{
+    QMutexLocker locker(&m_mutex);
+    m_glyphs.setMaxCost(qMax(1, maxPathElements));
+}
+
+GlyphOutlineCache::Stats GlyphOutlineCache::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    Stats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.glyphCount = m_glyphs.count();
+    stats.totalCost = m_glyphs.totalCost();
+    stats.maxCost = m_glyphs.maxCost();
+    return stats;
+}
+
+void GlyphOutlineCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_glyphs.clear();
+    m_fontIds.clear();
+    m_hits.store(0, std::memory_order_relaxed);
+    m_misses.store(0, std::memory_order_relaxed);
+}
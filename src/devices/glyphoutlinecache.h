@@ -0,0 +1,71 @@
+#ifndef GLYPHOUTLINECACHE_H
+#define GLYPHOUTLINECACHE_H
+
+// --- Standard Library Includes ---
+#include <atomic>
+
+// --- Qt Includes ---
+#include <QCache>
+#include <QFont>
+#include <QHash>
+#include <QMutex>
+#include <QPainterPath>
+#include <QString>
+
+/**
+ * @brief Process-wide cache of glyph outlines used to assemble OSD text paths.
+ *
+ * QPainterPath::addText() shapes and converts every glyph to an outline on each call.
+ * The OSD only uses a small alphabet in one or two fonts, so each (font, character)
+ * outline is built once and text paths are assembled by translating cached outlines
+ * along the baseline. The cache is bounded by the total number of path elements and
+ * evicts least recently used glyphs. All methods are thread-safe.
+ */
+class GlyphOutlineCache
+{
+public:
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        int glyphCount = 0;
+        int totalCost = 0; // Path elements held
+        int maxCost = 0;
+    };
+
+    static GlyphOutlineCache &instance();
+
+    /**
+     * @brief Builds the outline of @p text with the baseline at y = 0 (same origin as addText(0, 0, ...)).
+     */
+    QPainterPath textPath(const QFont &font, const QString &text);
+
+    /**
+     * @brief Sets the memory bound, in painter path elements. Evicts glyphs if needed.
+     */
+    void setMaxCost(int maxPathElements);
+
+    Stats stats() const;
+    void clear();
+
+private:
+    GlyphOutlineCache();
+
+    // Cache key: font id above bit 16, UTF-16 code unit in the low 16 bits
+    static quint64 glyphKey(quint32 fontId, char16_t unicode) { return (static_cast<quint64>(fontId) << 16) | unicode; }
+
+    struct GlyphOutline {
+        QPainterPath path; // Outline with the pen position at (0, 0)
+        qreal advance = 0.0;
+    };
+
+    quint32 fontIdLocked(const QFont &font);
+
+    mutable QMutex m_mutex;
+    QCache<quint64, GlyphOutline> m_glyphs;
+    QHash<QString, quint32> m_fontIds; // QFont::key() -> compact id used in glyph keys
+
+    std::atomic<quint64> m_hits{0};
+    std::atomic<quint64> m_misses{0};
+};
+
+#endif // GLYPHOUTLINECACHE_H
@@ -0,0 +1,354 @@
+#include "networkvideooutput.h"
+#include "framelatency.h" // FrameTimestamps::nowNs()
+
+#include <QDebug>
+#include <QPainter>
+
+#include <gst/app/gstappsrc.h>
+
+namespace {
+// Frames the encoder may fall behind by before its queue leaks, key frame interval
+constexpr int OUTPUT_QUEUE_BUFFERS = 2;
+constexpr int OUTPUT_KEY_FRAME_SECONDS = 1;
+// Encoder input stamps kept while waiting for the matching output (frames dropped inside x264enc)
+constexpr size_t MAX_PENDING_ENCODE_STAMPS = 64;
+const char *const DEFAULT_OUTPUT_HOST = "127.0.0.1";
+} // namespace
+
+bool NetworkVideoOutputConfig::fromSpec(const QString &spec, NetworkVideoOutputConfig &config, QString *errorMessage)
+{
+    const int separator = spec.lastIndexOf(':');
+    const QString host = separator < 0 ? QString(DEFAULT_OUTPUT_HOST) : spec.left(separator);
+    bool ok = false;
+    const int port = spec.mid(separator + 1).toInt(&ok);
+    if (!ok || port <= 0 || port > 65535 || host.isEmpty()) {
+        if (errorMessage) *errorMessage = QString("Invalid network output '%1', expected <host>:<port>").arg(spec);
+        return false;
+    }
+    config.host = host;
+    config.port = port;
+    return true;
+}
+
+NetworkVideoOutput::NetworkVideoOutput(const NetworkVideoOutputConfig &config, QObject *parent)
+    : QThread(parent),
+    m_config(config)
+{
+    m_reportTimer.start();
+}
+
+NetworkVideoOutput::~NetworkVideoOutput()
+{
+    stop();
+    wait();
+}
+
+void NetworkVideoOutput::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stopRequested = true;
+    m_wake.wakeOne();
+}
+
+void NetworkVideoOutput::pushFrame(const QImage &frame, const QImage &overlay)
+{
+    if (frame.isNull()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    if (m_stopRequested) {
+        return;
+    }
+    if (m_hasPending) {
+        m_framesSuperseded.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Shallow copies: the output thread composes from the shared buffers
+    m_pendingFrame = frame;
+    m_pendingOverlay = overlay;
+    m_hasPending = true;
+    m_framesPushed.fetch_add(1, std::memory_order_relaxed);
+    m_wake.wakeOne();
+}
+
+QString NetworkVideoOutput::receiverPipeline() const
+{
+    return QString("gst-launch-1.0 udpsrc port=%1 "
+                   "caps=\"application/x-rtp,media=video,clock-rate=90000,encoding-name=H264,payload=96\" ! "
+                   "rtpjitterbuffer latency=50 ! rtph264depay ! h264parse ! avdec_h264 ! "
+                   "videoconvert ! autovideosink sync=false").arg(m_config.port);
+}
+
+QString NetworkVideoOutput::takeReport()
+{
+    const qint64 windowNs = m_reportTimer.nsecsElapsed();
+    m_reportTimer.restart();
+    const quint64 encoded = framesEncoded();
+    const double fps = windowNs > 0 ? (encoded - m_reportEncoded) / (windowNs / 1.0e9) : 0.0;
+    m_reportEncoded = encoded;
+
+    const qint64 latencyNs = m_latencyNsTotal.exchange(0, std::memory_order_relaxed);
+    const quint64 latencyCount = m_latencyCount.exchange(0, std::memory_order_relaxed);
+    const qint64 latencyMaxNs = m_latencyMaxNs.exchange(0, std::memory_order_relaxed);
+    const double meanMs = latencyCount > 0 ? latencyNs / 1.0e6 / latencyCount : 0.0;
+    m_encodeLatencyMs.store(meanMs, std::memory_order_relaxed);
+
+    return QString("encode latency %1 ms mean / %2 ms max, %3 fps sent, %4 frames pushed, "
+                   "%5 superseded, %6 dropped by the encoder queue")
+        .arg(meanMs, 0, 'f', 2)
+        .arg(latencyMaxNs / 1.0e6, 0, 'f', 2)
+        .arg(fps, 0, 'f', 1)
+        .arg(framesPushed())
+        .arg(framesSuperseded())
+        .arg(queueDrops());
+}
+
+void NetworkVideoOutput::run()
+{
+    if (!initializeGStreamer()) {
+        QMutexLocker locker(&m_mutex);
+        m_stopRequested = true;
+        return;
+    }
+    qInfo() << "NetworkVideoOutput: Streaming" << (m_config.composited ? "composited" : "raw") << "video to"
+            << m_config.host << ":" << m_config.port << "at" << m_config.bitrateKbps << "kbit/s";
+    qInfo().noquote() << "NetworkVideoOutput: Receive with:" << receiverPipeline();
+
+    while (true) {
+        QImage frame;
+        QImage overlay;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_hasPending && !m_stopRequested) {
+                m_wake.wait(&m_mutex);
+            }
+            if (m_stopRequested) {
+                break;
+            }
+            frame.swap(m_pendingFrame);
+            overlay.swap(m_pendingOverlay);
+            m_hasPending = false;
+        }
+
+        GstBuffer *buffer = composeBuffer(frame, overlay);
+        frame = QImage(); // Hand the camera buffer back to its pool before encoding
+        overlay = QImage();
+        if (buffer && gst_app_src_push_buffer(GST_APP_SRC(m_appSrc), buffer) != GST_FLOW_OK) {
+            qWarning() << "NetworkVideoOutput: appsrc refused a frame.";
+        }
+        updateQueueDrops();
+        if (!pollBus()) {
+            QMutexLocker locker(&m_mutex);
+            m_stopRequested = true; // Later frames are ignored
+            break;
+        }
+    }
+
+    cleanupGStreamer();
+    qInfo() << "NetworkVideoOutput: Stopped," << framesEncoded() << "frames sent," << framesSuperseded()
+            << "superseded," << queueDrops() << "dropped by the encoder queue";
+}
+
+bool NetworkVideoOutput::initializeGStreamer()
+{
+    gst_init(nullptr, nullptr);
+
+    // appsrc never blocks (frames are pushed one at a time) and the leaky queue keeps a slow
+    // encoder or network from holding frames; caps follow the frame size (see composeBuffer())
+    const QString pipelineStr = QString(
+        "appsrc name=netsrc is-live=true format=time do-timestamp=true block=false ! "
+        "queue name=netqueue leaky=downstream max-size-buffers=%1 max-size-bytes=0 max-size-time=0 ! "
+        "videoconvert ! "
+        "x264enc tune=zerolatency speed-preset=ultrafast bitrate=%2 key-int-max=%3 ! "
+        "rtph264pay name=pay config-interval=1 pt=96 ! "
+        "udpsink host=%4 port=%5 sync=false async=false")
+        .arg(OUTPUT_QUEUE_BUFFERS)
+        .arg(m_config.bitrateKbps)
+        .arg(m_config.framerate * OUTPUT_KEY_FRAME_SECONDS)
+        .arg(m_config.host)
+        .arg(m_config.port);
+    qInfo() << "NetworkVideoOutput: GStreamer Pipeline:" << pipelineStr;
+
+    GError *error = nullptr;
+    m_pipeline = gst_parse_launch(pipelineStr.toUtf8().constData(), &error);
+    if (!m_pipeline) {
+        qCritical() << "NetworkVideoOutput: Failed to parse GStreamer pipeline:" << (error ? error->message : "Unknown error");
+        if (error) g_error_free(error);
+        return false;
+    }
+    if (error) {
+        qWarning() << "NetworkVideoOutput: GStreamer parsing warning/error:" << error->message;
+        g_error_free(error);
+    }
+    m_appSrc = gst_bin_get_by_name(GST_BIN(m_pipeline), "netsrc");
+    m_queue = gst_bin_get_by_name(GST_BIN(m_pipeline), "netqueue");
+    GstElement *payloader = gst_bin_get_by_name(GST_BIN(m_pipeline), "pay");
+    if (!m_appSrc || !m_queue || !payloader) {
+        qCritical() << "NetworkVideoOutput: Pipeline elements missing.";
+        if (payloader) gst_object_unref(payloader);
+        cleanupGStreamer();
+        return false;
+    }
+    // Frames leave the queue on the encoder thread; latency is measured from there to the payloader
+    addPadProbe(m_queue, "sink", &NetworkVideoOutput::on_buffer_count_probe, &m_queueBuffersIn);
+    addPadProbe(m_queue, "src", &NetworkVideoOutput::on_buffer_count_probe, &m_queueBuffersOut);
+    addPadProbe(m_queue, "src", &NetworkVideoOutput::on_encoder_input, this);
+    addPadProbe(payloader, "sink", &NetworkVideoOutput::on_encoder_output, this);
+    gst_object_unref(payloader);
+
+    if (gst_element_set_state(m_pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        qCritical() << "NetworkVideoOutput: Failed to start the pipeline.";
+        cleanupGStreamer();
+        return false;
+    }
+    return true;
+}
+
+void NetworkVideoOutput::cleanupGStreamer()
+{
+    if (m_pipeline) {
+        gst_element_set_state(m_pipeline, GST_STATE_NULL);
+    }
+    for (GstElement **element : {&m_appSrc, &m_queue, &m_pipeline}) {
+        if (*element) {
+            gst_object_unref(*element);
+            *element = nullptr;
+        }
+    }
+    m_capsSize = QSize();
+}
+
+GstBuffer *NetworkVideoOutput::composeBuffer(const QImage &frame, const QImage &overlay)
+{
+    const int width = frame.width();
+    const int height = frame.height();
+    if (frame.size() != m_capsSize) {
+        // QImage::Format_RGB32 is BGRx in memory; x264enc renegotiates on new caps
+        GstCaps *caps = gst_caps_new_simple("video/x-raw",
+                                            "format", G_TYPE_STRING, "BGRx",
+                                            "width", G_TYPE_INT, width,
+                                            "height", G_TYPE_INT, height,
+                                            "framerate", GST_TYPE_FRACTION, m_config.framerate, 1,
+                                            nullptr);
+        gst_app_src_set_caps(GST_APP_SRC(m_appSrc), caps);
+        gst_caps_unref(caps);
+        m_capsSize = frame.size();
+        qInfo() << "NetworkVideoOutput: Frame size" << width << "x" << height;
+    }
+
+    GstBuffer *buffer = gst_buffer_new_allocate(nullptr, static_cast<gsize>(width) * height * 4, nullptr);
+    GstMapInfo map;
+    if (!buffer || !gst_buffer_map(buffer, &map, GST_MAP_WRITE)) {
+        if (buffer) gst_buffer_unref(buffer);
+        return nullptr;
+    }
+    // One pass into the buffer: the frame, then the OSD over it (the camera buffer itself is never written)
+    {
+        QImage target(map.data, width, height, width * 4, QImage::Format_RGB32);
+        QPainter painter(&target);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(0, 0, frame);
+        if (!overlay.isNull()) {
+            painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+            painter.drawImage(target.rect(), overlay);
+        }
+    }
+    gst_buffer_unmap(buffer, &map);
+    return buffer;
+}
+
+bool NetworkVideoOutput::pollBus()
+{
+    GstBus *bus = gst_element_get_bus(m_pipeline);
+    bool healthy = true;
+    while (GstMessage *message = gst_bus_pop_filtered(bus, static_cast<GstMessageType>(GST_MESSAGE_ERROR | GST_MESSAGE_WARNING))) {
+        GError *error = nullptr;
+        gchar *debugInfo = nullptr;
+        if (GST_MESSAGE_TYPE(message) == GST_MESSAGE_ERROR) {
+            gst_message_parse_error(message, &error, &debugInfo);
+            qCritical() << "NetworkVideoOutput: Error from" << GST_OBJECT_NAME(message->src) << ":"
+                        << (error ? error->message : "unknown") << "- output stopped";
+            healthy = false;
+        } else {
+            gst_message_parse_warning(message, &error, &debugInfo);
+            qWarning() << "NetworkVideoOutput: Warning from" << GST_OBJECT_NAME(message->src) << ":"
+                       << (error ? error->message : "unknown");
+        }
+        if (error) g_error_free(error);
+        g_free(debugInfo);
+        gst_message_unref(message);
+    }
+    gst_object_unref(bus);
+    return healthy;
+}
+
+void NetworkVideoOutput::updateQueueDrops()
+{
+    guint queued = 0;
+    g_object_get(G_OBJECT(m_queue), "current-level-buffers", &queued, nullptr);
+    const quint64 in = m_queueBuffersIn.load(std::memory_order_relaxed);
+    const quint64 out = m_queueBuffersOut.load(std::memory_order_relaxed);
+    if (in >= out + queued) {
+        m_queueDrops.store(in - out - queued, std::memory_order_relaxed);
+    }
+}
+
+GstPadProbeReturn NetworkVideoOutput::on_encoder_input(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+    Q_UNUSED(pad);
+    NetworkVideoOutput *output = static_cast<NetworkVideoOutput *>(user_data);
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    if (buffer && GST_BUFFER_PTS_IS_VALID(buffer)) {
+        if (output->m_encodeStartNs.size() >= MAX_PENDING_ENCODE_STAMPS) {
+            output->m_encodeStartNs.pop_front();
+        }
+        output->m_encodeStartNs.emplace_back(GST_BUFFER_PTS(buffer), FrameTimestamps::nowNs());
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn NetworkVideoOutput::on_encoder_output(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+    Q_UNUSED(pad);
+    NetworkVideoOutput *output = static_cast<NetworkVideoOutput *>(user_data);
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    output->m_framesEncoded.fetch_add(1, std::memory_order_relaxed);
+    if (!buffer || !GST_BUFFER_PTS_IS_VALID(buffer)) {
+        return GST_PAD_PROBE_OK;
+    }
+    // Encoded frames keep the input PTS; stamps of frames the encoder skipped are discarded on the way
+    const GstClockTime pts = GST_BUFFER_PTS(buffer);
+    std::deque<std::pair<GstClockTime, qint64>> &stamps = output->m_encodeStartNs;
+    while (!stamps.empty() && stamps.front().first < pts) {
+        stamps.pop_front();
+    }
+    if (stamps.empty() || stamps.front().first != pts) {
+        return GST_PAD_PROBE_OK;
+    }
+    const qint64 latencyNs = FrameTimestamps::nowNs() - stamps.front().second;
+    stamps.pop_front();
+    output->m_latencyNsTotal.fetch_add(latencyNs, std::memory_order_relaxed);
+    output->m_latencyCount.fetch_add(1, std::memory_order_relaxed);
+    qint64 maxNs = output->m_latencyMaxNs.load(std::memory_order_relaxed);
+    while (latencyNs > maxNs && !output->m_latencyMaxNs.compare_exchange_weak(maxNs, latencyNs, std::memory_order_relaxed)) {
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn NetworkVideoOutput::on_buffer_count_probe(GstPad *pad, GstPadProbeInfo *info, gpointer counter)
+{
+    Q_UNUSED(pad);
+    Q_UNUSED(info);
+    static_cast<std::atomic<quint64> *>(counter)->fetch_add(1, std::memory_order_relaxed);
+    return GST_PAD_PROBE_OK;
+}
+
+void NetworkVideoOutput::addPadProbe(GstElement *element, const char *padName, GstPadProbeCallback callback, gpointer data)
+{
+    GstPad *pad = gst_element_get_static_pad(element, padName);
+    if (!pad) {
+        qWarning() << "NetworkVideoOutput: No pad" << padName << "for a statistics probe.";
+        return;
+    }
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, callback, data, nullptr);
+    gst_object_unref(pad);
+}
@@ -0,0 +1,138 @@
+#ifndef NETWORKVIDEOOUTPUT_H
+#define NETWORKVIDEOOUTPUT_H
+
+// --- Standard Library Includes ---
+#include <atomic>
+#include <deque>
+#include <utility>
+
+// --- Qt Includes ---
+#include <QElapsedTimer>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+// --- GStreamer Includes ---
+#include <gst/gst.h>
+
+/**
+ * @brief Settings of the RTP/UDP output to a remote console.
+ */
+struct NetworkVideoOutputConfig {
+    QString host;            // Receiver address; empty disables the output
+    int port = 5600;         // Receiver UDP port
+    int bitrateKbps = 4000;  // Encoder target bitrate
+    int framerate = 30;      // Nominal frame rate, for rate control and the key frame interval
+    bool composited = true;  // Send the presented frames with the OSD; false sends the raw camera frames
+
+    bool enabled() const { return !host.isEmpty() && port > 0; }
+
+    /**
+     * @brief Parses "<host>:<port>" or a bare "<port>" (sent to 127.0.0.1).
+     * @return False (and @p config untouched) if the port is not a valid number.
+     */
+    static bool fromSpec(const QString &spec, NetworkVideoOutputConfig &config, QString *errorMessage = nullptr);
+};
+
+/**
+ * @brief Streams video frames as H.264 over RTP/UDP on its own thread.
+ *
+ * pushFrame() only stores the frame (and the OSD overlay to draw over it) as the newest
+ * one to send: a frame the output thread has not taken yet is replaced and counted as
+ * superseded, so the caller never waits. The thread composes into a GstBuffer and hands
+ * it to "appsrc ! queue leaky=downstream ! videoconvert ! x264enc ! rtph264pay ! udpsink",
+ * where the leaky queue drops frames when the encoder or the network falls behind.
+ *
+ * The stream plays with the pipeline from receiverPipeline(), e.g. on the same host:
+ * gst-launch-1.0 udpsrc port=5600 caps="application/x-rtp,..." ! rtph264depay ! ...
+ */
+class NetworkVideoOutput : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit NetworkVideoOutput(const NetworkVideoOutputConfig &config, QObject *parent = nullptr);
+    ~NetworkVideoOutput() override;
+
+    const NetworkVideoOutputConfig &config() const { return m_config; }
+
+    /**
+     * @brief Stops the output thread and closes the pipeline.
+     */
+    void stop();
+
+    /**
+     * @brief Queues @p frame for sending, replacing one not sent yet. Never blocks on the encoder.
+     * @param overlay Premultiplied ARGB at the frame's size drawn over it, or null.
+     */
+    void pushFrame(const QImage &frame, const QImage &overlay = QImage());
+
+    /**
+     * @brief gst-launch-1.0 pipeline that receives and shows the stream.
+     */
+    QString receiverPipeline() const;
+
+    // --- Statistics (thread-safe) ---
+    quint64 framesPushed() const { return m_framesPushed.load(std::memory_order_relaxed); }
+    quint64 framesSuperseded() const { return m_framesSuperseded.load(std::memory_order_relaxed); } // Replaced before composing
+    quint64 framesEncoded() const { return m_framesEncoded.load(std::memory_order_relaxed); }
+    quint64 queueDrops() const { return m_queueDrops.load(std::memory_order_relaxed); } // Leaked in front of the encoder
+    double encodeLatencyMs() const { return m_encodeLatencyMs.load(std::memory_order_relaxed); } // Mean of the last report window
+
+    /**
+     * @brief Encoder latency (mean and max) since the previous call, plus the frame counters.
+     */
+    QString takeReport();
+
+protected:
+    void run() override;
+
+private:
+    bool initializeGStreamer();
+    void cleanupGStreamer();
+    GstBuffer *composeBuffer(const QImage &frame, const QImage &overlay);
+    bool pollBus();
+    void updateQueueDrops();
+    static GstPadProbeReturn on_encoder_input(GstPad *pad, GstPadProbeInfo *info, gpointer user_data);
+    static GstPadProbeReturn on_encoder_output(GstPad *pad, GstPadProbeInfo *info, gpointer user_data);
+    static GstPadProbeReturn on_buffer_count_probe(GstPad *pad, GstPadProbeInfo *info, gpointer counter);
+    void addPadProbe(GstElement *element, const char *padName, GstPadProbeCallback callback, gpointer data);
+
+    const NetworkVideoOutputConfig m_config;
+
+    // Handoff from the presenting thread
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QImage m_pendingFrame;
+    QImage m_pendingOverlay;
+    bool m_hasPending = false;
+    bool m_stopRequested = false;
+
+    // Output thread
+    GstElement *m_pipeline = nullptr;
+    GstElement *m_appSrc = nullptr;
+    GstElement *m_queue = nullptr;
+    QSize m_capsSize;                    // Frame size the appsrc caps were set for
+
+    // Encoder streaming thread (x264enc pushes its output from the thread that feeds it)
+    std::deque<std::pair<GstClockTime, qint64>> m_encodeStartNs; // PTS -> time the frame left the queue
+
+    // Statistics
+    std::atomic<quint64> m_framesPushed{0};
+    std::atomic<quint64> m_framesSuperseded{0};
+    std::atomic<quint64> m_framesEncoded{0};
+    std::atomic<quint64> m_queueBuffersIn{0};
+    std::atomic<quint64> m_queueBuffersOut{0};
+    std::atomic<quint64> m_queueDrops{0};        // In minus out minus queued, updated by the output thread
+    std::atomic<qint64> m_latencyNsTotal{0};     // Encoder latency sum and count of the current window
+    std::atomic<quint64> m_latencyCount{0};
+    std::atomic<qint64> m_latencyMaxNs{0};
+    std::atomic<double> m_encodeLatencyMs{0.0};
+    QElapsedTimer m_reportTimer;         // takeReport() caller only
+    quint64 m_reportEncoded = 0;
+};
+
+#endif // NETWORKVIDEOOUTPUT_H
@@ -0,0 +1,273 @@
+#include "osdlayout.h"
+
+#include <QDebug>
+#include <QPainter>
+#include <cmath> // For M_PI, tan
+
+namespace OsdLayout {
+
+OsdPens makePens(const QColor &osdColor, int lineWidth)
+{
+    // Use a consistent outline color, or derive from osdColor if preferred
+    const QColor outlineColor = DEFAULT_OUTLINE_COLOR;
+    OsdPens pens;
+
+    pens.fill = QBrush(osdColor);
+
+    // Text Outline Pen (thin)
+    pens.textOutline = QPen(outlineColor, 1);
+    pens.textOutline.setJoinStyle(Qt::RoundJoin);
+
+    // Main Pen (for primary colored elements)
+    pens.main = QPen(osdColor, lineWidth);
+    pens.main.setCosmetic(true); // Constant pixel width
+    pens.main.setJoinStyle(Qt::RoundJoin);
+    pens.main.setCapStyle(Qt::RoundCap);
+
+    // Shape Outline Pen (slightly thicker)
+    pens.shapeOutline = QPen(outlineColor, lineWidth + 1);
+    pens.shapeOutline.setCosmetic(true);
+    pens.shapeOutline.setJoinStyle(Qt::RoundJoin);
+    pens.shapeOutline.setCapStyle(Qt::RoundCap);
+
+    // Needle Outline Pen (even thicker)
+    pens.needleOutline = QPen(outlineColor, lineWidth + 2);
+    pens.needleOutline.setCosmetic(true);
+    pens.needleOutline.setJoinStyle(Qt::RoundJoin);
+    pens.needleOutline.setCapStyle(Qt::RoundCap);
+
+    // Tick Mark Pens
+    pens.tickMarkMain = pens.main;
+    pens.tickMarkOutline = pens.shapeOutline;
+
+    // Tracking Outline Pen
+    pens.trackingOutline = QPen(outlineColor, lineWidth + 2); // Thicker outline
+    pens.trackingOutline.setCosmetic(true);
+
+    // Reticle Outline Pen
+    pens.reticleOutline = QPen(outlineColor, RETICLE_LINE_WIDTH * RETICLE_OUTLINE_WIDTH_FACTOR);
+    pens.reticleOutline.setCosmetic(true);
+    pens.reticleOutline.setJoinStyle(Qt::RoundJoin);
+    pens.reticleOutline.setCapStyle(Qt::RoundCap);
+
+    return pens;
+}
+
+QPointF anchoredPos(const QPointF &referencePos, int width, int height)
+{
+    const qreal x = (referencePos.x() > REFERENCE_WIDTH / 2.0)
+                        ? width - (REFERENCE_WIDTH - referencePos.x()) : referencePos.x();
+    const qreal y = (referencePos.y() > REFERENCE_HEIGHT / 2.0)
+                        ? height - (REFERENCE_HEIGHT - referencePos.y()) : referencePos.y();
+    return QPointF(x, y);
+}
+
+QFont defaultFont()
+{
+    return QFont(QString::fromUtf8(DEFAULT_FONT_FAMILY), DEFAULT_FONT_SIZE, DEFAULT_FONT_WEIGHT);
+}
+
+// === Status Text ===
+
+QString modeText(OperationalMode mode)
+{
+    switch (mode) {
+    case OperationalMode::Idle: return "MODE: IDLE";
+    case OperationalMode::Surveillance: return "MODE: OBS";
+    case OperationalMode::Tracking: return "MODE: TRACKING";
+    case OperationalMode::Engagement: return "MODE: ENGAGE";
+    case OperationalMode::EmergencyStop: return "MODE: EMERGENCY STOP";
+    default: return "MODE: UNKNOWN";
+    }
+}
+
+QString motionText(MotionMode motionMode)
+{
+    switch (motionMode) {
+    case MotionMode::Manual: return "MOTION: MAN";
+    case MotionMode::AutoSectorScan: return "MOTION: SCAN";
+    case MotionMode::TRPScan: return "MOTION: TRP";
+    case MotionMode::ManualTrack: return "MOTION: TRACK";
+    case MotionMode::AutoTrack: return "MOTION: AUTO TRACK";
+    case MotionMode::RadarSlew: return "MOTION: RADAR";
+    default: return "MOTION: N/A";
+    }
+}
+
+QString systemStatusText(bool charged, bool armed, bool ready)
+{
+    return QString("SYS: %1 %2 %3")
+        .arg(charged ? "CHG" : "---")
+        .arg(armed ? "ARM" : "SAF")
+        .arg(ready ? "RDY" : "NRD");
+}
+
+QString fireRateText(FireMode rate)
+{
+    switch (rate) {
+    case FireMode::SingleShot: return "RATE: SINGLE SHOT";
+    case FireMode::ShortBurst: return "RATE: SHORT BURST";
+    case FireMode::LongBurst: return "RATE: LONG BURST";
+    default: return "RATE: UNKNOWN";
+    }
+}
+
+QString lrfText(float distance)
+{
+    return (distance > 0.1f) ? QString::number(distance, 'f', 1) + " m" : "LRF: --- m";
+}
+
+// === Picture-in-Picture ===
+
+void drawInset(QPainter &painter, const QImage &inset, const QPoint &position, const OsdPens &pens)
+{
+    if (inset.isNull()) {
+        return;
+    }
+    const QRect frame(position, inset.size());
+    painter.save();
+    painter.setCompositionMode(QPainter::CompositionMode_Source); // Opaque camera pixels, no blending
+    painter.drawImage(position, inset);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(pens.shapeOutline);
+    painter.drawRect(frame);
+    painter.setPen(pens.main);
+    painter.drawRect(frame);
+    painter.restore();
+}
+
+QPointF insetLabelPos(const QPoint &position, const QFontMetricsF &metrics)
+{
+    return QPointF(position.x() + 4, position.y() + metrics.ascent() + 2);
+}
+
+// === Reticles ===
+
+double pixelsPerMil(double horizontalFovDegrees, double screenWidthPixels)
+{
+    if (horizontalFovDegrees <= 0 || screenWidthPixels <= 0) {
+        return 0.0; // Avoid division by zero or invalid input
+    }
+    // Horizontal size visible at 1000 units distance; 1 mil subtends 1 unit at 1000 units
+    double horizontalFovRadians = horizontalFovDegrees * M_PI / 180.0;
+    double milsAcrossScreen = 2.0 * 1000.0 * tan(horizontalFovRadians / 2.0);
+    return screenWidthPixels / milsAcrossScreen;
+}
+
+namespace {
+
+void addBasic(std::vector<ReticlePart> &parts)
+{
+    const qreal size = BASIC_RETICLE_SIZE;
+    QPainterPath path;
+    path.moveTo(-size, 0); path.lineTo(size, 0);
+    path.moveTo(0, -size); path.lineTo(0, size);
+    parts.push_back({path, false});
+}
+
+void addBoxCrosshair(std::vector<ReticlePart> &parts)
+{
+    const qreal lineLen = BOX_CROSSHAIR_LINE_LEN;
+    const qreal boxSize = BOX_CROSSHAIR_BOX_SIZE;
+    const qreal halfBox = boxSize / 2.0;
+    const qreal gap = BOX_CROSSHAIR_GAP;
+
+    // Cross lines with a gap around the box
+    QPainterPath linesPath;
+    linesPath.moveTo(-lineLen, 0); linesPath.lineTo(-halfBox - gap, 0);
+    linesPath.moveTo(halfBox + gap, 0); linesPath.lineTo(lineLen, 0);
+    linesPath.moveTo(0, -lineLen); linesPath.lineTo(0, -halfBox - gap);
+    linesPath.moveTo(0, halfBox + gap); linesPath.lineTo(0, lineLen);
+    parts.push_back({linesPath, false});
+
+    // Box centered at (0,0)
+    QPainterPath boxPath;
+    boxPath.addRect(-halfBox, -halfBox, boxSize, boxSize);
+    parts.push_back({boxPath, false});
+}
+
+void addStandardCrosshair(std::vector<ReticlePart> &parts)
+{
+    const qreal size = STD_CROSSHAIR_SIZE;
+    const qreal gap = STD_CROSSHAIR_GAP;
+    QPainterPath path;
+    path.moveTo(-size, 0); path.lineTo(-gap, 0);
+    path.moveTo(gap, 0); path.lineTo(size, 0);
+    path.moveTo(0, -size); path.lineTo(0, -gap);
+    path.moveTo(0, gap); path.lineTo(0, size);
+    parts.push_back({path, false});
+}
+
+void addPrecisionCrosshair(std::vector<ReticlePart> &parts)
+{
+    const qreal size = PRECISION_CROSSHAIR_SIZE;
+    const qreal dotRadius = PRECISION_CROSSHAIR_CENTER_DOT_RADIUS;
+    const qreal tickLen = PRECISION_CROSSHAIR_TICK_LENGTH;
+
+    QPainterPath path;
+    path.addEllipse(-dotRadius, -dotRadius, dotRadius * 2, dotRadius * 2); // Center dot
+    path.moveTo(-size, 0); path.lineTo(size, 0);
+    path.moveTo(0, -size); path.lineTo(0, size);
+    for (int i = 1; i <= PRECISION_CROSSHAIR_NUM_TICKS; ++i) {
+        qreal dist = i * PRECISION_CROSSHAIR_TICK_SPACING;
+        path.moveTo(-dist, -tickLen); path.lineTo(-dist, tickLen);
+        path.moveTo( dist, -tickLen); path.lineTo( dist, tickLen);
+        path.moveTo(-tickLen, -dist); path.lineTo(tickLen, -dist);
+        path.moveTo(-tickLen,  dist); path.lineTo(tickLen,  dist);
+    }
+    parts.push_back({path, false});
+}
+
+void addMilDot(std::vector<ReticlePart> &parts, double horizontalFovDegrees, int screenWidthPixels)
+{
+    const qreal lineSize = MILDOT_RETICLE_SIZE;
+    const qreal dotRadius = MILDOT_RETICLE_DOT_RADIUS;
+
+    const double ppm = pixelsPerMil(horizontalFovDegrees, screenWidthPixels);
+    if (ppm <= 0.1) {
+        qWarning() << "Cannot create MilDot reticle: Invalid FOV/width or pixelsPerMil too small (" << ppm << "). Falling back.";
+        addStandardCrosshair(parts);
+        return;
+    }
+    const qreal dotSpacing = ppm; // 1 Mil spacing
+
+    QPainterPath linesPath;
+    linesPath.moveTo(-lineSize, 0); linesPath.lineTo(lineSize, 0);
+    linesPath.moveTo(0, -lineSize); linesPath.lineTo(0, lineSize);
+    parts.push_back({linesPath, false});
+
+    for (int i = 1; i <= MILDOT_RETICLE_NUM_DOTS; ++i) {
+        qreal distFromCenter = i * dotSpacing;
+        if (distFromCenter > lineSize + dotRadius) break; // Don't draw dots past the lines
+
+        // One set of 4 dots (left, right, top, bottom) at this mil distance
+        QPainterPath dotPath;
+        dotPath.addEllipse(-distFromCenter - dotRadius, -dotRadius, dotRadius * 2, dotRadius * 2);
+        dotPath.addEllipse( distFromCenter - dotRadius, -dotRadius, dotRadius * 2, dotRadius * 2);
+        dotPath.addEllipse(-dotRadius, -distFromCenter - dotRadius, dotRadius * 2, dotRadius * 2);
+        dotPath.addEllipse(-dotRadius,  distFromCenter - dotRadius, dotRadius * 2, dotRadius * 2);
+        parts.push_back({dotPath, true});
+    }
+}
+
+} // namespace
+
+std::vector<ReticlePart> reticleParts(ReticleType type, double horizontalFovDegrees, int screenWidthPixels)
+{
+    std::vector<ReticlePart> parts;
+    switch (type) {
+    case ReticleType::Basic:              addBasic(parts); break;
+    case ReticleType::BoxCrosshair:       addBoxCrosshair(parts); break;
+    case ReticleType::StandardCrosshair:  addStandardCrosshair(parts); break;
+    case ReticleType::PrecisionCrosshair: addPrecisionCrosshair(parts); break;
+    case ReticleType::MilDot:             addMilDot(parts, horizontalFovDegrees, screenWidthPixels); break;
+    default:
+        qWarning() << "Unknown reticle type:" << static_cast<int>(type);
+        addStandardCrosshair(parts); // Fallback
+        break;
+    }
+    return parts;
+}
+
+} // namespace OsdLayout
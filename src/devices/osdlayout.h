@@ -0,0 +1,198 @@
+#ifndef OSDLAYOUT_H
+#define OSDLAYOUT_H
+
+// --- Standard Library Includes ---
+#include <vector>
+
+// --- Qt Includes ---
+#include <QBrush>
+#include <QColor>
+#include <QFont>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QPainterPath>
+#include <QPen>
+#include <QPoint>
+#include <QPointF>
+#include <QString>
+
+// --- Project Includes ---
+#include "../models/systemstatemodel.h" // OperationalMode, MotionMode, FireMode, ReticleType
+
+class QPainter;
+
+/**
+ * @brief Geometry, styling and text of the OSD elements.
+ *
+ * Shared by the scene-based OsdRenderer and the scene-free OsdPainterRenderer so both
+ * draw the same elements at the same places.
+ */
+namespace OsdLayout {
+
+// Z-Values for layering
+constexpr qreal Z_ORDER_OUTLINE = 9.0;
+constexpr qreal Z_ORDER_MAIN = 10.0;
+constexpr qreal Z_ORDER_TRACKING = 15.0;
+constexpr qreal Z_ORDER_DETECTION = 12.0; // Ensure detections are visible but potentially behind tracking
+constexpr qreal Z_ORDER_RETICLE_MAIN = 20.0; // Text should be on top of everything
+
+// Default Colors (can be overridden by updateColorStyle)
+const QColor DEFAULT_OSD_COLOR = QColor(70, 226, 165); // Green
+const QColor DEFAULT_OUTLINE_COLOR = QColor(10, 10, 10);//(18, 67, 21); // Dark Green/Black
+// Tracking Colors (Defined in original code, keep them)
+//const QColor COLOR_TRACKING_DEFAULT = Qt::yellow;
+//const QColor COLOR_TRACKING_ACQUIRING = Qt::cyan;
+const QColor COLOR_TRACKING_ACQUIRED = Qt::green;
+
+//const QColor COLOR_TRACKING_LOST = QColor(200,20,40);
+
+// Default Font
+constexpr const char *DEFAULT_FONT_FAMILY = "Archivo Narrow";
+constexpr int DEFAULT_FONT_SIZE = 16;
+constexpr QFont::Weight DEFAULT_FONT_WEIGHT = QFont::Bold;
+
+// Default Line Width
+constexpr int DEFAULT_LINE_WIDTH = 2;
+
+// Frame size the positions below were laid out for (see anchoredPos())
+constexpr int REFERENCE_WIDTH = 1024;
+constexpr int REFERENCE_HEIGHT = 768;
+
+// Element Positions & Sizes (Extracted from original code)
+// Text Item Positions
+const QPointF POS_MODE_TEXT(10, 25);
+const QPointF POS_MOTION_TEXT(10, 55);
+const QPointF POS_SPEED_TEXT(500, 25);
+const QPointF POS_STAB_TEXT(100, 748);
+const QPointF POS_CAMERA_TEXT(250, 748);
+const QPointF POS_FOV_TEXT(425, 748);
+const QPointF POS_ZOOM_TEXT(300, 748);
+const QPointF POS_STATUS_TEXT(10, 120);
+const QPointF POS_RATE_TEXT(10, 145);
+const QPointF POS_LRF_TEXT(10, 170);
+const QPointF POS_ZEROING_STATUS_TEXT(10, 195);  
+const QPointF POS_WINDAGE_STATUS_TEXT(10, 220);
+const QPointF POS_ZONE_WARNING_TEXT(REFERENCE_WIDTH / 2.0 + 50, REFERENCE_HEIGHT / 2.0 + 50);
+const QPointF POS_ZONE_LAC_TEXT(10, 245);
+const QPointF POS_SCAN_NAME_TEXT(10, 270);
+
+// Azimuth Indicator
+constexpr qreal AZ_INDICATOR_X_OFFSET = 75; // Offset from right edge
+constexpr qreal AZ_INDICATOR_Y = 75;
+constexpr qreal AZ_RADIUS = 50;
+constexpr qreal AZ_NEEDLE_LENGTH_FACTOR = 0.8;
+constexpr qreal AZ_TICK_LENGTH_MAJOR = 8.0;
+constexpr qreal AZ_TICK_LENGTH_MINOR = 4.0;
+constexpr int AZ_TICK_STEP = 30; // Degrees
+constexpr qreal AZ_LABEL_OFFSET = 12.0;
+constexpr qreal AZ_TEXT_Y_OFFSET_FACTOR = 0.5; // Relative to radius
+constexpr qreal AZ_TEXT_Y_EXTRA_OFFSET = 5.0;
+
+// Elevation Scale
+constexpr qreal EL_SCALE_X_OFFSET = 55; // Offset from right edge
+constexpr qreal EL_SCALE_HEIGHT = 120;
+constexpr qreal EL_SCALE_Y_OFFSET = 25; // Offset from bottom edge
+constexpr qreal EL_RANGE =80.0;
+constexpr qreal EL_MIN = -20.0;
+constexpr qreal EL_TICK_LENGTH = 5.0;
+constexpr qreal EL_MAJOR_TICK_LENGTH = 10.0;
+
+constexpr qreal EL_LABEL_X_OFFSET = 13.0;
+constexpr qreal EL_INDICATOR_WIDTH = 6.0; // Base of triangle is 8 (Y), point is 6 away (X)
+constexpr qreal EL_INDICATOR_HEIGHT = 8.0;
+
+// Tracking Corners
+constexpr qreal TRACKING_CORNER_LENGTH = 15.0;
+
+// Reticle Constants
+constexpr double RETICLE_LINE_WIDTH = 2.0;
+constexpr double RETICLE_OUTLINE_WIDTH_FACTOR = 2.0; // Multiplier for outline pen width
+// Basic Reticle
+constexpr qreal BASIC_RETICLE_SIZE = 20.0;
+// Box Crosshair Reticle
+constexpr qreal BOX_CROSSHAIR_LINE_LEN = 80.0;
+constexpr qreal BOX_CROSSHAIR_BOX_SIZE = 50.0;
+constexpr qreal BOX_CROSSHAIR_GAP = 2.0;
+// Standard Crosshair Reticle
+constexpr qreal STD_CROSSHAIR_SIZE = 60.0;
+constexpr qreal STD_CROSSHAIR_GAP = 10.0;
+// Precision Crosshair Reticle
+constexpr qreal PRECISION_CROSSHAIR_SIZE = 100.0;
+constexpr qreal PRECISION_CROSSHAIR_CENTER_DOT_RADIUS = 2.0;
+constexpr qreal PRECISION_CROSSHAIR_TICK_LENGTH = 5.0;
+constexpr int PRECISION_CROSSHAIR_NUM_TICKS = 5; // Per quadrant arm
+constexpr qreal PRECISION_CROSSHAIR_TICK_SPACING = 15.0;
+// Mil-Dot Reticle
+constexpr qreal MILDOT_RETICLE_SIZE = 120.0;
+constexpr qreal MILDOT_RETICLE_DOT_RADIUS = 1.5;
+constexpr int MILDOT_RETICLE_NUM_DOTS = 4; // Per quadrant arm (excluding center)
+
+// Detection Box
+constexpr int DETECTION_TEXT_OFFSET_Y = -5; // Offset above the box
+
+
+/**
+ * @brief Pens and brushes derived from the OSD colour.
+ */
+struct OsdPens {
+    QPen main;             // Primary coloured elements
+    QPen shapeOutline;     // Outlines of shapes (circles, scales)
+    QPen needleOutline;    // Thicker needle outlines
+    QPen tickMarkMain;     // Main tick marks
+    QPen tickMarkOutline;  // Tick mark outlines
+    QPen textOutline;      // Text outlines
+    QPen trackingOutline;  // Tracking corner outlines
+    QPen reticleOutline;   // Reticle outlines
+    QBrush fill;           // Text fill and filled shapes
+};
+
+OsdPens makePens(const QColor &osdColor, int lineWidth);
+
+/**
+ * @brief Maps a text position from the reference layout onto a @p width x @p height frame.
+ *
+ * The element keeps its pixel size and its distance to the nearest horizontal and vertical
+ * edge, so the OSD stays crisp at whatever resolution the display negotiated.
+ */
+QPointF anchoredPos(const QPointF &referencePos, int width, int height);
+QFont defaultFont();
+
+// --- Status Text ---
+QString modeText(OperationalMode mode);
+QString motionText(MotionMode motionMode);
+QString systemStatusText(bool charged, bool armed, bool ready);
+QString fireRateText(FireMode rate);
+QString lrfText(float distance);
+
+// --- Picture-in-Picture ---
+
+/**
+ * @brief Draws a picture-in-picture inset 1:1 at @p position, framed like the other OSD shapes.
+ */
+void drawInset(QPainter &painter, const QImage &inset, const QPoint &position, const OsdPens &pens);
+
+/**
+ * @brief Baseline position of the inset's camera label, inside its top-left corner.
+ */
+QPointF insetLabelPos(const QPoint &position, const QFontMetricsF &metrics);
+
+// --- Reticles ---
+
+/**
+ * @brief One outlined reticle path, relative to the aimpoint at (0, 0).
+ */
+struct ReticlePart {
+    QPainterPath path;
+    bool filled = false; // Filled with the OSD colour (mil-dots) instead of stroked only
+};
+
+double pixelsPerMil(double horizontalFovDegrees, double screenWidthPixels);
+
+/**
+ * @brief Builds the paths of a reticle type. Mil-dot spacing depends on the FOV and width.
+ */
+std::vector<ReticlePart> reticleParts(ReticleType type, double horizontalFovDegrees, int screenWidthPixels);
+
+} // namespace OsdLayout
+
+#endif // OSDLAYOUT_H
@@ -0,0 +1,622 @@
+#include "osdpainterrenderer.h"
+#include "glyphoutlinecache.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QLineF>
+#include <QPainter>
+#include <QPicture>
+#include <algorithm>
+#include <cmath> // For M_PI, cos, sin
+#include <utility>
+
+using namespace OsdLayout;
+
+namespace {
+constexpr int LAYER_MARGIN_PX = 4; // Extra border around cached layers for outline pens and antialiasing
+constexpr int MAX_TEXT_RASTER_PIXELS = 512 * 128; // Larger texts are drawn from the path
+constexpr quint64 TIMING_LOG_INTERVAL = 300; // Frames between timing log lines
+
+const QColor WARNING_TEXT_COLOR = QColor(200, 20, 40);
+} // namespace
+
+// === Constructor ===
+
+OsdPainterRenderer::OsdPainterRenderer(int width, int height)
+    : m_width(width)
+    , m_height(height)
+    , m_outputPool(width, height, QImage::Format_ARGB32_Premultiplied)
+    , m_osdColor(DEFAULT_OSD_COLOR)
+    , m_font(defaultFont())
+    , m_fontMetrics(m_font)
+    , m_lineWidth(DEFAULT_LINE_WIDTH)
+    , m_pens(makePens(DEFAULT_OSD_COLOR, DEFAULT_LINE_WIDTH))
+{
+}
+
+// === Public Methods ===
+
+QImage OsdPainterRenderer::render(QImage baseImage, const OsdFrameState &state)
+{
+    QElapsedTimer timer;
+    timer.start();
+    OsdLayerTimings timings;
+
+    // Lay the OSD out at the frame's own (display-negotiated) resolution
+    if (!baseImage.isNull() && (baseImage.width() != m_width || baseImage.height() != m_height)) {
+        setFrameSize(baseImage.width(), baseImage.height());
+    }
+    updateStyle(state);
+
+    QPainter painter;
+    QImage pooledImage;   // Composite and Overlay: pooled output buffer
+    const bool inPlace = (m_renderMode == OsdRenderMode::InPlace) && canRenderInPlace(baseImage);
+    const bool overlay = (m_renderMode == OsdRenderMode::Overlay);
+    if (m_renderMode == OsdRenderMode::InPlace && !inPlace) {
+        ++m_inPlaceFallbacks;
+    }
+    if (overlay) {
+        // OSD only: clearing is a plain fill, the frame itself is never touched or copied
+        pooledImage = m_outputPool.acquire();
+        pooledImage.fill(Qt::transparent);
+        painter.begin(&pooledImage);
+    } else if (inPlace) {
+        // Sole reference, see OsdRenderer::renderOsd()
+        painter.begin(&baseImage);
+    } else {
+        pooledImage = m_outputPool.acquire();
+        painter.begin(&pooledImage);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        if (baseImage.size() == pooledImage.size()) {
+            painter.drawImage(0, 0, baseImage);
+        } else {
+            painter.drawImage(QRect(0, 0, m_width, m_height), baseImage);
+        }
+        FrameCopyStats::recordCopy(static_cast<qint64>(pooledImage.sizeInBytes()));
+    }
+    timings.baseImageNs = timer.nsecsElapsed();
+
+    // Picture-in-picture inset right over the frame, under every OSD element
+    if (!state.pipInset.isNull()) {
+        drawInset(painter, state.pipInset, state.pipPosition, m_pens);
+        timings.insetNs = timer.nsecsElapsed() - timings.baseImageNs;
+    }
+
+    // Cached layers, back to front (same order as OsdRenderer)
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    compositeLayer(painter, OsdLayer::Reticle, state.reticlePosition.toPoint(), timings);
+    compositeLayer(painter, OsdLayer::AzimuthDial, QPoint(0, 0), timings);
+    compositeLayer(painter, OsdLayer::ElevationScale, QPoint(0, 0), timings);
+    compositeLayer(painter, OsdLayer::LobMarker, QPoint(0, 0), timings);
+
+    const qint64 dynamicStartNs = timer.nsecsElapsed();
+    painter.setRenderHint(QPainter::Antialiasing);
+    drawDynamic(painter, state);
+    painter.end();
+    timings.layerNs[static_cast<int>(OsdLayer::Dynamic)] = timer.nsecsElapsed() - dynamicStartNs;
+
+    timings.totalNs = timer.nsecsElapsed();
+    m_lastTimings = timings;
+
+    if (++m_renderCount % TIMING_LOG_INTERVAL == 0) {
+        qDebug().nospace() << "OsdPainterRenderer: " << (overlay ? "overlay" : inPlace ? "in-place" : "composite") << " render "
+                           << timings.totalNs / 1000 << " us (base " << timings.baseImageNs / 1000
+                           << " us, inset " << timings.insetNs / 1000
+                           << " us, dynamic " << timings.layerNs[static_cast<int>(OsdLayer::Dynamic)] / 1000
+                           << " us), text raster hits " << m_textRasterHits << " rebuilds " << m_textRasterRebuilds
+                           << ", in-place fallbacks " << m_inPlaceFallbacks;
+    }
+
+    // Handed on, not copied: the pools get their buffers back once the display drops them
+    return inPlace ? std::move(baseImage) : std::move(pooledImage);
+}
+
+void OsdPainterRenderer::setFrameSize(int width, int height)
+{
+    if (width <= 0 || height <= 0 || (width == m_width && height == m_height)) {
+        return;
+    }
+    m_width = width;
+    m_height = height;
+    m_outputPool.reset(width, height);
+    // Dial and scale hang off the right/bottom edges, mil-dot spacing depends on the width
+    for (CachedLayer &layer : m_layers) {
+        layer.valid = false;
+    }
+}
+
+bool OsdPainterRenderer::canRenderInPlace(const QImage &baseImage) const
+{
+    if (baseImage.isNull() || baseImage.width() != m_width || baseImage.height() != m_height) {
+        return false;
+    }
+    // Any other reference (network output, recorder, the frame still on screen) must
+    // never see the OSD burned into the frame
+    if (!baseImage.isDetached()) {
+        return false;
+    }
+    return baseImage.format() == QImage::Format_ARGB32_Premultiplied ||
+           baseImage.format() == QImage::Format_RGB32;
+}
+
+// === Styling ===
+
+void OsdPainterRenderer::updateStyle(const OsdFrameState &state)
+{
+    if (!m_hasStyle || state.colorStyle != m_osdColor) {
+        m_osdColor = state.colorStyle;
+        m_pens = makePens(m_osdColor, m_lineWidth);
+        m_hasStyle = true;
+        for (CachedLayer &layer : m_layers) {
+            layer.valid = false;
+        }
+        // Text rasters are keyed by their fill colour, so they rebuild on their own
+    }
+
+    // Mil-dot spacing depends on the FOV; other reticles only on their type
+    if (state.reticleType != m_reticleType ||
+        (state.reticleType == ReticleType::MilDot && !qFuzzyCompare(state.fov, m_reticleHfov))) {
+        m_layers[static_cast<int>(OsdLayer::Reticle)].valid = false;
+    }
+    m_reticleType = state.reticleType;
+    m_reticleHfov = state.fov;
+}
+
+qreal OsdPainterRenderer::textWidth(const QString &text) const
+{
+    // Same as OutlinedTextItem::boundingRect(): text advance widened by the outline pen
+    return m_fontMetrics.horizontalAdvance(text) + m_pens.textOutline.widthF();
+}
+
+qreal OsdPainterRenderer::textHeight() const
+{
+    return m_fontMetrics.height() + m_pens.textOutline.widthF();
+}
+
+// === Text ===
+
+void OsdPainterRenderer::drawOutlinedPath(QPainter &painter, const QPainterPath &path, const QColor &fill) const
+{
+    painter.setPen(m_pens.textOutline);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPath(path);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(fill);
+    painter.drawPath(path);
+}
+
+void OsdPainterRenderer::drawText(QPainter &painter, CachedText &slot, const QString &text,
+                                  const QPointF &pos, const QColor &fill)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+
+    if (slot.text != text || slot.fill != fill || slot.path.isEmpty()) {
+        slot.text = text;
+        slot.fill = fill;
+        slot.path = GlyphOutlineCache::instance().textPath(m_font, text);
+
+        const qreal adjust = m_pens.textOutline.widthF() / 2.0 + 1.0; // One extra pixel for antialiasing
+        const QRect rasterRect = slot.path.boundingRect().adjusted(-adjust, -adjust, adjust, adjust).toAlignedRect();
+        if (rasterRect.isEmpty() || rasterRect.width() * rasterRect.height() > MAX_TEXT_RASTER_PIXELS) {
+            slot.raster = QImage();
+        } else {
+            if (slot.raster.size() != rasterRect.size()) {
+                slot.raster = QImage(rasterRect.size(), QImage::Format_ARGB32_Premultiplied);
+            }
+            slot.raster.fill(Qt::transparent);
+            slot.rasterOffset = rasterRect.topLeft();
+
+            QPainter rasterPainter(&slot.raster);
+            rasterPainter.setRenderHint(QPainter::Antialiasing);
+            rasterPainter.translate(-slot.rasterOffset);
+            drawOutlinedPath(rasterPainter, slot.path, fill);
+            rasterPainter.end();
+        }
+        ++m_textRasterRebuilds;
+    } else {
+        ++m_textRasterHits;
+    }
+
+    if (!slot.raster.isNull()) {
+        // Integer placement keeps the blit a plain copy
+        painter.drawImage(pos.toPoint() + slot.rasterOffset, slot.raster);
+    } else if (!slot.path.isEmpty()) {
+        painter.save();
+        painter.translate(pos);
+        drawOutlinedPath(painter, slot.path, fill);
+        painter.restore();
+    }
+}
+
+void OsdPainterRenderer::drawText(QPainter &painter, TextSlot slot, const QString &text,
+                                  const QPointF &pos, const QColor &fill)
+{
+    drawText(painter, m_texts[slot], text, pos, fill);
+}
+
+// === Cached Layers ===
+
+void OsdPainterRenderer::compositeLayer(QPainter &painter, OsdLayer layer, const QPoint &anchor,
+                                        OsdLayerTimings &timings)
+{
+    QElapsedTimer layerTimer;
+    layerTimer.start();
+
+    const int index = static_cast<int>(layer);
+    CachedLayer &cache = m_layers[index];
+    if (!cache.valid) {
+        rebuildLayer(layer, anchor);
+        timings.rebuilt[index] = true;
+    }
+    if (!cache.image.isNull()) {
+        painter.drawImage(anchor + cache.origin, cache.image);
+    }
+
+    timings.layerNs[index] = layerTimer.nsecsElapsed();
+}
+
+void OsdPainterRenderer::rebuildLayer(OsdLayer layer, const QPoint &anchor)
+{
+    CachedLayer &cache = m_layers[static_cast<int>(layer)];
+    cache.valid = true;
+
+    // Record once to find the bounds, then replay into a tight raster
+    QPicture picture;
+    QPainter recorder(&picture);
+    recorder.setRenderHint(QPainter::Antialiasing);
+    drawLayerContents(recorder, layer);
+    recorder.end();
+
+    const QRect itemsRect = picture.boundingRect();
+    if (itemsRect.isEmpty()) {
+        cache.image = QImage();
+        return;
+    }
+
+    const QRect sourceRect = itemsRect.adjusted(-LAYER_MARGIN_PX, -LAYER_MARGIN_PX, LAYER_MARGIN_PX, LAYER_MARGIN_PX);
+    if (cache.image.size() != sourceRect.size()) {
+        cache.image = QImage(sourceRect.size(), QImage::Format_ARGB32_Premultiplied);
+    }
+    cache.image.fill(Qt::transparent);
+
+    // The reticle is drawn around (0, 0) and blitted at the aimpoint; the rest in frame coordinates
+    cache.origin = (layer == OsdLayer::Reticle) ? sourceRect.topLeft() : sourceRect.topLeft() - anchor;
+
+    QPainter layerPainter(&cache.image);
+    layerPainter.setRenderHint(QPainter::Antialiasing);
+    layerPainter.translate(-sourceRect.topLeft());
+    layerPainter.drawPicture(0, 0, picture);
+    layerPainter.end();
+}
+
+void OsdPainterRenderer::drawLayerContents(QPainter &painter, OsdLayer layer)
+{
+    switch (layer) {
+    case OsdLayer::Reticle:        drawReticle(painter); break;
+    case OsdLayer::AzimuthDial:    drawAzimuthDial(painter); break;
+    case OsdLayer::ElevationScale: drawElevationScale(painter); break;
+    case OsdLayer::LobMarker:      drawLobMarker(painter); break;
+    default: break;
+    }
+}
+
+void OsdPainterRenderer::drawAzimuthDial(QPainter &painter)
+{
+    const QPointF center(m_width - AZ_INDICATOR_X_OFFSET, AZ_INDICATOR_Y);
+
+    std::vector<QLineF> ticks;
+    for (int deg = 0; deg < 360; deg += AZ_TICK_STEP) {
+        const qreal length = (deg % 90 == 0) ? AZ_TICK_LENGTH_MAJOR : AZ_TICK_LENGTH_MINOR;
+        const double angleRad = (90.0 - deg) * M_PI / 180.0;
+        const qreal innerRad = AZ_RADIUS - length;
+        ticks.emplace_back(QPointF(center.x() + innerRad * cos(angleRad), center.y() - innerRad * sin(angleRad)),
+                           QPointF(center.x() + AZ_RADIUS * cos(angleRad), center.y() - AZ_RADIUS * sin(angleRad)));
+    }
+
+    // Outlines first, then the coloured parts on top
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(m_pens.shapeOutline);
+    painter.drawEllipse(center, AZ_RADIUS, AZ_RADIUS);
+    painter.setPen(m_pens.tickMarkOutline);
+    painter.drawLines(ticks.data(), static_cast<int>(ticks.size()));
+
+    painter.setPen(m_pens.main);
+    painter.drawEllipse(center, AZ_RADIUS, AZ_RADIUS);
+    painter.setPen(m_pens.tickMarkMain);
+    painter.drawLines(ticks.data(), static_cast<int>(ticks.size()));
+
+    // Cardinal labels, centred on their point outside the dial
+    static const std::array<std::pair<int, const char *>, 4> labels = {{{0, "N"}, {90, "E"}, {180, "S"}, {270, "W"}}};
+    for (const auto &label : labels) {
+        const QString text = QString::fromLatin1(label.second);
+        const double angleRad = (90.0 - label.first) * M_PI / 180.0;
+        const qreal labelRad = AZ_RADIUS + AZ_LABEL_OFFSET;
+        const qreal labelX = center.x() + labelRad * cos(angleRad);
+        const qreal labelY = center.y() - labelRad * sin(angleRad) + 25;
+        const QPointF pos(labelX - textWidth(text) / 2.0, labelY - textHeight() / 2.0);
+
+        painter.save();
+        painter.translate(pos);
+        drawOutlinedPath(painter, GlyphOutlineCache::instance().textPath(m_font, text), m_osdColor);
+        painter.restore();
+    }
+}
+
+void OsdPainterRenderer::drawElevationScale(QPainter &painter)
+{
+    const qreal scaleX = m_width - EL_SCALE_X_OFFSET;
+    const qreal scaleYBase = m_height - EL_SCALE_Y_OFFSET;
+    const QLineF scaleLine(scaleX, scaleYBase - EL_SCALE_HEIGHT, scaleX, scaleYBase);
+
+    std::vector<QLineF> ticks;
+    for (int deg = static_cast<int>(EL_MIN); deg < static_cast<int>(EL_MIN + EL_RANGE + 1); deg += 10) {
+        const bool isMajor = (deg == 60 || deg == 30 || deg == 0 || deg == -20);
+        const qreal length = isMajor ? EL_MAJOR_TICK_LENGTH : EL_TICK_LENGTH;
+        const qreal yPos = scaleYBase - (deg - EL_MIN) / EL_RANGE * EL_SCALE_HEIGHT;
+        ticks.emplace_back(QPointF(scaleX + length, yPos), QPointF(scaleX, yPos));
+    }
+
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(m_pens.shapeOutline);
+    painter.drawLine(scaleLine);
+    painter.setPen(m_pens.tickMarkOutline);
+    painter.drawLines(ticks.data(), static_cast<int>(ticks.size()));
+
+    painter.setPen(m_pens.main);
+    painter.drawLine(scaleLine);
+    painter.setPen(m_pens.tickMarkMain);
+    painter.drawLines(ticks.data(), static_cast<int>(ticks.size()));
+
+    for (qreal degree : {60.0, 0.0, -20.0}) {
+        const QString text = QString::number(static_cast<int>(degree));
+        const qreal yPos = scaleYBase - (degree - EL_MIN) / EL_RANGE * EL_SCALE_HEIGHT + 15;
+        painter.save();
+        painter.translate(scaleX + EL_LABEL_X_OFFSET, yPos - textHeight() / 2.0);
+        drawOutlinedPath(painter, GlyphOutlineCache::instance().textPath(m_font, text), m_osdColor);
+        painter.restore();
+    }
+}
+
+void OsdPainterRenderer::drawLobMarker(QPainter &painter)
+{
+    const qreal size = 5.0; // Small, simple cross at screen centre
+    const QPointF center(m_width / 2.0, m_height / 2.0);
+    QPainterPath lobPath;
+    lobPath.moveTo(center.x() - size, center.y()); lobPath.lineTo(center.x() + size, center.y());
+    lobPath.moveTo(center.x(), center.y() - size); lobPath.lineTo(center.x(), center.y() + size);
+
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(m_pens.reticleOutline);
+    painter.drawPath(lobPath);
+    painter.setPen(m_pens.main);
+    painter.drawPath(lobPath);
+}
+
+void OsdPainterRenderer::drawReticle(QPainter &painter)
+{
+    for (const ReticlePart &part : reticleParts(m_reticleType, m_reticleHfov, m_width)) {
+        painter.setPen(m_pens.reticleOutline);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPath(part.path);
+        painter.setPen(m_pens.main);
+        painter.setBrush(part.filled ? m_pens.fill : QBrush(Qt::NoBrush));
+        painter.drawPath(part.path);
+    }
+}
+
+// === Per-frame Elements ===
+
+void OsdPainterRenderer::drawTrackingCorners(QPainter &painter, const OsdFrameState &state, bool outline)
+{
+    // The plain tracking box first (OsdRenderer::updateTrackingBox()), then the same
+    // visibility/colour rules as OsdRenderer::updateTrackingPhaseDisplay(), which drives
+    // the same corners and so moves, restyles or hides them
+    QRectF box = state.trackingBox;
+    QColor color = COLOR_TRACKING_DEFAULT;
+    Qt::PenStyle style = Qt::SolidLine;
+    switch (state.trackingPhase) {
+    case TrackingPhase::Acquisition:
+        box = state.acquisitionBox;
+        color = COLOR_TRACKING_ACQUIRING;
+        break;
+    case TrackingPhase::Tracking_LockPending:
+        if (!state.hasValidLock) return;
+        box = state.trackedBox;
+        color = COLOR_TRACKING_ACQUIRING;
+        break;
+    case TrackingPhase::Tracking_ActiveLock:
+        if (!state.hasValidLock) return;
+        box = state.trackedBox;
+        color = COLOR_TRACKING_ACQUIRED;
+        style = Qt::DashLine;
+        break;
+    case TrackingPhase::Tracking_Coast:
+        if (!state.hasValidLock) return;
+        box = state.trackedBox;
+        color = COLOR_TRACKING_LOST;
+        style = Qt::DashLine;
+        break;
+    case TrackingPhase::Tracking_Firing:
+        if (!state.hasValidLock) return;
+        box = state.trackedBox;
+        color = COLOR_TRACKING_FIRING;
+        style = Qt::DashLine;
+        break;
+    case TrackingPhase::Off:
+    default:
+        return;
+    }
+    if (box.width() <= 0 || box.height() <= 0) {
+        return;
+    }
+
+    const qreal len = TRACKING_CORNER_LENGTH;
+    const QPointF tl = box.topLeft();
+    const QPointF tr = box.topRight();
+    const QPointF bl = box.bottomLeft();
+    const QPointF br = box.bottomRight();
+    const QLineF lines[8] = {
+        QLineF(tl, tl + QPointF(len, 0)), QLineF(tl, tl + QPointF(0, len)),
+        QLineF(tr, tr + QPointF(-len, 0)), QLineF(tr, tr + QPointF(0, len)),
+        QLineF(bl, bl + QPointF(len, 0)), QLineF(bl, bl + QPointF(0, -len)),
+        QLineF(br, br + QPointF(-len, 0)), QLineF(br, br + QPointF(0, -len))
+    };
+
+    QPen pen;
+    if (outline) {
+        pen = m_pens.trackingOutline;
+    } else {
+        pen = QPen(color, m_lineWidth);
+        pen.setCosmetic(true);
+    }
+    pen.setStyle(style);
+    painter.setPen(pen);
+    painter.drawLines(lines, 8);
+}
+
+void OsdPainterRenderer::drawDynamic(QPainter &painter, const OsdFrameState &state)
+{
+    // Text positions follow the frame edges they are anchored to
+    const auto at = [this](const QPointF &referencePos) { return anchoredPos(referencePos, m_width, m_height); };
+
+    // --- Geometry of the moving indicators ---
+    float azimuth = state.azimuth;
+    while (azimuth < 0.0f) azimuth += 360.0f;
+    while (azimuth >= 360.0f) azimuth -= 360.0f;
+    const QPointF azCenter(m_width - AZ_INDICATOR_X_OFFSET, AZ_INDICATOR_Y);
+    const qreal needleLength = AZ_RADIUS * AZ_NEEDLE_LENGTH_FACTOR;
+    const double azRad = azimuth * M_PI / 180.0;
+    const QLineF needle(azCenter, QPointF(azCenter.x() + needleLength * sin(azRad), azCenter.y() - needleLength * cos(azRad)));
+
+    const qreal elScaleX = m_width - EL_SCALE_X_OFFSET;
+    const qreal elScaleYBase = m_height - EL_SCALE_Y_OFFSET;
+    const qreal normElevation = std::max(0.0, std::min(1.0, static_cast<double>((state.elevation - EL_MIN) / EL_RANGE)));
+    const qreal indicatorY = elScaleYBase - normElevation * EL_SCALE_HEIGHT;
+    const qreal indicatorX = elScaleX - 12;
+    QPainterPath triangle;
+    triangle.moveTo(indicatorX + EL_INDICATOR_WIDTH, indicatorY); // Point left
+    triangle.lineTo(indicatorX, indicatorY - EL_INDICATOR_HEIGHT / 2.0);
+    triangle.lineTo(indicatorX, indicatorY + EL_INDICATOR_HEIGHT / 2.0);
+    triangle.closeSubpath();
+
+    // --- Outlines (Z_ORDER_OUTLINE) ---
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(m_pens.needleOutline);
+    painter.drawLine(needle);
+    painter.setPen(m_pens.shapeOutline);
+    painter.drawPath(triangle);
+    drawTrackingCorners(painter, state, true);
+    painter.setPen(m_pens.shapeOutline);
+    painter.setBrush(Qt::NoBrush);
+    for (const YoloDetection &det : state.detections) {
+        painter.drawRect(QRectF(det.box.x, det.box.y, det.box.width, det.box.height));
+    }
+
+    // --- Main elements (Z_ORDER_MAIN) ---
+    drawText(painter, TextMode, modeText(state.mode), at(POS_MODE_TEXT),
+             state.mode == OperationalMode::EmergencyStop ? QColor(Qt::red) : m_osdColor);
+    drawText(painter, TextMotion, motionText(state.motionMode), at(POS_MOTION_TEXT), m_osdColor);
+    drawText(painter, TextSpeed, QString("SPD: %1 %").arg(state.speed, 0, 'f', 1), at(POS_SPEED_TEXT), m_osdColor);
+    drawText(painter, TextStab, state.stabEnabled ? "STAB: ON" : "STAB: OFF", at(POS_STAB_TEXT), m_osdColor);
+    drawText(painter, TextCamera, QString("CAM: %1").arg(state.cameraType.toUpper()), at(POS_CAMERA_TEXT), m_osdColor);
+    drawText(painter, TextFov, QString("FOV: %1").arg(state.fov, 0, 'f', 1) + QChar(0xB0), at(POS_FOV_TEXT), m_osdColor);
+    drawText(painter, TextStatus, systemStatusText(state.sysCharged, state.sysArmed, state.sysReady), at(POS_STATUS_TEXT), m_osdColor);
+    drawText(painter, TextRate, fireRateText(state.fireMode), at(POS_RATE_TEXT), m_osdColor);
+    drawText(painter, TextLrf, lrfText(state.lrfDistance), at(POS_LRF_TEXT), m_osdColor);
+
+    const QString azText = QString::number(azimuth, 'f', 1) + QChar(0xB0);
+    drawText(painter, TextAzimuth, azText,
+             QPointF(azCenter.x() - textWidth(azText) / 2.0,
+                     AZ_INDICATOR_Y + AZ_RADIUS * AZ_TEXT_Y_OFFSET_FACTOR + AZ_TEXT_Y_EXTRA_OFFSET),
+             m_osdColor);
+    const QString elText = QString::number(state.elevation, 'f', 1) + QChar(0xB0);
+    drawText(painter, TextElevation, elText,
+             QPointF(elScaleX - EL_INDICATOR_WIDTH - textWidth(elText) - 5,
+                     elScaleYBase - (state.elevation - EL_MIN) / EL_RANGE * EL_SCALE_HEIGHT),
+             m_osdColor);
+
+    if (state.zeroingModeActive) {
+        drawText(painter, TextZeroing, "ZEROING", at(POS_ZEROING_STATUS_TEXT), m_osdColor);
+    } else if (state.zeroingApplied) {
+        drawText(painter, TextZeroing, "Z", at(POS_ZEROING_STATUS_TEXT), m_osdColor);
+    }
+    if (state.windageModeActive) {
+        drawText(painter, TextWindage, QString("WINDAGE: %1 kt").arg(state.windageSpeedKnots, 0, 'f', 0),
+                 at(POS_WINDAGE_STATUS_TEXT), m_osdColor);
+    } else if (state.windageApplied) {
+        drawText(painter, TextWindage, QString("W: %1 kt").arg(state.windageSpeedKnots, 0, 'f', 0),
+                 at(POS_WINDAGE_STATUS_TEXT), m_osdColor);
+    }
+    drawText(painter, TextScanName, state.scanName, at(POS_SCAN_NAME_TEXT), m_osdColor);
+
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(m_pens.main);
+    painter.drawLine(needle);
+    QPen triangleMainPen(m_osdColor, 1.0); // Thin border for filled shape
+    triangleMainPen.setCosmetic(true);
+    painter.setPen(triangleMainPen);
+    painter.setBrush(m_pens.fill);
+    painter.drawPath(triangle);
+    drawTrackingCorners(painter, state, false);
+
+    // --- Detections (Z_ORDER_DETECTION and above) ---
+    if (!state.detections.empty()) {
+        QPen detectionPen(m_osdColor, 2);
+        detectionPen.setCosmetic(true);
+        painter.setPen(detectionPen);
+        painter.setBrush(Qt::NoBrush);
+        for (const YoloDetection &det : state.detections) {
+            painter.drawRect(QRectF(det.box.x, det.box.y, det.box.width, det.box.height));
+        }
+
+        if (m_detectionTexts.size() < state.detections.size()) {
+            m_detectionTexts.resize(state.detections.size());
+        }
+        for (size_t i = 0; i < state.detections.size(); ++i) {
+            const YoloDetection &det = state.detections[i];
+            const QString label = QString("%1 %2%")
+                                      .arg(QString::fromStdString(det.className))
+                                      .arg(static_cast<int>(det.confidence * 100));
+            drawText(painter, m_detectionTexts[i], label,
+                     QPointF(det.box.x, det.box.y + DETECTION_TEXT_OFFSET_Y), m_osdColor);
+        }
+    }
+
+    // --- Warnings (Z_ORDER_MAIN + 5) ---
+    const QPointF zoneWarningPos(m_width / 2.0 + 50, m_height / 2.0 + 50);
+    if (state.inNoFireZone) {
+        drawText(painter, TextZoneWarning, "NO FIRE ZONE", zoneWarningPos, WARNING_TEXT_COLOR);
+    } else if (state.inNoTraverseZoneAtLimit) {
+        drawText(painter, TextZoneWarning, "NO TRAVERSE LIMIT", zoneWarningPos, WARNING_TEXT_COLOR);
+    }
+    // Lead angle status: the pre-formatted text first (OsdRenderer::updateLeadStatusText()),
+    // then the lead angle display replaces or hides it (OsdRenderer::updateLeadAngleDisplay())
+    QString leadText = state.leadStatusText;
+    QColor leadColor = leadText.contains("LAG")    ? QColor(Qt::yellow)
+                       : leadText.contains("ZOOM") ? WARNING_TEXT_COLOR
+                                                   : m_osdColor;
+    switch (state.leadAngleActive ? state.leadAngleStatus : LeadAngleStatus::Off) {
+    case LeadAngleStatus::On:
+        leadText = "LEAD ANGLE ON";
+        leadColor = m_osdColor;
+        break;
+    case LeadAngleStatus::Lag:
+        leadText = "LEAD ANGLE LAG";
+        leadColor = QColor(Qt::yellow);
+        break;
+    case LeadAngleStatus::ZoomOut:
+        leadText = "ZOOM OUT";
+        leadColor = WARNING_TEXT_COLOR;
+        break;
+    case LeadAngleStatus::Off:
+    default:
+        leadText.clear();
+        break;
+    }
+    drawText(painter, TextLeadAngle, leadText, at(POS_ZONE_LAC_TEXT), leadColor);
+    if (!state.pipInset.isNull()) {
+        drawText(painter, TextInsetLabel, state.pipLabel.toUpper(), insetLabelPos(state.pipPosition, m_fontMetrics), m_osdColor);
+    }
+}
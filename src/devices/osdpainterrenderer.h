@@ -0,0 +1,158 @@
+#ifndef OSDPAINTERRENDERER_H
+#define OSDPAINTERRENDERER_H
+
+// --- Standard Library Includes ---
+#include <array>
+#include <vector>
+
+// --- Qt Includes ---
+#include <QColor>
+#include <QFont>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QPainterPath>
+#include <QPoint>
+#include <QString>
+
+// --- Project Includes ---
+#include "framebufferpool.h"
+#include "osdlayout.h"
+#include "osdtypes.h"
+
+class QPainter;
+
+/**
+ * @brief Draws the OSD for one OsdFrameState straight onto a frame with QPainter.
+ *
+ * Produces the same elements as OsdRenderer without a QGraphicsScene, so it holds no
+ * QObject or widget state and can run on any thread (one instance per thread). Static
+ * elements are rasterised into cached layers keyed by colour, reticle type and FOV, and
+ * every text slot keeps a raster of its outlined text that is only rebuilt when the
+ * string or colour changes. Glyph outlines come from the shared GlyphOutlineCache.
+ */
+class OsdPainterRenderer
+{
+public:
+    OsdPainterRenderer(int width, int height);
+
+    /**
+     * @brief Renders @p state over @p baseImage.
+     *
+     * Output follows the render mode as in OsdRenderer::renderOsd(): InPlace paints into
+     * @p baseImage's pixels when it is detached (move the frame in) and composites otherwise,
+     * Composite paints into a pooled copy. Overlay leaves
+     * @p baseImage alone and paints only the OSD into a cleared, transparent pooled image,
+     * for displays that composite it over the frame themselves (GlVideoDisplayWidget).
+     * @return The frame with the OSD, or the OSD alone in Overlay mode (shared, not copied).
+     */
+    QImage render(QImage baseImage, const OsdFrameState &state);
+
+    /**
+     * @brief Lays the OSD out for @p width x @p height frames.
+     *
+     * render() calls this itself when a frame of a different size arrives.
+     */
+    void setFrameSize(int width, int height);
+
+    void setRenderMode(OsdRenderMode mode) { m_renderMode = mode; }
+    OsdRenderMode renderMode() const { return m_renderMode; }
+    quint64 inPlaceFallbackCount() const { return m_inPlaceFallbacks; } // InPlace frames composited because they were shared
+
+    /**
+     * @brief Timing breakdown of the most recent render() call, for profiling.
+     */
+    const OsdLayerTimings &lastLayerTimings() const { return m_lastTimings; }
+
+    // --- Text cache statistics ---
+    quint64 textRasterHits() const { return m_textRasterHits; }
+    quint64 textRasterRebuilds() const { return m_textRasterRebuilds; }
+
+private:
+    // One cached text raster per on-screen text slot
+    enum TextSlot {
+        TextMode = 0,
+        TextMotion,
+        TextSpeed,
+        TextStab,
+        TextCamera,
+        TextFov,
+        TextStatus,
+        TextRate,
+        TextLrf,
+        TextAzimuth,
+        TextElevation,
+        TextZeroing,
+        TextWindage,
+        TextScanName,
+        TextZoneWarning,
+        TextLeadAngle,
+        TextInsetLabel,
+        TextSlotCount
+    };
+
+    struct CachedText {
+        QString text;
+        QColor fill;
+        QPainterPath path;   // Baseline at y = 0
+        QImage raster;       // Outlined, filled path (premultiplied); null if too large
+        QPoint rasterOffset; // Raster top-left relative to the text origin
+    };
+
+    struct CachedLayer {
+        QImage image;  // Premultiplied raster of the layer's bounding rect
+        QPoint origin; // Image top-left relative to the anchor it is blitted at
+        bool valid = false;
+    };
+
+    // --- Styling ---
+    void updateStyle(const OsdFrameState &state);
+    qreal textWidth(const QString &text) const;
+    qreal textHeight() const;
+
+    // --- Text ---
+    void drawText(QPainter &painter, CachedText &slot, const QString &text, const QPointF &pos, const QColor &fill);
+    void drawText(QPainter &painter, TextSlot slot, const QString &text, const QPointF &pos, const QColor &fill);
+    void drawOutlinedPath(QPainter &painter, const QPainterPath &path, const QColor &fill) const;
+
+    // --- Cached layers ---
+    void compositeLayer(QPainter &painter, OsdLayer layer, const QPoint &anchor, OsdLayerTimings &timings);
+    void rebuildLayer(OsdLayer layer, const QPoint &anchor);
+    void drawLayerContents(QPainter &painter, OsdLayer layer);
+    void drawAzimuthDial(QPainter &painter);
+    void drawElevationScale(QPainter &painter);
+    void drawLobMarker(QPainter &painter);
+    void drawReticle(QPainter &painter);
+
+    // --- Per-frame elements ---
+    void drawDynamic(QPainter &painter, const OsdFrameState &state);
+    void drawTrackingCorners(QPainter &painter, const OsdFrameState &state, bool outline);
+
+    bool canRenderInPlace(const QImage &baseImage) const;
+
+    int m_width;
+    int m_height;
+    FrameBufferPool m_outputPool; // Composited output frames, recycled once the display releases them
+    OsdRenderMode m_renderMode = OsdRenderMode::Composite;
+
+    // Style the cached layers and text were built with
+    QColor m_osdColor;
+    QFont m_font;
+    QFontMetricsF m_fontMetrics;
+    int m_lineWidth;
+    OsdLayout::OsdPens m_pens;
+    bool m_hasStyle = false;
+    ReticleType m_reticleType = ReticleType::BoxCrosshair;
+    float m_reticleHfov = 0.0f;
+
+    std::array<CachedLayer, static_cast<int>(OsdLayer::Dynamic)> m_layers;
+    std::array<CachedText, TextSlotCount> m_texts;
+    std::vector<CachedText> m_detectionTexts;
+
+    OsdLayerTimings m_lastTimings;
+    quint64 m_renderCount = 0;
+    quint64 m_inPlaceFallbacks = 0;
+    quint64 m_textRasterHits = 0;
+    quint64 m_textRasterRebuilds = 0;
+};
+
+#endif // OSDPAINTERRENDERER_H
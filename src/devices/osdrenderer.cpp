@@ -1,112 +1,24 @@
 #include "osdrenderer.h"
 #include "outlinedtextitem.h" // Include the implementation dependency
+#include "glyphoutlinecache.h"
+#include "osdlayout.h"
 
 #include <QPainter>
 #include <QPainterPath>
-#include <QPixmap>
 #include <QDebug>
 #include <cmath> // For M_PI, cos, sin
 #include <QPainterPathStroker>
+#include <QElapsedTimer>
+#include <utility>
 
 // === Constants ===
+// Element geometry, colours and fonts are shared with OsdPainterRenderer (see osdlayout.h)
+using namespace OsdLayout;
+
 namespace {
-// Z-Values for layering
-constexpr qreal Z_ORDER_BACKGROUND = -1.0;
-constexpr qreal Z_ORDER_OUTLINE = 9.0;
-constexpr qreal Z_ORDER_MAIN = 10.0;
-constexpr qreal Z_ORDER_TRACKING = 15.0;
-constexpr qreal Z_ORDER_DETECTION = 12.0; // Ensure detections are visible but potentially behind tracking
-constexpr qreal Z_ORDER_RETICLE_MAIN = 20.0; // Text should be on top of everything
-
-// Default Colors (can be overridden by updateColorStyle)
-const QColor DEFAULT_OSD_COLOR = QColor(70, 226, 165); // Green
-const QColor DEFAULT_OUTLINE_COLOR = QColor(10, 10, 10);//(18, 67, 21); // Dark Green/Black
-// Tracking Colors (Defined in original code, keep them)
-//const QColor COLOR_TRACKING_DEFAULT = Qt::yellow;
-//const QColor COLOR_TRACKING_ACQUIRING = Qt::cyan;
-const QColor COLOR_TRACKING_ACQUIRED = Qt::green;
-
-//const QColor COLOR_TRACKING_LOST = QColor(200,20,40);
-
-// Default Font
-const char* DEFAULT_FONT_FAMILY = "Archivo Narrow";
-constexpr int DEFAULT_FONT_SIZE = 16;
-constexpr QFont::Weight DEFAULT_FONT_WEIGHT = QFont::Bold;
-
-// Default Line Width
-constexpr int DEFAULT_LINE_WIDTH = 2;
-
-// Element Positions & Sizes (Extracted from original code)
-// Text Item Positions
-const QPointF POS_MODE_TEXT(10, 25);
-const QPointF POS_MOTION_TEXT(10, 55);
-const QPointF POS_SPEED_TEXT(500, 25);
-const QPointF POS_STAB_TEXT(100, 748);
-const QPointF POS_CAMERA_TEXT(250, 748);
-const QPointF POS_FOV_TEXT(425, 748);
-const QPointF POS_ZOOM_TEXT(300, 748);
-const QPointF POS_STATUS_TEXT(10, 120);
-const QPointF POS_RATE_TEXT(10, 145);
-const QPointF POS_LRF_TEXT(10, 170);
-const QPointF POS_ZEROING_STATUS_TEXT(10, 195);  
-const QPointF POS_WINDAGE_STATUS_TEXT(10, 220);
-const QPointF POS_ZONE_WARNING_TEXT(1024 / 2.0 + 50, 768 / 2.0 + 50);
-const QPointF POS_ZONE_LAC_TEXT(10, 245);
-const QPointF POS_SCAN_NAME_TEXT(10, 270);
-
-// Azimuth Indicator
-constexpr qreal AZ_INDICATOR_X_OFFSET = 75; // Offset from right edge
-constexpr qreal AZ_INDICATOR_Y = 75;
-constexpr qreal AZ_RADIUS = 50;
-constexpr qreal AZ_NEEDLE_LENGTH_FACTOR = 0.8;
-constexpr qreal AZ_TICK_LENGTH_MAJOR = 8.0;
-constexpr qreal AZ_TICK_LENGTH_MINOR = 4.0;
-constexpr int AZ_TICK_STEP = 30; // Degrees
-constexpr qreal AZ_LABEL_OFFSET = 12.0;
-constexpr qreal AZ_TEXT_Y_OFFSET_FACTOR = 0.5; // Relative to radius
-constexpr qreal AZ_TEXT_Y_EXTRA_OFFSET = 5.0;
-
-// Elevation Scale
-constexpr qreal EL_SCALE_X_OFFSET = 55; // Offset from right edge
-constexpr qreal EL_SCALE_HEIGHT = 120;
-constexpr qreal EL_SCALE_Y_OFFSET = 25; // Offset from bottom edge
-constexpr qreal EL_RANGE =80.0;
-constexpr qreal EL_MIN = -20.0;
-constexpr qreal EL_TICK_LENGTH = 5.0;
-constexpr qreal EL_MAJOR_TICK_LENGTH = 10.0;
-
-constexpr qreal EL_LABEL_X_OFFSET = 13.0;
-constexpr qreal EL_INDICATOR_WIDTH = 6.0; // Base of triangle is 8 (Y), point is 6 away (X)
-constexpr qreal EL_INDICATOR_HEIGHT = 8.0;
-
-// Tracking Corners
-constexpr qreal TRACKING_CORNER_LENGTH = 15.0;
-
-// Reticle Constants
-constexpr double RETICLE_LINE_WIDTH = 2.0;
-constexpr double RETICLE_OUTLINE_WIDTH_FACTOR = 2.0; // Multiplier for outline pen width
-// Basic Reticle
-constexpr qreal BASIC_RETICLE_SIZE = 20.0;
-// Box Crosshair Reticle
-constexpr qreal BOX_CROSSHAIR_LINE_LEN = 80.0;
-constexpr qreal BOX_CROSSHAIR_BOX_SIZE = 50.0;
-constexpr qreal BOX_CROSSHAIR_GAP = 2.0;
-// Standard Crosshair Reticle
-constexpr qreal STD_CROSSHAIR_SIZE = 60.0;
-constexpr qreal STD_CROSSHAIR_GAP = 10.0;
-// Precision Crosshair Reticle
-constexpr qreal PRECISION_CROSSHAIR_SIZE = 100.0;
-constexpr qreal PRECISION_CROSSHAIR_CENTER_DOT_RADIUS = 2.0;
-constexpr qreal PRECISION_CROSSHAIR_TICK_LENGTH = 5.0;
-constexpr int PRECISION_CROSSHAIR_NUM_TICKS = 5; // Per quadrant arm
-constexpr qreal PRECISION_CROSSHAIR_TICK_SPACING = 15.0;
-// Mil-Dot Reticle
-constexpr qreal MILDOT_RETICLE_SIZE = 120.0;
-constexpr qreal MILDOT_RETICLE_DOT_RADIUS = 1.5;
-constexpr int MILDOT_RETICLE_NUM_DOTS = 4; // Per quadrant arm (excluding center)
-
-// Detection Box
-constexpr int DETECTION_TEXT_OFFSET_Y = -5; // Offset above the box
+// Layer Caching
+constexpr int LAYER_MARGIN_PX = 4; // Extra border around cached layers for outline pens and antialiasing
+constexpr quint64 LAYER_TIMING_LOG_INTERVAL = 300; // Frames between timing log lines
 
 } // namespace
 
@@ -116,8 +28,9 @@ OsdRenderer::OsdRenderer(int width, int height, QObject *parent)
     : QObject(parent)
     , m_width(width)
     , m_height(height)
+    , m_outputPool(width, height, QImage::Format_ARGB32_Premultiplied)
     , m_osdColor(DEFAULT_OSD_COLOR)
-    , m_osdFont(QString::fromUtf8(DEFAULT_FONT_FAMILY), DEFAULT_FONT_SIZE, DEFAULT_FONT_WEIGHT)
+    , m_osdFont(defaultFont())
     , m_lineWidth(DEFAULT_LINE_WIDTH)
     // Initialize state variables with defaults (as in original code or sensible defaults)
     , m_currentMode(OperationalMode::Idle)
@@ -137,7 +50,6 @@ OsdRenderer::OsdRenderer(int width, int height, QObject *parent)
     , m_reticleType(ReticleType::BoxCrosshair) // Default reticle
     , m_currentHfov(63.7) // Default HFOV
     // Null-initialize all graphics item pointers
-    , m_backgroundItem(nullptr)
     , m_modeTextItem(nullptr)
     , m_motionTextItem(nullptr)
     , m_stabTextItem(nullptr)
@@ -166,6 +78,9 @@ OsdRenderer::OsdRenderer(int width, int height, QObject *parent)
     , m_isLacActiveForReticle(false)
 {
     m_scene.setSceneRect(0, 0, width, height);
+    for (CachedLayer &layer : m_layers) {
+        layer.scene.setSceneRect(0, 0, width, height);
+    }
 
     // Configure the view (used internally for rendering)
     m_view.setScene(&m_scene);
@@ -176,11 +91,6 @@ OsdRenderer::OsdRenderer(int width, int height, QObject *parent)
     m_view.setViewportUpdateMode(QGraphicsView::NoViewportUpdate); // We control updates
     m_view.setBackgroundBrush(Qt::transparent); // Ensure transparency
 
-    // Create the background item (initially empty and hidden)
-    m_backgroundItem = m_scene.addPixmap(QPixmap());
-    m_backgroundItem->setZValue(Z_ORDER_BACKGROUND);
-    m_backgroundItem->setVisible(false); // Only visible during renderOsd
-
     // Initialize pens, brushes, and scene items
     setupPensAndBrushes();
     initializeScene();
@@ -197,80 +107,367 @@ OsdRenderer::~OsdRenderer()
     // Vectors of pointers owned by the scene are cleared automatically
     // when the scene is destroyed, but clearing them here is good practice.
     m_scene.clear(); // Removes and deletes all items
+    for (CachedLayer &layer : m_layers) {
+        layer.scene.clear();
+    }
 }
 
 // === Public Methods ===
 
-QImage OsdRenderer::renderOsd(const QImage &baseImage)
+QImage OsdRenderer::renderOsd(QImage baseImage)
 {
-    // Update the background item
-    m_backgroundItem->setPixmap(QPixmap::fromImage(baseImage));
-    m_backgroundItem->setVisible(true);
+    QElapsedTimer timer;
+    timer.start();
+    OsdLayerTimings timings;
+
+    QPainter painter;
+    QImage pooledImage;   // Composite: pooled output buffer
+    const bool inPlace = (m_renderMode == OsdRenderMode::InPlace) && canRenderInPlace(baseImage);
+    if (m_renderMode == OsdRenderMode::InPlace && !inPlace) {
+        ++m_inPlaceFallbacks;
+    }
+    if (inPlace) {
+        // Sole reference, so painting writes the frame's own pixels without detaching
+        painter.begin(&baseImage);
+    } else {
+        // Reuse an output buffer the display has already released
+        pooledImage = m_outputPool.acquire();
+        painter.begin(&pooledImage);
+
+        // Draw the video frame straight from the shared buffer (no QPixmap round-trip).
+        // Source mode overwrites the previous contents, so no transparent fill is needed.
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        if (baseImage.size() == pooledImage.size()) {
+            painter.drawImage(0, 0, baseImage);
+        } else {
+            painter.drawImage(QRect(0, 0, m_width, m_height), baseImage);
+        }
+        FrameCopyStats::recordCopy(static_cast<qint64>(pooledImage.sizeInBytes()));
+    }
+    timings.baseImageNs = timer.nsecsElapsed();
 
-    // Create the target image
-    QImage resultImage(m_width, m_height, QImage::Format_ARGB32_Premultiplied);
-    resultImage.fill(Qt::transparent);
+    // Picture-in-picture inset right over the frame, under every OSD element
+    if (!m_appliedState.pipInset.isNull()) {
+        drawInset(painter, m_appliedState.pipInset, m_appliedState.pipPosition, makePens(m_osdColor, m_lineWidth));
+        timings.insetNs = timer.nsecsElapsed() - timings.baseImageNs;
+    }
+
+    // Blit the cached layers back to front (the reticle group had the lowest z in the single scene)
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    const QPointF reticleAnchor = m_reticleRootGroup ? m_reticleRootGroup->pos() : QPointF(m_width / 2.0, m_height / 2.0);
+    compositeLayer(painter, OsdLayer::Reticle, reticleAnchor, timings);
+    compositeLayer(painter, OsdLayer::AzimuthDial, QPointF(0, 0), timings);
+    compositeLayer(painter, OsdLayer::ElevationScale, QPointF(0, 0), timings);
+    compositeLayer(painter, OsdLayer::LobMarker, QPointF(0, 0), timings);
 
-    // Render the scene to the image
-    QPainter painter(&resultImage);
+    // Only the per-frame items still go through the scene
+    qint64 dynamicStartNs = timer.nsecsElapsed();
     painter.setRenderHint(QPainter::Antialiasing);
     m_scene.render(&painter);
     painter.end(); // Ensure painting is finished
+    timings.layerNs[static_cast<int>(OsdLayer::Dynamic)] = timer.nsecsElapsed() - dynamicStartNs;
+
+    timings.totalNs = timer.nsecsElapsed();
+    m_lastTimings = timings;
+
+    if (++m_renderCount % LAYER_TIMING_LOG_INTERVAL == 0) {
+        {
+            QDebug dbg = qDebug().nospace();
+            dbg << "OsdRenderer: " << (inPlace ? "in-place" : "composite") << " render " << timings.totalNs / 1000
+                << " us (base " << timings.baseImageNs / 1000 << " us, inset " << timings.insetNs / 1000 << " us";
+            for (int i = 0; i < static_cast<int>(OsdLayer::Count); ++i) {
+                dbg << ", " << layerName(static_cast<OsdLayer>(i)) << " " << timings.layerNs[i] / 1000 << " us";
+            }
+            dbg << "), items invalidated by last apply " << m_lastInvalidatedItems;
+            if (m_renderMode == OsdRenderMode::InPlace) {
+                dbg << ", in-place fallbacks " << m_inPlaceFallbacks;
+            }
+        }
 
-    // Hide the background item again for the next frame
-    m_backgroundItem->setVisible(false);
+        const GlyphOutlineCache::Stats glyphStats = GlyphOutlineCache::instance().stats();
+        qDebug() << "OsdRenderer: glyph cache hits" << glyphStats.hits << "misses" << glyphStats.misses
+                 << "glyphs" << glyphStats.glyphCount << "cost" << glyphStats.totalCost << "/" << glyphStats.maxCost
+                 << "| text path rebuilds" << OutlinedTextItem::pathRebuildCount()
+                 << "raster hits" << OutlinedTextItem::rasterHitCount()
+                 << "raster rebuilds" << OutlinedTextItem::rasterRebuildCount();
+    }
 
-    return resultImage;
+    // Handed on, not copied: the pools get their buffers back once the display drops them
+    return inPlace ? std::move(baseImage) : std::move(pooledImage);
+}
+
+bool OsdRenderer::canRenderInPlace(const QImage &baseImage) const
+{
+    if (baseImage.isNull() || baseImage.width() != m_width || baseImage.height() != m_height) {
+        return false;
+    }
+    // Any other reference (network output, recorder, the frame still on screen) must
+    // never see the OSD burned into the frame
+    if (!baseImage.isDetached()) {
+        return false;
+    }
+    // Formats QPainter rasterises into directly
+    return baseImage.format() == QImage::Format_ARGB32_Premultiplied ||
+           baseImage.format() == QImage::Format_RGB32;
+}
+
+void OsdRenderer::setFrameSize(int width, int height)
+{
+    if (width <= 0 || height <= 0 || (width == m_width && height == m_height)) {
+        return;
+    }
+    const qreal dx = width - m_width;
+    const qreal dy = height - m_height;
+    m_width = width;
+    m_height = height;
+
+    m_scene.setSceneRect(0, 0, width, height);
+    for (CachedLayer &layer : m_layers) {
+        layer.scene.setSceneRect(0, 0, width, height);
+    }
+    m_view.setFixedSize(width, height);
+    m_outputPool.reset(width, height);
+
+    // The dial hangs off the right edge, the elevation scale off the bottom-right corner
+    for (QGraphicsItem *item : layerScene(OsdLayer::AzimuthDial).items()) {
+        if (!item->parentItem()) item->moveBy(dx, 0);
+    }
+    for (QGraphicsItem *item : layerScene(OsdLayer::ElevationScale).items()) {
+        if (!item->parentItem()) item->moveBy(dx, dy);
+    }
+    const QPointF azCenter(m_width - AZ_INDICATOR_X_OFFSET, AZ_INDICATOR_Y);
+    for (QGraphicsLineItem *needle : {m_azimuthNeedle, m_azimuthNeedleOutline}) {
+        if (!needle) continue;
+        needle->setLine(needle->line().translated(dx, 0));
+        needle->setTransformOriginPoint(azCenter);
+    }
+    for (QGraphicsPathItem *indicator : {m_elevationIndicator, m_elevationIndicatorOutline}) {
+        if (indicator) indicator->setPath(indicator->path().translated(dx, dy));
+    }
+    for (QGraphicsPathItem *lob : {m_fixedLobMarkerItem, m_fixedLobMarkerOutlineItem}) {
+        if (lob) lob->setPos(m_width / 2.0, m_height / 2.0);
+    }
+
+    const std::pair<OutlinedTextItem *, QPointF> textItems[] = {
+        {m_modeTextItem, POS_MODE_TEXT}, {m_motionTextItem, POS_MOTION_TEXT},
+        {m_speedTextItem, POS_SPEED_TEXT}, {m_stabTextItem, POS_STAB_TEXT},
+        {m_cameraTextItem, POS_CAMERA_TEXT}, {m_fovTextItem, POS_FOV_TEXT},
+        {m_zoomTextItem, POS_ZOOM_TEXT}, {m_statusTextItem, POS_STATUS_TEXT},
+        {m_rateTextItem, POS_RATE_TEXT}, {m_lrfTextItem, POS_LRF_TEXT},
+        {m_zeroingDisplayItem, POS_ZEROING_STATUS_TEXT}, {m_windageDisplayItem, POS_WINDAGE_STATUS_TEXT},
+        {m_leadAngleStatusTextItem, POS_ZONE_LAC_TEXT}, {m_currentScanNameTextItem, POS_SCAN_NAME_TEXT},
+    };
+    for (const auto &entry : textItems) {
+        if (entry.first) entry.first->setPos(anchoredPos(entry.second, m_width, m_height));
+    }
+    updateAzimuthIndicator();
+    updateElevationScale();
+
+    // Mil-dot spacing depends on the width
+    m_forceReticleRecreation = true;
+    updateReticleType(m_reticleType);
+    invalidateCachedLayers();
+    // Reticle position, zone warning etc. are recomputed by the next apply()
+    m_hasAppliedState = false;
+    qInfo() << "OsdRenderer: frame size set to" << width << "x" << height;
+}
+
+void OsdRenderer::setRenderMode(OsdRenderMode mode)
+{
+    if (m_renderMode == mode) return;
+    m_renderMode = mode;
+    qInfo() << "OsdRenderer: render mode set to" << (mode == OsdRenderMode::InPlace ? "in-place" : "composite");
+}
+
+const char *OsdRenderer::layerName(OsdLayer layer)
+{
+    switch (layer) {
+    case OsdLayer::Reticle:        return "reticle";
+    case OsdLayer::AzimuthDial:    return "azimuthDial";
+    case OsdLayer::ElevationScale: return "elevationScale";
+    case OsdLayer::LobMarker:      return "lobMarker";
+    case OsdLayer::Dynamic:        return "dynamic";
+    default:                       return "unknown";
+    }
+}
+
+void OsdRenderer::invalidateCachedLayers()
+{
+    for (CachedLayer &layer : m_layers) {
+        layer.dirty = true;
+    }
+}
+
+namespace {
+bool sameDetections(const std::vector<YoloDetection> &a, const std::vector<YoloDetection> &b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].class_id != b[i].class_id || a[i].box != b[i].box ||
+            a[i].confidence != b[i].confidence || a[i].className != b[i].className) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int OsdRenderer::apply(const OsdFrameState &state)
+{
+    const OsdFrameState &prev = m_appliedState;
+    // A colour change rewrites pens/brushes on every item (and resets per-item colours such as
+    // the lead/zone warnings), so everything downstream has to be re-applied as well.
+    const bool all = !m_hasAppliedState || state.colorStyle != prev.colorStyle;
+    int invalidated = 0;
+
+    if (all) {
+        updateColorStyle(state.colorStyle);
+        invalidated += static_cast<int>(m_scene.items().size());
+        for (const CachedLayer &layer : m_layers) {
+            invalidated += static_cast<int>(layer.scene.items().size());
+        }
+    }
+
+    // --- Status text ---
+    if (all || state.cameraType != prev.cameraType) { updateCameraType(state.cameraType); ++invalidated; }
+    if (all || state.mode != prev.mode) { updateMode(state.mode); ++invalidated; }
+    if (all || state.motionMode != prev.motionMode) { updateMotionMode(state.motionMode); ++invalidated; }
+    if (all || state.stabEnabled != prev.stabEnabled) { updateStabilization(state.stabEnabled); ++invalidated; }
+    if (all || state.lrfDistance != prev.lrfDistance) { updateLrfDistance(state.lrfDistance); ++invalidated; }
+    if (all || state.sysCharged != prev.sysCharged || state.sysArmed != prev.sysArmed ||
+        state.sysReady != prev.sysReady || state.fireMode != prev.fireMode) {
+        updateSystemStatus(state.sysCharged, state.sysArmed, state.sysReady);
+        updateFiringMode(state.fireMode);
+        invalidated += 2; // Status and rate lines
+    }
+    const bool fovChanged = all || state.fov != prev.fov;
+    if (fovChanged) { updateFov(state.fov); ++invalidated; }
+    if (all || state.speed != prev.speed) { updateSpeed(state.speed); ++invalidated; }
+
+    // --- Indicators ---
+    if (all || state.azimuth != prev.azimuth) { updateAzimuth(state.azimuth); invalidated += 3; } // Needle, outline, text
+    if (all || state.elevation != prev.elevation) { updateElevation(state.elevation); invalidated += 3; } // Indicator, outline, text
+
+    // --- Tracking box (both calls drive the same corner items, the phase display wins) ---
+    if (all || state.trackingBox != prev.trackingBox || state.trackingPhase != prev.trackingPhase ||
+        state.hasValidLock != prev.hasValidLock || state.acquisitionBox != prev.acquisitionBox ||
+        state.trackedBox != prev.trackedBox) {
+        updateTrackingBox(static_cast<float>(state.trackingBox.x()), static_cast<float>(state.trackingBox.y()),
+                          static_cast<float>(state.trackingBox.width()), static_cast<float>(state.trackingBox.height()));
+        updateTrackingPhaseDisplay(state.trackingPhase, state.hasValidLock, state.acquisitionBox, state.trackedBox);
+        invalidated += 1 + static_cast<int>(m_trackingCorners.size() + m_trackingCornersOutline.size());
+    }
+
+    // --- Detections ---
+    if (all || !sameDetections(state.detections, prev.detections)) {
+        invalidated += static_cast<int>(m_detectionRectItems.size() + m_detectionTextItems.size() + m_detectionRectOutlines.size());
+        updateDetectionBoxes(state.detections);
+        invalidated += static_cast<int>(m_detectionRectItems.size() + m_detectionTextItems.size() + m_detectionRectOutlines.size());
+    }
+
+    // --- Zeroing, windage, zones ---
+    if (all || state.zeroingModeActive != prev.zeroingModeActive || state.zeroingApplied != prev.zeroingApplied ||
+        state.zeroingAzOffset != prev.zeroingAzOffset || state.zeroingElOffset != prev.zeroingElOffset) {
+        updateZeroingDisplay(state.zeroingModeActive, state.zeroingApplied, state.zeroingAzOffset, state.zeroingElOffset);
+        ++invalidated;
+    }
+    if (all || state.windageModeActive != prev.windageModeActive || state.windageApplied != prev.windageApplied ||
+        state.windageSpeedKnots != prev.windageSpeedKnots) {
+        updateWindageDisplay(state.windageModeActive, state.windageApplied, state.windageSpeedKnots);
+        ++invalidated;
+    }
+    if (all || state.inNoFireZone != prev.inNoFireZone || state.inNoTraverseZoneAtLimit != prev.inNoTraverseZoneAtLimit) {
+        updateZoneWarning(state.inNoFireZone, state.inNoTraverseZoneAtLimit);
+        ++invalidated;
+    }
+
+    // --- Reticle position and lead angle ---
+    // Zeroing offsets, aimpoint and lead angle all move the same reticle group (and the FOV scales
+    // the offsets), so the calls are replayed together in their original order.
+    if (fovChanged || state.zeroingApplied != prev.zeroingApplied ||
+        state.zeroingAzOffset != prev.zeroingAzOffset || state.zeroingElOffset != prev.zeroingElOffset ||
+        state.reticleType != prev.reticleType || state.reticlePosition != prev.reticlePosition ||
+        state.leadStatusText != prev.leadStatusText || state.leadAngleActive != prev.leadAngleActive ||
+        state.leadAngleStatus != prev.leadAngleStatus || state.leadAngleOffsetAz != prev.leadAngleOffsetAz ||
+        state.leadAngleOffsetEl != prev.leadAngleOffsetEl) {
+        updateAppliedZeroingOffsets(state.zeroingApplied, state.zeroingAzOffset, state.zeroingElOffset);
+        updateReticleType(state.reticleType);
+        updateReticlePosition(static_cast<float>(state.reticlePosition.x()), static_cast<float>(state.reticlePosition.y()));
+        updateLeadStatusText(state.leadStatusText);
+        updateLeadAngleDisplay(state.leadAngleActive, state.leadAngleStatus,
+                               state.leadAngleOffsetAz, state.leadAngleOffsetEl);
+        invalidated += 2; // Reticle group and lead status text
+    }
+    if (all || state.scanName != prev.scanName) { updateCurrentScanNameDisplay(state.scanName); ++invalidated; }
+
+    m_appliedState = state;
+    m_hasAppliedState = true;
+    m_lastInvalidatedItems = invalidated;
+    return invalidated;
 }
 
 // === Private Helper Functions ===
 
+void OsdRenderer::rebuildLayer(OsdLayer layer, const QPointF &anchor)
+{
+    CachedLayer &cache = m_layers[static_cast<int>(layer)];
+    cache.dirty = false;
+
+    const QRectF itemsRect = cache.scene.itemsBoundingRect();
+    if (itemsRect.isEmpty()) {
+        cache.image = QImage();
+        return;
+    }
+
+    // Rasterise at 1:1 scale over the pixel-aligned bounds of the layer's items
+    const QRect sourceRect = itemsRect.toAlignedRect().adjusted(-LAYER_MARGIN_PX, -LAYER_MARGIN_PX,
+                                                                  LAYER_MARGIN_PX, LAYER_MARGIN_PX);
+    if (cache.image.size() != sourceRect.size()) {
+        cache.image = QImage(sourceRect.size(), QImage::Format_ARGB32_Premultiplied);
+    }
+    cache.image.fill(Qt::transparent);
+    cache.origin = QPointF(sourceRect.topLeft()) - anchor;
+
+    QPainter layerPainter(&cache.image);
+    layerPainter.setRenderHint(QPainter::Antialiasing);
+    cache.scene.render(&layerPainter, QRectF(QPointF(0, 0), QSizeF(sourceRect.size())), QRectF(sourceRect));
+    layerPainter.end();
+}
+
+void OsdRenderer::compositeLayer(QPainter &painter, OsdLayer layer, const QPointF &anchor, OsdLayerTimings &timings)
+{
+    QElapsedTimer layerTimer;
+    layerTimer.start();
+
+    const int index = static_cast<int>(layer);
+    CachedLayer &cache = m_layers[index];
+    if (cache.dirty) {
+        rebuildLayer(layer, anchor);
+        timings.rebuilt[index] = true;
+    }
+    if (!cache.image.isNull()) {
+        // Integer placement keeps the blit a plain copy (no resampling)
+        painter.drawImage((anchor + cache.origin).toPoint(), cache.image);
+    }
+
+    timings.layerNs[index] = layerTimer.nsecsElapsed();
+}
+
 void OsdRenderer::setupPensAndBrushes()
 {
-    // Use a consistent outline color, or derive from m_osdColor if preferred
-    // QColor currentOutlineColor = m_osdColor.darker(150);
-    QColor currentOutlineColor = DEFAULT_OUTLINE_COLOR;
-
-    m_fillBrush = QBrush(m_osdColor);
-
-    // Text Outline Pen (thin)
-    m_textOutlinePen = QPen(currentOutlineColor, 1);
-    m_textOutlinePen.setJoinStyle(Qt::RoundJoin);
-
-    // Main Pen (for primary colored elements)
-    m_mainPen = QPen(m_osdColor, m_lineWidth);
-    m_mainPen.setCosmetic(true); // Constant pixel width
-    m_mainPen.setJoinStyle(Qt::RoundJoin);
-    m_mainPen.setCapStyle(Qt::RoundCap);
-
-    // Shape Outline Pen (slightly thicker)
-    m_shapeOutlinePen = QPen(currentOutlineColor, m_lineWidth + 1);
-    m_shapeOutlinePen.setCosmetic(true);
-    m_shapeOutlinePen.setJoinStyle(Qt::RoundJoin);
-    m_shapeOutlinePen.setCapStyle(Qt::RoundCap);
-
-    // Needle Outline Pen (even thicker)
-    m_needleOutlinePen = QPen(currentOutlineColor, m_lineWidth + 2);
-    m_needleOutlinePen.setCosmetic(true);
-    m_needleOutlinePen.setJoinStyle(Qt::RoundJoin);
-    m_needleOutlinePen.setCapStyle(Qt::RoundCap);
-
-    // Tick Mark Pens
-    m_tickMarkMainPen = m_mainPen; // Use main pen for ticks
-    m_tickMarkOutlinePen = m_shapeOutlinePen; // Use shape outline for tick outlines
-
-    // Tracking Outline Pen
-    m_trackingOutlinePen = QPen(currentOutlineColor, m_lineWidth + 2); // Thicker outline
-    m_trackingOutlinePen.setCosmetic(true);
-
-    // Reticle Outline Pen
-    m_reticleOutlinePen = QPen(currentOutlineColor, RETICLE_LINE_WIDTH * RETICLE_OUTLINE_WIDTH_FACTOR);
-    m_reticleOutlinePen.setCosmetic(true);
-    m_reticleOutlinePen.setJoinStyle(Qt::RoundJoin);
-    m_reticleOutlinePen.setCapStyle(Qt::RoundCap);
+    const OsdPens pens = makePens(m_osdColor, m_lineWidth);
+    m_fillBrush = pens.fill;
+    m_textOutlinePen = pens.textOutline;
+    m_mainPen = pens.main;
+    m_shapeOutlinePen = pens.shapeOutline;
+    m_needleOutlinePen = pens.needleOutline;
+    m_tickMarkMainPen = pens.tickMarkMain;
+    m_tickMarkOutlinePen = pens.tickMarkOutline;
+    m_trackingOutlinePen = pens.trackingOutline;
+    m_reticleOutlinePen = pens.reticleOutline;
 }
 
-OutlinedTextItem* OsdRenderer::createTextItem(const QPointF &pos, qreal zValue)
+OutlinedTextItem* OsdRenderer::createTextItem(const QPointF &pos, qreal zValue, QGraphicsScene *scene)
 {
     OutlinedTextItem *item = new OutlinedTextItem();
     item->setFont(m_osdFont);
@@ -278,7 +475,7 @@ OutlinedTextItem* OsdRenderer::createTextItem(const QPointF &pos, qreal zValue)
     item->setFillBrush(m_fillBrush);
     item->setPos(pos);
     item->setZValue(zValue);
-    m_scene.addItem(item);
+    (scene ? scene : &m_scene)->addItem(item);
     return item;
 }
 
@@ -413,7 +610,8 @@ void OsdRenderer::addTickMarks(
 void OsdRenderer::addCardinalLabels(const QPointF& center, qreal radius, qreal labelOffset)
 {
     // Clear existing labels
-    for(auto item : m_azimuthLabels) { m_scene.removeItem(item); delete item; } m_azimuthLabels.clear();
+    QGraphicsScene &dialScene = layerScene(OsdLayer::AzimuthDial);
+    for(auto item : m_azimuthLabels) { dialScene.removeItem(item); delete item; } m_azimuthLabels.clear();
 
     const std::map<int, QString> labels = {{0, "N"}, {90, "E"}, {180, "S"}, {270, "W"}};
     for (const auto& pair : labels) {
@@ -425,19 +623,21 @@ void OsdRenderer::addCardinalLabels(const QPointF& center, qreal radius, qreal l
         qreal labelX = center.x() + labelRad * cos(angleRad);
         qreal labelY = center.y() - labelRad * sin(angleRad) + 25;
 
-        OutlinedTextItem *lbl = createTextItem(QPointF(0, 0), Z_ORDER_MAIN); // Create with helper
+        OutlinedTextItem *lbl = createTextItem(QPointF(0, 0), Z_ORDER_MAIN, &dialScene); // Create with helper
         lbl->setText(labelText);
         // Center the label on its calculated position
         lbl->setPos(labelX - lbl->boundingRect().width() / 2.0, labelY - lbl->boundingRect().height() / 2.0);
         m_azimuthLabels.push_back(lbl);
     }
+    invalidateLayer(OsdLayer::AzimuthDial);
 }
 
 // Helper to add elevation scale labels
 void OsdRenderer::addElevationLabels(qreal scaleX, qreal scaleYBase, qreal scaleHeight, qreal elMin, qreal elRange)
 {
     // Clear existing labels
-    for(auto item : m_elevationLabels) { m_scene.removeItem(item); delete item; } m_elevationLabels.clear();
+    QGraphicsScene &scaleScene = layerScene(OsdLayer::ElevationScale);
+    for(auto item : m_elevationLabels) { scaleScene.removeItem(item); delete item; } m_elevationLabels.clear();
 
     const std::vector<qreal> degrees = {60.0, 0.0, -20.0};
     for (qreal degree : degrees) {
@@ -445,49 +645,50 @@ void OsdRenderer::addElevationLabels(qreal scaleX, qreal scaleYBase, qreal scale
         qreal yPos = scaleYBase - norm * scaleHeight + 15;
         QString labelText = QString::number(static_cast<int>(degree));
 
-        OutlinedTextItem *lbl = createTextItem(QPointF(0, 0), Z_ORDER_MAIN);
+        OutlinedTextItem *lbl = createTextItem(QPointF(0, 0), Z_ORDER_MAIN, &scaleScene);
         lbl->setText(labelText);
         // Position label to the right of the tick
         lbl->setPos(scaleX + EL_LABEL_X_OFFSET, yPos - lbl->boundingRect().height() / 2.0);
         m_elevationLabels.push_back(lbl);
     }
+    invalidateLayer(OsdLayer::ElevationScale);
 }
 
 void OsdRenderer::initializeScene()
 {
     // --- Text Items ---
-    m_modeTextItem = createTextItem(POS_MODE_TEXT, Z_ORDER_MAIN);
-    m_motionTextItem = createTextItem(POS_MOTION_TEXT, Z_ORDER_MAIN);
-    m_speedTextItem = createTextItem(POS_SPEED_TEXT, Z_ORDER_MAIN);
-    m_stabTextItem = createTextItem(POS_STAB_TEXT, Z_ORDER_MAIN);
-    m_cameraTextItem = createTextItem(POS_CAMERA_TEXT, Z_ORDER_MAIN);
-    m_fovTextItem = createTextItem(POS_FOV_TEXT, Z_ORDER_MAIN);
-    m_zoomTextItem = createTextItem(POS_ZOOM_TEXT, Z_ORDER_MAIN);
-    m_statusTextItem = createTextItem(POS_STATUS_TEXT, Z_ORDER_MAIN);
-    m_rateTextItem = createTextItem(POS_RATE_TEXT, Z_ORDER_MAIN);
-    m_lrfTextItem = createTextItem(POS_LRF_TEXT, Z_ORDER_MAIN);
+    m_modeTextItem = createTextItem(anchoredPos(POS_MODE_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_motionTextItem = createTextItem(anchoredPos(POS_MOTION_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_speedTextItem = createTextItem(anchoredPos(POS_SPEED_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_stabTextItem = createTextItem(anchoredPos(POS_STAB_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_cameraTextItem = createTextItem(anchoredPos(POS_CAMERA_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_fovTextItem = createTextItem(anchoredPos(POS_FOV_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_zoomTextItem = createTextItem(anchoredPos(POS_ZOOM_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_statusTextItem = createTextItem(anchoredPos(POS_STATUS_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_rateTextItem = createTextItem(anchoredPos(POS_RATE_TEXT, m_width, m_height), Z_ORDER_MAIN);
+    m_lrfTextItem = createTextItem(anchoredPos(POS_LRF_TEXT, m_width, m_height), Z_ORDER_MAIN);
     m_azTextItem = createTextItem(QPointF(0, 0), Z_ORDER_MAIN); // Position updated in updateAzimuth
     m_elValueTextItem = createTextItem(QPointF(0, 0), Z_ORDER_MAIN); // Position updated in updateElevation
-    m_zeroingDisplayItem = createTextItem(POS_ZEROING_STATUS_TEXT, Z_ORDER_MAIN);
+    m_zeroingDisplayItem = createTextItem(anchoredPos(POS_ZEROING_STATUS_TEXT, m_width, m_height), Z_ORDER_MAIN);
     m_zeroingDisplayItem->setText("Z: N/A"); // Initial placeholder
     m_zeroingDisplayItem->setVisible(false); // Hide initially
 
-    m_windageDisplayItem = createTextItem(POS_WINDAGE_STATUS_TEXT, Z_ORDER_MAIN);
+    m_windageDisplayItem = createTextItem(anchoredPos(POS_WINDAGE_STATUS_TEXT, m_width, m_height), Z_ORDER_MAIN);
     m_windageDisplayItem->setText("W: N/A"); // Initial placeholder
     m_windageDisplayItem->setVisible(false); // Hide initially
 
-    m_zoneWarningItem = createTextItem(POS_ZONE_WARNING_TEXT, Z_ORDER_MAIN + 5); // High Z-order
+    m_zoneWarningItem = createTextItem(anchoredPos(POS_ZONE_WARNING_TEXT, m_width, m_height), Z_ORDER_MAIN + 5); // High Z-order
     m_zoneWarningItem->setBrush(QBrush(QColor(200,20,40))); // Make warnings stand out
     // m_zoneWarningItem->setOutlinePen(...); // Ensure good contrast for outline
     m_zoneWarningItem->setText(""); // Initially empty
     m_zoneWarningItem->setVisible(false);
     // Center the text item
     // m_zoneWarningItem->setPos(POS_ZONE_WARNING_TEXT.x() - m_zoneWarningItem->boundingRect().width() / 2.0, POS_ZONE_WARNING_TEXT.y());*
-    m_leadAngleStatusTextItem = createTextItem(POS_ZONE_LAC_TEXT, Z_ORDER_MAIN + 5); // High Z-order
+    m_leadAngleStatusTextItem = createTextItem(anchoredPos(POS_ZONE_LAC_TEXT, m_width, m_height), Z_ORDER_MAIN + 5); // High Z-order
     m_leadAngleStatusTextItem->setText(""); // Initially empty
     m_leadAngleStatusTextItem->setVisible(false);
 
-    m_currentScanNameTextItem = createTextItem(POS_SCAN_NAME_TEXT, Z_ORDER_MAIN);
+    m_currentScanNameTextItem = createTextItem(anchoredPos(POS_SCAN_NAME_TEXT, m_width, m_height), Z_ORDER_MAIN);
     m_currentScanNameTextItem->setText(""); // Initially empty
     m_currentScanNameTextItem->setVisible(false);
 
@@ -499,7 +700,8 @@ void OsdRenderer::initializeScene()
     lobPath.moveTo(0, -lob_cross_size); lobPath.lineTo(0, lob_cross_size);
 
     // Outline for LOB marker (optional, for better visibility)
-    if (m_fixedLobMarkerOutlineItem) { m_scene.removeItem(m_fixedLobMarkerOutlineItem); delete m_fixedLobMarkerOutlineItem; }
+    QGraphicsScene &lobScene = layerScene(OsdLayer::LobMarker);
+    if (m_fixedLobMarkerOutlineItem) { lobScene.removeItem(m_fixedLobMarkerOutlineItem); delete m_fixedLobMarkerOutlineItem; }
     m_fixedLobMarkerOutlineItem = new QGraphicsPathItem(lobPath);
     // Use a distinct outline pen, perhaps thinner or a standard outline color
     QPen lobOutlinePen = m_reticleOutlinePen; // Or a specific pen for LOB marker outline
@@ -507,10 +709,10 @@ void OsdRenderer::initializeScene()
     m_fixedLobMarkerOutlineItem->setPen(lobOutlinePen);
     m_fixedLobMarkerOutlineItem->setPos(m_width / 2.0, m_height / 2.0); // Position at screen center
     m_fixedLobMarkerOutlineItem->setZValue(Z_ORDER_MAIN - 1); // Just behind main OSD elements, but above background
-    m_scene.addItem(m_fixedLobMarkerOutlineItem);
+    lobScene.addItem(m_fixedLobMarkerOutlineItem);
 
     // Main LOB marker
-    if (m_fixedLobMarkerItem) { m_scene.removeItem(m_fixedLobMarkerItem); delete m_fixedLobMarkerItem; }
+    if (m_fixedLobMarkerItem) { lobScene.removeItem(m_fixedLobMarkerItem); delete m_fixedLobMarkerItem; }
     m_fixedLobMarkerItem = new QGraphicsPathItem(lobPath);
     // Use a distinct but unobtrusive color for the LOB marker itself
     // It should not compete with the main aiming reticle.
@@ -520,22 +722,25 @@ void OsdRenderer::initializeScene()
     m_fixedLobMarkerItem->setPen(m_mainPen);
     m_fixedLobMarkerItem->setPos(m_width / 2.0, m_height / 2.0); // Position at screen center
     m_fixedLobMarkerItem->setZValue(Z_ORDER_MAIN); // Same level as other main OSD elements
-    m_scene.addItem(m_fixedLobMarkerItem);
+    lobScene.addItem(m_fixedLobMarkerItem);
 
 
     // --- Azimuth Indicator ---
     qreal azIndicatorX = m_width - AZ_INDICATOR_X_OFFSET;
     QPointF azCenter(azIndicatorX, AZ_INDICATOR_Y);
 
+    // Static dial parts go to the cached layer, the needle stays in the dynamic scene
+    QGraphicsScene &dialScene = layerScene(OsdLayer::AzimuthDial);
+
     // Outline Circle
-    m_azimuthCircleOutline = m_scene.addEllipse(azCenter.x() - AZ_RADIUS, azCenter.y() - AZ_RADIUS, AZ_RADIUS * 2, AZ_RADIUS * 2, m_shapeOutlinePen, Qt::NoBrush);
+    m_azimuthCircleOutline = dialScene.addEllipse(azCenter.x() - AZ_RADIUS, azCenter.y() - AZ_RADIUS, AZ_RADIUS * 2, AZ_RADIUS * 2, m_shapeOutlinePen, Qt::NoBrush);
     m_azimuthCircleOutline->setZValue(Z_ORDER_OUTLINE);
     // Main Circle
-    m_azimuthCircle = m_scene.addEllipse(azCenter.x() - AZ_RADIUS, azCenter.y() - AZ_RADIUS, AZ_RADIUS * 2, AZ_RADIUS * 2, m_mainPen, Qt::NoBrush);
+    m_azimuthCircle = dialScene.addEllipse(azCenter.x() - AZ_RADIUS, azCenter.y() - AZ_RADIUS, AZ_RADIUS * 2, AZ_RADIUS * 2, m_mainPen, Qt::NoBrush);
     m_azimuthCircle->setZValue(Z_ORDER_MAIN);
 
     // Ticks
-    addTickMarks(m_scene, azCenter, AZ_RADIUS, 0, 360, AZ_TICK_STEP,
+    addTickMarks(dialScene, azCenter, AZ_RADIUS, 0, 360, AZ_TICK_STEP,
                  AZ_TICK_LENGTH_MAJOR, AZ_TICK_LENGTH_MINOR,
                  m_tickMarkMainPen, m_tickMarkOutlinePen,
                  Z_ORDER_MAIN, Z_ORDER_OUTLINE,
@@ -562,14 +767,17 @@ void OsdRenderer::initializeScene()
     QPointF elScaleBasePt(elScaleX, elScaleYBase);
     QPointF elScaleCenterForTicks(elScaleX, elScaleYBase); // Use base as reference for tick calculation
 
+    // Static scale parts go to the cached layer, the indicator stays in the dynamic scene
+    QGraphicsScene &scaleScene = layerScene(OsdLayer::ElevationScale);
+
     // Main Vertical Scale Line
-    m_elevationScaleOutline = m_scene.addLine(QLineF(elScaleTopPt, elScaleBasePt), m_shapeOutlinePen);
+    m_elevationScaleOutline = scaleScene.addLine(QLineF(elScaleTopPt, elScaleBasePt), m_shapeOutlinePen);
     m_elevationScaleOutline->setZValue(Z_ORDER_OUTLINE);
-    m_elevationScale = m_scene.addLine(QLineF(elScaleTopPt, elScaleBasePt), m_mainPen);
+    m_elevationScale = scaleScene.addLine(QLineF(elScaleTopPt, elScaleBasePt), m_mainPen);
     m_elevationScale->setZValue(Z_ORDER_MAIN);
 
     // Ticks (Note: Using scaleHeight as 'radius' for addTickMarks)
-    addTickMarks(m_scene, elScaleCenterForTicks, EL_SCALE_HEIGHT, static_cast<int>(EL_MIN), static_cast<int>(EL_MIN + EL_RANGE + 1), 10, // Tick every 10 degrees
+    addTickMarks(scaleScene, elScaleCenterForTicks, EL_SCALE_HEIGHT, static_cast<int>(EL_MIN), static_cast<int>(EL_MIN + EL_RANGE + 1), 10, // Tick every 10 degrees
                  EL_MAJOR_TICK_LENGTH, EL_TICK_LENGTH  , // Same length for major/minor here
                  m_tickMarkMainPen, m_tickMarkOutlinePen,
                  Z_ORDER_MAIN, Z_ORDER_OUTLINE,
@@ -621,7 +829,7 @@ void OsdRenderer::initializeScene()
 
     if (!m_reticleRootGroup) { // Ensure it's created only once
         m_reticleRootGroup = new QGraphicsItemGroup();
-        m_scene.addItem(m_reticleRootGroup); // Add to scene
+        layerScene(OsdLayer::Reticle).addItem(m_reticleRootGroup); // Cached layer, blitted at the group position
         m_reticleRootGroup->setPos(m_width / 2.0, m_height / 2.0); // Center it
         qDebug() << "m_reticleRootGroup CREATED and centered at" << m_reticleRootGroup->pos();
     } else {
@@ -651,20 +859,8 @@ void OsdRenderer::initializeScene()
 void OsdRenderer::updateStatusText() {
     if (!m_statusTextItem || !m_rateTextItem) return;
 
-    QString status = QString("SYS: %1 %2 %3")
-                         .arg(m_sysCharged ? "CHG" : "---")
-                         .arg(m_sysArmed ? "ARM" : "SAF")
-                         .arg(m_sysReady ? "RDY" : "NRD");
-    m_statusTextItem->setText(status);
-
-    QString rate;
-    switch (m_fireMode) {
-    case FireMode::SingleShot: rate = "RATE: SINGLE SHOT"; break;
-    case FireMode::ShortBurst: rate = "RATE: SHORT BURST"; break;
-    case FireMode::LongBurst: rate = "RATE: LONG BURST"; break;
-    default: rate = "RATE: UNKNOWN"; break;
-    }
-    m_rateTextItem->setText(rate);
+    m_statusTextItem->setText(systemStatusText(m_sysCharged, m_sysArmed, m_sysReady));
+    m_rateTextItem->setText(fireRateText(m_fireMode));
 }
 
 void OsdRenderer::updateAzimuthIndicator() {
@@ -820,163 +1016,15 @@ void OsdRenderer::drawDetectionBox(const YoloDetection& detection) {
     m_detectionTextItems.push_back(text);
 }
 
-void OsdRenderer::createBasicReticle() { // Assuming pens are member variables updated by setupPensAndBrushes
-    // clearReticleDrawingItems(); // This should be called by updateReticleType before calling this
-
-    qreal size = BASIC_RETICLE_SIZE; // Define this constant (e.g., 20.0)
-
-    QPainterPath path;
+void OsdRenderer::createReticle()
+{
     // Paths are defined relative to (0,0) which is the center of m_reticleRootGroup
-    path.moveTo(-size, 0);
-    path.lineTo(size, 0);
-    path.moveTo(0, -size);
-    path.lineTo(0, size);
-
-    // Use member pens setup by setupPensAndBrushes()
-    // Assuming m_mainPen is for reticle lines and m_reticleOutlinePen for their outline
-    addReticlePathWithOutline(path);
-}
-
-void OsdRenderer::createBoxCrosshairReticle() {
-    // clearReticleDrawingItems(); // This is called by the calling function: updateReticleType
-
-    // All coordinates are relative to the center of the reticle group, which is (0,0)
-    qreal lineLen = BOX_CROSSHAIR_LINE_LEN;
-    qreal boxSize = BOX_CROSSHAIR_BOX_SIZE;
-    qreal halfBox = boxSize / 2.0;
-    qreal gap = BOX_CROSSHAIR_GAP;
-
-    // --- Cross lines with gap ---
-    QPainterPath linesPath;
-    // Horizontal line parts
-    linesPath.moveTo(-lineLen, 0);              // Leftmost point of left segment
-    linesPath.lineTo(-halfBox - gap, 0);        // To the left of the box gap
-
-    linesPath.moveTo(halfBox + gap, 0);         // From the right of the box gap
-    linesPath.lineTo(lineLen, 0);               // To the rightmost point of right segment
-
-    // Vertical line parts
-    linesPath.moveTo(0, -lineLen);              // Topmost point of top segment
-    linesPath.lineTo(0, -halfBox - gap);        // To the top of the box gap
-
-    linesPath.moveTo(0, halfBox + gap);         // From the bottom of the box gap
-    linesPath.lineTo(0, lineLen);               // To the bottommost point of bottom segment
-
-    // Add the lines path with its outline
-    addReticlePathWithOutline(linesPath);
-
-
-    // --- Box ---
-    QPainterPath boxPath;
-    // Rectangle centered at (0,0)
-    boxPath.addRect(-halfBox, -halfBox, boxSize, boxSize);
-
-    // Add the box path with its outline
-    addReticlePathWithOutline(boxPath);
-}
-
-void OsdRenderer::createStandardCrosshairReticle() {
-    // clearReticleDrawingItems(); // Called by updateReticleType
-    qreal size = STD_CROSSHAIR_SIZE;
-    qreal gap = STD_CROSSHAIR_GAP;
-
-    QPainterPath path;
-    // Define path around (0,0)
-    path.moveTo(-size, 0); path.lineTo(-gap, 0);
-    path.moveTo(gap, 0); path.lineTo(size, 0);
-    path.moveTo(0, -size); path.lineTo(0, -gap);
-    path.moveTo(0, gap); path.lineTo(0, size);
-
-    addReticlePathWithOutline(path);
-}
-
-void OsdRenderer::createPrecisionCrosshairReticle() {
-    // clearReticleDrawingItems(); // Called by updateReticleType
-
-    qreal size = PRECISION_CROSSHAIR_SIZE;
-    qreal dotRadius = PRECISION_CROSSHAIR_CENTER_DOT_RADIUS;
-    qreal tickLen = PRECISION_CROSSHAIR_TICK_LENGTH;
-    int numTicks = PRECISION_CROSSHAIR_NUM_TICKS;
-    qreal tickSpacing = PRECISION_CROSSHAIR_TICK_SPACING;
-
-    QPainterPath path;
-    // Center dot (relative to group's 0,0)
-    path.addEllipse(0 - dotRadius, 0 - dotRadius, dotRadius * 2, dotRadius * 2);
-
-    // Main lines (relative to group's 0,0)
-    path.moveTo(-size, 0); path.lineTo(size, 0);
-    path.moveTo(0, -size); path.lineTo(0, size);
-
-    // Ticks (relative to group's 0,0)
-    for (int i = 1; i <= numTicks; ++i) {
-        qreal dist = i * tickSpacing;
-        // Horizontal ticks
-        path.moveTo(-dist, -tickLen); path.lineTo(-dist, tickLen);
-        path.moveTo( dist, -tickLen); path.lineTo( dist, tickLen);
-        // Vertical ticks
-        path.moveTo(-tickLen, -dist); path.lineTo(tickLen, -dist);
-        path.moveTo(-tickLen,  dist); path.lineTo(tickLen,  dist);
-    }
-    addReticlePathWithOutline(path);
-}
-
-double OsdRenderer::calculatePixelsPerMil(double horizontalFovDegrees, double screenWidthPixels) {
-    if (horizontalFovDegrees <= 0 || screenWidthPixels <= 0) {
-        return 0.0; // Avoid division by zero or invalid input
-    }
-    // Convert FOV from degrees to radians
-    double horizontalFovRadians = horizontalFovDegrees * M_PI / 180.0;
-    // Calculate the horizontal size visible at 1000 units distance
-    double visibleWidthAt1000 = 2.0 * 1000.0 * tan(horizontalFovRadians / 2.0);
-    // Calculate how many mils fit into this visible width (1 mil subtends 1 unit at 1000 units)
-    double milsAcrossScreen = visibleWidthAt1000;
-    // Calculate pixels per mil
-    return screenWidthPixels / milsAcrossScreen;
-}
-
-void OsdRenderer::createMilDotReticle() { // Assuming pens are member variables
-    // clearReticleDrawingItems(); // Called by updateReticleType
-
-    qreal lineSize = MILDOT_RETICLE_SIZE;     // e.g., 150.0
-    qreal dotRadius = MILDOT_RETICLE_DOT_RADIUS; // e.g., 1.5 (total diameter 3.0)
-    int numDotsPerArm = MILDOT_RETICLE_NUM_DOTS; // e.g., 4
-
-    double pixelsPerMil = calculatePixelsPerMil(m_currentHfov, m_width);
-    if (pixelsPerMil <= 0.1) {
-        qWarning() << "Cannot create MilDot reticle: Invalid FOV/width or pixelsPerMil too small (" << pixelsPerMil << "). Falling back.";
-        createStandardCrosshairReticle(); // Fallback, ensure it also uses member pens
-        return;
-    }
-    qreal dotSpacing = pixelsPerMil; // 1 Mil spacing
-
-    // --- Main Cross Lines (relative to 0,0) ---
-    QPainterPath linesPath;
-    linesPath.moveTo(-lineSize, 0); linesPath.lineTo(lineSize, 0);
-    linesPath.moveTo(0, -lineSize); linesPath.lineTo(0, lineSize);
-    addReticlePathWithOutline(linesPath);
-
-    // --- Dots ---
-    // Pens/Brushes for dots
-    QPen dotMainPen = m_mainPen; // Or Qt::NoPen if fillBrush defines the color entirely
-    QBrush dotFillBrush = m_fillBrush; // This uses m_osdColor
-    QPen dotOutlinePen = m_reticleOutlinePen;
-
-    for (int i = 1; i <= numDotsPerArm; ++i) {
-        qreal distFromCenter = i * dotSpacing;
-        if (distFromCenter > lineSize + dotRadius) break; // Optional: Don't draw dots way past lines
-
-        QPainterPath dotPath; // Path for one set of 4 dots at this mil distance
-
-        // Horizontal dots (left and right of center)
-        dotPath.addEllipse(-distFromCenter - dotRadius, -dotRadius, dotRadius * 2, dotRadius * 2); // Left
-        dotPath.addEllipse( distFromCenter - dotRadius, -dotRadius, dotRadius * 2, dotRadius * 2); // Right
-
-        // Vertical dots (top and bottom of center)
-        dotPath.addEllipse(-dotRadius, -distFromCenter - dotRadius, dotRadius * 2, dotRadius * 2); // Top
-        dotPath.addEllipse(-dotRadius,  distFromCenter - dotRadius, dotRadius * 2, dotRadius * 2); // Bottom
-
-        // Add these 4 dots (as one path) with outline and fill
-        addReticleShapeWithOutline(dotPath);
+    for (const ReticlePart &part : reticleParts(m_reticleType, m_currentHfov, m_width)) {
+        if (part.filled) {
+            addReticleShapeWithOutline(part.path); // Mil-dots: outline plus fill
+        } else {
+            addReticlePathWithOutline(part.path);
+        }
     }
 }
 
@@ -986,20 +1034,7 @@ void OsdRenderer::updateMode(OperationalMode mode) {
     if (m_currentMode == mode && m_modeTextItem && !m_modeTextItem->text().isEmpty()) return;
     m_currentMode = mode;
     if (!m_modeTextItem) return;
-    QString modeStr;
-    switch (mode) {
-    case OperationalMode::Idle: modeStr = "MODE: IDLE"; break;
-    case OperationalMode::Surveillance: modeStr = "MODE: OBS"; break;
-    case OperationalMode::Tracking: modeStr = "MODE: TRACKING"; break;
- 
-    case OperationalMode::Engagement: modeStr = "MODE: ENGAGE"; break;
-    case OperationalMode::EmergencyStop: modeStr = "MODE: EMERGENCY STOP"; break;
-            //case OperationalMode::: modeStr = "MODE: EMERGENCY"; break;
-    
-    //case OperationalMode::eme: modeStr = "MODE: CALIB"; break;
-    default: modeStr = "MODE: UNKNOWN"; break;
-    }
-    m_modeTextItem->setText(modeStr);
+    m_modeTextItem->setText(modeText(mode));
 
     // Make the text highly visible
     if (mode == OperationalMode::EmergencyStop) {
@@ -1017,18 +1052,7 @@ void OsdRenderer::updateMotionMode(MotionMode motionMode) {
     if (m_motionMode == motionMode && m_motionTextItem && !m_motionTextItem->text().isEmpty()) return;
     m_motionMode = motionMode;
     if (!m_motionTextItem) return;
-    QString motionStr;
-    switch (motionMode) {
-        case MotionMode::Manual: motionStr = "MOTION: MAN"; break;
-        case MotionMode::AutoSectorScan: motionStr = "MOTION: SCAN"; break;
-        case MotionMode::TRPScan: motionStr = "MOTION: TRP"; break;
-        case MotionMode::ManualTrack: motionStr = "MOTION: TRACK"; break;
-        case MotionMode::AutoTrack: motionStr = "MOTION: AUTO TRACK"; break;
-        case MotionMode::RadarSlew: motionStr = "MOTION: RADAR"; break;
- 
-        default: motionStr = "MOTION: N/A"; break;
-    }
-    m_motionTextItem->setText(motionStr);
+    m_motionTextItem->setText(motionText(motionMode));
 
 }
 
@@ -1053,8 +1077,7 @@ void OsdRenderer::updateLrfDistance(float distance) {
     // if (qFuzzyCompare(m_lrfDistance, distance)) return;
     m_lrfDistance = distance;
     if (!m_lrfTextItem) return;
-    QString distStr = (distance > 0.1f) ? QString::number(distance, 'f', 1) + " m" : "LRF: --- m";
-    m_lrfTextItem->setText(distStr);
+    m_lrfTextItem->setText(lrfText(distance));
 }
 
 void OsdRenderer::updateSystemStatus(bool charged, bool armed, bool ready) {
@@ -1264,19 +1287,10 @@ void OsdRenderer::updateDetectionBoxes(const std::vector<YoloDetection> &detecti
 
     clearReticleDrawingItems(); // Clear previous items from m_reticleRootGroup
 
-    switch (type) {
-        case ReticleType::Basic:            createBasicReticle(); break;
-        case ReticleType::BoxCrosshair:     createBoxCrosshairReticle(); break;
-        case ReticleType::StandardCrosshair:createStandardCrosshairReticle(); break;
-        case ReticleType::PrecisionCrosshair:createPrecisionCrosshairReticle(); break;
-        case ReticleType::MilDot:           createMilDotReticle(); break;
-        default:
-            qWarning() << "Unknown reticle type:" << static_cast<int>(type);
-            createStandardCrosshairReticle(); // Fallback
-            break;
-    }
+    createReticle();
 
     applyReticlePosition(); // Apply current zeroing/lead offsets to the new reticle group's position
+    invalidateLayer(OsdLayer::Reticle); // Moving the group only changes where the cache is blitted
     m_view.update();        // Request viewport update
     debugReticlePositions(); // <<< CALL DEBUG METHOD
 
@@ -1370,6 +1384,11 @@ void OsdRenderer::updateColorStyle(QColor style) {
 
 
 
+    // Dial, scale and LOB marker pens changed: re-rasterise them on the next frame
+    invalidateLayer(OsdLayer::AzimuthDial);
+    invalidateLayer(OsdLayer::ElevationScale);
+    invalidateLayer(OsdLayer::LobMarker);
+
     // Reticle (Recreate to ensure correct colors/pens)
     // This is simpler than trying to update pens on potentially complex path items
     m_forceReticleRecreation = true;
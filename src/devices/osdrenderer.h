@@ -13,12 +13,17 @@
 #include <QFont>
 #include <QColor>
 #include <QPointF>
+#include <QRectF>
 #include <QString>
 #include <vector>
+#include <array>
 #include <QGraphicsItemGroup> 
+#include "framebufferpool.h"
+#include "osdtypes.h"
 
 // Forward declarations
 class OutlinedTextItem;
+class QPainter;
 
 // Include necessary enums/structs directly or via a dedicated header
 #include "../models/systemstatemodel.h" // Contains OperationalMode, MotionMode, FireMode, ReticleType
@@ -29,7 +34,9 @@ class OutlinedTextItem;
  * @brief Renders On-Screen Display (OSD) elements over a base video image.
  *
  * Manages various graphical elements like status text, indicators (azimuth, elevation),
- * reticles, tracking boxes, and detection boxes within a QGraphicsScene.
+ * reticles, tracking boxes, and detection boxes. Rarely changing elements live in their
+ * own scenes and are composited from cached premultiplied images (see OsdLayer); only
+ * the dynamic scene is rendered every frame.
  */
 class OsdRenderer : public QObject
 {
@@ -41,10 +48,51 @@ public:
 
     /**
      * @brief Renders the current OSD state onto the provided base image.
+     *
+     * In OsdRenderMode::InPlace the overlays are painted into @p baseImage's pixels and the
+     * same buffer is returned, but only when @p baseImage is detached: a frame someone else
+     * still references (the raw network output, the previous frame on screen) is never written.
+     * Shared frames, frames that do not match the OSD size or a directly paintable format fall
+     * back to Composite, and so does OsdRenderMode::Overlay. Move the frame in to hand over
+     * its last reference.
      * @param baseImage The background image (e.g., video frame).
-     * @return A new QImage with the OSD elements drawn on top.
+     * @return A QImage with the OSD elements drawn on top (shared, not copied).
      */
-    QImage renderOsd(const QImage &baseImage);
+    QImage renderOsd(QImage baseImage);
+
+    /**
+     * @brief Lays the OSD out for @p width x @p height frames without rebuilding the scene.
+     *
+     * Edge-anchored elements are moved by the size difference and every cached layer is
+     * re-rasterised; the next apply() re-applies the whole state.
+     */
+    void setFrameSize(int width, int height);
+
+    void setRenderMode(OsdRenderMode mode);
+    OsdRenderMode renderMode() const { return m_renderMode; }
+    quint64 inPlaceFallbackCount() const { return m_inPlaceFallbacks; } // InPlace frames composited because they were shared
+
+    /**
+     * @brief Timing breakdown of the most recent renderOsd() call, for profiling.
+     */
+    const OsdLayerTimings &lastLayerTimings() const { return m_lastTimings; }
+    static const char *layerName(OsdLayer layer);
+
+    /**
+     * @brief Marks every cached layer dirty so it is re-rasterised on the next frame.
+     */
+    void invalidateCachedLayers();
+
+    /**
+     * @brief Applies a complete frame state, touching only the items whose inputs changed.
+     *
+     * Compares @p state against the previously applied one and calls the matching update
+     * slots for changed groups only (in the same order a full update would). A colour
+     * change or the first call re-applies everything.
+     * @return Number of graphics items invalidated by this call.
+     */
+    int apply(const OsdFrameState &state);
+    int lastInvalidatedItemCount() const { return m_lastInvalidatedItems; }
 
 public slots:
     // --- Update Slots for OSD Data ---
@@ -100,10 +148,10 @@ private:
     // --- Initialization and Setup ---
     void initializeScene();
     void setupPensAndBrushes(); // Helper to initialize/update pens based on m_osdColor
-    void createReticle();       // Combined reticle creation logic
+    void createReticle();       // Adds the OsdLayout::reticleParts() of m_reticleType to the reticle group
 
     // --- Helper Functions for Creating Graphics Items ---
-    OutlinedTextItem* createTextItem(const QPointF &pos, qreal zValue); // Helper for text items
+    OutlinedTextItem* createTextItem(const QPointF &pos, qreal zValue, QGraphicsScene *scene = nullptr); // Helper for text items (defaults to the dynamic scene)
     void addReticlePathWithOutline(const QPainterPath& path); // Helper for reticle parts
     void addReticleShapeWithOutline(const QPainterPath &path);
     void addTickMarks(QGraphicsScene& scene, const QPointF& center, qreal radius, int startDeg, int endDeg, int stepDeg, qreal majorTickLen, qreal minorTickLen, const QPen& mainPen, const QPen& outlinePen, qreal zMain, qreal zOutline, std::vector<QGraphicsLineItem*>& mainTicks, std::vector<QGraphicsLineItem*>& outlineTicks, bool isAzimuth = true);
@@ -119,27 +167,44 @@ private:
     void clearDetectionGraphics();
     void drawDetectionBox(const YoloDetection& detection);
 
-    // --- Reticle Creation Functions ---
-    void createBasicReticle();
-    void createBoxCrosshairReticle();
-    void createStandardCrosshairReticle();
-    void createPrecisionCrosshairReticle();
-    void createMilDotReticle();
-
     // --- Utility Functions ---
-    double calculatePixelsPerMil(double horizontalFovDegrees, double screenWidthPixels);
     QPointF convertAngularOffsetToPixelOffset(float offsetAzDegrees, float offsetElDegrees);
     void applyReticleTranslation(); // Applies the pixel offsets to reticle QGraphicsItems
     void clearReticleDrawingItems(); // Clears children from m_reticleRootGroup
     void applyReticlePosition();     // Calculates total offset and moves m_reticleRootGroup
     QPointF convertAngularToPixelOffset(float offsetAzDegrees, float offsetElDegrees); // Helper
 
+    // --- Layer Caching ---
+    QGraphicsScene &layerScene(OsdLayer layer) { return m_layers[static_cast<int>(layer)].scene; }
+    void invalidateLayer(OsdLayer layer) { m_layers[static_cast<int>(layer)].dirty = true; }
+    void rebuildLayer(OsdLayer layer, const QPointF &anchor);
+    void compositeLayer(QPainter &painter, OsdLayer layer, const QPointF &anchor, OsdLayerTimings &timings);
+    bool canRenderInPlace(const QImage &baseImage) const;
+
     // === CORE RENDERING COMPONENTS ===
-    QGraphicsScene m_scene; // The scene holding all OSD items
+    QGraphicsScene m_scene; // Dynamic layer: items rendered every frame
     QGraphicsView m_view;   // The view used for rendering (could be internal)
-    QGraphicsPixmapItem *m_backgroundItem = nullptr; // For the base image
     int m_width;  // Scene/View width
     int m_height; // Scene/View height
+    FrameBufferPool m_outputPool; // Composited output frames, recycled once the display releases them
+    OsdRenderMode m_renderMode = OsdRenderMode::Composite;
+
+    // === CACHED LAYERS ===
+    struct CachedLayer {
+        QGraphicsScene scene; // Items belonging to this layer only
+        QImage image;         // Premultiplied raster of the items' bounding rect
+        QPointF origin;       // Image top-left relative to the anchor it was rasterised at
+        bool dirty = true;
+    };
+    std::array<CachedLayer, static_cast<int>(OsdLayer::Dynamic)> m_layers;
+    OsdLayerTimings m_lastTimings;
+    quint64 m_renderCount = 0;
+    quint64 m_inPlaceFallbacks = 0;
+
+    // === APPLIED FRAME STATE ===
+    OsdFrameState m_appliedState;     // Last state passed to apply()
+    bool m_hasAppliedState = false;   // False until the first apply(), which updates everything
+    int m_lastInvalidatedItems = 0;
 
     // === STYLING AND APPEARANCE ===
     QColor m_osdColor; // Current primary OSD color
@@ -0,0 +1,54 @@
+#include "osdrenderworker.h"
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QMetaType>
+
+#include <utility>
+
+OsdRenderWorker::OsdRenderWorker(int cameraIndex, int width, int height, OsdRenderMode mode, QObject *parent)
+    : QObject(parent)
+    , m_cameraIndex(cameraIndex)
+    , m_renderer(width, height)
+{
+    qRegisterMetaType<OsdFrameState>("OsdFrameState");
+    qRegisterMetaType<FrameTimestamps>("FrameTimestamps");
+    m_renderer.setRenderMode(mode);
+}
+
+void OsdRenderWorker::submit(const OsdFrameState &state, QImage baseImage, const FrameTimestamps &timestamps)
+{
+    m_queueDepth.fetch_add(1, std::memory_order_relaxed);
+    // The functor owns the frame until render() takes it, so no Q_ARG copy is left behind
+    QMetaObject::invokeMethod(this, [this, state, image = std::move(baseImage), timestamps]() mutable {
+        render(state, std::move(image), timestamps);
+    }, Qt::QueuedConnection);
+}
+
+void OsdRenderWorker::render(const OsdFrameState &state, QImage baseImage, FrameTimestamps timestamps)
+{
+    // A newer frame is already queued behind this one: drop this one (and its buffer reference)
+    if (m_queueDepth.fetch_sub(1, std::memory_order_relaxed) > 1) {
+        m_skippedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (baseImage.isNull()) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    // Overlay shows the frame under the OSD, so keep it; otherwise hand the last reference over
+    const bool overlay = (m_renderer.renderMode() == OsdRenderMode::Overlay);
+    const QImage rendered = overlay ? m_renderer.render(baseImage, state)
+                                    : m_renderer.render(std::move(baseImage), state);
+    m_lastRenderNs.store(timer.nsecsElapsed(), std::memory_order_relaxed);
+    m_renderedFrames.fetch_add(1, std::memory_order_relaxed);
+    timestamps.osdDoneNs = FrameTimestamps::nowNs();
+
+    if (overlay) {
+        emit frameRendered(m_cameraIndex, baseImage, rendered, timestamps);
+    } else {
+        emit frameRendered(m_cameraIndex, rendered, QImage(), timestamps);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef OSDRENDERWORKER_H
+#define OSDRENDERWORKER_H
+
+// --- Standard Library Includes ---
+#include <atomic>
+
+// --- Qt Includes ---
+#include <QImage>
+#include <QObject>
+
+// --- Project Includes ---
+#include "framelatency.h"
+#include "osdpainterrenderer.h"
+#include "osdtypes.h"
+
+/**
+ * @brief Renders one camera's OSD on a worker thread.
+ *
+ * Lives on its own QThread (see MainWindow). The GUI thread hands over a frame and its
+ * OsdFrameState with submit() and receives the finished image through frameRendered(),
+ * so the GUI thread only presents. In OsdRenderMode::Overlay the signal carries the
+ * untouched camera frame plus the OSD on its own transparent image. Submissions are queued; when the worker falls behind,
+ * queued frames that already have a newer frame behind them are skipped so only the
+ * latest one is rendered.
+ */
+class OsdRenderWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    OsdRenderWorker(int cameraIndex, int width, int height,
+                    OsdRenderMode mode = OsdRenderMode::Composite, QObject *parent = nullptr);
+
+    /**
+     * @brief Queues @p baseImage for rendering with @p state. Thread-safe.
+     *
+     * Move the frame in: the queued call then holds its only reference, which InPlace
+     * rendering needs.
+     * @param timestamps The frame's timestamp trail, returned with osdDoneNs set.
+     */
+    void submit(const OsdFrameState &state, QImage baseImage, const FrameTimestamps &timestamps);
+
+    int cameraIndex() const { return m_cameraIndex; }
+
+    // --- Statistics (thread-safe) ---
+    int queueDepth() const { return m_queueDepth.load(std::memory_order_relaxed); }
+    quint64 renderedFrames() const { return m_renderedFrames.load(std::memory_order_relaxed); }
+    quint64 skippedFrames() const { return m_skippedFrames.load(std::memory_order_relaxed); }
+    qint64 lastRenderNs() const { return m_lastRenderNs.load(std::memory_order_relaxed); }
+
+signals:
+    /**
+     * @param overlay The OSD alone in Overlay mode, null otherwise (@p image has it drawn in).
+     */
+    void frameRendered(int cameraIndex, const QImage &image, const QImage &overlay, const FrameTimestamps &timestamps);
+
+private:
+    void render(const OsdFrameState &state, QImage baseImage, FrameTimestamps timestamps);
+
+    const int m_cameraIndex;
+    OsdPainterRenderer m_renderer; // Only touched on the worker thread
+
+    std::atomic<int> m_queueDepth{0}; // Submitted but not yet rendered or skipped
+    std::atomic<quint64> m_renderedFrames{0};
+    std::atomic<quint64> m_skippedFrames{0};
+    std::atomic<qint64> m_lastRenderNs{0};
+};
+
+#endif // OSDRENDERWORKER_H
@@ -0,0 +1,122 @@
+#ifndef OSDTYPES_H
+#define OSDTYPES_H
+
+// --- Standard Library Includes ---
+#include <array>
+#include <vector>
+
+// --- Qt Includes ---
+#include <QColor>
+#include <QImage>
+#include <QMetaType>
+#include <QPoint>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+
+// --- Project Includes ---
+#include "../models/systemstatemodel.h" // OperationalMode, MotionMode, FireMode, ReticleType, TrackingPhase
+#include "../utils/inference.h"         // YoloDetection
+
+// Types shared by the scene-based OsdRenderer and the scene-free OsdPainterRenderer.
+
+/**
+ * @brief Compositing layers of the OSD, in back-to-front order.
+ *
+ * All but Dynamic are rasterised once into cached images and only redrawn when
+ * their inputs (colour, reticle type, FOV) change.
+ */
+enum class OsdLayer {
+    Reticle = 0,    // Reticle for the current type/colour/FOV, blitted at the aimpoint
+    AzimuthDial,    // Dial circle, ticks and cardinal labels
+    ElevationScale, // Scale line, ticks and labels
+    LobMarker,      // Fixed line-of-bore cross at screen centre
+    Dynamic,        // Per-frame items (text, needle, indicators, tracking, detections)
+    Count
+};
+
+/**
+ * @brief Per-layer render time breakdown of the last rendered frame.
+ */
+struct OsdLayerTimings {
+    qint64 baseImageNs = 0;  // Video frame blit
+    qint64 insetNs = 0;      // Picture-in-picture inset blit (0 without an inset)
+    std::array<qint64, static_cast<int>(OsdLayer::Count)> layerNs{}; // Blit (+ rebuild) per layer
+    std::array<bool, static_cast<int>(OsdLayer::Count)> rebuilt{};   // True if the cache was re-rasterised
+    qint64 totalNs = 0;
+};
+
+/**
+ * @brief How the OSD renderers produce their output frame.
+ */
+enum class OsdRenderMode {
+    Composite, // Copy the frame into a pooled output image, then draw the overlays on the copy
+    InPlace,   // Draw the overlays into the frame itself when the renderer holds its only reference, else Composite
+    Overlay    // Draw the overlays alone on a transparent pooled image; the display composites it
+};
+
+/**
+ * @brief Everything the OSD shows for one frame.
+ *
+ * Applied in one call via OsdRenderer::apply(), or drawn directly by OsdPainterRenderer.
+ *
+ * Mirrors the arguments of the individual update slots. Detections should be left empty
+ * when detection did not run for the frame.
+ */
+struct OsdFrameState {
+    // Status text
+    QString cameraType = "DAY";
+    OperationalMode mode = OperationalMode::Idle;
+    MotionMode motionMode = MotionMode::Manual;
+    bool stabEnabled = false;
+    float lrfDistance = 0.0f;
+    bool sysCharged = false;
+    bool sysArmed = false;
+    bool sysReady = false;
+    FireMode fireMode = FireMode::SingleShot;
+    float fov = 0.0f;
+    double speed = 0.0;
+    QString leadStatusText;
+    QString scanName;
+
+    // Indicators
+    float azimuth = 0.0f;
+    float elevation = 0.0f;
+    QColor colorStyle = QColor(70, 226, 165);
+
+    // Tracking and detection
+    QRectF trackingBox;
+    TrackingPhase trackingPhase = TrackingPhase::Off;
+    bool hasValidLock = false;
+    QRectF acquisitionBox;
+    QRectF trackedBox;
+    std::vector<YoloDetection> detections;
+
+    // Zeroing, windage and zones
+    bool zeroingModeActive = false;
+    bool zeroingApplied = false;
+    float zeroingAzOffset = 0.0f;
+    float zeroingElOffset = 0.0f;
+    bool windageModeActive = false;
+    bool windageApplied = false;
+    float windageSpeedKnots = 0.0f;
+    bool inNoFireZone = false;
+    bool inNoTraverseZoneAtLimit = false;
+
+    // Reticle and lead angle
+    ReticleType reticleType = ReticleType::BoxCrosshair;
+    QPointF reticlePosition; // Final aimpoint in pixels (already includes zeroing and lead)
+    bool leadAngleActive = false;
+    LeadAngleStatus leadAngleStatus = LeadAngleStatus::Off;
+    float leadAngleOffsetAz = 0.0f;
+    float leadAngleOffsetEl = 0.0f;
+
+    // Picture-in-picture: the inactive camera, decimated by its capture thread (null: no inset)
+    QImage pipInset;    // Drawn 1:1, shared with the camera device
+    QPoint pipPosition; // Top-left in frame pixels
+    QString pipLabel;   // Camera type of the inset
+};
+
+Q_DECLARE_METATYPE(OsdFrameState)
+
+#endif // OSDTYPES_H
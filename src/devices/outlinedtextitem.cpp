@@ -1,8 +1,24 @@
 #include "outlinedtextitem.h"
+#include "glyphoutlinecache.h"   // Shared glyph outlines
 #include <QPainter>              // For drawing operations
 #include <QPainterPath>          // For creating text path
 #include <QPainterPathStroker>   // For creating outline shape
 #include <Qt>                    // For Qt::SolidLine, Qt::RoundCap, etc.
+#include <cmath>                 // For std::floor
+
+namespace {
+// Items larger than this are drawn from the path instead of a cached raster
+constexpr int MAX_RASTER_PIXELS = 512 * 128;
+
+bool isIntegral(qreal value)
+{
+    return qFuzzyIsNull(value - std::floor(value + 0.5));
+}
+} // namespace
+
+std::atomic<quint64> OutlinedTextItem::s_pathRebuilds{0};
+std::atomic<quint64> OutlinedTextItem::s_rasterHits{0};
+std::atomic<quint64> OutlinedTextItem::s_rasterRebuilds{0};
 
 // --- Constructors ---
 
@@ -34,6 +50,7 @@ void OutlinedTextItem::setOutlinePen(const QPen &pen) {
         // This is crucial if the pen width affects the bounding box
         prepareGeometryChange();
         m_outlinePen = pen;
+        m_rasterValid = false;
         update(); // Schedule a repaint to reflect the change
     }
 }
@@ -42,6 +59,7 @@ void OutlinedTextItem::setFillBrush(const QBrush &brush) {
     // Only update if the brush has actually changed
     if (m_fillBrush != brush) {
         m_fillBrush = brush;
+        m_rasterValid = false;
         update(); // Schedule a repaint
     }
 }
@@ -54,21 +72,36 @@ void OutlinedTextItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
+    ensureTextPath();
+    if (m_textPath.isEmpty()) {
+        return;
+    }
+
+    // With a pure integer translation the cached raster is pixel-identical to drawing the path
+    const QTransform &transform = painter->worldTransform();
+    if (transform.type() <= QTransform::TxTranslate && isIntegral(transform.dx()) && isIntegral(transform.dy())) {
+        ensureRaster();
+        if (!m_raster.isNull()) {
+            painter->drawImage(m_rasterOffset, m_raster);
+            s_rasterHits.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
     // Enable antialiasing for smoother text rendering
     painter->setRenderHint(QPainter::Antialiasing);
+    drawOutlinedPath(painter);
+}
 
-    // Create a painter path from the text
-    // Using (0, 0) as the origin because the item's position handles the placement
-    QPainterPath path;
-    path.addText(0, 0, font(), text());
-
+void OutlinedTextItem::drawOutlinedPath(QPainter *painter) const
+{
     // 1. Draw the Outline:
     // Set the painter's pen to the outline pen
     painter->setPen(m_outlinePen);
     // Ensure the path is not filled when drawing the outline
     painter->setBrush(Qt::NoBrush);
     // Draw the outline
-    painter->drawPath(path);
+    painter->drawPath(m_textPath);
 
     // 2. Draw the Fill:
     // Ensure the path is not stroked when drawing the fill
@@ -76,7 +109,54 @@ void OutlinedTextItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
     // Set the painter's brush to the fill brush
     painter->setBrush(m_fillBrush);
     // Draw the filled text
-    painter->drawPath(path);
+    painter->drawPath(m_textPath);
+}
+
+void OutlinedTextItem::ensureTextPath()
+{
+    // QGraphicsSimpleTextItem::setText()/setFont() are not virtual, so compare against the inputs
+    const QString currentText = text();
+    const QFont currentFont = font();
+    if (m_pathValid && m_pathText == currentText && m_pathFont == currentFont) {
+        return;
+    }
+
+    // Using (0, 0) as the origin because the item's position handles the placement
+    m_textPath = GlyphOutlineCache::instance().textPath(currentFont, currentText);
+    m_pathText = currentText;
+    m_pathFont = currentFont;
+    m_pathValid = true;
+    m_rasterValid = false;
+    s_pathRebuilds.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OutlinedTextItem::ensureRaster()
+{
+    if (m_rasterValid) {
+        return;
+    }
+    m_rasterValid = true;
+
+    qreal penWidth = (m_outlinePen.style() == Qt::NoPen) ? 0.0 : m_outlinePen.widthF();
+    qreal adjust = penWidth / 2.0 + 1.0; // One extra pixel for antialiasing
+    QRect rasterRect = m_textPath.boundingRect().adjusted(-adjust, -adjust, adjust, adjust).toAlignedRect();
+    if (rasterRect.isEmpty() || rasterRect.width() * rasterRect.height() > MAX_RASTER_PIXELS) {
+        m_raster = QImage();
+        return;
+    }
+
+    if (m_raster.size() != rasterRect.size()) {
+        m_raster = QImage(rasterRect.size(), QImage::Format_ARGB32_Premultiplied);
+    }
+    m_raster.fill(Qt::transparent);
+    m_rasterOffset = rasterRect.topLeft();
+
+    QPainter rasterPainter(&m_raster);
+    rasterPainter.setRenderHint(QPainter::Antialiasing);
+    rasterPainter.translate(-m_rasterOffset);
+    drawOutlinedPath(&rasterPainter);
+    rasterPainter.end();
+    s_rasterRebuilds.fetch_add(1, std::memory_order_relaxed);
 }
 
 QRectF OutlinedTextItem::boundingRect() const {
@@ -10,6 +10,8 @@
 #include <QWidget>               // For paint method
 #include <QPainterPath>          // For shape calculation
 #include <QPainterPathStroker>   // For shape calculation
+#include <QImage>                // For the raster cache
+#include <atomic>                // For cache statistics
 
 // Forward declaration if needed, but seems self-contained
 
@@ -18,6 +20,10 @@
  *
  * This class allows setting a separate pen for the outline and a brush for the fill,
  * providing a common visual effect for OSD elements.
+ *
+ * The text path is assembled from GlyphOutlineCache and only rebuilt when the text or
+ * font changes. When painted with a pure integer translation (the OSD case), the item
+ * blits a cached raster of the outlined text instead of stroking and filling the path.
  */
 class OutlinedTextItem : public QGraphicsSimpleTextItem
 {
@@ -47,9 +53,33 @@ public:
      */
     QPainterPath shape() const override;
 
+    // --- Cache statistics (all items) ---
+    static quint64 pathRebuildCount() { return s_pathRebuilds.load(std::memory_order_relaxed); }
+    static quint64 rasterHitCount() { return s_rasterHits.load(std::memory_order_relaxed); }
+    static quint64 rasterRebuildCount() { return s_rasterRebuilds.load(std::memory_order_relaxed); }
+
 private:
+    void ensureTextPath();
+    void ensureRaster();
+    void drawOutlinedPath(QPainter *painter) const;
+
     QPen m_outlinePen;  // Pen used for drawing the text outline
     QBrush m_fillBrush; // Brush used for filling the text
+
+    // Path cache, keyed by the text/font it was built from
+    QPainterPath m_textPath;
+    QString m_pathText;
+    QFont m_pathFont;
+    bool m_pathValid = false;
+
+    // Raster cache of the outlined, filled path (premultiplied)
+    QImage m_raster;
+    QPoint m_rasterOffset; // Raster top-left in item coordinates
+    bool m_rasterValid = false;
+
+    static std::atomic<quint64> s_pathRebuilds;
+    static std::atomic<quint64> s_rasterHits;
+    static std::atomic<quint64> s_rasterRebuilds;
 };
 
 #endif // OUTLINEDTEXTITEM_OPTIMIZED_H
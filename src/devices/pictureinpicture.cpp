@@ -0,0 +1,82 @@
+#include "pictureinpicture.h"
+
+#include <QStringList>
+#include <QtGlobal>
+
+namespace {
+// Distance of the inset to the frame edges: clear of the top and bottom text rows
+constexpr int INSET_MARGIN_X = 10;
+constexpr int INSET_MARGIN_Y = 40;
+constexpr int MIN_SIZE_PERCENT = 10;
+constexpr int MAX_SIZE_PERCENT = 50;
+constexpr int MAX_REFRESH_HZ = 30;
+
+struct CornerName {
+    const char *name;
+    PictureInPictureCorner corner;
+};
+
+const CornerName CORNER_NAMES[] = {
+    {"top-left", PictureInPictureCorner::TopLeft},
+    {"top-right", PictureInPictureCorner::TopRight},
+    {"bottom-left", PictureInPictureCorner::BottomLeft},
+    {"bottom-right", PictureInPictureCorner::BottomRight},
+};
+} // namespace
+
+bool PictureInPictureConfig::fromSpec(const QString &spec, PictureInPictureConfig &config, QString *errorMessage)
+{
+    PictureInPictureConfig parsed = config;
+    parsed.enabled = true;
+    const QStringList fields = spec.split(',', Qt::SkipEmptyParts);
+    for (const QString &field : fields) {
+        bool ok = false;
+        if (field.startsWith(QLatin1String("size="))) {
+            const int percent = field.mid(5).toInt(&ok);
+            ok = ok && percent >= MIN_SIZE_PERCENT && percent <= MAX_SIZE_PERCENT;
+            parsed.sizePercent = percent;
+        } else if (field.startsWith(QLatin1String("fps="))) {
+            const int rate = field.mid(4).toInt(&ok);
+            ok = ok && rate > 0 && rate <= MAX_REFRESH_HZ;
+            parsed.refreshHz = rate;
+        } else {
+            for (const CornerName &corner : CORNER_NAMES) {
+                if (field == QLatin1String(corner.name)) {
+                    parsed.corner = corner.corner;
+                    ok = true;
+                }
+            }
+        }
+        if (!ok) {
+            if (errorMessage) *errorMessage = QString("Picture-in-picture: bad option '%1'").arg(field);
+            return false;
+        }
+    }
+    config = parsed;
+    return true;
+}
+
+int PictureInPictureConfig::decimationStep() const
+{
+    return qMax(2, qRound(100.0 / qMax(1, sizePercent)));
+}
+
+QPoint PictureInPictureConfig::insetPosition(const QSize &frameSize, const QSize &insetSize) const
+{
+    const bool right = (corner == PictureInPictureCorner::TopRight || corner == PictureInPictureCorner::BottomRight);
+    const bool bottom = (corner == PictureInPictureCorner::BottomLeft || corner == PictureInPictureCorner::BottomRight);
+    const int x = right ? frameSize.width() - insetSize.width() - INSET_MARGIN_X : INSET_MARGIN_X;
+    const int y = bottom ? frameSize.height() - insetSize.height() - INSET_MARGIN_Y : INSET_MARGIN_Y;
+    return QPoint(qMax(0, x), qMax(0, y));
+}
+
+QString PictureInPictureConfig::toSpec() const
+{
+    QString cornerName;
+    for (const CornerName &entry : CORNER_NAMES) {
+        if (entry.corner == corner) {
+            cornerName = QLatin1String(entry.name);
+        }
+    }
+    return QString("%1,size=%2,fps=%3").arg(cornerName).arg(sizePercent).arg(refreshHz);
+}
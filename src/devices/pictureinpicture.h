@@ -0,0 +1,58 @@
+#ifndef PICTUREINPICTURE_H
+#define PICTUREINPICTURE_H
+
+// --- Qt Includes ---
+#include <QPoint>
+#include <QSize>
+#include <QString>
+
+/**
+ * @brief Corner of the active view the picture-in-picture inset sits in.
+ */
+enum class PictureInPictureCorner {
+    TopLeft,
+    TopRight,
+    BottomLeft,
+    BottomRight
+};
+
+/**
+ * @brief Settings of the picture-in-picture inset showing the inactive camera.
+ *
+ * The inset is decimated straight from the inactive camera's raw YUY2 frame on its
+ * capture thread (see CameraVideoStreamDevice::setInset()), so it costs neither a
+ * full-size conversion nor a scale on the GUI thread. Decimation keeps every n-th
+ * pixel, so the inset size is the frame size divided by a whole number.
+ */
+struct PictureInPictureConfig {
+    bool enabled = false;
+    PictureInPictureCorner corner = PictureInPictureCorner::BottomLeft; // Clear of the status texts
+    int sizePercent = 25;  // Inset width in percent of the frame width, rounded to 100 / n
+    int refreshHz = 5;     // Insets produced per second
+
+    /**
+     * @brief Parses "<corner>[,size=<percent>][,fps=<rate>]" or "" for the defaults.
+     *
+     * Corner is top-left, top-right, bottom-left or bottom-right; size is 10 to 50.
+     * @return False (and @p config untouched) on a malformed spec.
+     */
+    static bool fromSpec(const QString &spec, PictureInPictureConfig &config, QString *errorMessage = nullptr);
+
+    /**
+     * @brief Decimation step giving the configured inset size (at least 2).
+     */
+    int decimationStep() const;
+    int refreshIntervalMs() const { return refreshHz > 0 ? 1000 / refreshHz : 0; }
+
+    /**
+     * @brief Top-left of an @p insetSize inset in a @p frameSize view.
+     */
+    QPoint insetPosition(const QSize &frameSize, const QSize &insetSize) const;
+
+    /**
+     * @brief The spec accepted by fromSpec(), for logs.
+     */
+    QString toSpec() const;
+};
+
+#endif // PICTUREINPICTURE_H
@@ -0,0 +1,265 @@
+#include "videorecorder.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+namespace {
+// Encoded data the writer may fall behind by before units are dropped (~60 s at 2 Mbit/s)
+constexpr qint64 MAX_PENDING_BYTES = 16LL * 1024 * 1024;
+constexpr qint64 NS_PER_SECOND = 1000000000LL;
+} // namespace
+
+VideoRecorder::VideoRecorder(int cameraIndex, const VideoRecorderConfig &config, QObject *parent)
+    : QThread(parent),
+    m_cameraIndex(cameraIndex),
+    m_config(config),
+    m_cameraDirectory(QDir(config.directory).filePath(QString("cam%1").arg(cameraIndex)))
+{
+    m_reportTimer.start();
+}
+
+VideoRecorder::~VideoRecorder()
+{
+    stop();
+    wait();
+}
+
+void VideoRecorder::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stopRequested = true;
+    m_wake.wakeOne();
+}
+
+void VideoRecorder::pushAccessUnit(const QByteArray &bytes, qint64 ptsNs, bool keyFrame)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_stopRequested) {
+        return;
+    }
+    // After a drop the stream only becomes decodable again at the next key frame
+    if (m_pendingBytes + bytes.size() > MAX_PENDING_BYTES || (m_dropUntilKeyFrame && !keyFrame)) {
+        m_dropUntilKeyFrame = true;
+        m_droppedUnits.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_dropUntilKeyFrame = false;
+    m_pending.push_back(AccessUnit{bytes, ptsNs, keyFrame});
+    m_pendingBytes += bytes.size();
+    m_wake.wakeOne();
+}
+
+void VideoRecorder::triggerEvent(const QString &reason)
+{
+    QMutexLocker locker(&m_mutex);
+    m_eventReasons.append(reason);
+    m_wake.wakeOne();
+}
+
+QString VideoRecorder::takeReport()
+{
+    const qint64 windowNs = m_reportTimer.nsecsElapsed();
+    m_reportTimer.restart();
+    const quint64 bytes = bytesWritten();
+    const qint64 writeNs = m_writeNsTotal.load(std::memory_order_relaxed);
+    const double windowBytes = static_cast<double>(bytes - m_reportBytes);
+    const double throughputMBps = windowNs > 0 ? windowBytes / (1024.0 * 1024.0) / (windowNs / 1.0e9) : 0.0;
+    const double writeBusyPercent = windowNs > 0 ? 100.0 * (writeNs - m_reportWriteNs) / windowNs : 0.0;
+    m_reportBytes = bytes;
+    m_reportWriteNs = writeNs;
+    m_diskThroughputMBps.store(throughputMBps, std::memory_order_relaxed);
+
+    return QString("disk %1 MB/s (write busy %2 %), %3 MB total, %4 segments, %5 events, %6 units dropped")
+        .arg(throughputMBps, 0, 'f', 2)
+        .arg(writeBusyPercent, 0, 'f', 1)
+        .arg(bytes / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(segmentsWritten())
+        .arg(eventsWritten())
+        .arg(droppedUnits());
+}
+
+void VideoRecorder::run()
+{
+    if (!QDir().mkpath(m_cameraDirectory)) {
+        qCritical() << "Cam" << m_cameraIndex << ": Cannot create recording directory" << m_cameraDirectory;
+        return;
+    }
+    // Segments left by an earlier run stay part of the ring (names sort by time)
+    const QFileInfoList existing = QDir(m_cameraDirectory).entryInfoList(QStringList() << "seg_*.h264",
+                                                                        QDir::Files, QDir::Name);
+    for (const QFileInfo &info : existing) {
+        m_segments.push_back(SegmentEntry{info.absoluteFilePath(), info.size()});
+        m_segmentRingBytes += info.size();
+    }
+    enforceDiskLimit();
+    qInfo() << "Cam" << m_cameraIndex << ": Recording to" << m_cameraDirectory << "-" << m_config.segmentSeconds
+            << "s segments, ring" << m_config.maxDiskBytes / (1024 * 1024) << "MB, pre-event"
+            << m_config.preEventSeconds << "s";
+
+    while (true) {
+        std::deque<AccessUnit> batch;
+        QStringList reasons;
+        bool stopping = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_pending.empty() && m_eventReasons.isEmpty() && !m_stopRequested) {
+                m_wake.wait(&m_mutex);
+            }
+            batch.swap(m_pending);
+            m_pendingBytes = 0;
+            reasons.swap(m_eventReasons);
+            stopping = m_stopRequested;
+        }
+        for (const QString &reason : reasons) {
+            startEvent(reason);
+        }
+        for (const AccessUnit &unit : batch) {
+            writeUnit(unit);
+        }
+        if (stopping) {
+            break;
+        }
+    }
+
+    finishEvent();
+    closeSegment();
+    qInfo() << "Cam" << m_cameraIndex << ": Recorder stopped," << bytesWritten() / (1024 * 1024) << "MB in"
+            << segmentsWritten() << "segments and" << eventsWritten() << "events," << droppedUnits() << "units dropped";
+}
+
+void VideoRecorder::writeUnit(const AccessUnit &unit)
+{
+    // Pre-event buffer: drop whole GOPs from the front while the rest still covers the window
+    m_preEvent.push_back(unit);
+    const qint64 preEventNs = m_config.preEventSeconds * NS_PER_SECOND;
+    while (true) {
+        auto nextKey = m_preEvent.begin() + 1;
+        while (nextKey != m_preEvent.end() && !nextKey->keyFrame) {
+            ++nextKey;
+        }
+        if (nextKey == m_preEvent.end() || unit.ptsNs - nextKey->ptsNs < preEventNs) {
+            break;
+        }
+        m_preEvent.erase(m_preEvent.begin(), nextKey);
+    }
+
+    // Segment ring: rotate on the first key frame past the segment length
+    if (unit.keyFrame && (!m_segmentFile.isOpen() ||
+                          unit.ptsNs - m_segmentStartPtsNs >= m_config.segmentSeconds * NS_PER_SECOND)) {
+        closeSegment();
+        openSegment();
+        m_segmentStartPtsNs = unit.ptsNs;
+    }
+    if (m_segmentFile.isOpen()) {
+        writeTo(m_segmentFile, unit.bytes);
+    }
+
+    if (m_eventFile.isOpen()) {
+        if (m_eventEndPtsNs < 0) {
+            m_eventEndPtsNs = unit.ptsNs + m_config.postEventSeconds * NS_PER_SECOND;
+        }
+        writeTo(m_eventFile, unit.bytes);
+        if (unit.ptsNs >= m_eventEndPtsNs) {
+            finishEvent();
+        }
+    }
+}
+
+void VideoRecorder::startEvent(const QString &reason)
+{
+    const qint64 lastPtsNs = m_preEvent.empty() ? -1 : m_preEvent.back().ptsNs;
+    if (m_eventFile.isOpen()) {
+        // Another trigger during an event extends the clip
+        if (lastPtsNs >= 0) {
+            m_eventEndPtsNs = lastPtsNs + m_config.postEventSeconds * NS_PER_SECOND;
+        }
+        qInfo() << "Cam" << m_cameraIndex << ": Recording event extended (" << reason << ")";
+        return;
+    }
+
+    QString safeReason = reason;
+    safeReason.replace(QRegularExpression("[^A-Za-z0-9_-]"), "_");
+    m_eventFile.setFileName(timestampedPath("event_", safeReason));
+    if (!m_eventFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cam" << m_cameraIndex << ": Cannot open event clip" << m_eventFile.fileName()
+                   << ":" << m_eventFile.errorString();
+        return;
+    }
+    for (const AccessUnit &unit : m_preEvent) {
+        writeTo(m_eventFile, unit.bytes);
+    }
+    m_eventEndPtsNs = lastPtsNs >= 0 ? lastPtsNs + m_config.postEventSeconds * NS_PER_SECOND : -1;
+    qInfo() << "Cam" << m_cameraIndex << ": Recording event (" << reason << ") to" << m_eventFile.fileName()
+            << "with" << (m_preEvent.empty() ? 0.0 : (lastPtsNs - m_preEvent.front().ptsNs) / 1.0e9) << "s pre-event";
+}
+
+void VideoRecorder::finishEvent()
+{
+    if (!m_eventFile.isOpen()) {
+        return;
+    }
+    const QString path = m_eventFile.fileName();
+    m_eventFile.close();
+    m_eventEndPtsNs = -1;
+    m_eventsWritten.fetch_add(1, std::memory_order_relaxed);
+    qInfo() << "Cam" << m_cameraIndex << ": Event clip complete:" << path;
+    emit eventClipWritten(m_cameraIndex, path);
+}
+
+void VideoRecorder::openSegment()
+{
+    m_segmentFile.setFileName(timestampedPath("seg_"));
+    if (!m_segmentFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cam" << m_cameraIndex << ": Cannot open segment" << m_segmentFile.fileName()
+                   << ":" << m_segmentFile.errorString();
+    }
+}
+
+void VideoRecorder::closeSegment()
+{
+    if (!m_segmentFile.isOpen()) {
+        return;
+    }
+    const qint64 bytes = m_segmentFile.size();
+    m_segmentFile.close();
+    m_segments.push_back(SegmentEntry{m_segmentFile.fileName(), bytes});
+    m_segmentRingBytes += bytes;
+    m_segmentsWritten.fetch_add(1, std::memory_order_relaxed);
+    enforceDiskLimit();
+}
+
+void VideoRecorder::enforceDiskLimit()
+{
+    while (m_segmentRingBytes > m_config.maxDiskBytes && !m_segments.empty()) {
+        const SegmentEntry oldest = m_segments.front();
+        m_segments.pop_front();
+        m_segmentRingBytes -= oldest.bytes;
+        if (!QFile::remove(oldest.path)) {
+            qWarning() << "Cam" << m_cameraIndex << ": Cannot remove old segment" << oldest.path;
+        }
+    }
+}
+
+void VideoRecorder::writeTo(QFile &file, const QByteArray &bytes)
+{
+    QElapsedTimer timer;
+    timer.start();
+    if (file.write(bytes) != bytes.size()) {
+        qWarning() << "Cam" << m_cameraIndex << ": Write to" << file.fileName() << "failed:" << file.errorString();
+        return;
+    }
+    m_writeNsTotal.fetch_add(timer.nsecsElapsed(), std::memory_order_relaxed);
+    m_bytesWritten.fetch_add(static_cast<quint64>(bytes.size()), std::memory_order_relaxed);
+}
+
+QString VideoRecorder::timestampedPath(const QString &prefix, const QString &suffix) const
+{
+    QString name = prefix + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss_zzz");
+    if (!suffix.isEmpty()) {
+        name += "_" + suffix;
+    }
+    return QDir(m_cameraDirectory).filePath(name + ".h264");
+}
@@ -0,0 +1,152 @@
+#ifndef VIDEORECORDER_H
+#define VIDEORECORDER_H
+
+// --- Standard Library Includes ---
+#include <atomic>
+#include <deque>
+
+// --- Qt Includes ---
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+
+/**
+ * @brief Settings of the rolling recorder of one camera.
+ */
+struct VideoRecorderConfig {
+    QString directory;                          // Root directory; empty disables recording
+    int segmentSeconds = 60;                    // Length of one on-disk ring segment
+    qint64 maxDiskBytes = 2LL * 1024 * 1024 * 1024; // Segment ring size per camera (event clips are kept)
+    int preEventSeconds = 10;                   // Held in memory, written ahead of an event
+    int postEventSeconds = 10;                  // Written after the last trigger of an event
+    int bitrateKbps = 2000;                     // Encoder target bitrate
+
+    bool enabled() const { return !directory.isEmpty(); }
+};
+
+/**
+ * @brief Writes the encoded H.264 stream of one camera to disk on its own thread.
+ *
+ * The encoder branch of the camera pipeline hands over access units (Annex B, parameter
+ * sets repeated on every key frame) with pushAccessUnit(), which only queues them: when
+ * the writer falls behind by more than a bounded backlog, units are dropped up to the next
+ * key frame instead of blocking the encoder.
+ *
+ * The writer keeps two things:
+ * - a ring of fixed-length segments in <directory>/cam<N>/seg_*.h264, each starting on a
+ *   key frame, oldest deleted once the ring exceeds maxDiskBytes;
+ * - an in-memory pre-event buffer of at least preEventSeconds, starting on a key frame.
+ *   triggerEvent() writes it to event_*.h264 and keeps appending until postEventSeconds
+ *   after the last trigger. Event clips are never rotated out.
+ *
+ * Every file is a playable H.264 elementary stream.
+ */
+class VideoRecorder : public QThread
+{
+    Q_OBJECT
+
+public:
+    VideoRecorder(int cameraIndex, const VideoRecorderConfig &config, QObject *parent = nullptr);
+    ~VideoRecorder() override;
+
+    const VideoRecorderConfig &config() const { return m_config; }
+
+    /**
+     * @brief Stops the writer once the queued units are on disk.
+     */
+    void stop();
+
+    /**
+     * @brief Queues one access unit; called from the encoder streaming thread, never blocks on disk.
+     * @param ptsNs Capture time on the pipeline clock (monotonic across restarts), used for
+     *        segment, pre-event and post-event lengths.
+     */
+    void pushAccessUnit(const QByteArray &bytes, qint64 ptsNs, bool keyFrame);
+
+    /**
+     * @brief Saves the pre-event buffer and the next postEventSeconds as an event clip. Thread-safe.
+     */
+    void triggerEvent(const QString &reason);
+
+    // --- Statistics (thread-safe) ---
+    quint64 bytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); }
+    quint64 droppedUnits() const { return m_droppedUnits.load(std::memory_order_relaxed); } // Writer backlog full
+    quint64 segmentsWritten() const { return m_segmentsWritten.load(std::memory_order_relaxed); }
+    quint64 eventsWritten() const { return m_eventsWritten.load(std::memory_order_relaxed); }
+    double diskThroughputMBps() const { return m_diskThroughputMBps.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Disk throughput and write time since the previous call, plus the totals above.
+     */
+    QString takeReport();
+
+signals:
+    /**
+     * @brief Emitted from the writer thread when an event clip is complete.
+     */
+    void eventClipWritten(int cameraIndex, const QString &path);
+
+protected:
+    void run() override;
+
+private:
+    struct AccessUnit {
+        QByteArray bytes;
+        qint64 ptsNs = 0;
+        bool keyFrame = false;
+    };
+
+    // Writer thread
+    void writeUnit(const AccessUnit &unit);
+    void startEvent(const QString &reason);
+    void finishEvent();
+    void openSegment();
+    void closeSegment();
+    void enforceDiskLimit();
+    void writeTo(QFile &file, const QByteArray &bytes);
+    QString timestampedPath(const QString &prefix, const QString &suffix = QString()) const;
+
+    const int m_cameraIndex;
+    const VideoRecorderConfig m_config;
+    QString m_cameraDirectory;
+
+    // Handoff from the encoder thread
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    std::deque<AccessUnit> m_pending;
+    qint64 m_pendingBytes = 0;
+    bool m_dropUntilKeyFrame = false;
+    QStringList m_eventReasons;
+    bool m_stopRequested = false;
+
+    // Writer thread state
+    std::deque<AccessUnit> m_preEvent;
+    QFile m_segmentFile;
+    qint64 m_segmentStartPtsNs = 0;
+    struct SegmentEntry {
+        QString path;
+        qint64 bytes;
+    };
+    std::deque<SegmentEntry> m_segments; // Closed segments, oldest first
+    qint64 m_segmentRingBytes = 0;
+    QFile m_eventFile;
+    qint64 m_eventEndPtsNs = -1;         // -1: no unit seen since the trigger yet
+
+    // Statistics
+    std::atomic<quint64> m_bytesWritten{0};
+    std::atomic<quint64> m_droppedUnits{0};
+    std::atomic<quint64> m_segmentsWritten{0};
+    std::atomic<quint64> m_eventsWritten{0};
+    std::atomic<qint64> m_writeNsTotal{0};
+    std::atomic<double> m_diskThroughputMBps{0.0};
+    QElapsedTimer m_reportTimer;         // takeReport() caller only
+    quint64 m_reportBytes = 0;
+    qint64 m_reportWriteNs = 0;
+};
+
+#endif // VIDEORECORDER_H
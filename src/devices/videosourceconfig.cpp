@@ -0,0 +1,131 @@
+#include "videosourceconfig.h"
+
+namespace {
+struct SourceTypeName {
+    VideoSourceType type;
+    const char *name;
+};
+
+constexpr SourceTypeName SOURCE_TYPE_NAMES[] = {
+    {VideoSourceType::V4l2Yuy2, "v4l2"},
+    {VideoSourceType::V4l2Mjpeg, "mjpeg"},
+    {VideoSourceType::H264Rtp, "rtp-h264"},
+    {VideoSourceType::H264File, "h264"},
+    {VideoSourceType::MediaFile, "file"},
+    {VideoSourceType::TestPattern, "test"},
+};
+
+const char *const DEFAULT_RTP_PORT = "5000";
+const char *const DEFAULT_TEST_PATTERN = "smpte";
+
+// Decoded frames are scaled to the source size first (cheaper on planar decoder output), then packed to YUY2
+const char *const DECODED_TAIL = "videoscale ! videoconvert ! capsfilter name=srccaps caps=%2";
+} // namespace
+
+VideoSourceConfig VideoSourceConfig::v4l2(const QString &deviceName)
+{
+    VideoSourceConfig config;
+    config.type = VideoSourceType::V4l2Yuy2;
+    config.location = deviceName;
+    return config;
+}
+
+bool VideoSourceConfig::fromSpec(const QString &spec, VideoSourceConfig &config, QString *errorMessage)
+{
+    const int separator = spec.indexOf(':');
+    const QString typeName = separator < 0 ? spec : spec.left(separator);
+    QString location = separator < 0 ? QString() : spec.mid(separator + 1);
+
+    if (spec.startsWith('/')) {
+        config = v4l2(spec); // Plain device path, as before sources were configurable
+        return true;
+    }
+
+    VideoSourceConfig parsed;
+    bool known = false;
+    for (const SourceTypeName &entry : SOURCE_TYPE_NAMES) {
+        if (typeName == QLatin1String(entry.name)) {
+            parsed.type = entry.type;
+            known = true;
+            break;
+        }
+    }
+    if (!known) {
+        if (errorMessage) *errorMessage = QString("Unknown video source type '%1'").arg(typeName);
+        return false;
+    }
+
+    if (location.isEmpty()) {
+        if (parsed.type == VideoSourceType::H264Rtp) {
+            location = DEFAULT_RTP_PORT;
+        } else if (parsed.type == VideoSourceType::TestPattern) {
+            location = DEFAULT_TEST_PATTERN;
+        } else {
+            if (errorMessage) *errorMessage = QString("Video source '%1' needs a device or file").arg(spec);
+            return false;
+        }
+    }
+    parsed.location = location;
+    config = parsed;
+    return true;
+}
+
+QString VideoSourceConfig::toSpec() const
+{
+    for (const SourceTypeName &entry : SOURCE_TYPE_NAMES) {
+        if (entry.type == type) {
+            return QString("%1:%2").arg(QLatin1String(entry.name), location);
+        }
+    }
+    return location;
+}
+
+QString VideoSourceConfig::sourceCaps(int width, int height) const
+{
+    switch (type) {
+    case VideoSourceType::V4l2Yuy2:
+    case VideoSourceType::TestPattern:
+        return QString("video/x-raw,format=YUY2,width=%1,height=%2,framerate=%3/1").arg(width).arg(height).arg(framerate);
+    case VideoSourceType::V4l2Mjpeg:
+        return QString("image/jpeg,width=%1,height=%2,framerate=%3/1").arg(width).arg(height).arg(framerate);
+    case VideoSourceType::H264Rtp:
+    case VideoSourceType::H264File:
+    case VideoSourceType::MediaFile:
+        break;
+    }
+    // Streams and files keep their own frame rate
+    return QString("video/x-raw,format=YUY2,width=%1,height=%2").arg(width).arg(height);
+}
+
+QString VideoSourceConfig::pipelineDescription(int width, int height) const
+{
+    const QString caps = sourceCaps(width, height);
+    switch (type) {
+    case VideoSourceType::V4l2Yuy2:
+        return QString("v4l2src name=source device=%1 do-timestamp=true ! "
+                       "capsfilter name=srccaps caps=%2").arg(location, caps);
+    case VideoSourceType::V4l2Mjpeg:
+        return QString("v4l2src name=source device=%1 do-timestamp=true ! "
+                       "capsfilter name=srccaps caps=%2 ! "
+                       "queue name=decodequeue max-size-buffers=2 leaky=downstream ! "
+                       "jpegdec ! videoconvert ! video/x-raw,format=YUY2").arg(location, caps);
+    case VideoSourceType::H264Rtp:
+        return QString("udpsrc name=source port=%1 "
+                       "caps=\"application/x-rtp,media=video,clock-rate=90000,encoding-name=H264\" ! "
+                       "rtpjitterbuffer latency=50 ! rtph264depay ! h264parse ! "
+                       "queue name=decodequeue max-size-buffers=4 leaky=downstream ! "
+                       "avdec_h264 ! " + QString(DECODED_TAIL)).arg(location, caps);
+    case VideoSourceType::H264File:
+        return QString("filesrc name=source location=\"%1\" ! parsebin ! h264parse ! "
+                       "queue name=decodequeue max-size-buffers=4 ! "
+                       "avdec_h264 ! " + QString(DECODED_TAIL) + " ! identity sync=true").arg(location, caps);
+    case VideoSourceType::MediaFile:
+        return QString("filesrc name=source location=\"%1\" ! parsebin ! "
+                       "queue name=decodequeue max-size-buffers=4 ! "
+                       "decodebin ! " + QString(DECODED_TAIL) + " ! identity sync=true").arg(location, caps);
+    case VideoSourceType::TestPattern:
+        return QString("videotestsrc name=source is-live=true pattern=%1 ! "
+                       "capsfilter name=srccaps caps=%2").arg(location, caps);
+    }
+    return QString();
+}
@@ -0,0 +1,73 @@
+#ifndef VIDEOSOURCECONFIG_H
+#define VIDEOSOURCECONFIG_H
+
+// --- Qt Includes ---
+#include <QString>
+
+/**
+ * @brief Kind of GStreamer source stage feeding a CameraVideoStreamDevice.
+ */
+enum class VideoSourceType {
+    V4l2Yuy2,    ///< V4L2 camera delivering raw YUY2 (the original hard-wired source)
+    V4l2Mjpeg,   ///< V4L2 camera delivering MJPEG, decoded on its own thread
+    H264Rtp,     ///< H.264 over RTP/UDP, decoded on its own thread
+    H264File,    ///< H.264 in a container file (MP4, MKV, TS), decoded on its own thread
+    MediaFile,   ///< Any file decodebin can play, for recorded clips
+    TestPattern  ///< videotestsrc, live, for synthetic load without cameras
+};
+
+/**
+ * @brief Selects and describes the source stage of a camera pipeline.
+ *
+ * Every source stage ends in YUY2 frames at the configured source size, so cropping,
+ * scaling, conversion and everything after the appsink stay the same for all types. The
+ * size is set by a capsfilter named "srccaps" (the capture caps for cameras). Decoding
+ * sources put a queue named "decodequeue" in front of the decoder, which runs the decoder
+ * and colour conversion on a thread of their own. Files are paced to real time.
+ *
+ * Sources are written as "<type>:<location>" (see fromSpec()), e.g. "v4l2:/dev/video0",
+ * "mjpeg:/dev/video2", "rtp-h264:5000", "h264:/clips/day.mp4", "file:/clips/night.mkv"
+ * or "test:ball".
+ */
+struct VideoSourceConfig {
+    VideoSourceType type = VideoSourceType::V4l2Yuy2;
+    QString location;   // Device node, file path, UDP port or videotestsrc pattern, by type
+    int framerate = 30; // Requested from cameras and the test pattern
+
+    static VideoSourceConfig v4l2(const QString &deviceName);
+
+    /**
+     * @brief Parses "<type>:<location>"; type is v4l2, mjpeg, rtp-h264, h264, file or test.
+     *
+     * A missing location selects the default of the type ("5000" for rtp-h264, "smpte"
+     * for test). A bare path without a type is taken as a V4L2 YUY2 device.
+     * @return False (and @p config untouched) if the type is unknown or a file/device has no location.
+     */
+    static bool fromSpec(const QString &spec, VideoSourceConfig &config, QString *errorMessage = nullptr);
+
+    /**
+     * @brief The "<type>:<location>" form accepted by fromSpec(), for logs.
+     */
+    QString toSpec() const;
+
+    bool isDevice() const { return type == VideoSourceType::V4l2Yuy2 || type == VideoSourceType::V4l2Mjpeg; }
+    bool isFile() const { return type == VideoSourceType::H264File || type == VideoSourceType::MediaFile; }
+    bool decodes() const { return type != VideoSourceType::V4l2Yuy2 && type != VideoSourceType::TestPattern; }
+
+    /**
+     * @brief Caps of the "srccaps" filter for a @p width x @p height source.
+     *
+     * For cameras and the test pattern this is what the source produces (image/jpeg for
+     * MJPEG cameras); for streams and files it is the size decoded frames are scaled to.
+     */
+    QString sourceCaps(int width, int height) const;
+
+    /**
+     * @brief gst-launch description of the source stage, up to and including "srccaps".
+     *
+     * The source element is named "source". The description ends in YUY2 frames.
+     */
+    QString pipelineDescription(int width, int height) const;
+};
+
+#endif // VIDEOSOURCECONFIG_H
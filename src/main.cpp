@@ -6,11 +6,31 @@
 #include <QDateTime>
 #include <QDir>
 #include "TimestampLogger.h"
+#include "utils/yuy2converter.h"
+#include "devices/framelatency.h"
+#include <QTextStream>
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // Offline timing of the colour conversion kernels, no hardware required
+    if (app.arguments().contains(QStringLiteral("--benchmark-yuy2"))) {
+        QTextStream(stdout) << Yuy2Converter::runBenchmark() << "\n";
+        return 0;
+    }
+
+    // --latency-report=<file> writes the per-stage frame latency histograms on exit
+    const QString latencyReportPrefix = QStringLiteral("--latency-report=");
+    for (const QString &argument : app.arguments()) {
+        if (argument.startsWith(latencyReportPrefix)) {
+            const QString reportPath = argument.mid(latencyReportPrefix.size());
+            QObject::connect(&app, &QCoreApplication::aboutToQuit, [reportPath]() {
+                FrameLatencyStats::dumpToFile(reportPath);
+            });
+        }
+    }
+
     SystemController sysCtrl;
     sysCtrl.initializeSystem();
     sysCtrl.showMainWindow();
@@ -0,0 +1,245 @@
+#include "systemstatedata.h"
+
+#include <type_traits>
+
+namespace {
+
+constexpr quint32 STATE_STREAM_MAGIC = 0x53535444; // "SSTD"
+
+const char *const FIELD_NAMES[] = {
+#define SYSTEM_STATE_FIELD_NAME(group, type, name, init) #name,
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_NAME)
+#undef SYSTEM_STATE_FIELD_NAME
+};
+static_assert(sizeof(FIELD_NAMES) / sizeof(FIELD_NAMES[0]) == STATE_FIELD_COUNT, "Field name table out of step");
+
+const StateGroup FIELD_GROUPS[] = {
+#define SYSTEM_STATE_FIELD_GROUP(group, type, name, init) StateGroup::group,
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_GROUP)
+#undef SYSTEM_STATE_FIELD_GROUP
+};
+static_assert(sizeof(FIELD_GROUPS) / sizeof(FIELD_GROUPS[0]) == STATE_FIELD_COUNT, "Field group table out of step");
+
+// "type name;" for every field in table order: what a reader must agree on field by field
+constexpr char FIELD_SCHEMA[] =
+#define SYSTEM_STATE_FIELD_SCHEMA(group, type, name, init) #type " " #name ";"
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_SCHEMA)
+#undef SYSTEM_STATE_FIELD_SCHEMA
+    ;
+
+// 32-bit FNV-1a
+constexpr quint32 schemaHash(const char *text)
+{
+    quint32 hash = 2166136261u;
+    for (; *text; ++text) {
+        hash = (hash ^ static_cast<unsigned char>(*text)) * 16777619u;
+    }
+    return hash;
+}
+
+constexpr quint32 STATE_SCHEMA_HASH = schemaHash(FIELD_SCHEMA);
+
+// Enums go on the wire as qint32, everything else through its own QDataStream operator
+template <typename T>
+void writeField(QDataStream &out, const T &value)
+{
+    if constexpr (std::is_enum_v<T>) {
+        out << static_cast<qint32>(value);
+    } else {
+        out << value;
+    }
+}
+
+template <typename T>
+void readField(QDataStream &in, T &value)
+{
+    if constexpr (std::is_enum_v<T>) {
+        qint32 raw = 0;
+        in >> raw;
+        value = static_cast<T>(raw);
+    } else {
+        in >> value;
+    }
+}
+
+template <typename T>
+void debugField(QDebug &debug, const T &value)
+{
+    if constexpr (std::is_enum_v<T>) {
+        debug << static_cast<int>(value);
+    } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) < sizeof(int)) {
+        debug << static_cast<int>(value); // quint8 would print as a character
+    } else {
+        debug << value;
+    }
+}
+
+template <typename T>
+void debugField(QDebug &debug, const QVector<T> &values)
+{
+    debug << values.size() << " items";
+}
+
+void debugField(QDebug &debug, const VideoStreamHealth &health)
+{
+    debug << (health.streaming ? "streaming" : "stalled") << "/restarts " << health.restarts;
+}
+
+} // namespace
+
+const char *stateFieldName(StateField field)
+{
+    const int index = static_cast<int>(field);
+    return (index >= 0 && index < static_cast<int>(STATE_FIELD_COUNT)) ? FIELD_NAMES[index] : "?";
+}
+
+StateGroup stateFieldGroup(StateField field)
+{
+    const int index = static_cast<int>(field);
+    return (index >= 0 && index < static_cast<int>(STATE_FIELD_COUNT)) ? FIELD_GROUPS[index] : StateGroup::None;
+}
+
+quint32 stateSchemaHash()
+{
+    return STATE_SCHEMA_HASH;
+}
+
+StateGroups stateFieldGroups(const StateFieldSet &fields)
+{
+    StateGroups groups;
+    if (fields.none()) {
+        return groups;
+    }
+    for (std::size_t i = 0; i < STATE_FIELD_COUNT; ++i) {
+        if (fields.test(i)) {
+            groups |= FIELD_GROUPS[i];
+        }
+    }
+    return groups;
+}
+
+QStringList stateFieldNames(const StateFieldSet &fields)
+{
+    QStringList names;
+    for (std::size_t i = 0; i < STATE_FIELD_COUNT; ++i) {
+        if (fields.test(i)) {
+            names.append(QLatin1String(FIELD_NAMES[i]));
+        }
+    }
+    return names;
+}
+
+// === SystemStateData ===
+
+QDataStream &operator<<(QDataStream &out, const SystemStateData &data)
+{
+    out << STATE_STREAM_MAGIC << STATE_SCHEMA_HASH;
+#define SYSTEM_STATE_FIELD_WRITE(group, type, name, init) writeField(out, data.name);
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_WRITE)
+#undef SYSTEM_STATE_FIELD_WRITE
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, SystemStateData &data)
+{
+    quint32 magic = 0;
+    quint32 schema = 0;
+    in >> magic >> schema;
+    if (magic != STATE_STREAM_MAGIC || schema != STATE_SCHEMA_HASH) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    SystemStateData read;
+#define SYSTEM_STATE_FIELD_READ(group, type, name, init) readField(in, read.name);
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_READ)
+#undef SYSTEM_STATE_FIELD_READ
+    if (in.status() == QDataStream::Ok) {
+        data = read;
+    }
+    return in;
+}
+
+QDebug operator<<(QDebug debug, const SystemStateData &data)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << "SystemStateData(";
+    const char *separator = "";
+#define SYSTEM_STATE_FIELD_DEBUG(group, type, name, init) \
+    debug << separator << #name "="; \
+    debugField(debug, data.name); \
+    separator = ", ";
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_DEBUG)
+#undef SYSTEM_STATE_FIELD_DEBUG
+    debug << ')';
+    return debug;
+}
+
+// === Nested structures ===
+
+QDataStream &operator<<(QDataStream &out, const AreaZone &zone)
+{
+    out << zone.id << static_cast<qint32>(zone.type) << zone.isEnabled << zone.isFactorySet << zone.isOverridable
+        << zone.startAzimuth << zone.endAzimuth << zone.minElevation << zone.maxElevation
+        << zone.minRange << zone.maxRange << zone.name;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, AreaZone &zone)
+{
+    qint32 type = 0;
+    in >> zone.id >> type >> zone.isEnabled >> zone.isFactorySet >> zone.isOverridable
+       >> zone.startAzimuth >> zone.endAzimuth >> zone.minElevation >> zone.maxElevation
+       >> zone.minRange >> zone.maxRange >> zone.name;
+    zone.type = static_cast<ZoneType>(type);
+    return in;
+}
+
+QDataStream &operator<<(QDataStream &out, const AutoSectorScanZone &zone)
+{
+    out << zone.id << zone.isEnabled << zone.az1 << zone.el1 << zone.az2 << zone.el2 << zone.scanSpeed;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, AutoSectorScanZone &zone)
+{
+    in >> zone.id >> zone.isEnabled >> zone.az1 >> zone.el1 >> zone.az2 >> zone.el2 >> zone.scanSpeed;
+    return in;
+}
+
+QDataStream &operator<<(QDataStream &out, const TargetReferencePoint &trp)
+{
+    out << trp.id << trp.locationPage << trp.trpInPage << trp.azimuth << trp.elevation << trp.haltTime;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, TargetReferencePoint &trp)
+{
+    in >> trp.id >> trp.locationPage >> trp.trpInPage >> trp.azimuth >> trp.elevation >> trp.haltTime;
+    return in;
+}
+
+QDataStream &operator<<(QDataStream &out, const SimpleRadarPlot &plot)
+{
+    out << plot.id << plot.azimuth << plot.range << plot.relativeCourse << plot.relativeSpeed;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, SimpleRadarPlot &plot)
+{
+    in >> plot.id >> plot.azimuth >> plot.range >> plot.relativeCourse >> plot.relativeSpeed;
+    return in;
+}
+
+QDataStream &operator<<(QDataStream &out, const VideoStreamHealth &health)
+{
+    out << health.streaming << health.recovering << health.restarts << health.busErrors << health.busWarnings
+        << health.qosDroppedBuffers << health.qosMessages << health.lastRecoveryMs;
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, VideoStreamHealth &health)
+{
+    in >> health.streaming >> health.recovering >> health.restarts >> health.busErrors >> health.busWarnings
+       >> health.qosDroppedBuffers >> health.qosMessages >> health.lastRecoveryMs;
+    return in;
+}
@@ -33,6 +33,7 @@
  * • System readiness checks
  * • Health monitoring utilities
  * • Comparison operators for state management
+ * • Field table (SYSTEM_STATE_FIELDS) generating diff, serialization and debug output
  *
  * @author MB
  * @date [Current Date]
@@ -43,7 +44,15 @@
 #include <QColor>
 #include <QDateTime>
 #include <QPointF>
+#include <QVector>
+#include <QMetaType>
 #include <QtGlobal> // For qFuzzyCompare
+#include <QFlags>
+#include <QDataStream>
+#include <QDebug>
+#include <QStringList>
+#include <bitset>
+#include <cstddef>
 #include <vector>
 #include "../utils/colorutils.h" // For ColorUtils
 #include <vpi/algo/DCFTracker.h> // VPITrackingState, VPIDCFTrackedBoundingBox
@@ -290,238 +299,403 @@ struct SimpleRadarPlot {
     }
 };
 
+/**
+ * @brief Health of one camera's video pipeline, as reported by its CameraVideoStreamDevice
+ *
+ * Counters are cumulative since the device thread started.
+ */
+struct VideoStreamHealth {
+    bool streaming = false;         ///< Frames arrived within the watchdog timeout
+    bool recovering = false;        ///< A stall or error was detected and no frame arrived since
+    quint32 restarts = 0;           ///< Automatic pipeline restarts
+    quint32 busErrors = 0;          ///< Error messages posted on the pipeline bus
+    quint32 busWarnings = 0;        ///< Warning messages posted on the pipeline bus
+    quint64 qosDroppedBuffers = 0;  ///< Buffers dropped by pipeline elements, from QoS messages
+    quint64 qosMessages = 0;        ///< QoS messages posted on the pipeline bus
+    double lastRecoveryMs = 0.0;    ///< Stall/error detection to first frame after the last recovery
+
+    bool operator==(const VideoStreamHealth &other) const {
+        return streaming == other.streaming &&
+               recovering == other.recovering &&
+               restarts == other.restarts &&
+               busErrors == other.busErrors &&
+               busWarnings == other.busWarnings &&
+               qosDroppedBuffers == other.qosDroppedBuffers &&
+               qosMessages == other.qosMessages &&
+               lastRecoveryMs == other.lastRecoveryMs;
+    }
+
+    bool operator!=(const VideoStreamHealth &other) const {
+        return !(*this == other);
+    }
+};
+Q_DECLARE_METATYPE(VideoStreamHealth)
+
 // =================================
-// MAIN SYSTEM STATE STRUCTURE
+// CHANGE NOTIFICATION GROUPS
 // =================================
 
 /**
- * @brief Comprehensive system state structure containing all RCWS operational data
- * 
- * This structure serves as the central data repository for the entire RCWS system,
- * organizing all operational parameters, sensor data, control states, and status
- * information into logical categories for efficient access and management.
+ * @brief Field groups of SystemStateData, for change notifications
+ *
+ * SystemStateModel publishes which groups changed with every update (see
+ * SystemStateData::changedGroups()), so subscribers only react to, and copy, what they use.
  */
-struct SystemStateData {
-    
-    // =================================
-    // OPERATIONAL STATE & MODES
-    // =================================
-    OperationalMode opMode = OperationalMode::Idle;         ///< Current operational mode
-    OperationalMode previousOpMode = OperationalMode::Idle; ///< Previous operational mode for state transitions
-    MotionMode motionMode = MotionMode::Idle;               ///< Current motion control mode
-    MotionMode previousMotionMode = MotionMode::Idle;       ///< Previous motion mode for state transitions
-    
-    // =================================
-    // DISPLAY & UI CONFIGURATION
-    // =================================
-    ReticleType reticleType = ReticleType::BoxCrosshair;    ///< Current reticle style
-    ColorStyle osdColorStyle = ColorStyle::Green;           ///< On-screen display color style
-    QColor colorStyle = QColor(70, 226, 165);              ///< Current UI color theme
-    int currentImageWidthPx = 1024;                         ///< Current image width in pixels
-    int currentImageHeightPx = 768;                         ///< Current image height in pixels
-    float reticleAimpointImageX_px = currentImageWidthPx / 2.0f;  ///< Reticle X position in image coordinates
-    float reticleAimpointImageY_px = currentImageHeightPx / 2.0f; ///< Reticle Y position in image coordinates
-    
-    // =================================
-    // ZONE MANAGEMENT
-    // =================================
-    std::vector<AreaZone> areaZones;                        ///< Collection of all area zones
-    std::vector<AutoSectorScanZone> sectorScanZones;       ///< Collection of all sector scan zones
-    std::vector<TargetReferencePoint> targetReferencePoints; ///< Collection of all target reference points
-    int activeAutoSectorScanZoneId = 1;                     ///< Currently active sector scan zone ID
-    int activeTRPLocationPage = 1;                          ///< Currently active TRP location page
-    QString currentScanName;                                ///< Name of current scanning operation
-    QString currentTRPScanName;                             ///< Name of current TRP scan operation
-    bool isReticleInNoFireZone = false;                     ///< Whether reticle is in a no-fire zone
-    bool isReticleInNoTraverseZone = false;                 ///< Whether reticle is in a no-traverse zone
-    
-    // =================================
-    // CAMERA SYSTEMS
-    // =================================
-    // Day Camera
-    double dayZoomPosition = 0.0;       ///< Day camera zoom position (0-1 normalized)
-    double dayCurrentHFOV = 9.0;        ///< Day camera current horizontal field of view in degrees
-    bool dayCameraConnected = false;    ///< Day camera connection status
-    bool dayCameraError = false;        ///< Day camera error status
-    quint8 dayCameraStatus = 0;         ///< Day camera detailed status code
-    
-    // Night Camera
-    double nightZoomPosition = 0.0;     ///< Night camera zoom position (0-1 normalized)
-    double nightCurrentHFOV = 8.0;      ///< Night camera current horizontal field of view in degrees
-    bool nightCameraConnected = false;  ///< Night camera connection status
-    bool nightCameraError = false;      ///< Night camera error status
-    quint8 nightCameraStatus = 0;       ///< Night camera detailed status code
-    
-    // Camera Control
-    bool activeCameraIsDay = false;     ///< True if day camera is active, false if night camera
-    
-    // =================================
-    // GIMBAL & POSITIONING SYSTEM
-    // =================================
-    double gimbalAz = 0.0;              ///< Current gimbal azimuth position in degrees
-    double gimbalEl = 0.0;              ///< Current gimbal elevation position in degrees
-    float azMotorTemp = 0.0f;           ///< Azimuth motor temperature in Celsius
-    float azDriverTemp = 0.0f;          ///< Azimuth driver temperature in Celsius
-    float elMotorTemp = 0.0f;           ///< Elevation motor temperature in Celsius
-    float elDriverTemp = 0.0f;          ///< Elevation driver temperature in Celsius
-    float reticleAz = 0.0f;             ///< Reticle azimuth position in degrees
-    float reticleEl = 0.0f;             ///< Reticle elevation position in degrees
-    double actuatorPosition = 0.0;       ///< Linear actuator position
-    
-    // =================================
-    // ORIENTATION & STABILIZATION
-    // =================================
-    double imuRollDeg = 0.0;            ///< IMU Roll angle in degrees
-    double imuPitchDeg = 0.0;           ///< IMU Pitch angle in degrees
-    double imuYawDeg = 0.0;             ///< IMU Yaw angle in degrees
-    double GyroX = 0.0;                 ///< Gyro X-axis rate in deg/s
-    double GyroY = 0.0;                 ///< Gyro Y-axis rate in deg/s
-    double GyroZ = 0.0;                 ///< Gyro Z-axis rate in deg/s
-    double AccelX = 0.0;                ///< Accelerometer X-axis in G
-    double AccelY = 0.0;                ///< Accelerometer Y-axis in G
-    double AccelZ = 0.0;                ///< Accelerometer Z-axis in G
-    bool isStabilizationActive = false; ///< Stabilization system active status
-    double temperature = 0.0;           ///< Current system temperature in Celsius
-    // Stationary detection variables
-    bool isVehicleStationary = false;   ///< Flag indicating if the vehicle is stationary
-    double previousAccelMagnitude = 0.0; ///< Previous accelerometer magnitude for delta calculation
-    QDateTime stationaryStartTime;      ///< Timestamp when stationary conditions began
-    // =================================
-    // LASER RANGE FINDER (LRF)
-    // =================================
-    double lrfDistance = 0.0;           ///< Last measured distance in meters
-    quint8 lrfSystemStatus = 0;         ///< LRF system status code
-    quint8 isOverTemperature = 0;         ///< LRF over-temperature status (1 = true, 0 = false)
-    // =================================
-    // --- Radar Data ---
-    // =================================
-    QVector<SimpleRadarPlot> radarPlots;         // The latest list of all detected plots
-    quint32 selectedRadarTrackId = 0;      // The ID of the target the user has selected from the list
-    
-    // =================================
-    // JOYSTICK & MANUAL CONTROLS
-    // =================================
-    bool deadManSwitchActive = false;   ///< Safety dead man switch status
-    float joystickAzValue = 0.0f;       ///< Joystick azimuth axis value (-1.0 to 1.0)
-    float joystickElValue = 0.0f;       ///< Joystick elevation axis value (-1.0 to 1.0)
-    bool upTrackButton = false;         ///< Up track button status
-    bool downTrackButton = false;       ///< Down track button status
-    bool menuUp = false;                  ///< Up switch status
-    bool menuDown = false;                ///< Down switch status
-    bool menuVal = false;             ///< Menu validation switch status
-    int joystickHatDirection = 0;         ///< Joystick hat switch direction (0-7, 0 = center, 1 = up, 2 = up-right, etc.)
+enum class StateGroup : quint32 {
+    None         = 0,
+    Modes        = 1u << 0,  ///< Operational and motion modes
+    UiStyle      = 1u << 1,  ///< Reticle type and colour style
+    Optics       = 1u << 2,  ///< Active camera, zoom/HFOV, image size, reticle aimpoint pixels
+    Zones        = 1u << 3,  ///< Zone lists, active scan zone/TRP page, scan names, in-zone flags
+    DeviceHealth = 1u << 4,  ///< Camera/video/LRF status, motor, driver and station temperatures
+    GimbalPose   = 1u << 5,  ///< Gimbal azimuth/elevation, reticle angles, actuator position
+    Orientation  = 1u << 6,  ///< IMU attitude, rates, accelerations, stabilisation, stationary detection
+    Radar        = 1u << 7,  ///< Radar plots and selected track
+    Controls     = 1u << 8,  ///< Joystick, dead man switch, track and menu buttons
+    Station      = 1u << 9,  ///< PLC21 panel switches and PLC42 station I/O
+    Tracking     = 1u << 10, ///< Tracker phase, target, acquisition box
+    Ballistics   = 1u << 11, ///< Zeroing, windage, lead angle, target range and rates
+    StatusText   = 1u << 12, ///< Status and information strings
+    All          = (1u << 13) - 1
+};
+Q_DECLARE_FLAGS(StateGroups, StateGroup)
+Q_DECLARE_OPERATORS_FOR_FLAGS(StateGroups)
+Q_DECLARE_METATYPE(StateGroups)
 
-    
-    // =================================
-    // WEAPON SYSTEM CONTROL (PLC21)
-    // =================================
-    bool stationEnabled = true;         ///< Weapon station enable status
-    bool gotoHomePosition = false;                ///< Home position switch status
-    bool gunArmed = false;              ///< Weapon arming status
-    bool ammoLoaded = false;            ///< Ammunition loaded status
-    bool authorized = false;            ///< System authorization status
-    bool detectionEnabled = false;      ///< Target detection enable status
-    FireMode fireMode = FireMode::Unknown; ///< Current weapon fire mode
-    double gimbalSpeed = 2.0;               ///< Speed switch setting
-    bool enableStabilization = true;   ///< Platform stabilization enable switch
+/**
+ * @brief Optics group payload (SystemStateModel::opticsChanged)
+ */
+struct OpticsState {
+    bool activeCameraIsDay = false;
+    int activeCameraIndex = 1;
+    double dayZoomPosition = 0.0;
+    double dayCurrentHFOV = 0.0;
+    double nightZoomPosition = 0.0;
+    double nightCurrentHFOV = 0.0;
+    int imageWidthPx = 0;
+    int imageHeightPx = 0;
+    float reticleAimpointImageX_px = 0.0f;
+    float reticleAimpointImageY_px = 0.0f;
+    float currentCameraHfovDegrees = 0.0f;
+};
+Q_DECLARE_METATYPE(OpticsState)
 
-    // =================================
-    // GIMBAL STATION HARDWARE (PLC42)
-    // =================================
-    // Limit Sensors
-    bool upperLimitSensorActive = false; ///< Upper travel limit sensor status
-    bool lowerLimitSensorActive = false; ///< Lower travel limit sensor status
-    bool emergencyStopActive = false;    ///< Emergency stop activation status
-    
-    // Station Inputs
-    bool stationAmmunitionLevel = false; ///< Station ammunition level sensor
-    bool stationInput1 = false;          ///< General station input 1
-    bool stationInput2 = false;          ///< General station input 2
-    bool stationInput3 = false;          ///< General station input 3
-    
-    // Environmental Monitoring
-    int panelTemperature = 0;            ///< Control panel temperature in Celsius
-    int stationTemperature = 0;          ///< Station ambient temperature in Celsius
-    int stationPressure = 0;             ///< Station atmospheric pressure
-    
-    // Control States
-    uint16_t solenoidMode = 0;           ///< Solenoid valve mode setting
-    uint16_t gimbalOpMode = 0;           ///< Gimbal operational mode
-    uint32_t azimuthSpeed = 0;           ///< Azimuth movement speed setting
-    uint32_t elevationSpeed = 0;         ///< Elevation movement speed setting
-    uint16_t azimuthDirection = 0;       ///< Azimuth movement direction
-    uint16_t elevationDirection = 0;     ///< Elevation movement direction
-    uint16_t solenoidState = 0;          ///< Current solenoid state
-    uint16_t resetAlarm = 0;             ///< Alarm reset control
-    
-    // =================================
-    // TRACKING SYSTEM
-    // =================================
-    bool upTrack = false;                ///< Up tracking button status
-    bool downTrack = false;              ///< Down tracking button status
-    bool valTrack = false;               ///< Track validation button status
-    bool startTracking = false;          ///< Start tracking command status
-    bool requestTrackingRestart = false; ///< Tracking restart request status
-    bool trackingActive = false;         ///< Current tracking active status
-    double targetAz = 0.0;               ///< Current target azimuth in degrees
-    double targetEl = 0.0;               ///< Current target elevation in degrees
-    float trackedTargetVelocityX_px_s = 0.0;
-    float trackedTargetVelocityY_px_s = 0.0;
-    // --- Active Tracked Target Data (from Video Processor) ---
-
-    float currentCameraHfovDegrees = 45.0f; // Set by CameraController
-
-    bool  trackerHasValidTarget = false;
+/**
+ * @brief Device health group payload (SystemStateModel::deviceHealthChanged)
+ */
+struct DeviceHealthState {
+    bool dayCameraConnected = false;
+    bool dayCameraError = false;
+    quint8 dayCameraStatus = 0;
+    VideoStreamHealth dayVideoHealth;
+    bool nightCameraConnected = false;
+    bool nightCameraError = false;
+    quint8 nightCameraStatus = 0;
+    VideoStreamHealth nightVideoHealth;
+    QVector<VideoStreamHealth> auxVideoHealth; ///< Implicitly shared, copying it is a ref-count bump
+    float azMotorTemp = 0.0f;
+    float azDriverTemp = 0.0f;
+    float elMotorTemp = 0.0f;
+    float elDriverTemp = 0.0f;
+    double temperature = 0.0;
+    quint8 lrfSystemStatus = 0;
+    quint8 isOverTemperature = 0;
+    int panelTemperature = 0;
+    int stationTemperature = 0;
+    int stationPressure = 0;
+};
+Q_DECLARE_METATYPE(DeviceHealthState)
+
+/**
+ * @brief Tracking group payload (SystemStateModel::trackingChanged)
+ */
+struct TrackingState {
+    bool startTracking = false;
+    bool requestTrackingRestart = false;
+    bool trackingActive = false;
+    TrackingPhase phase = TrackingPhase::Off;
+    bool trackerHasValidTarget = false;
+    VPITrackingState trackedTargetState = VPI_TRACKING_STATE_LOST;
     float trackedTargetCenterX_px = 0.0f;
     float trackedTargetCenterY_px = 0.0f;
     float trackedTargetWidth_px = 0.0f;
     float trackedTargetHeight_px = 0.0f;
-    VPITrackingState trackedTargetState = VPI_TRACKING_STATE_LOST; // Store the raw tracker state
-    TrackingPhase currentTrackingPhase = TrackingPhase::Off;
+    float trackedTargetVelocityX_px_s = 0.0f;
+    float trackedTargetVelocityY_px_s = 0.0f;
+    double targetAz = 0.0;
+    double targetEl = 0.0;
+    float acquisitionBoxX_px = 0.0f;
+    float acquisitionBoxY_px = 0.0f;
+    float acquisitionBoxW_px = 0.0f;
+    float acquisitionBoxH_px = 0.0f;
+};
+Q_DECLARE_METATYPE(TrackingState)
 
-    // The acquisition gate/box, defined by user before lock-on.
-    // In IMAGE PIXEL coordinates.
-    float acquisitionBoxX_px = 512.0f;
-    float acquisitionBoxY_px = 384.0f;
-    float acquisitionBoxW_px = 100.0f; // Default size
-    float acquisitionBoxH_px = 100.0f;
+/**
+ * @brief Ballistics group payload (SystemStateModel::ballisticsChanged)
+ */
+struct BallisticsState {
+    bool zeroingModeActive = false;
+    float zeroingAzimuthOffset = 0.0f;
+    float zeroingElevationOffset = 0.0f;
+    bool zeroingAppliedToBallistics = false;
+    bool windageModeActive = false;
+    float windageSpeedKnots = 0.0f;
+    bool windageAppliedToBallistics = false;
+    bool leadAngleCompensationActive = false;
+    LeadAngleStatus currentLeadAngleStatus = LeadAngleStatus::Off;
+    float leadAngleOffsetAz = 0.0f;
+    float leadAngleOffsetEl = 0.0f;
+    double lrfDistance = 0.0;
+    float currentTargetRange = 0.0f;
+    float currentTargetAngularRateAz = 0.0f;
+    float currentTargetAngularRateEl = 0.0f;
+    float muzzleVelocityMPS = 0.0f;
+};
+Q_DECLARE_METATYPE(BallisticsState)
 
-    // =================================
-    // BALLISTICS & FIRE CONTROL
-    // =================================
-    // Zeroing System
-    bool zeroingModeActive = false;         ///< Weapon zeroing mode active status
-    float zeroingAzimuthOffset = 0.0f;      ///< Zeroing azimuth offset in degrees
-    float zeroingElevationOffset = 0.0f;    ///< Zeroing elevation offset in degrees
-    bool zeroingAppliedToBallistics = false; ///< Whether zeroing is applied to ballistic calculations
-    
-    // Windage Compensation
-    bool windageModeActive = false;         ///< Windage compensation mode active status
-    float windageSpeedKnots = 0.0f;         ///< Wind speed for windage calculation in knots
-    bool windageAppliedToBallistics = false; ///< Whether windage is applied to ballistic calculations
-    
-    // Lead Angle Compensation
-    bool leadAngleCompensationActive = false;           ///< Lead angle compensation active status
-    LeadAngleStatus currentLeadAngleStatus = LeadAngleStatus::Off; ///< Current lead angle system status
-    float leadAngleOffsetAz = 0.0f;                     ///< Lead angle azimuth offset in degrees
-    float leadAngleOffsetEl = 0.0f;                     ///< Lead angle elevation offset in degrees
-    
-    // Target Parameters for Ballistics
-    float currentTargetRange = 2000.0f;                 ///< Current target range in meters
-    float currentTargetAngularRateAz = 0.0f;            ///< Target angular rate in azimuth (degrees/second)
-    float currentTargetAngularRateEl = 0.0f;            ///< Target angular rate in elevation (degrees/second)
-    float muzzleVelocityMPS = 900.0f;                   ///< Projectile muzzle velocity in meters per second
+// =================================
+// FIELD TABLE
+// =================================
+
+/**
+ * @brief The fields of SystemStateData: X(group, type, name, default)
+ *
+ * This is the only place a state field is declared. The table generates the members,
+ * operator==, changedFields()/changedGroups(), binary serialization and debug printing,
+ * so a new field takes part in all of them. @c group is the StateGroup notified when the
+ * field changes.
+ */
+#define SYSTEM_STATE_FIELDS(X) \
+    /* OPERATIONAL STATE & MODES */ \
+    X(Modes, OperationalMode, opMode, OperationalMode::Idle)                 /* Current operational mode */ \
+    X(Modes, OperationalMode, previousOpMode, OperationalMode::Idle)         /* Previous operational mode for state transitions */ \
+    X(Modes, MotionMode, motionMode, MotionMode::Idle)                       /* Current motion control mode */ \
+    X(Modes, MotionMode, previousMotionMode, MotionMode::Idle)               /* Previous motion mode for state transitions */ \
+    /* DISPLAY & UI CONFIGURATION */ \
+    X(UiStyle, ReticleType, reticleType, ReticleType::BoxCrosshair)          /* Current reticle style */ \
+    X(UiStyle, ColorStyle, osdColorStyle, ColorStyle::Green)                 /* On-screen display color style */ \
+    X(UiStyle, QColor, colorStyle, QColor(70, 226, 165))                     /* Current UI color theme */ \
+    X(Optics, int, currentImageWidthPx, 1024)                                /* Current image width in pixels */ \
+    X(Optics, int, currentImageHeightPx, 768)                                /* Current image height in pixels */ \
+    X(Optics, float, reticleAimpointImageX_px, currentImageWidthPx / 2.0f)   /* Reticle X position in image coordinates */ \
+    X(Optics, float, reticleAimpointImageY_px, currentImageHeightPx / 2.0f)  /* Reticle Y position in image coordinates */ \
+    /* ZONE MANAGEMENT (zone lists are implicitly shared) */ \
+    X(Zones, QVector<AreaZone>, areaZones, )                                 /* Collection of all area zones */ \
+    X(Zones, QVector<AutoSectorScanZone>, sectorScanZones, )                 /* Collection of all sector scan zones */ \
+    X(Zones, QVector<TargetReferencePoint>, targetReferencePoints, )         /* Collection of all target reference points */ \
+    X(Zones, int, activeAutoSectorScanZoneId, 1)                             /* Currently active sector scan zone ID */ \
+    X(Zones, int, activeTRPLocationPage, 1)                                  /* Currently active TRP location page */ \
+    X(Zones, QString, currentScanName, )                                     /* Name of current scanning operation */ \
+    X(Zones, QString, currentTRPScanName, )                                  /* Name of current TRP scan operation */ \
+    X(Zones, bool, isReticleInNoFireZone, false)                             /* Whether reticle is in a no-fire zone */ \
+    X(Zones, bool, isReticleInNoTraverseZone, false)                         /* Whether reticle is in a no-traverse zone */ \
+    /* CAMERA SYSTEMS: day camera */ \
+    X(Optics, double, dayZoomPosition, 0.0)                                  /* Day camera zoom position (0-1 normalized) */ \
+    X(Optics, double, dayCurrentHFOV, 9.0)                                   /* Day camera current horizontal field of view in degrees */ \
+    X(DeviceHealth, bool, dayCameraConnected, false)                         /* Day camera connection status */ \
+    X(DeviceHealth, bool, dayCameraError, false)                             /* Day camera error status */ \
+    X(DeviceHealth, quint8, dayCameraStatus, 0)                              /* Day camera detailed status code */ \
+    X(DeviceHealth, VideoStreamHealth, dayVideoHealth, )                     /* Day camera video pipeline health */ \
+    /* CAMERA SYSTEMS: night camera */ \
+    X(Optics, double, nightZoomPosition, 0.0)                                /* Night camera zoom position (0-1 normalized) */ \
+    X(Optics, double, nightCurrentHFOV, 8.0)                                 /* Night camera current horizontal field of view in degrees */ \
+    X(DeviceHealth, bool, nightCameraConnected, false)                       /* Night camera connection status */ \
+    X(DeviceHealth, bool, nightCameraError, false)                           /* Night camera error status */ \
+    X(DeviceHealth, quint8, nightCameraStatus, 0)                            /* Night camera detailed status code */ \
+    X(DeviceHealth, VideoStreamHealth, nightVideoHealth, )                   /* Night camera video pipeline health */ \
+    /* CAMERA SYSTEMS: camera control */ \
+    X(Optics, bool, activeCameraIsDay, false)                                /* True if day camera is active, false if night camera */ \
+    X(Optics, int, activeCameraIndex, 1)                                     /* CameraRegistry index of the camera shown: 0 day, 1 night, 2+ auxiliary */ \
+    X(DeviceHealth, QVector<VideoStreamHealth>, auxVideoHealth, )            /* Video pipeline health of auxiliary cameras (index 2 first) */ \
+    /* GIMBAL & POSITIONING SYSTEM */ \
+    X(GimbalPose, double, gimbalAz, 0.0)                                     /* Current gimbal azimuth position in degrees */ \
+    X(GimbalPose, double, gimbalEl, 0.0)                                     /* Current gimbal elevation position in degrees */ \
+    X(DeviceHealth, float, azMotorTemp, 0.0f)                                /* Azimuth motor temperature in Celsius */ \
+    X(DeviceHealth, float, azDriverTemp, 0.0f)                               /* Azimuth driver temperature in Celsius */ \
+    X(DeviceHealth, float, elMotorTemp, 0.0f)                                /* Elevation motor temperature in Celsius */ \
+    X(DeviceHealth, float, elDriverTemp, 0.0f)                               /* Elevation driver temperature in Celsius */ \
+    X(GimbalPose, float, reticleAz, 0.0f)                                    /* Reticle azimuth position in degrees */ \
+    X(GimbalPose, float, reticleEl, 0.0f)                                    /* Reticle elevation position in degrees */ \
+    X(GimbalPose, double, actuatorPosition, 0.0)                             /* Linear actuator position */ \
+    /* ORIENTATION & STABILIZATION */ \
+    X(Orientation, double, imuRollDeg, 0.0)                                  /* IMU Roll angle in degrees */ \
+    X(Orientation, double, imuPitchDeg, 0.0)                                 /* IMU Pitch angle in degrees */ \
+    X(Orientation, double, imuYawDeg, 0.0)                                   /* IMU Yaw angle in degrees */ \
+    X(Orientation, double, GyroX, 0.0)                                       /* Gyro X-axis rate in deg/s */ \
+    X(Orientation, double, GyroY, 0.0)                                       /* Gyro Y-axis rate in deg/s */ \
+    X(Orientation, double, GyroZ, 0.0)                                       /* Gyro Z-axis rate in deg/s */ \
+    X(Orientation, double, AccelX, 0.0)                                      /* Accelerometer X-axis in G */ \
+    X(Orientation, double, AccelY, 0.0)                                      /* Accelerometer Y-axis in G */ \
+    X(Orientation, double, AccelZ, 0.0)                                      /* Accelerometer Z-axis in G */ \
+    X(Orientation, bool, isStabilizationActive, false)                       /* Stabilization system active status */ \
+    X(DeviceHealth, double, temperature, 0.0)                                /* Current system temperature in Celsius */ \
+    X(Orientation, bool, isVehicleStationary, false)                         /* Flag indicating if the vehicle is stationary */ \
+    /* LASER RANGE FINDER (LRF) */ \
+    X(Ballistics, double, lrfDistance, 0.0)                                  /* Last measured distance in meters */ \
+    X(DeviceHealth, quint8, lrfSystemStatus, 0)                              /* LRF system status code */ \
+    X(DeviceHealth, quint8, isOverTemperature, 0)                            /* LRF over-temperature status (1 = true, 0 = false) */ \
+    /* RADAR DATA */ \
+    X(Radar, QVector<SimpleRadarPlot>, radarPlots, )                         /* The latest list of all detected plots */ \
+    X(Radar, quint32, selectedRadarTrackId, 0)                               /* The ID of the target the user has selected from the list */ \
+    /* JOYSTICK & MANUAL CONTROLS */ \
+    X(Controls, bool, deadManSwitchActive, false)                            /* Safety dead man switch status */ \
+    X(Controls, float, joystickAzValue, 0.0f)                                /* Joystick azimuth axis value (-1.0 to 1.0) */ \
+    X(Controls, float, joystickElValue, 0.0f)                                /* Joystick elevation axis value (-1.0 to 1.0) */ \
+    X(Controls, bool, upTrackButton, false)                                  /* Up track button status */ \
+    X(Controls, bool, downTrackButton, false)                                /* Down track button status */ \
+    X(Controls, bool, menuUp, false)                                         /* Up switch status */ \
+    X(Controls, bool, menuDown, false)                                       /* Down switch status */ \
+    X(Controls, bool, menuVal, false)                                        /* Menu validation switch status */ \
+    X(Controls, int, joystickHatDirection, 0)                                /* Joystick hat direction (0-7, 0 = center, 1 = up, 2 = up-right, etc.) */ \
+    /* WEAPON SYSTEM CONTROL (PLC21) */ \
+    X(Station, bool, stationEnabled, true)                                   /* Weapon station enable status */ \
+    X(Station, bool, gotoHomePosition, false)                                /* Home position switch status */ \
+    X(Station, bool, gunArmed, false)                                        /* Weapon arming status */ \
+    X(Station, bool, ammoLoaded, false)                                      /* Ammunition loaded status */ \
+    X(Station, bool, authorized, false)                                      /* System authorization status */ \
+    X(Station, bool, detectionEnabled, false)                                /* Target detection enable status */ \
+    X(Station, FireMode, fireMode, FireMode::Unknown)                        /* Current weapon fire mode */ \
+    X(Station, double, gimbalSpeed, 2.0)                                     /* Speed switch setting */ \
+    X(Station, bool, enableStabilization, true)                              /* Platform stabilization enable switch */ \
+    /* GIMBAL STATION HARDWARE (PLC42): limit sensors */ \
+    X(Station, bool, upperLimitSensorActive, false)                          /* Upper travel limit sensor status */ \
+    X(Station, bool, lowerLimitSensorActive, false)                          /* Lower travel limit sensor status */ \
+    X(Station, bool, emergencyStopActive, false)                             /* Emergency stop activation status */ \
+    /* GIMBAL STATION HARDWARE (PLC42): station inputs */ \
+    X(Station, bool, stationAmmunitionLevel, false)                          /* Station ammunition level sensor */ \
+    X(Station, bool, stationInput1, false)                                   /* General station input 1 */ \
+    X(Station, bool, stationInput2, false)                                   /* General station input 2 */ \
+    X(Station, bool, stationInput3, false)                                   /* General station input 3 */ \
+    /* GIMBAL STATION HARDWARE (PLC42): environmental monitoring */ \
+    X(DeviceHealth, int, panelTemperature, 0)                                /* Control panel temperature in Celsius */ \
+    X(DeviceHealth, int, stationTemperature, 0)                              /* Station ambient temperature in Celsius */ \
+    X(DeviceHealth, int, stationPressure, 0)                                 /* Station atmospheric pressure */ \
+    /* GIMBAL STATION HARDWARE (PLC42): control states */ \
+    X(Station, uint16_t, solenoidMode, 0)                                    /* Solenoid valve mode setting */ \
+    X(Station, uint16_t, gimbalOpMode, 0)                                    /* Gimbal operational mode */ \
+    X(Station, uint32_t, azimuthSpeed, 0)                                    /* Azimuth movement speed setting */ \
+    X(Station, uint32_t, elevationSpeed, 0)                                  /* Elevation movement speed setting */ \
+    X(Station, uint16_t, azimuthDirection, 0)                                /* Azimuth movement direction */ \
+    X(Station, uint16_t, elevationDirection, 0)                              /* Elevation movement direction */ \
+    X(Station, uint16_t, solenoidState, 0)                                   /* Current solenoid state */ \
+    X(Station, uint16_t, resetAlarm, 0)                                      /* Alarm reset control */ \
+    /* TRACKING SYSTEM */ \
+    X(Controls, bool, upTrack, false)                                        /* Up tracking button status */ \
+    X(Controls, bool, downTrack, false)                                      /* Down tracking button status */ \
+    X(Controls, bool, valTrack, false)                                       /* Track validation button status */ \
+    X(Tracking, bool, startTracking, false)                                  /* Start tracking command status */ \
+    X(Tracking, bool, requestTrackingRestart, false)                         /* Tracking restart request status */ \
+    X(Tracking, bool, trackingActive, false)                                 /* Current tracking active status */ \
+    X(Tracking, double, targetAz, 0.0)                                       /* Current target azimuth in degrees */ \
+    X(Tracking, double, targetEl, 0.0)                                       /* Current target elevation in degrees */ \
+    X(Tracking, float, trackedTargetVelocityX_px_s, 0.0f)                    /* Tracked target image velocity, pixels/s */ \
+    X(Tracking, float, trackedTargetVelocityY_px_s, 0.0f) \
+    X(Optics, float, currentCameraHfovDegrees, 45.0f)                        /* Set by CameraController */ \
+    /* Active tracked target data (from video processor) */ \
+    X(Tracking, bool, trackerHasValidTarget, false) \
+    X(Tracking, float, trackedTargetCenterX_px, 0.0f) \
+    X(Tracking, float, trackedTargetCenterY_px, 0.0f) \
+    X(Tracking, float, trackedTargetWidth_px, 0.0f) \
+    X(Tracking, float, trackedTargetHeight_px, 0.0f) \
+    X(Tracking, VPITrackingState, trackedTargetState, VPI_TRACKING_STATE_LOST) /* The raw tracker state */ \
+    X(Tracking, TrackingPhase, currentTrackingPhase, TrackingPhase::Off) \
+    /* Acquisition gate/box defined by the user before lock-on, in image pixel coordinates */ \
+    X(Tracking, float, acquisitionBoxX_px, 512.0f) \
+    X(Tracking, float, acquisitionBoxY_px, 384.0f) \
+    X(Tracking, float, acquisitionBoxW_px, 100.0f) \
+    X(Tracking, float, acquisitionBoxH_px, 100.0f) \
+    /* BALLISTICS & FIRE CONTROL: zeroing */ \
+    X(Ballistics, bool, zeroingModeActive, false)                            /* Weapon zeroing mode active status */ \
+    X(Ballistics, float, zeroingAzimuthOffset, 0.0f)                         /* Zeroing azimuth offset in degrees */ \
+    X(Ballistics, float, zeroingElevationOffset, 0.0f)                       /* Zeroing elevation offset in degrees */ \
+    X(Ballistics, bool, zeroingAppliedToBallistics, false)                   /* Whether zeroing is applied to ballistic calculations */ \
+    /* BALLISTICS & FIRE CONTROL: windage */ \
+    X(Ballistics, bool, windageModeActive, false)                            /* Windage compensation mode active status */ \
+    X(Ballistics, float, windageSpeedKnots, 0.0f)                            /* Wind speed for windage calculation in knots */ \
+    X(Ballistics, bool, windageAppliedToBallistics, false)                   /* Whether windage is applied to ballistic calculations */ \
+    /* BALLISTICS & FIRE CONTROL: lead angle */ \
+    X(Ballistics, bool, leadAngleCompensationActive, false)                  /* Lead angle compensation active status */ \
+    X(Ballistics, LeadAngleStatus, currentLeadAngleStatus, LeadAngleStatus::Off) /* Current lead angle system status */ \
+    X(Ballistics, float, leadAngleOffsetAz, 0.0f)                            /* Lead angle azimuth offset in degrees */ \
+    X(Ballistics, float, leadAngleOffsetEl, 0.0f)                            /* Lead angle elevation offset in degrees */ \
+    /* BALLISTICS & FIRE CONTROL: target parameters */ \
+    X(Ballistics, float, currentTargetRange, 2000.0f)                        /* Current target range in meters */ \
+    X(Ballistics, float, currentTargetAngularRateAz, 0.0f)                   /* Target angular rate in azimuth (degrees/second) */ \
+    X(Ballistics, float, currentTargetAngularRateEl, 0.0f)                   /* Target angular rate in elevation (degrees/second) */ \
+    X(Ballistics, float, muzzleVelocityMPS, 900.0f)                          /* Projectile muzzle velocity in meters per second */ \
+    /* STATUS & INFORMATION DISPLAY */ \
+    X(StatusText, QString, weaponSystemStatus, )                             /* Weapon system status message */ \
+    X(StatusText, QString, targetInformation, )                              /* Current target information display */ \
+    X(StatusText, QString, gpsCoordinates, )                                 /* GPS coordinate information */ \
+    X(StatusText, QString, sensorReadings, )                                 /* Sensor readings summary */ \
+    X(StatusText, QString, alertsWarnings, )                                 /* System alerts and warnings */ \
+    X(StatusText, QString, leadStatusText, )                                 /* Lead angle status text for display */ \
+    X(StatusText, QString, zeroingStatusText, )                              /* Zeroing status text for display */
+
+/**
+ * @brief One enumerator per SystemStateData field, in declaration order
+ */
+enum class StateField : int {
+#define SYSTEM_STATE_FIELD_ENUMERATOR(group, type, name, init) name,
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_ENUMERATOR)
+#undef SYSTEM_STATE_FIELD_ENUMERATOR
+    Count
+};
+
+constexpr std::size_t STATE_FIELD_COUNT = static_cast<std::size_t>(StateField::Count);
+
+/**
+ * @brief Set of SystemStateData fields, indexed by StateField (see SystemStateData::changedFields())
+ */
+using StateFieldSet = std::bitset<STATE_FIELD_COUNT>;
+
+/**
+ * @brief Name of @p field as declared, e.g. "gimbalAz"
+ */
+const char *stateFieldName(StateField field);
+
+/**
+ * @brief Hash of the declared type and name of every field, in table order
+ */
+quint32 stateSchemaHash();
+
+/**
+ * @brief Group notified when @p field changes
+ */
+StateGroup stateFieldGroup(StateField field);
+
+/**
+ * @brief Groups of all fields in @p fields
+ */
+StateGroups stateFieldGroups(const StateFieldSet &fields);
+
+/**
+ * @brief Names of the fields in @p fields, for logs
+ */
+QStringList stateFieldNames(const StateFieldSet &fields);
+
+// =================================
+// MAIN SYSTEM STATE STRUCTURE
+// =================================
+
+/**
+ * @brief Comprehensive system state structure containing all RCWS operational data
+ * 
+ * This structure serves as the central data repository for the entire RCWS system,
+ * organizing all operational parameters, sensor data, control states, and status
+ * information into logical categories for efficient access and management.
+ *
+ * The members are generated from SYSTEM_STATE_FIELDS, which documents them.
+ */
+struct SystemStateData {
     
     // =================================
-    // STATUS & INFORMATION DISPLAY
+    // STATE FIELDS
     // =================================
-    QString weaponSystemStatus;         ///< Weapon system status message
-    QString targetInformation;          ///< Current target information display
-    QString gpsCoordinates;             ///< GPS coordinate information
-    QString sensorReadings;             ///< Sensor readings summary
-    QString alertsWarnings;             ///< System alerts and warnings
-    QString leadStatusText = "";        ///< Lead angle status text for display
-    QString zeroingStatusText = "";     ///< Zeroing status text for display
+#define SYSTEM_STATE_FIELD_MEMBER(group, type, name, init) type name{init};
+    SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_MEMBER)
+#undef SYSTEM_STATE_FIELD_MEMBER
     
     // =================================
     // HELPER FUNCTIONS
@@ -552,6 +726,120 @@ struct SystemStateData {
                                  : (!nightCameraError && nightCameraConnected);
     }
     
+    // --- Group Payloads ---
+    OpticsState optics() const {
+        OpticsState o;
+        o.activeCameraIsDay = activeCameraIsDay;
+        o.activeCameraIndex = activeCameraIndex;
+        o.dayZoomPosition = dayZoomPosition;
+        o.dayCurrentHFOV = dayCurrentHFOV;
+        o.nightZoomPosition = nightZoomPosition;
+        o.nightCurrentHFOV = nightCurrentHFOV;
+        o.imageWidthPx = currentImageWidthPx;
+        o.imageHeightPx = currentImageHeightPx;
+        o.reticleAimpointImageX_px = reticleAimpointImageX_px;
+        o.reticleAimpointImageY_px = reticleAimpointImageY_px;
+        o.currentCameraHfovDegrees = currentCameraHfovDegrees;
+        return o;
+    }
+
+    DeviceHealthState deviceHealth() const {
+        DeviceHealthState h;
+        h.dayCameraConnected = dayCameraConnected;
+        h.dayCameraError = dayCameraError;
+        h.dayCameraStatus = dayCameraStatus;
+        h.dayVideoHealth = dayVideoHealth;
+        h.nightCameraConnected = nightCameraConnected;
+        h.nightCameraError = nightCameraError;
+        h.nightCameraStatus = nightCameraStatus;
+        h.nightVideoHealth = nightVideoHealth;
+        h.auxVideoHealth = auxVideoHealth;
+        h.azMotorTemp = azMotorTemp;
+        h.azDriverTemp = azDriverTemp;
+        h.elMotorTemp = elMotorTemp;
+        h.elDriverTemp = elDriverTemp;
+        h.temperature = temperature;
+        h.lrfSystemStatus = lrfSystemStatus;
+        h.isOverTemperature = isOverTemperature;
+        h.panelTemperature = panelTemperature;
+        h.stationTemperature = stationTemperature;
+        h.stationPressure = stationPressure;
+        return h;
+    }
+
+    TrackingState tracking() const {
+        TrackingState t;
+        t.startTracking = startTracking;
+        t.requestTrackingRestart = requestTrackingRestart;
+        t.trackingActive = trackingActive;
+        t.phase = currentTrackingPhase;
+        t.trackerHasValidTarget = trackerHasValidTarget;
+        t.trackedTargetState = trackedTargetState;
+        t.trackedTargetCenterX_px = trackedTargetCenterX_px;
+        t.trackedTargetCenterY_px = trackedTargetCenterY_px;
+        t.trackedTargetWidth_px = trackedTargetWidth_px;
+        t.trackedTargetHeight_px = trackedTargetHeight_px;
+        t.trackedTargetVelocityX_px_s = trackedTargetVelocityX_px_s;
+        t.trackedTargetVelocityY_px_s = trackedTargetVelocityY_px_s;
+        t.targetAz = targetAz;
+        t.targetEl = targetEl;
+        t.acquisitionBoxX_px = acquisitionBoxX_px;
+        t.acquisitionBoxY_px = acquisitionBoxY_px;
+        t.acquisitionBoxW_px = acquisitionBoxW_px;
+        t.acquisitionBoxH_px = acquisitionBoxH_px;
+        return t;
+    }
+
+    BallisticsState ballistics() const {
+        BallisticsState b;
+        b.zeroingModeActive = zeroingModeActive;
+        b.zeroingAzimuthOffset = zeroingAzimuthOffset;
+        b.zeroingElevationOffset = zeroingElevationOffset;
+        b.zeroingAppliedToBallistics = zeroingAppliedToBallistics;
+        b.windageModeActive = windageModeActive;
+        b.windageSpeedKnots = windageSpeedKnots;
+        b.windageAppliedToBallistics = windageAppliedToBallistics;
+        b.leadAngleCompensationActive = leadAngleCompensationActive;
+        b.currentLeadAngleStatus = currentLeadAngleStatus;
+        b.leadAngleOffsetAz = leadAngleOffsetAz;
+        b.leadAngleOffsetEl = leadAngleOffsetEl;
+        b.lrfDistance = lrfDistance;
+        b.currentTargetRange = currentTargetRange;
+        b.currentTargetAngularRateAz = currentTargetAngularRateAz;
+        b.currentTargetAngularRateEl = currentTargetAngularRateEl;
+        b.muzzleVelocityMPS = muzzleVelocityMPS;
+        return b;
+    }
+
+    /**
+     * @brief Fields that differ from @p other
+     *
+     * Exact comparisons (a change is a change). Implicitly shared members that still
+     * share their data with @p other compare in constant time.
+     */
+    StateFieldSet changedFields(const SystemStateData& other) const {
+        StateFieldSet fields;
+#define SYSTEM_STATE_FIELD_DIFF(group, type, name, init) \
+        if (!(name == other.name)) { fields.set(static_cast<std::size_t>(StateField::name)); }
+        SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_DIFF)
+#undef SYSTEM_STATE_FIELD_DIFF
+        return fields;
+    }
+
+    /**
+     * @brief Groups with at least one field different from @p other
+     *
+     * Same comparisons as changedFields(), skipping the fields of groups already found changed.
+     */
+    StateGroups changedGroups(const SystemStateData& other) const {
+        StateGroups groups;
+#define SYSTEM_STATE_GROUP_DIFF(group, type, name, init) \
+        if (!groups.testFlag(StateGroup::group) && !(name == other.name)) { groups |= StateGroup::group; }
+        SYSTEM_STATE_FIELDS(SYSTEM_STATE_GROUP_DIFF)
+#undef SYSTEM_STATE_GROUP_DIFF
+        return groups;
+    }
+
     // =================================
     // COMPARISON OPERATORS
     // =================================
@@ -562,130 +850,46 @@ struct SystemStateData {
      * @return True if all system state parameters are identical
      */
     bool operator==(const SystemStateData& other) const {
-        return opMode == other.opMode && 
-               motionMode == other.motionMode && 
-               previousOpMode == other.previousOpMode &&
-               previousMotionMode == other.previousMotionMode &&
-               reticleType == other.reticleType &&
-               osdColorStyle == other.osdColorStyle &&
-               colorStyle == other.colorStyle &&
-               currentImageWidthPx == other.currentImageWidthPx &&
-               currentImageHeightPx == other.currentImageHeightPx &&
-               qFuzzyCompare(reticleAimpointImageX_px, other.reticleAimpointImageX_px) &&
-               qFuzzyCompare(reticleAimpointImageY_px, other.reticleAimpointImageY_px) &&
-               areaZones == other.areaZones &&
-               sectorScanZones == other.sectorScanZones &&
-               targetReferencePoints == other.targetReferencePoints &&
-               activeAutoSectorScanZoneId == other.activeAutoSectorScanZoneId &&
-               activeTRPLocationPage == other.activeTRPLocationPage &&
-               currentScanName == other.currentScanName &&
-               currentTRPScanName == other.currentTRPScanName &&
-               isReticleInNoFireZone == other.isReticleInNoFireZone &&
-               isReticleInNoTraverseZone == other.isReticleInNoTraverseZone &&
-               qFuzzyCompare(dayZoomPosition, other.dayZoomPosition) &&
-               qFuzzyCompare(dayCurrentHFOV, other.dayCurrentHFOV) &&
-               dayCameraConnected == other.dayCameraConnected &&
-               dayCameraError == other.dayCameraError &&
-               dayCameraStatus == other.dayCameraStatus &&
-               qFuzzyCompare(nightZoomPosition, other.nightZoomPosition) &&
-               qFuzzyCompare(nightCurrentHFOV, other.nightCurrentHFOV) &&
-               nightCameraConnected == other.nightCameraConnected &&
-               nightCameraError == other.nightCameraError &&
-               nightCameraStatus == other.nightCameraStatus &&
-               activeCameraIsDay == other.activeCameraIsDay &&
-               qFuzzyCompare(gimbalAz, other.gimbalAz) &&
-               qFuzzyCompare(gimbalEl, other.gimbalEl) &&
-               qFuzzyCompare(azMotorTemp, other.azMotorTemp) &&
-               qFuzzyCompare(azDriverTemp, other.azDriverTemp) &&
-               qFuzzyCompare(elMotorTemp, other.elMotorTemp) &&
-               qFuzzyCompare(elDriverTemp, other.elDriverTemp) &&
-               qFuzzyCompare(reticleAz, other.reticleAz) &&
-               qFuzzyCompare(reticleEl, other.reticleEl) &&
-               qFuzzyCompare(actuatorPosition, other.actuatorPosition) &&
-               qFuzzyCompare(imuRollDeg, other.imuRollDeg) &&
-               qFuzzyCompare(imuPitchDeg, other.imuPitchDeg) &&
-               qFuzzyCompare(imuYawDeg, other.imuYawDeg) &&
-                qFuzzyCompare(temperature, other.temperature) &&
-                AccelX == other.AccelX &&
-                AccelY == other.AccelY &&
-                AccelZ == other.AccelZ &&
-                GyroX == other.GyroX &&
-                GyroY == other.GyroY &&
-                GyroZ == other.GyroZ &&
-               enableStabilization == other.enableStabilization &&
-               qFuzzyCompare(lrfDistance, other.lrfDistance) &&
-               lrfSystemStatus == other.lrfSystemStatus &&
-               deadManSwitchActive == other.deadManSwitchActive &&
-               qFuzzyCompare(joystickAzValue, other.joystickAzValue) &&
-               qFuzzyCompare(joystickElValue, other.joystickElValue) &&
-               upTrackButton == other.upTrackButton &&
-               downTrackButton == other.downTrackButton &&
-               menuUp == other.menuUp &&
-               menuDown == other.menuDown &&
-               menuVal == other.menuVal &&
-               stationEnabled == other.stationEnabled &&
-               gotoHomePosition == other.gotoHomePosition &&
-               gunArmed == other.gunArmed &&
-               ammoLoaded == other.ammoLoaded &&
-
-               authorized == other.authorized &&
-               detectionEnabled == other.detectionEnabled &&
-               fireMode == other.fireMode &&
-               qFuzzyCompare(gimbalSpeed, other.gimbalSpeed) &&
-               upperLimitSensorActive == other.upperLimitSensorActive &&
-               lowerLimitSensorActive == other.lowerLimitSensorActive &&
-               emergencyStopActive == other.emergencyStopActive &&
-               stationAmmunitionLevel == other.stationAmmunitionLevel &&
-               stationInput1 == other.stationInput1 &&
-               stationInput2 == other.stationInput2 &&
-               stationInput3 == other.stationInput3 &&
-               panelTemperature == other.panelTemperature &&
-               stationTemperature == other.stationTemperature &&
-               stationPressure == other.stationPressure &&
-               solenoidMode == other.solenoidMode &&
-               gimbalOpMode == other.gimbalOpMode &&
-               azimuthSpeed == other.azimuthSpeed &&
-               elevationSpeed == other.elevationSpeed &&
-               azimuthDirection == other.azimuthDirection &&
-               elevationDirection == other.elevationDirection &&
-               solenoidState == other.solenoidState &&
-               resetAlarm == other.resetAlarm &&
-               upTrack == other.upTrack &&
-               downTrack == other.downTrack &&
-               valTrack == other.valTrack &&
-               startTracking == other.startTracking &&
-               requestTrackingRestart == other.requestTrackingRestart &&
-               trackingActive == other.trackingActive &&
-               qFuzzyCompare(targetAz, other.targetAz) &&
-               qFuzzyCompare(targetEl, other.targetEl) &&
-               zeroingModeActive == other.zeroingModeActive &&
-               qFuzzyCompare(zeroingAzimuthOffset, other.zeroingAzimuthOffset) &&
-               qFuzzyCompare(zeroingElevationOffset, other.zeroingElevationOffset) &&
-               zeroingAppliedToBallistics == other.zeroingAppliedToBallistics &&
-               windageModeActive == other.windageModeActive &&
-               qFuzzyCompare(windageSpeedKnots, other.windageSpeedKnots) &&
-               windageAppliedToBallistics == other.windageAppliedToBallistics &&
-               leadAngleCompensationActive == other.leadAngleCompensationActive &&
-               currentLeadAngleStatus == other.currentLeadAngleStatus &&
-               qFuzzyCompare(leadAngleOffsetAz, other.leadAngleOffsetAz) &&
-               qFuzzyCompare(leadAngleOffsetEl, other.leadAngleOffsetEl) &&
-               qFuzzyCompare(currentTargetRange, other.currentTargetRange) &&
-               qFuzzyCompare(currentTargetAngularRateAz, other.currentTargetAngularRateAz) &&
-               qFuzzyCompare(currentTargetAngularRateEl, other.currentTargetAngularRateEl) &&
-               qFuzzyCompare(muzzleVelocityMPS, other.muzzleVelocityMPS) &&
-               weaponSystemStatus == other.weaponSystemStatus &&
-               targetInformation == other.targetInformation &&
-               gpsCoordinates == other.gpsCoordinates &&
-               sensorReadings == other.sensorReadings &&
-               alertsWarnings == other.alertsWarnings &&
-               leadStatusText == other.leadStatusText &&
-               zeroingStatusText == other.zeroingStatusText&&
-               (radarPlots == other.radarPlots);
+#define SYSTEM_STATE_FIELD_EQUAL(group, type, name, init) \
+        if (!(name == other.name)) { return false; }
+        SYSTEM_STATE_FIELDS(SYSTEM_STATE_FIELD_EQUAL)
+#undef SYSTEM_STATE_FIELD_EQUAL
+        return true;
     }
     
     bool operator!=(const SystemStateData& other) const {
         return !(*this == other);
     }
 };
+Q_DECLARE_METATYPE(SystemStateData)
+
+// =================================
+// SERIALIZATION & DEBUG OUTPUT
+// =================================
+
+/**
+ * @brief Binary snapshot of every field in table order, preceded by a magic and stateSchemaHash()
+ *
+ * Reading a snapshot written with a different field table (a field added, removed,
+ * renamed, retyped or moved) sets QDataStream::ReadCorruptData.
+ */
+QDataStream &operator<<(QDataStream &out, const SystemStateData &data);
+QDataStream &operator>>(QDataStream &in, SystemStateData &data);
+
+/**
+ * @brief Prints every field as name=value; lists print their size
+ */
+QDebug operator<<(QDebug debug, const SystemStateData &data);
+
+QDataStream &operator<<(QDataStream &out, const AreaZone &zone);
+QDataStream &operator>>(QDataStream &in, AreaZone &zone);
+QDataStream &operator<<(QDataStream &out, const AutoSectorScanZone &zone);
+QDataStream &operator>>(QDataStream &in, AutoSectorScanZone &zone);
+QDataStream &operator<<(QDataStream &out, const TargetReferencePoint &trp);
+QDataStream &operator>>(QDataStream &in, TargetReferencePoint &trp);
+QDataStream &operator<<(QDataStream &out, const SimpleRadarPlot &plot);
+QDataStream &operator>>(QDataStream &in, SimpleRadarPlot &plot);
+QDataStream &operator<<(QDataStream &out, const VideoStreamHealth &health);
+QDataStream &operator>>(QDataStream &in, VideoStreamHealth &health);
 
 #endif // SYSTEMSTATEDATA_H
@@ -4,9 +4,30 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QElapsedTimer>
+#include <QThread>
 #include <algorithm> // For std::find_if, std::sort (if needed)
 #include <set>       // For getting unique page numbers
+#include <utility>   // For std::as_const
 
+namespace {
+// The panel switch selects day or night: follow it whenever it changes, even away from an auxiliary camera
+void followDayNightSwitch(const SystemStateData &oldData, SystemStateData &newData)
+{
+    if (newData.activeCameraIsDay != oldData.activeCameraIsDay) {
+        newData.activeCameraIndex = newData.activeCameraIsDay ? 0 : 1;
+    }
+}
+
+constexpr qint64 SIGNAL_STATS_LOG_INTERVAL_MS = 10000;
+
+// Bytes a queued receiver copies for one SystemStateData. Zone vectors, radar plots and
+// strings are implicitly shared, so only the struct itself is copied
+qint64 wholeStateCopyBytes(const SystemStateData &)
+{
+    return static_cast<qint64>(sizeof(SystemStateData));
+}
+} // namespace
 
 SystemStateModel::SystemStateModel(QObject *parent)
     : QObject(parent),
@@ -14,6 +35,13 @@ SystemStateModel::SystemStateModel(QObject *parent)
       m_nextSectorScanId(1),
       m_nextTRPId(1)
 {
+    qRegisterMetaType<SystemStateData>("SystemStateData");
+    qRegisterMetaType<StateGroups>("StateGroups");
+    qRegisterMetaType<OpticsState>("OpticsState");
+    qRegisterMetaType<DeviceHealthState>("DeviceHealthState");
+    qRegisterMetaType<TrackingState>("TrackingState");
+    qRegisterMetaType<BallisticsState>("BallisticsState");
+
     // Initialize m_currentStateData with defaults if needed
     clearZeroing(); // Zero is lost on power down
     clearWindage(); // Windage is zero on startup
@@ -41,27 +69,184 @@ SystemStateModel::SystemStateModel(QObject *parent)
 }
 
 // --- General Data Update ---
-void SystemStateModel::updateData(const SystemStateData &newState) {
+void SystemStateModel::updateData(const SystemStateData &state) {
 
     SystemStateData oldData = m_currentStateData;
+    SystemStateData newState = state;
+    followDayNightSwitch(oldData, newState);
 
     // Check if anything has actually changed to avoid unnecessary signals/updates
-    if (oldData == newState) { // Assumes you have operator== for SystemStateData
+    if (oldData == newState) {
+        return;
+    }
+    m_currentStateData = newState;
+    processStateTransitions(oldData, m_currentStateData);
+    publishState(); // Group signals (gimbal position included) follow the fields that changed
+}
+
+void SystemStateModel::setCoalescingWindow(int windowMs)
+{
+    windowMs = qMax(0, windowMs);
+    if (windowMs == m_coalescingWindowMs) {
+        return;
+    }
+    m_coalescingWindowMs = windowMs;
+
+    if (windowMs == 0) {
+        if (m_coalescingTimer) {
+            m_coalescingTimer->stop();
+        }
+        const StateGroups changed = m_currentStateData.changedGroups(m_publishedStateData);
+        if (changed) {
+            emitState(changed); // Updates undone within the window publish nothing, as on a tick
+        }
+        m_pendingUpdates = 0;
+        qInfo() << "SystemStateModel: update coalescing off";
+        return;
+    }
+
+    if (!m_coalescingTimer) {
+        m_coalescingTimer = new QTimer(this);
+        m_coalescingTimer->setTimerType(Qt::PreciseTimer);
+        connect(m_coalescingTimer, &QTimer::timeout, this, &SystemStateModel::onCoalescingTick);
+    }
+    m_coalescingTimer->start(windowMs);
+    qInfo() << "SystemStateModel: coalescing updates every" << windowMs << "ms, immediate groups" << m_immediateGroups;
+}
+
+void SystemStateModel::onCoalescingTick()
+{
+    const StateGroups changed = m_currentStateData.changedGroups(m_publishedStateData);
+    if (m_pendingUpdates == 0 || !changed) {
+        ++m_coalescingStats.idleTicks; // A change undone within the window needs no publish
+        m_pendingUpdates = 0;
         return;
     }
-    if (m_currentStateData != newState) {
-        // Check specifically if gimbal position changed before updating m_currentStateData
-        bool gimbalChanged = !qFuzzyCompare(m_currentStateData.gimbalAz, newState.gimbalAz) ||
-                             !qFuzzyCompare(m_currentStateData.gimbalEl, newState.gimbalEl);
+    ++m_coalescingStats.ticks;
+    m_coalescingStats.mergedUpdates += m_pendingUpdates;
+    m_coalescingStats.maxMergedPerTick = qMax(m_coalescingStats.maxMergedPerTick, m_pendingUpdates);
+    emitState(changed);
+}
+
+void SystemStateModel::publishState()
+{
+    Q_ASSERT_X(QThread::currentThread() == thread(), "SystemStateModel::publishState",
+               "state changes must be made on the model's thread");
+    const StateGroups changed = m_currentStateData.changedGroups(m_publishedStateData);
+    if (m_coalescingWindowMs > 0) {
+        ++m_pendingUpdates;
+        if (!(changed & m_immediateGroups)) {
+            return; // Goes out with the next tick
+        }
+        ++m_coalescingStats.immediatePublishes;
+        m_coalescingStats.immediateUpdates += m_pendingUpdates;
+    }
+    emitState(changed);
+}
+
+void SystemStateModel::emitState(StateGroups changed)
+{
+    m_pendingUpdates = 0;
+    m_publishedStateData = m_currentStateData;
+    m_snapshot.publish(m_currentStateData); // Before the signals, so slots reading snapshot() agree
+    const SystemStateData &data = m_currentStateData;
 
-        m_currentStateData = newState;
-        processStateTransitions(oldData, m_currentStateData);
-        emit dataChanged(m_currentStateData);
+    emit dataChanged(data);
+    recordDelivery(SIGNAL(dataChanged(SystemStateData)), wholeStateCopyBytes(data), true);
+
+    if (changed & StateGroup::Modes) {
+        emit modesChanged(data.opMode, data.motionMode);
+        recordDelivery(SIGNAL(modesChanged(OperationalMode,MotionMode)),
+                       sizeof(OperationalMode) + sizeof(MotionMode), false);
+    }
+    if (changed & StateGroup::UiStyle) {
+        emit uiStyleChanged(data.colorStyle, data.reticleType);
+        recordDelivery(SIGNAL(uiStyleChanged(QColor,ReticleType)),
+                       sizeof(QColor) + sizeof(ReticleType), false);
+    }
+    if (changed & StateGroup::Optics) {
+        emit opticsChanged(data.optics());
+        recordDelivery(SIGNAL(opticsChanged(OpticsState)), sizeof(OpticsState), false);
+    }
+    if (changed & StateGroup::DeviceHealth) {
+        emit deviceHealthChanged(data.deviceHealth());
+        recordDelivery(SIGNAL(deviceHealthChanged(DeviceHealthState)), sizeof(DeviceHealthState), false);
+    }
+    if (changed & StateGroup::GimbalPose) {
+        emit gimbalPositionChanged(data.gimbalAz, data.gimbalEl);
+        recordDelivery(SIGNAL(gimbalPositionChanged(float,float)), 2 * sizeof(float), false);
+    }
+    if (changed & StateGroup::Radar) {
+        emit radarChanged(data.radarPlots, data.selectedRadarTrackId);
+        recordDelivery(SIGNAL(radarChanged(QVector<SimpleRadarPlot>,quint32)),
+                       sizeof(QVector<SimpleRadarPlot>) + sizeof(quint32), false);
+    }
+    if (changed & StateGroup::Tracking) {
+        emit trackingChanged(data.tracking());
+        recordDelivery(SIGNAL(trackingChanged(TrackingState)), sizeof(TrackingState), false);
+    }
+    if (changed & StateGroup::Ballistics) {
+        emit ballisticsChanged(data.ballistics());
+        recordDelivery(SIGNAL(ballisticsChanged(BallisticsState)), sizeof(BallisticsState), false);
+    }
+    if (changed) {
+        emit stateGroupsChanged(changed);
+        recordDelivery(SIGNAL(stateGroupsChanged(StateGroups)), sizeof(StateGroups), false);
+    }
 
-        // Emit gimbal position change if it occurred
-        if (gimbalChanged) {
-            emit gimbalPositionChanged(m_currentStateData.gimbalAz, m_currentStateData.gimbalEl);
+    if (!m_signalStatsEnabled) {
+        return;
+    }
+    ++m_signalStats.publishes;
+    const qint64 elapsedMs = m_signalStatsTimer.elapsed();
+    if (elapsedMs >= SIGNAL_STATS_LOG_INTERVAL_MS) {
+        const double seconds = elapsedMs / 1000.0;
+        qDebug().nospace() << "SystemStateModel: " << QString::number(m_signalStats.publishes / seconds, 'f', 1)
+                           << " updates/s; whole-state deliveries "
+                           << QString::number(m_signalStats.wholeStateDeliveries / seconds, 'f', 1) << "/s ("
+                           << QString::number(m_signalStats.wholeStateBytes / seconds / 1024.0, 'f', 1)
+                           << " KiB/s, " << wholeStateCopyBytes(data) << " B each); group deliveries "
+                           << QString::number(m_signalStats.groupDeliveries / seconds, 'f', 1) << "/s ("
+                           << QString::number(m_signalStats.groupBytes / seconds / 1024.0, 'f', 1) << " KiB/s)";
+        if (m_coalescingWindowMs > 0) {
+            const CoalescingStats &total = m_coalescingStats;
+            const CoalescingStats &last = m_loggedCoalescingStats;
+            const quint64 ticks = total.ticks - last.ticks;
+            qDebug().nospace() << "SystemStateModel: coalescing " << m_coalescingWindowMs << " ms: "
+                               << QString::number(ticks ? static_cast<double>(total.mergedUpdates - last.mergedUpdates) / ticks : 0.0, 'f', 2)
+                               << " updates merged per tick over " << ticks << " ticks (max "
+                               << total.maxMergedPerTick << " since start), " << (total.idleTicks - last.idleTicks)
+                               << " idle ticks, " << (total.immediatePublishes - last.immediatePublishes)
+                               << " immediate publishes carrying " << (total.immediateUpdates - last.immediateUpdates)
+                               << " updates";
+            m_loggedCoalescingStats = m_coalescingStats;
         }
+        m_signalStats = SignalStats();
+        m_signalStatsTimer.restart();
+    }
+}
+
+void SystemStateModel::setSignalStatsEnabled(bool enabled)
+{
+    m_signalStatsEnabled = enabled;
+    m_signalStats = SignalStats();
+    m_loggedCoalescingStats = m_coalescingStats;
+    m_signalStatsTimer.start();
+}
+
+void SystemStateModel::recordDelivery(const char *signal, qint64 payloadBytes, bool wholeState)
+{
+    if (!m_signalStatsEnabled) {
+        return;
+    }
+    // Bytes are an upper bound: only queued receivers copy the arguments
+    const int receiverCount = receivers(signal);
+    if (wholeState) {
+        m_signalStats.wholeStateDeliveries += static_cast<quint64>(receiverCount);
+        m_signalStats.wholeStateBytes += receiverCount * payloadBytes;
+    } else {
+        m_signalStats.groupDeliveries += static_cast<quint64>(receiverCount);
+        m_signalStats.groupBytes += receiverCount * payloadBytes;
     }
 }
 
@@ -90,15 +275,28 @@ void SystemStateModel::setReticleStyle(const ReticleType &type)
     emit reticleStyleChanged(type);
 }
 
-void SystemStateModel::setDeadManSwitch(bool pressed) { if(m_currentStateData.deadManSwitchActive != pressed) { m_currentStateData.deadManSwitchActive = pressed; emit dataChanged(m_currentStateData); } }
-void SystemStateModel::setDownTrack(bool pressed) { if(m_currentStateData.downTrack != pressed) { m_currentStateData.downTrack = pressed; emit dataChanged(m_currentStateData); } }
-void SystemStateModel::setDownSw(bool pressed) { if(m_currentStateData.menuDown != pressed) { m_currentStateData.menuDown = pressed; emit dataChanged(m_currentStateData); } }
-void SystemStateModel::setUpTrack(bool pressed) { if(m_currentStateData.upTrack != pressed) { m_currentStateData.upTrack = pressed; emit dataChanged(m_currentStateData); } }
-void SystemStateModel::setUpSw(bool pressed) { if(m_currentStateData.menuUp != pressed) { m_currentStateData.menuUp = pressed; emit dataChanged(m_currentStateData); } }
-void SystemStateModel::setActiveCameraIsDay(bool pressed) { if(m_currentStateData.activeCameraIsDay != pressed) { m_currentStateData.activeCameraIsDay = pressed; emit dataChanged(m_currentStateData); } }
+void SystemStateModel::setDeadManSwitch(bool pressed) { if(m_currentStateData.deadManSwitchActive != pressed) { m_currentStateData.deadManSwitchActive = pressed; publishState(); } }
+void SystemStateModel::setDownTrack(bool pressed) { if(m_currentStateData.downTrack != pressed) { m_currentStateData.downTrack = pressed; publishState(); } }
+void SystemStateModel::setDownSw(bool pressed) { if(m_currentStateData.menuDown != pressed) { m_currentStateData.menuDown = pressed; publishState(); } }
+void SystemStateModel::setUpTrack(bool pressed) { if(m_currentStateData.upTrack != pressed) { m_currentStateData.upTrack = pressed; publishState(); } }
+void SystemStateModel::setUpSw(bool pressed) { if(m_currentStateData.menuUp != pressed) { m_currentStateData.menuUp = pressed; publishState(); } }
+void SystemStateModel::setActiveCameraIsDay(bool pressed) { if(m_currentStateData.activeCameraIsDay != pressed) { m_currentStateData.activeCameraIsDay = pressed; m_currentStateData.activeCameraIndex = pressed ? 0 : 1; publishState(); } }
+
+void SystemStateModel::setActiveCameraIndex(int index)
+{
+    if (index < 0 || m_currentStateData.activeCameraIndex == index) {
+        return;
+    }
+    SystemStateData newData = m_currentStateData;
+    newData.activeCameraIndex = index;
+    if (index <= 1) {
+        newData.activeCameraIsDay = (index == 0);
+    }
+    updateData(newData);
+}
 
 // --- Area Zone Methods Implementation ---
-const std::vector<AreaZone>& SystemStateModel::getAreaZones() const {
+const QVector<AreaZone>& SystemStateModel::getAreaZones() const {
     return m_currentStateData.areaZones;
 }
 
@@ -145,7 +343,7 @@ bool SystemStateModel::deleteAreaZone(int id) {
 }
 
 // --- Auto Sector Scan Zone Methods Implementation ---
-const std::vector<AutoSectorScanZone>& SystemStateModel::getSectorScanZones() const {
+const QVector<AutoSectorScanZone>& SystemStateModel::getSectorScanZones() const {
     return m_currentStateData.sectorScanZones;
 }
 
@@ -192,7 +390,7 @@ bool SystemStateModel::deleteSectorScanZone(int id) {
 }
 
 // --- Target Reference Point Methods Implementation ---
-const std::vector<TargetReferencePoint>& SystemStateModel::getTargetReferencePoints() const {
+const QVector<TargetReferencePoint>& SystemStateModel::getTargetReferencePoints() const {
     return m_currentStateData.targetReferencePoints;
 }
 
@@ -251,7 +449,7 @@ bool SystemStateModel::saveZonesToFile(const QString& filePath) {
 
     // Save Area Zones
     QJsonArray areaZonesArray;
-    for (const auto& zone : m_currentStateData.areaZones) {
+    for (const auto& zone : std::as_const(m_currentStateData.areaZones)) {
         QJsonObject zoneObj;
         zoneObj["id"] = zone.id;
         zoneObj["type"] = static_cast<int>(zone.type); // Assuming type is always AreaZone type
@@ -271,7 +469,7 @@ bool SystemStateModel::saveZonesToFile(const QString& filePath) {
 
     // Save Sector Scan Zones
     QJsonArray sectorScanZonesArray;
-    for (const auto& zone : m_currentStateData.sectorScanZones) {
+    for (const auto& zone : std::as_const(m_currentStateData.sectorScanZones)) {
         QJsonObject zoneObj;
         zoneObj["id"] = zone.id;
         zoneObj["isEnabled"] = zone.isEnabled;
@@ -286,7 +484,7 @@ bool SystemStateModel::saveZonesToFile(const QString& filePath) {
 
     // Save Target Reference Points
     QJsonArray trpsArray;
-    for (const auto& trp : m_currentStateData.targetReferencePoints) {
+    for (const auto& trp : std::as_const(m_currentStateData.targetReferencePoints)) {
         QJsonObject trpObj;
         trpObj["id"] = trp.id;
         trpObj["locationPage"] = trp.locationPage;
@@ -440,20 +638,20 @@ bool SystemStateModel::loadZonesFromFile(const QString& filePath) {
 // Helper to update ID counters after loading zones
 void SystemStateModel::updateNextIdsAfterLoad() {
     int maxAreaId = 0;
-    for(const auto& zone : m_currentStateData.areaZones) {
+    for(const auto& zone : std::as_const(m_currentStateData.areaZones)) {
         maxAreaId = std::max(maxAreaId, zone.id);
     }
     // Ensure next ID is at least one greater than the max loaded ID, or the value read from file
     m_nextAreaZoneId = std::max(m_nextAreaZoneId, maxAreaId + 1);
 
     int maxSectorId = 0;
-    for(const auto& zone : m_currentStateData.sectorScanZones) {
+    for(const auto& zone : std::as_const(m_currentStateData.sectorScanZones)) {
         maxSectorId = std::max(maxSectorId, zone.id);
     }
     m_nextSectorScanId = std::max(m_nextSectorScanId, maxSectorId + 1);
 
     int maxTRPId = 0;
-    for(const auto& trp : m_currentStateData.targetReferencePoints) {
+    for(const auto& trp : std::as_const(m_currentStateData.targetReferencePoints)) {
         maxTRPId = std::max(maxTRPId, trp.id);
     }
     m_nextTRPId = std::max(m_nextTRPId, maxTRPId + 1);
@@ -470,8 +668,7 @@ void SystemStateModel::onServoAzDataChanged(const ServoData &azData) {
         m_currentStateData.azMotorTemp = azData.motorTemp;
         m_currentStateData.azDriverTemp = azData.driverTemp;
         // Potentially update other related fields from azData
-        emit dataChanged(m_currentStateData); // Emit general data change
-        emit gimbalPositionChanged(m_currentStateData.gimbalAz, m_currentStateData.gimbalEl); // Emit specific gimbal change
+        publishState(); // Also emits gimbalPositionChanged if the position moved
     //}
 }
 
@@ -482,8 +679,7 @@ void SystemStateModel::onServoElDataChanged(const ServoData &elData) {
         m_currentStateData.elMotorTemp = elData.motorTemp;
         m_currentStateData.elDriverTemp = elData.driverTemp;
         // Potentially update other related fields from elData
-        emit dataChanged(m_currentStateData); // Emit general data change
-        emit gimbalPositionChanged(m_currentStateData.gimbalAz, m_currentStateData.gimbalEl); // Emit specific gimbal change
+        publishState(); // Also emits gimbalPositionChanged if the position moved
     //}
 }
 
@@ -510,15 +706,15 @@ void SystemStateModel::setMotionMode(MotionMode newMode) {
         }
         m_currentStateData.motionMode = newMode;
 
-        emit dataChanged(m_currentStateData);
+        publishState();
          if (newMode == MotionMode::AutoSectorScan || newMode == MotionMode::TRPScan) {
             updateCurrentScanName(); // Ensure name is updated when entering these modes
         }
     }
 }
-void SystemStateModel::setOpMode(OperationalMode newOpMode) { if(m_currentStateData.opMode != newOpMode) { m_currentStateData.previousOpMode = m_currentStateData.opMode; m_currentStateData.opMode = newOpMode; emit dataChanged(m_currentStateData); } }
-void SystemStateModel::setTrackingRestartRequested(bool restart) { if(m_currentStateData.requestTrackingRestart != restart) { m_currentStateData.requestTrackingRestart = restart; emit dataChanged(m_currentStateData); } }
-void SystemStateModel::setTrackingStarted(bool start) { if(m_currentStateData.startTracking != start) { m_currentStateData.startTracking = start; emit dataChanged(m_currentStateData); } }
+void SystemStateModel::setOpMode(OperationalMode newOpMode) { if(m_currentStateData.opMode != newOpMode) { m_currentStateData.previousOpMode = m_currentStateData.opMode; m_currentStateData.opMode = newOpMode; publishState(); } }
+void SystemStateModel::setTrackingRestartRequested(bool restart) { if(m_currentStateData.requestTrackingRestart != restart) { m_currentStateData.requestTrackingRestart = restart; publishState(); } }
+void SystemStateModel::setTrackingStarted(bool start) { if(m_currentStateData.startTracking != start) { m_currentStateData.startTracking = start; publishState(); } }
 
 // TODO Implement other slots similarly, updating relevant parts of m_currentStateData and emitting dataChanged
 void SystemStateModel::onGyroDataChanged(const ImuData &gyroData)
@@ -554,20 +750,20 @@ void SystemStateModel::updateStationaryStatus(SystemStateData& data)
                                       data.AccelZ * data.AccelZ);
 
     // 3. Calculate the change in acceleration since the last update
-    double accelDelta = std::abs(accelMagnitude - data.previousAccelMagnitude);
-    data.previousAccelMagnitude = accelMagnitude; // Store for the next cycle
+    double accelDelta = std::abs(accelMagnitude - m_previousAccelMagnitude);
+    m_previousAccelMagnitude = accelMagnitude; // Store for the next cycle
 
     // 4. Check if the motion is below our thresholds
     if (gyroMagnitude < STATIONARY_GYRO_LIMIT && accelDelta < STATIONARY_ACCEL_DELTA_LIMIT)
     {
         // Motion is low, check how long it's been this way
-        if (data.stationaryStartTime.isNull()) {
+        if (m_stationaryStartTime.isNull()) {
             // If the timer wasn't running, start it now
-            data.stationaryStartTime = QDateTime::currentDateTime();
+            m_stationaryStartTime = QDateTime::currentDateTime();
         }
 
         // If we have been stationary for long enough, set the flag
-        qint64 elapsedMs = data.stationaryStartTime.msecsTo(QDateTime::currentDateTime());
+        qint64 elapsedMs = m_stationaryStartTime.msecsTo(QDateTime::currentDateTime());
         if (elapsedMs > STATIONARY_TIME_MS) {
             data.isVehicleStationary = true;
         }
@@ -576,7 +772,7 @@ void SystemStateModel::updateStationaryStatus(SystemStateData& data)
     {
         // Motion detected, we are not stationary
         data.isVehicleStationary = false;
-        data.stationaryStartTime = QDateTime(); // Reset the timer
+        m_stationaryStartTime = QDateTime(); // Reset the timer
     }
 }
 
@@ -647,6 +843,27 @@ void SystemStateModel::onNightCameraDataChanged(const NightCameraData &nightData
 
 }
 
+void SystemStateModel::onVideoStreamHealthChanged(int cameraIndex, const VideoStreamHealth &health)
+{
+    SystemStateData newData = m_currentStateData;
+
+    if (cameraIndex == 0) {
+        newData.dayVideoHealth = health;
+    } else if (cameraIndex == 1) {
+        newData.nightVideoHealth = health;
+    } else if (cameraIndex > 1) {
+        const int auxIndex = cameraIndex - 2;
+        if (newData.auxVideoHealth.size() <= auxIndex) {
+            newData.auxVideoHealth.resize(auxIndex + 1);
+        }
+        newData.auxVideoHealth[auxIndex] = health;
+    } else {
+        qWarning() << "SystemStateModel: Video health for unknown camera" << cameraIndex;
+        return;
+    }
+    updateData(newData);
+}
+
 void SystemStateModel::onPlc21DataChanged(const Plc21PanelData &pData)
 {
     SystemStateData newData = m_currentStateData;
@@ -725,7 +942,7 @@ void SystemStateModel::startZeroingProcedure() {
         m_currentStateData.zeroingModeActive = true;
         // Don't reset offsets here, user might be re-doing it or making cumulative adjustments
         qDebug() << "Zeroing procedure started.";
-        emit dataChanged(m_currentStateData);
+        publishState();
         emit zeroingStateChanged(true, m_currentStateData.zeroingAzimuthOffset, m_currentStateData.zeroingElevationOffset);
     }
 }
@@ -748,7 +965,7 @@ void SystemStateModel::applyZeroingAdjustment(float deltaAz, float deltaEl) {
 
         qDebug() << "Zeroing adjustment applied. New offsets Az:" << m_currentStateData.zeroingAzimuthOffset
                  << "El:" << m_currentStateData.zeroingElevationOffset;
-        emit dataChanged(m_currentStateData); // For OSD to potentially show live offset values
+        publishState(); // For OSD to potentially show live offset values
         emit zeroingStateChanged(true, m_currentStateData.zeroingAzimuthOffset, m_currentStateData.zeroingElevationOffset);
     }
 }
@@ -759,7 +976,7 @@ void SystemStateModel::finalizeZeroing() {
         m_currentStateData.zeroingAppliedToBallistics = true; // Zeroing is now active
         qDebug() << "Zeroing procedure finalized. Offsets Az:" << m_currentStateData.zeroingAzimuthOffset
                  << "El:" << m_currentStateData.zeroingElevationOffset;
-        emit dataChanged(m_currentStateData);
+        publishState();
         emit zeroingStateChanged(false, m_currentStateData.zeroingAzimuthOffset, m_currentStateData.zeroingElevationOffset);
     }
 }
@@ -770,7 +987,7 @@ void SystemStateModel::clearZeroing() { // Called on power down, or manually
     m_currentStateData.zeroingElevationOffset = 0.0f;
     m_currentStateData.zeroingAppliedToBallistics = false;
     qDebug() << "Zeroing cleared.";
-    emit dataChanged(m_currentStateData);
+    publishState();
     emit zeroingStateChanged(false, 0.0f, 0.0f);
 }
 
@@ -781,7 +998,7 @@ void SystemStateModel::startWindageProcedure() {
         // PDF: "Windage is always zero when CROWS is started."
         // So, starting the procedure doesn't necessarily clear the current value being entered.
         qDebug() << "Windage procedure started.";
-        emit dataChanged(m_currentStateData);
+        publishState();
         emit windageStateChanged(true, m_currentStateData.windageSpeedKnots);
     }
 }
@@ -790,7 +1007,7 @@ void SystemStateModel::setWindageSpeed(float knots) {
     if (m_currentStateData.windageModeActive) {
         m_currentStateData.windageSpeedKnots = qMax(0.0f, knots); // Speed can't be negative
         qDebug() << "Windage speed set to:" << m_currentStateData.windageSpeedKnots << "knots";
-        emit dataChanged(m_currentStateData);
+        publishState();
         emit windageStateChanged(true, m_currentStateData.windageSpeedKnots);
     }
 }
@@ -801,7 +1018,7 @@ void SystemStateModel::finalizeWindage() {
         m_currentStateData.windageAppliedToBallistics = (m_currentStateData.windageSpeedKnots > 0.001f); // Apply if speed > 0
         qDebug() << "Windage procedure finalized. Speed:" << m_currentStateData.windageSpeedKnots
                  << "Applied:" << m_currentStateData.windageAppliedToBallistics;
-        emit dataChanged(m_currentStateData);
+        publishState();
         emit windageStateChanged(false, m_currentStateData.windageSpeedKnots);
     }
 }
@@ -905,7 +1122,7 @@ void SystemStateModel::recalculateDerivedAimpointData() {
         qDebug() << "SystemStateModel: Recalculated Reticle. PosPx X:" << data.reticleAimpointImageX_px
                  << "Y:" << data.reticleAimpointImageY_px
                  << "LeadTxt:" << data.leadStatusText << "ZeroTxt:" << data.zeroingStatusText;
-        emit dataChanged(m_currentStateData); // Emit if anything derived changed
+        publishState(); // Emit if anything derived changed
     }
 }
 
@@ -922,14 +1139,19 @@ void SystemStateModel::updateCameraOpticsAndActivity(int width, int height, floa
     if (m_currentStateData.currentImageHeightPx != height) { m_currentStateData.currentImageHeightPx = height; changed=true; }
     if (!qFuzzyCompare(static_cast<float>(m_currentStateData.dayCurrentHFOV), dayHfov)) { m_currentStateData.dayCurrentHFOV = dayHfov; changed=true; }
     if (!qFuzzyCompare(static_cast<float>(m_currentStateData.nightCurrentHFOV), nightHfov)) { m_currentStateData.nightCurrentHFOV = nightHfov; changed=true; }
-    if (m_currentStateData.activeCameraIsDay != isDayActive) {m_currentStateData.activeCameraIsDay = isDayActive; changed=true;}
+    if (m_currentStateData.activeCameraIsDay != isDayActive) {m_currentStateData.activeCameraIsDay = isDayActive; m_currentStateData.activeCameraIndex = isDayActive ? 0 : 1; changed=true;}
 
     if(changed){
         recalculateDerivedAimpointData();
-        emit dataChanged(m_currentStateData);
+        publishState();
     }
 }
 
+void SystemStateModel::onCameraImageSizeChanged(int width, int height) {
+    updateCameraOpticsAndActivity(width, height, m_currentStateData.dayCurrentHFOV,
+                                  m_currentStateData.nightCurrentHFOV, m_currentStateData.activeCameraIsDay);
+}
+
 void SystemStateModel::updateCalculatedLeadOffsets(float angularLeadAz, float angularLeadEl, LeadAngleStatus statusFromCalc) {
     // This method is called by the WeaponController/BallisticsProcessor with new calculations
     bool changed = false;
@@ -1001,7 +1223,7 @@ void SystemStateModel::setPointInNoFireZone(bool inZone) {
     // if you want to track whether the current point is in a No Fire Zone.
     // It could be used for UI updates or other logic.
     m_currentStateData.isReticleInNoFireZone = inZone;
-    emit dataChanged(m_currentStateData);
+    publishState();
 }
 
 bool SystemStateModel::isPointInNoTraverseZone(float targetAz, float currentEl) const {
@@ -1021,7 +1243,7 @@ bool SystemStateModel::isPointInNoTraverseZone(float targetAz, float currentEl)
 void SystemStateModel::setPointInNoTraverseZone(bool inZone) {
     // Similar to No Fire Zone, this can be used to track if the current azimuth is in a No Traverse Zone
     m_currentStateData.isReticleInNoTraverseZone = inZone;
-    emit dataChanged(m_currentStateData);
+    publishState();
 }
 
 void SystemStateModel::updateCurrentScanName() {
@@ -1029,9 +1251,9 @@ void SystemStateModel::updateCurrentScanName() {
     QString newScanName = "";
 
     if (data.motionMode == MotionMode::AutoSectorScan) {
-        auto it = std::find_if(data.sectorScanZones.begin(), data.sectorScanZones.end(),
+        auto it = std::find_if(data.sectorScanZones.cbegin(), data.sectorScanZones.cend(),
                                [&](const AutoSectorScanZone& z){ return z.id == data.activeAutoSectorScanZoneId && z.isEnabled; });
-        if (it != data.sectorScanZones.end()) {
+        if (it != data.sectorScanZones.cend()) {
             newScanName = QString("SCAN: SECTOR %1").arg(QString::number(it->id));
         } else {
             newScanName = "SCAN: SECTOR (none)";
@@ -1055,13 +1277,13 @@ void SystemStateModel::selectNextAutoSectorScanZone() {
     if (data.sectorScanZones.empty()) {
         data.activeAutoSectorScanZoneId = -1;
         updateCurrentScanName(); // Update display name
-        emit dataChanged(data);
+        publishState();
         return;
     }
 
     // Get a sorted list of enabled zone IDs
     std::vector<int> enabledZoneIds;
-    for (const auto& zone : data.sectorScanZones) {
+    for (const auto& zone : std::as_const(data.sectorScanZones)) {
         if (zone.isEnabled) {
             enabledZoneIds.push_back(zone.id);
         }
@@ -1069,7 +1291,7 @@ void SystemStateModel::selectNextAutoSectorScanZone() {
     if (enabledZoneIds.empty()) {
         data.activeAutoSectorScanZoneId = -1;
         updateCurrentScanName();
-        emit dataChanged(data);
+        publishState();
         return;
     }
     std::sort(enabledZoneIds.begin(), enabledZoneIds.end());
@@ -1086,7 +1308,7 @@ void SystemStateModel::selectNextAutoSectorScanZone() {
     qDebug() << "Selected next Auto Sector Scan Zone ID:" << data.activeAutoSectorScanZoneId;
 
     updateCurrentScanName();
-    emit dataChanged(data);
+    publishState();
 }
 
 void SystemStateModel::selectPreviousAutoSectorScanZone() {
@@ -1094,12 +1316,12 @@ void SystemStateModel::selectPreviousAutoSectorScanZone() {
     if (data.sectorScanZones.empty()) {
         data.activeAutoSectorScanZoneId = -1;
         updateCurrentScanName();
-        emit dataChanged(data);
+        publishState();
         return;
     }
 
     std::vector<int> enabledZoneIds;
-    for (const auto& zone : data.sectorScanZones) {
+    for (const auto& zone : std::as_const(data.sectorScanZones)) {
         if (zone.isEnabled) {
             enabledZoneIds.push_back(zone.id);
         }
@@ -1107,7 +1329,7 @@ void SystemStateModel::selectPreviousAutoSectorScanZone() {
     if (enabledZoneIds.empty()) {
         data.activeAutoSectorScanZoneId = -1;
         updateCurrentScanName();
-        emit dataChanged(data);
+        publishState();
         return;
     }
     std::sort(enabledZoneIds.begin(), enabledZoneIds.end());
@@ -1123,7 +1345,7 @@ void SystemStateModel::selectPreviousAutoSectorScanZone() {
     }
     qDebug() << "Selected previous Auto Sector Scan Zone ID:" << data.activeAutoSectorScanZoneId;
     updateCurrentScanName();
-    emit dataChanged(data);
+    publishState();
         updateData(data);
 }
 
@@ -1134,7 +1356,7 @@ void SystemStateModel::selectNextTRPLocationPage() {
 
     // 1. Find all unique page numbers that have at least one TRP defined.
     std::set<int> definedPagesSet;
-    for (const auto& trp : data.targetReferencePoints) {
+    for (const auto& trp : std::as_const(data.targetReferencePoints)) {
         definedPagesSet.insert(trp.locationPage);
     }
 
@@ -1142,7 +1364,7 @@ void SystemStateModel::selectNextTRPLocationPage() {
         qDebug() << "selectNextTRPLocationPage: No TRP pages defined at all.";
         // data.activeTRPLocationPage might remain, or you could set to a default like 1
         updateCurrentScanName(); // Update OSD text if any
-        emit dataChanged(data);
+        publishState();
         return;
     }
 
@@ -1165,21 +1387,21 @@ void SystemStateModel::selectNextTRPLocationPage() {
 
     qDebug() << "Selected next TRP Location Page:" << data.activeTRPLocationPage;
     updateCurrentScanName(); // Update m_currentStateData.currentScanName
-    emit dataChanged(data);
+    publishState();
 }
 
 void SystemStateModel::selectPreviousTRPLocationPage() {
     SystemStateData& data = m_currentStateData;
 
     std::set<int> definedPagesSet;
-    for (const auto& trp : data.targetReferencePoints) {
+    for (const auto& trp : std::as_const(data.targetReferencePoints)) {
         definedPagesSet.insert(trp.locationPage);
     }
 
     if (definedPagesSet.empty()) {
         qDebug() << "selectPreviousTRPLocationPage: No TRP pages defined at all.";
         updateCurrentScanName();
-        emit dataChanged(data);
+        publishState();
         return;
     }
 
@@ -1198,7 +1420,7 @@ void SystemStateModel::selectPreviousTRPLocationPage() {
 
     qDebug() << "Selected previous TRP Location Page:" << data.activeTRPLocationPage;
     updateCurrentScanName();
-    emit dataChanged(data);
+    publishState();
 }
 
 void SystemStateModel::processStateTransitions(const SystemStateData& oldData, SystemStateData& newData)
@@ -1251,7 +1473,7 @@ void SystemStateModel::enterSurveillanceMode() {
     data.opMode = OperationalMode::Surveillance;
     data.motionMode = MotionMode::Manual;
     // Any other setup for entering surveillance
-    emit dataChanged(m_currentStateData);
+    publishState();
 }
 
 void SystemStateModel::enterIdleMode() {
@@ -1267,7 +1489,7 @@ void SystemStateModel::enterIdleMode() {
     }
     // Note: stopTracking will emit dataChanged, so we might not need another emit here.
     // It's safer to ensure one is called.
-    emit dataChanged(m_currentStateData);
+    publishState();
 }
 
 void SystemStateModel::commandEngagement(bool start) {
@@ -1290,7 +1512,7 @@ void SystemStateModel::commandEngagement(bool start) {
         data.opMode = data.previousOpMode;
         data.motionMode = data.previousMotionMode;
     }
-    emit dataChanged(m_currentStateData);
+    publishState();
 }
 
  
@@ -1314,7 +1536,7 @@ void SystemStateModel::enterEmergencyStopMode() {
     // The E-Stop is about stopping motion and firing, not erasing calibration.
 
     // Emit the state change so all components react
-    emit dataChanged(m_currentStateData);
+    publishState();
 }
 
 /*void SystemStateModel::updateTrackedTargetInfo(int cameraIndex, bool isValid, float centerX_px, float centerY_px,
@@ -1387,11 +1609,18 @@ void SystemStateModel::updateTrackingResult(
     float velocityX_px_s, float velocityY_px_s,
     VPITrackingState trackerState)
 {
-    //QMutexLocker locker(&m_mutex); // Protect shared state
+    // Called from the camera capture threads: the model (and its snapshot) has one writer,
+    // the model's thread, so the result is applied there
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, [=]() {
+            updateTrackingResult(cameraIndex, hasLock, centerX_px, centerY_px, width_px, height_px,
+                                 velocityX_px_s, velocityY_px_s, trackerState);
+        }, Qt::QueuedConnection);
+        return;
+    }
 
     // 1. Determine if this camera is the active one for tracking
-    int activeCameraIndex = m_currentStateData.activeCameraIsDay ? 0 : 1;
-    if (cameraIndex != activeCameraIndex) {
+    if (cameraIndex != m_currentStateData.activeCameraIndex) {
         // qDebug() << "[MODEL-REJECT] IGNORING update from INACTIVE Cam" << cameraIndex;
         return; // Ignore tracking updates from inactive cameras
     }
@@ -1526,7 +1755,7 @@ void SystemStateModel::updateTrackingResult(
                  << "Valid Target:" << data.trackerHasValidTarget;
          qDebug() << "trackedTarget_position: (" << data.trackedTargetCenterX_px << ", " << data.trackedTargetCenterY_px << ")";
          
-        emit dataChanged(m_currentStateData);
+        publishState();
     }
 }
 
@@ -1558,7 +1787,7 @@ void SystemStateModel::updateTrackingResult(
     }
 
     qDebug() << "[MODEL-SIMULATE] Phase changed to:" << static_cast<int>(newPhase) << "for camera:" << cameraIndex;
-    emit dataChanged(m_currentStateData);
+    publishState();
 }*/
 
 
@@ -1590,7 +1819,7 @@ void SystemStateModel::startTrackingAcquisition() {
         data.opMode = OperationalMode::Surveillance;
         data.motionMode = MotionMode::Manual;
 
-        emit dataChanged(m_currentStateData);
+        publishState();
     }
 }
 
@@ -1600,7 +1829,7 @@ void SystemStateModel::requestTrackerLockOn() {
         data.currentTrackingPhase = TrackingPhase::Tracking_LockPending;
         // Motion mode is still Manual here. GimbalController will switch it to AutoTrack
         // only AFTER CameraVideoStreamDevice confirms a lock via updateTrackingResult.
-        emit dataChanged(m_currentStateData);
+        publishState();
     }
 }
 
@@ -1612,7 +1841,7 @@ void SystemStateModel::stopTracking() {
         // Revert to Surveillance/Manual modes
         data.opMode = OperationalMode::Surveillance;
         data.motionMode = MotionMode::Manual;
-        emit dataChanged(m_currentStateData);
+        publishState();
     }
 }
 
@@ -1637,7 +1866,7 @@ void SystemStateModel::stopTracking() {
             data.opMode = OperationalMode::Surveillance; // Or stay in Tracking op mode with a "COAST" status
             data.motionMode = MotionMode::Manual;
         }
-        emit dataChanged(m_currentStateData);
+        publishState();
     }
 }
 */
@@ -1652,7 +1881,7 @@ void SystemStateModel::adjustAcquisitionBoxSize(float dW, float dH) {
         // Recenter box after resizing
         data.acquisitionBoxX_px = (data.currentImageWidthPx / 2.0f) - (data.acquisitionBoxW_px / 2.0f);
         data.acquisitionBoxY_px = (data.currentImageHeightPx / 2.0f) - (data.acquisitionBoxH_px / 2.0f);
-        emit dataChanged(m_currentStateData);
+        publishState();
     }
 }
 
@@ -1682,21 +1911,21 @@ void SystemStateModel::selectNextRadarTrack() {
     if (data.radarPlots.isEmpty()) return;
 
     // Find the index of the currently selected track ID
-    auto it = std::find_if(data.radarPlots.begin(), data.radarPlots.end(),
+    auto it = std::find_if(data.radarPlots.cbegin(), data.radarPlots.cend(),
                            [&](const SimpleRadarPlot& p){
                                return p.id == data.selectedRadarTrackId;
                             }
                            );
 
-    if (it == data.radarPlots.end() || std::next(it) == data.radarPlots.end()) {
+    if (it == data.radarPlots.cend() || std::next(it) == data.radarPlots.cend()) {
         // Not found or is the last one, wrap to the first
-        data.selectedRadarTrackId = data.radarPlots.front().id;
+        data.selectedRadarTrackId = data.radarPlots.constFirst().id;
     } else {
         // Move to the next
         data.selectedRadarTrackId = (*std::next(it)).id;
     }
     qDebug() << "[MODEL] Selected Radar Track ID:" << data.selectedRadarTrackId;
-    emit dataChanged(data);
+    publishState();
 }
 
 void SystemStateModel::selectPreviousRadarTrack() {
@@ -1704,21 +1933,21 @@ void SystemStateModel::selectPreviousRadarTrack() {
     if (data.radarPlots.isEmpty()) return;
 
     // Find the index of the currently selected track ID
-    auto it = std::find_if(data.radarPlots.begin(), data.radarPlots.end(),
+    auto it = std::find_if(data.radarPlots.cbegin(), data.radarPlots.cend(),
                            [&](const SimpleRadarPlot& p){
                                return p.id == data.selectedRadarTrackId;
                            }
                            );
 
-    if (it == data.radarPlots.end() || it == data.radarPlots.begin()) {
+    if (it == data.radarPlots.cend() || it == data.radarPlots.cbegin()) {
         // Not found or is the first one, wrap to the last
-        data.selectedRadarTrackId = data.radarPlots.back().id;
+        data.selectedRadarTrackId = data.radarPlots.constLast().id;
     } else {
         // Move to the previous
         data.selectedRadarTrackId = (*std::prev(it)).id;
     }
     qDebug() << "[MODEL] Selected Radar Track ID:" << data.selectedRadarTrackId;
-    emit dataChanged(data);
+    publishState();
 }
 
 void SystemStateModel::commandSlewToSelectedRadarTrack() {
@@ -1731,6 +1960,6 @@ void SystemStateModel::commandSlewToSelectedRadarTrack() {
         // The responsibility of moving the gimbal is NOT here.
         // We set the MOTION mode. The GimbalController will react to it.
         //data.motionMode = MotionMode::RadarSlew; // << NEW MOTION MODE
-        emit dataChanged(data);
+        publishState();
     }
 }
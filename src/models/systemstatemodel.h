@@ -62,12 +62,14 @@
 #include "servodriverdatamodel.h"
 #include "../TimestampLogger.h"
 #include "../utils/reticleaimpointcalculator.h"
+#include "../utils/leftrightsnapshot.h"
 
 #include <cmath> 
 #include <algorithm> // Include for std::find_if, std::remove_if, std::max
 #include <limits> // Include for std::numeric_limits
 #include <QElapsedTimer>
 #include <QDateTime>
+#include <QTimer>
 #include <cmath>
 
 // Constants for stationary detection
@@ -87,13 +89,82 @@ public:
      * @return The current SystemStateData structure.
      */
     virtual SystemStateData data() const { return m_currentStateData; }
-    
+
+    /**
+     * @brief The current state by reference, without a copy.
+     *
+     * For code running on the model's thread, synchronously with the updates. A slot may
+     * run after later updates (queued, or coalesced), so subscribers read snapshot().
+     */
+    const SystemStateData &state() const { return m_currentStateData; }
+
+    /**
+     * @brief The state as of the last publish, from any thread, wait-free.
+     *
+     * For readers on other threads (camera capture threads), instead of mirroring the
+     * fields from a queued slot. Each call returns one consistent snapshot.
+     */
+    SystemStateData snapshot() const { return m_snapshot.read(); }
+
     /**
      * @brief Updates the entire system state with new data.
      * @param newState The new system state data to apply.
      */
     void updateData(const SystemStateData &newState);
 
+    // --- Update Coalescing ---
+    /**
+     * @brief Publishes at most once per @p windowMs, merging the updates in between.
+     *
+     * Updates still apply (and run the state transitions) as they arrive; dataChanged(),
+     * the group signals and snapshot() follow on a fixed-rate tick. 0, the default,
+     * publishes every update immediately. Disabling publishes the pending updates if
+     * they left a net change. Model's thread only.
+     */
+    void setCoalescingWindow(int windowMs);
+    int coalescingWindow() const { return m_coalescingWindowMs; }
+
+    /**
+     * @brief Groups that publish immediately even while coalescing, taking everything
+     *        pending with them. Defaults to Modes, Controls and Station.
+     */
+    void setImmediateGroups(StateGroups groups) { m_immediateGroups = groups; }
+    StateGroups immediateGroups() const { return m_immediateGroups; }
+
+    struct CoalescingStats {
+        quint64 ticks = 0;              // Ticks that published
+        quint64 idleTicks = 0;          // Ticks with nothing pending, or no net change
+        quint64 mergedUpdates = 0;      // Updates published by ticks
+        quint64 maxMergedPerTick = 0;
+        quint64 immediatePublishes = 0; // Publishes forced by an immediate group
+        quint64 immediateUpdates = 0;   // Updates those carried, the forcing one included
+
+        double mergedPerTick() const { return ticks ? static_cast<double>(mergedUpdates) / ticks : 0.0; }
+    };
+    /**
+     * @brief Coalescing counters since the model was created.
+     */
+    const CoalescingStats &coalescingStats() const { return m_coalescingStats; }
+
+    /**
+     * @brief Counts signal deliveries and logs them, with the coalescing statistics,
+     *        every 10 s. Off by default.
+     */
+    void setSignalStatsEnabled(bool enabled);
+    bool signalStatsEnabled() const { return m_signalStatsEnabled; }
+
+    struct SignalStats {
+        quint64 publishes = 0;
+        quint64 wholeStateDeliveries = 0;  // dataChanged() x receivers
+        qint64 wholeStateBytes = 0;
+        quint64 groupDeliveries = 0;       // Group signals x receivers
+        qint64 groupBytes = 0;             // Upper bound: only queued receivers copy
+    };
+    /**
+     * @brief Delivery counters since the last statistics line, while enabled.
+     */
+    const SignalStats &signalStats() const { return m_signalStats; }
+
     // --- User Interface Controls ---
     /**
      * @brief Sets the color style for the user interface.
@@ -119,6 +190,15 @@ public:
      */
     void setActiveCameraIsDay(bool pressed);
 
+    /**
+     * @brief Selects the camera shown by its CameraRegistry index.
+     *
+     * 0 and 1 also set activeCameraIsDay. An auxiliary camera (2 and up) leaves it as it
+     * is, so the day/night optics stay those of the panel switch; the next change of the
+     * switch selects the day or night camera again.
+     */
+    void setActiveCameraIndex(int index);
+
     // --- Weapon Control and Tracking ---
     /**
      * @brief Sets the down track button state for weapon control.
@@ -225,7 +305,7 @@ public:
      * @brief Gets all area zones in the system.
      * @return A constant reference to the vector of area zones.
      */
-    const std::vector<AreaZone>& getAreaZones() const;
+    const QVector<AreaZone>& getAreaZones() const;
     
     /**
      * @brief Gets a specific area zone by its identifier.
@@ -261,7 +341,7 @@ public:
      * @brief Gets all automatic sector scan zones in the system.
      * @return A constant reference to the vector of sector scan zones.
      */
-    const std::vector<AutoSectorScanZone>& getSectorScanZones() const;
+    const QVector<AutoSectorScanZone>& getSectorScanZones() const;
     
     /**
      * @brief Gets a specific sector scan zone by its identifier.
@@ -307,7 +387,7 @@ public:
      * @brief Gets all target reference points in the system.
      * @return A constant reference to the vector of target reference points.
      */
-    const std::vector<TargetReferencePoint>& getTargetReferencePoints() const;
+    const QVector<TargetReferencePoint>& getTargetReferencePoints() const;
     
     /**
      * @brief Gets a specific target reference point by its identifier.
@@ -389,6 +469,10 @@ public:
                                  float width_px, float height_px,
                                  float velocityX_px_s, float velocityY_px_s,
                                  VPITrackingState state);*/
+    /**
+     * @brief Applies a tracker result from camera @p cameraIndex. Any thread: calls from
+     *        other threads are queued to the model's thread.
+     */
     void updateTrackingResult(int cameraIndex, bool hasLock,
                               float centerX_px, float centerY_px,
                               float width_px, float height_px,
@@ -414,9 +498,31 @@ signals:
     // --- Core System Signals ---
     /**
      * @brief Emitted when system state data changes.
+     *
+     * Carries the whole structure, which every queued receiver copies: prefer
+     * stateGroupsChanged() or the group signals below.
      * @param newState The new system state data.
      */
     void dataChanged(const SystemStateData &newState);
+
+    /**
+     * @brief Emitted with every update that changed at least one field group.
+     *
+     * Subscribers test @p changed against the groups they use and only then copy the
+     * state through snapshot(), which is at least as new as this update. Emitted after
+     * the typed group signals of the same update.
+     * @param changed The groups with at least one changed field.
+     */
+    void stateGroupsChanged(StateGroups changed);
+
+    // --- Typed Group Signals (only emitted when their group changed) ---
+    void modesChanged(OperationalMode opMode, MotionMode motionMode);                   ///< StateGroup::Modes
+    void uiStyleChanged(const QColor &colorStyle, ReticleType reticleType);             ///< StateGroup::UiStyle
+    void opticsChanged(const OpticsState &optics);                                      ///< StateGroup::Optics
+    void deviceHealthChanged(const DeviceHealthState &health);                          ///< StateGroup::DeviceHealth
+    void radarChanged(const QVector<SimpleRadarPlot> &plots, quint32 selectedTrackId);  ///< StateGroup::Radar
+    void trackingChanged(const TrackingState &tracking);                                ///< StateGroup::Tracking
+    void ballisticsChanged(const BallisticsState &ballistics);                          ///< StateGroup::Ballistics
     
     /**
      * @brief Emitted when UI color style changes.
@@ -438,7 +544,7 @@ signals:
 
     // --- Gimbal and Positioning Signals ---
     /**
-     * @brief Emitted when gimbal position changes.
+     * @brief Emitted when gimbal position changes (StateGroup::GimbalPose).
      * @param az New azimuth position in degrees.
      * @param el New elevation position in degrees.
      */
@@ -532,6 +638,21 @@ public slots:
      */
     void onNightCameraDataChanged(const NightCameraData &nightData);
 
+    /**
+     * @brief Handles video pipeline health reports from a camera stream device.
+     * @param cameraIndex 0 for the day camera, 1 for the night camera, 2+ for auxiliary cameras.
+     * @param health The latest pipeline health.
+     */
+    void onVideoStreamHealthChanged(int cameraIndex, const VideoStreamHealth &health);
+
+    /**
+     * @brief Sets the size of the frames the cameras deliver, which the aimpoint and
+     *        tracking gate pixels refer to. Keeps the HFOVs and the active camera.
+     * @param width Frame width in pixels.
+     * @param height Frame height in pixels.
+     */
+    void onCameraImageSizeChanged(int width, int height);
+
     // --- Joystick Control Slots ---
     /**
      * @brief Handles joystick axis movement changes.
@@ -580,6 +701,24 @@ public slots:
     
 private:
     SystemStateData m_currentStateData; // Central data store
+    SystemStateData m_publishedStateData; // State as of the last publishState(), to find the changed groups
+    LeftRightSnapshot<SystemStateData> m_snapshot; // Same state, for readers on other threads (see snapshot())
+
+    bool m_signalStatsEnabled = false;
+    SignalStats m_signalStats;
+    QElapsedTimer m_signalStatsTimer;
+
+    // Update coalescing (see setCoalescingWindow())
+    int m_coalescingWindowMs = 0;
+    StateGroups m_immediateGroups = StateGroup::Modes | StateGroup::Controls | StateGroup::Station;
+    QTimer *m_coalescingTimer = nullptr;
+    quint64 m_pendingUpdates = 0;      // Updates since the last publish
+    CoalescingStats m_coalescingStats;
+    CoalescingStats m_loggedCoalescingStats; // As of the last statistics line
+
+    // Stationary detection (see updateStationaryStatus()); not part of the published state
+    double m_previousAccelMagnitude = 0.0;
+    QDateTime m_stationaryStartTime;
 
     // ID Counters for zones
     int m_nextAreaZoneId;
@@ -605,6 +744,32 @@ private:
      */
     int getNextTRPId() { return m_nextTRPId++; }
 
+    /**
+     * @brief Notifies subscribers of m_currentStateData.
+     *
+     * Every change goes through here. Emits at once, or while coalescing, on the next
+     * tick unless an immediate group changed. Model's thread only: m_snapshot has a single
+     * writer, and the coalescing and signal counters are not synchronized.
+     */
+    void publishState();
+
+    /**
+     * @brief Emits dataChanged(), then the typed signal of each group in @p changed,
+     *        then stateGroupsChanged().
+     */
+    void emitState(StateGroups changed);
+
+    /**
+     * @brief Coalescing tick: publishes the updates merged since the last publish.
+     */
+    void onCoalescingTick();
+
+    /**
+     * @brief Counts one emission of @p signal (a SIGNAL() signature) to each of its
+     *        receivers for the statistics, if enabled.
+     */
+    void recordDelivery(const char *signal, qint64 payloadBytes, bool wholeState);
+
     /**
      * @brief Updates the next ID counters after loading data from file.
      */
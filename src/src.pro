@@ -1,6 +1,8 @@
 QT       += core gui serialbus serialport dbus
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+# QOpenGLWidget / QOpenGLBuffer moved out of widgets/gui in Qt 6
+greaterThan(QT_MAJOR_VERSION, 5): QT += opengl openglwidgets
 
 CONFIG += c++17
 
@@ -74,12 +76,25 @@ SOURCES += \
     devices/outlinedtextitem.cpp \
     devices/radardevice.cpp \
     devices/cameravideostreamdevice.cpp \
+    devices/framebufferpool.cpp \
+    devices/framelatency.cpp \
+    devices/framepacing.cpp \
+    devices/videosourceconfig.cpp \
+    devices/videorecorder.cpp \
+    devices/networkvideooutput.cpp \
+    devices/pictureinpicture.cpp \
+    devices/cameraregistry.cpp \
+    devices/glyphoutlinecache.cpp \
+    devices/osdlayout.cpp \
+    devices/osdpainterrenderer.cpp \
+    devices/osdrenderworker.cpp \
     ui/areazoneparameterpanel.cpp \
     ui/basestyledwidget.cpp \
     ui/radartargetlistwidget.cpp \
     ui/sectorscanparameterpanel.cpp \
     ui/trpparameterpanel.cpp \
     ui/videodisplaywidget.cpp \
+    ui/glvideodisplaywidget.cpp \
     main.cpp \
     ui/mainwindow.cpp \
     ui/custommenudialog.cpp \
@@ -95,6 +110,7 @@ SOURCES += \
     devices/servodriverdevice.cpp \
     models/joystickdatamodel.cpp \
     models/systemstatemodel.cpp \
+    models/systemstatedata.cpp \
     ui/zonedefinitionwidget.cpp \
     ui/zeroingwidget.cpp \
     ui/windagewidget.cpp \
@@ -103,7 +119,8 @@ SOURCES += \
     ui/cameracontainerwidget.cpp \
     utils/colorutils.cpp \
     utils/inference.cpp \
-    utils/reticleaimpointcalculator.cpp
+    utils/reticleaimpointcalculator.cpp \
+    utils/yuy2converter.cpp
 
 HEADERS += \
     controllers/cameracontroller.h \
@@ -125,6 +142,19 @@ HEADERS += \
     devices/outlinedtextitem.h \
     devices/radardevice.h \
     devices/cameravideostreamdevice.h \
+    devices/framebufferpool.h \
+    devices/framelatency.h \
+    devices/framepacing.h \
+    devices/videosourceconfig.h \
+    devices/videorecorder.h \
+    devices/networkvideooutput.h \
+    devices/pictureinpicture.h \
+    devices/cameraregistry.h \
+    devices/glyphoutlinecache.h \
+    devices/osdlayout.h \
+    devices/osdpainterrenderer.h \
+    devices/osdrenderworker.h \
+    devices/osdtypes.h \
     devices/vpi_helpers.h \
     models/radardatamodel.h \
     ui/areazoneparameterpanel.h \
@@ -133,6 +163,8 @@ HEADERS += \
     ui/sectorscanparameterpanel.h \
     ui/trpparameterpanel.h \
     ui/videodisplaywidget.h \
+    ui/videoframesink.h \
+    ui/glvideodisplaywidget.h \
     models/gyrodatamodel.h \
     models/lensdatamodel.h \
     models/nightcameradatamodel.h \
@@ -166,8 +198,11 @@ HEADERS += \
     utils/colorutils.h \
     utils/millenious.h \
     utils/inference.h \
+    utils/latestvaluemailbox.h \
+    utils/leftrightsnapshot.h \
     utils/reticleaimpointcalculator.h \
-    utils/targetstate.h
+    utils/targetstate.h \
+    utils/yuy2converter.h
 
 FORMS += \
     ui/mainwindow.ui
@@ -0,0 +1,369 @@
+#include "glvideodisplaywidget.h"
+
+#include "../devices/framebufferpool.h" // FrameCopyStats
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QOpenGLContext>
+#include <QPainter>
+#include <QResizeEvent>
+#include <QSurfaceFormat>
+#include <cstring>
+
+namespace {
+// Same letterboxing rule as VideoDisplayWidget: near-native frames are drawn 1:1
+constexpr int NATIVE_SIZE_TOLERANCE_PX = 4;
+constexpr quint64 TIMING_LOG_INTERVAL = 300; // Frames between timing log lines
+constexpr int IDLE_REFRESHES_BEFORE_STOP = 60; // ~1 s at 60 Hz without frames stops the refresh loop
+
+constexpr int POSITION_ATTRIBUTE = 0;
+constexpr int TEXCOORD_ATTRIBUTE = 1;
+
+// Triangle strip over the whole viewport: x, y, s, t (t = 0 is the first QImage row)
+const GLfloat QUAD_VERTICES[] = {
+    -1.0f, -1.0f, 0.0f, 1.0f,
+     1.0f, -1.0f, 1.0f, 1.0f,
+    -1.0f,  1.0f, 0.0f, 0.0f,
+     1.0f,  1.0f, 1.0f, 0.0f,
+};
+
+// GLSL ES 1.00 / GLSL 1.10 (Qt defines the precision qualifiers away on desktop GL)
+const char *VERTEX_SHADER =
+    "attribute highp vec2 position;\n"
+    "attribute highp vec2 texCoord;\n"
+    "varying highp vec2 v_texCoord;\n"
+    "void main() {\n"
+    "    v_texCoord = texCoord;\n"
+    "    gl_Position = vec4(position, 0.0, 1.0);\n"
+    "}\n";
+
+// Textures hold QImage's 32-bit pixels as stored in memory (B, G, R, A): swizzle back
+const char *FRAGMENT_SHADER =
+    "varying highp vec2 v_texCoord;\n"
+    "uniform sampler2D frameTexture;\n"
+    "void main() {\n"
+    "    gl_FragColor = texture2D(frameTexture, v_texCoord).bgra;\n"
+    "}\n";
+
+bool isBgraInMemory(QImage::Format format)
+{
+    return Q_BYTE_ORDER == Q_LITTLE_ENDIAN &&
+           (format == QImage::Format_ARGB32_Premultiplied || format == QImage::Format_RGB32 ||
+            format == QImage::Format_ARGB32);
+}
+} // namespace
+
+GlVideoDisplayWidget::GlVideoDisplayWidget(QWidget *parent)
+    : QOpenGLWidget(parent)
+{
+    connect(this, &QOpenGLWidget::frameSwapped, this, &GlVideoDisplayWidget::onFrameSwapped);
+}
+
+GlVideoDisplayWidget::~GlVideoDisplayWidget()
+{
+    cleanupGL();
+}
+
+void GlVideoDisplayWidget::updateFrame(const QImage &frame, const QImage &overlay, const FrameTimestamps &timestamps)
+{
+    if (frame.isNull()) {
+        qWarning() << "Received null frame in" << objectName();
+        return;
+    }
+    // Shallow copies, released as soon as paintGL() has uploaded them (or a newer frame replaced them)
+    m_pendingFrames.publish(PendingFrame{frame, overlay, timestamps});
+    requestRefresh();
+}
+
+void GlVideoDisplayWidget::setPlaceholderText(const QString &text)
+{
+    m_placeholderText = text;
+    m_pendingFrames.publish(PendingFrame());
+    requestRefresh();
+}
+
+void GlVideoDisplayWidget::requestRefresh()
+{
+    m_idleRefreshes = 0;
+    if (m_refreshLoopActive) {
+        return; // The next frameSwapped() picks the frame up
+    }
+    m_refreshLoopActive = true;
+    update();
+}
+
+void GlVideoDisplayWidget::initializeGL()
+{
+    initializeOpenGLFunctions();
+    // The context goes away before the widget on reparenting and shutdown
+    connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &GlVideoDisplayWidget::cleanupGL,
+            Qt::UniqueConnection);
+
+    const QSurfaceFormat format = context()->format();
+    const bool isEs = context()->isOpenGLES();
+    m_usePixelBuffer = isEs ? format.majorVersion() >= 3
+                            : (format.version() >= qMakePair(2, 1) ||
+                               context()->hasExtension(QByteArrayLiteral("GL_ARB_pixel_buffer_object")));
+    m_pixelBufferMappable = isEs ? format.majorVersion() >= 3
+                                 : (format.majorVersion() >= 3 ||
+                                    context()->hasExtension(QByteArrayLiteral("GL_ARB_map_buffer_range")));
+
+    m_program = new QOpenGLShaderProgram(this);
+    m_program->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER);
+    m_program->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER);
+    m_program->bindAttributeLocation("position", POSITION_ATTRIBUTE);
+    m_program->bindAttributeLocation("texCoord", TEXCOORD_ATTRIBUTE);
+    if (!m_program->link()) {
+        qCritical() << "GlVideoDisplayWidget: Shader link failed:" << m_program->log();
+    }
+    m_program->bind();
+    m_program->setUniformValue("frameTexture", 0);
+    m_program->release();
+
+    m_quadBuffer.create();
+    m_quadBuffer.bind();
+    m_quadBuffer.allocate(QUAD_VERTICES, sizeof(QUAD_VERTICES));
+    m_quadBuffer.release();
+
+    qInfo().noquote() << QString("GlVideoDisplayWidget: OpenGL%1 %2.%3 on")
+                             .arg(isEs ? " ES" : "").arg(format.majorVersion()).arg(format.minorVersion())
+                      << reinterpret_cast<const char *>(glGetString(GL_RENDERER))
+                      << "- pixel buffer upload:" << (m_usePixelBuffer ? (m_pixelBufferMappable ? "mapped" : "buffered") : "off");
+}
+
+void GlVideoDisplayWidget::cleanupGL()
+{
+    if (!m_program) {
+        return; // Never initialised, or already cleaned up
+    }
+    makeCurrent();
+    for (StreamTexture *texture : {&m_frameTexture, &m_overlayTexture}) {
+        if (texture->id != 0) {
+            glDeleteTextures(1, &texture->id);
+        }
+        texture->id = 0;
+        texture->size = QSize();
+        texture->pixelBuffer.destroy();
+    }
+    m_quadBuffer.destroy();
+    delete m_program;
+    m_program = nullptr;
+    m_hasOverlay = false;
+    m_showingFrame = false; // A new context shows the placeholder until the next frame
+    doneCurrent();
+}
+
+void GlVideoDisplayWidget::resizeEvent(QResizeEvent *event)
+{
+    QOpenGLWidget::resizeEvent(event);
+    emit displaySizeChanged(event->size());
+}
+
+void GlVideoDisplayWidget::paintGL()
+{
+    // Take the newest frame (if any); the producer's buffers go once uploaded
+    PendingFrame pending;
+    const bool newFrame = m_pendingFrames.take(pending);
+
+    m_swapTimestamps = FrameTimestamps();
+    m_paintStartNs = 0;
+    if (newFrame) {
+        m_showingFrame = !pending.frame.isNull();
+    }
+    m_swapShowsNewFrame = newFrame && m_showingFrame;
+    if (m_swapShowsNewFrame) {
+        m_paintStartNs = FrameTimestamps::nowNs();
+        QElapsedTimer uploadTimer;
+        uploadTimer.start();
+        upload(m_frameTexture, pending.frame);
+        m_hasOverlay = !pending.overlay.isNull();
+        if (m_hasOverlay) {
+            upload(m_overlayTexture, pending.overlay);
+        }
+        m_lastUploadNs = uploadTimer.nsecsElapsed();
+        m_uploadNsTotal += m_lastUploadNs;
+        m_swapTimestamps = pending.timestamps; // Closed on frameSwapped()
+    }
+
+    const qreal dpr = devicePixelRatioF();
+    glViewport(0, 0, qRound(width() * dpr), qRound(height() * dpr));
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (!m_showingFrame || m_frameTexture.id == 0) {
+        drawPlaceholder(m_placeholderText);
+        return;
+    }
+
+    // Letterbox the frame; the rasteriser scales it while sampling
+    QSize targetSize = m_frameTexture.size.scaled(size(), Qt::KeepAspectRatio);
+    if (targetSize.width() >= m_frameTexture.size.width() && targetSize.height() >= m_frameTexture.size.height() &&
+        targetSize.width() - m_frameTexture.size.width() <= NATIVE_SIZE_TOLERANCE_PX &&
+        targetSize.height() - m_frameTexture.size.height() <= NATIVE_SIZE_TOLERANCE_PX) {
+        targetSize = m_frameTexture.size;
+    }
+    const QRect targetRect(QPoint((width() - targetSize.width()) / 2, (height() - targetSize.height()) / 2),
+                           targetSize);
+    // GL viewports count from the bottom-left corner, in device pixels
+    glViewport(qRound(targetRect.x() * dpr), qRound((height() - targetRect.y() - targetRect.height()) * dpr),
+               qRound(targetRect.width() * dpr), qRound(targetRect.height() * dpr));
+
+    m_program->bind();
+    m_quadBuffer.bind();
+    m_program->enableAttributeArray(POSITION_ATTRIBUTE);
+    m_program->enableAttributeArray(TEXCOORD_ATTRIBUTE);
+    m_program->setAttributeBuffer(POSITION_ATTRIBUTE, GL_FLOAT, 0, 2, 4 * sizeof(GLfloat));
+    m_program->setAttributeBuffer(TEXCOORD_ATTRIBUTE, GL_FLOAT, 2 * sizeof(GLfloat), 2, 4 * sizeof(GLfloat));
+
+    glDisable(GL_BLEND);
+    drawTexture(m_frameTexture);
+    if (m_hasOverlay) {
+        // The OSD is premultiplied
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        drawTexture(m_overlayTexture);
+        glDisable(GL_BLEND);
+    }
+
+    m_program->disableAttributeArray(POSITION_ATTRIBUTE);
+    m_program->disableAttributeArray(TEXCOORD_ATTRIBUTE);
+    m_quadBuffer.release();
+    m_program->release();
+}
+
+void GlVideoDisplayWidget::upload(StreamTexture &texture, const QImage &image)
+{
+    // Pooled frames and OSD overlays are already BGRA in memory; anything else is converted once here
+    const QImage source = isBgraInMemory(image.format()) ? image
+                                                         : image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const int width = source.width();
+    const int height = source.height();
+    const int rowBytes = width * 4;
+    const int totalBytes = rowBytes * height;
+    const bool tightlyPacked = (source.bytesPerLine() == rowBytes);
+
+    if (texture.id == 0) {
+        glGenTextures(1, &texture.id);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    if (texture.size != source.size()) {
+        // (Re)allocate storage only when the negotiated frame size changes
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        texture.size = source.size();
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (m_usePixelBuffer && !texture.pixelBuffer.isCreated()) {
+        if (texture.pixelBuffer.create()) {
+            texture.pixelBuffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+        } else {
+            qWarning() << "GlVideoDisplayWidget: Cannot create pixel buffer, uploading directly";
+            m_usePixelBuffer = false;
+        }
+    }
+
+    if (m_usePixelBuffer) {
+        texture.pixelBuffer.bind();
+        // Orphan the storage: the driver hands out fresh memory while the last upload may still be read
+        texture.pixelBuffer.allocate(totalBytes);
+        uchar *mapped = m_pixelBufferMappable
+                            ? static_cast<uchar *>(texture.pixelBuffer.mapRange(
+                                  0, totalBytes, QOpenGLBuffer::RangeWrite | QOpenGLBuffer::RangeInvalidateBuffer))
+                            : nullptr;
+        if (mapped) {
+            if (tightlyPacked) {
+                std::memcpy(mapped, source.constBits(), static_cast<size_t>(totalBytes));
+            } else {
+                for (int y = 0; y < height; ++y) {
+                    std::memcpy(mapped + y * rowBytes, source.constScanLine(y), static_cast<size_t>(rowBytes));
+                }
+            }
+            texture.pixelBuffer.unmap();
+        } else if (tightlyPacked) {
+            texture.pixelBuffer.write(0, source.constBits(), totalBytes);
+        } else {
+            for (int y = 0; y < height; ++y) {
+                texture.pixelBuffer.write(y * rowBytes, source.constScanLine(y), rowBytes);
+            }
+        }
+        // Sources from the bound pixel buffer (offset 0); the copy into the texture runs on the GPU side
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        texture.pixelBuffer.release();
+    } else if (tightlyPacked) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, source.constBits());
+    } else {
+        for (int y = 0; y < height; ++y) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, 1, GL_RGBA, GL_UNSIGNED_BYTE, source.constScanLine(y));
+        }
+    }
+    FrameCopyStats::recordCopy(totalBytes);
+}
+
+void GlVideoDisplayWidget::drawTexture(const StreamTexture &texture)
+{
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
+void GlVideoDisplayWidget::drawPlaceholder(const QString &text)
+{
+    // Cleared to black by paintGL()
+    QPainter painter(this);
+    painter.setPen(Qt::white);
+    painter.drawText(rect(), Qt::AlignCenter, text);
+}
+
+void GlVideoDisplayWidget::onFrameSwapped()
+{
+    const qint64 nowNs = FrameTimestamps::nowNs();
+
+    // --- Pacing: every refresh while frames flow either shows a new frame or repeats one ---
+    if (m_refreshLoopActive && m_showingFrame) {
+        m_pacing.recordRefresh(nowNs, m_swapShowsNewFrame);
+    }
+    const quint64 droppedCount = m_pendingFrames.droppedCount();
+    m_pacing.recordSkipped(droppedCount - m_lastDroppedCount);
+    m_lastDroppedCount = droppedCount;
+
+    // --- Upload / present timing and latency trail of a newly shown frame ---
+    if (m_paintStartNs > 0) {
+        m_lastPresentNs = nowNs - m_paintStartNs;
+        m_presentNsTotal += m_lastPresentNs;
+        m_paintStartNs = 0;
+
+        // First swap of this frame: close its latency trail
+        if (m_swapTimestamps.presentedNs > 0) {
+            m_swapTimestamps.paintedNs = nowNs;
+            FrameLatencyStats::record(m_swapTimestamps);
+            m_swapTimestamps = FrameTimestamps();
+        }
+
+        if (++m_timedFrames % TIMING_LOG_INTERVAL == 0) {
+            qDebug() << "GlVideoDisplayWidget: Upload" << m_uploadNsTotal / static_cast<qint64>(TIMING_LOG_INTERVAL) / 1000
+                     << "us, present" << m_presentNsTotal / static_cast<qint64>(TIMING_LOG_INTERVAL) / 1000
+                     << "us per frame (avg of" << TIMING_LOG_INTERVAL << "frames)";
+            qDebug().noquote() << "GlVideoDisplayWidget: Pacing:" << m_pacing.report();
+            m_uploadNsTotal = 0;
+            m_presentNsTotal = 0;
+            m_pacing.reset();
+        }
+    }
+
+    // --- Drive the next refresh (vsync-throttled by the swap) until frames stop arriving ---
+    if (m_refreshLoopActive) {
+        m_idleRefreshes = m_swapShowsNewFrame ? 0 : m_idleRefreshes + 1;
+        if (m_idleRefreshes >= IDLE_REFRESHES_BEFORE_STOP) {
+            m_refreshLoopActive = false;
+            m_pacing.breakSequence(); // The restart gap is not judder
+        } else {
+            update();
+        }
+    }
+    m_swapShowsNewFrame = false;
+}
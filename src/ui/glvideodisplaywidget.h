@@ -0,0 +1,121 @@
+#ifndef GLVIDEODISPLAYWIDGET_H
+#define GLVIDEODISPLAYWIDGET_H
+
+// --- Qt Includes ---
+#include <QImage>
+#include <QOpenGLBuffer>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLWidget>
+#include <QSize>
+#include <QString>
+
+// --- Project Includes ---
+#include "../devices/framelatency.h"
+#include "../devices/framepacing.h"
+#include "../utils/latestvaluemailbox.h"
+#include "videoframesink.h"
+
+/**
+ * @brief Video display that draws frames as a GPU-scaled textured quad.
+ *
+ * Each new frame is streamed into a persistent texture through a pixel unpack buffer
+ * (orphaned and mapped per frame, so the upload never waits for the previous draw), and
+ * drawn letterboxed into the widget by the rasteriser instead of being scaled on the CPU.
+ * An OSD overlay (OsdRenderMode::Overlay) is uploaded into a second texture and blended
+ * over the frame. The 32-bit QImage bytes (BGRA in memory) are uploaded as-is and
+ * swizzled in the fragment shader.
+ *
+ * Only OpenGL 2.1 / OpenGL ES 2.0 features are required (the pixel buffer is skipped when
+ * unavailable), so the widget also runs on Mesa llvmpipe (LIBGL_ALWAYS_SOFTWARE=1) on
+ * machines without a GPU. Upload and present times are measured for every frame.
+ *
+ * Presentation is driven by the display refresh: while frames arrive, every frameSwapped()
+ * (throttled to vsync by the default swap interval of 1) requests the next repaint, and each
+ * repaint takes the newest frame from a LatestValueMailbox. updateFrame() only publishes
+ * into the mailbox and never waits. Frames replaced there before a refresh took them count
+ * as skipped, refreshes without a new frame as repeated; both and the on-screen frame time
+ * variance are kept in FramePacingStats. The loop stops after about a second without frames.
+ */
+class GlVideoDisplayWidget : public QOpenGLWidget, public VideoFrameSink, protected QOpenGLFunctions
+{
+    Q_OBJECT
+
+public:
+    explicit GlVideoDisplayWidget(QWidget *parent = nullptr);
+    ~GlVideoDisplayWidget() override;
+
+    // GUI thread only
+    void updateFrame(const QImage &frame, const QImage &overlay, const FrameTimestamps &timestamps) override;
+    void setPlaceholderText(const QString &text) override;
+
+    // --- Statistics (GUI thread) ---
+    const FramePacingStats &pacingStats() const { return m_pacing; } // Current log window
+    qint64 lastUploadNs() const { return m_lastUploadNs; }   // Frame + overlay texture upload
+    qint64 lastPresentNs() const { return m_lastPresentNs; } // paintGL() start to frameSwapped()
+
+signals:
+    /**
+     * @brief Emitted on resize so producers can deliver frames at the display resolution.
+     */
+    void displaySizeChanged(const QSize &size);
+
+protected:
+    void initializeGL() override;
+    void paintGL() override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private slots:
+    void onFrameSwapped();
+
+private:
+    struct PendingFrame {
+        QImage frame;   // Null: show the placeholder text
+        QImage overlay;
+        FrameTimestamps timestamps;
+    };
+
+    struct StreamTexture {
+        GLuint id = 0;
+        QSize size;              // Allocated texture size
+        QOpenGLBuffer pixelBuffer{QOpenGLBuffer::PixelUnpackBuffer};
+    };
+
+    void requestRefresh();
+    void cleanupGL();
+    void upload(StreamTexture &texture, const QImage &image);
+    void drawTexture(const StreamTexture &texture);
+    void drawPlaceholder(const QString &text);
+
+    // Published by updateFrame() / setPlaceholderText(), taken once per refresh by paintGL()
+    LatestValueMailbox<PendingFrame> m_pendingFrames;
+    QString m_placeholderText = "No Signal";
+
+    // Refresh loop
+    bool m_refreshLoopActive = false;
+    int m_idleRefreshes = 0;          // Consecutive refreshes without a new frame
+    bool m_swapShowsNewFrame = false; // The last paintGL() drew a frame taken from the mailbox
+    quint64 m_lastDroppedCount = 0;
+    FramePacingStats m_pacing;
+
+    // GL state (GUI thread, context current)
+    QOpenGLShaderProgram *m_program = nullptr;
+    QOpenGLBuffer m_quadBuffer{QOpenGLBuffer::VertexBuffer};
+    StreamTexture m_frameTexture;
+    StreamTexture m_overlayTexture;
+    bool m_showingFrame = false; // False: the placeholder text is drawn
+    bool m_hasOverlay = false;
+    bool m_usePixelBuffer = false;
+    bool m_pixelBufferMappable = false;
+
+    // Timing
+    FrameTimestamps m_swapTimestamps; // Trail of the frame being swapped, recorded on frameSwapped()
+    qint64 m_paintStartNs = 0;
+    qint64 m_lastUploadNs = 0;
+    qint64 m_lastPresentNs = 0;
+    qint64 m_uploadNsTotal = 0;
+    qint64 m_presentNsTotal = 0;
+    quint64 m_timedFrames = 0;
+};
+
+#endif // GLVIDEODISPLAYWIDGET_H
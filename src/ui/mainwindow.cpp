@@ -18,6 +18,12 @@
 #include <QCoreApplication>
 #include <QMessageBox>    // For messages
 #include <QStatusBar>     // Use status bar
+#include <QElapsedTimer>
+#include <QThread>
+#include <QShortcut>
+#include "../devices/osdrenderworker.h"
+#include "../devices/cameraregistry.h"
+#include "glvideodisplaywidget.h"
 
 
 MainWindow::MainWindow(GimbalController *gimbal,
@@ -25,8 +31,7 @@ MainWindow::MainWindow(GimbalController *gimbal,
                        CameraController *camera,
                        JoystickController *joystick,
                        SystemStateModel *stateModel,
-                       CameraVideoStreamDevice *dayProcessor,
-                       CameraVideoStreamDevice *nightProcessor,
+                       CameraRegistry *cameras,
                        QWidget *parent)
     : QMainWindow(parent), // Base class initializer first
     // UI Pointer (initialized by setupUi)
@@ -46,11 +51,8 @@ MainWindow::MainWindow(GimbalController *gimbal,
     // State Management
     m_stateModel(stateModel),
     m_oldState(), // Default construct SystemStateData
-    // Video Processing & OSD (using QPointer for safety)
-    m_dayProcessor(dayProcessor),
-    m_nightProcessor(nightProcessor),
-    m_osdRenderer_day(nullptr), // Initialize QPointer to nullptr
-    m_osdRenderer_night(nullptr),
+    // Video Processing & OSD (views hold QPointers for safety)
+    m_cameras(cameras),
     // State Flags (initialize with default values)
     m_isDayCameraActive(true),
     m_activeCameraIndex(0),
@@ -60,10 +62,6 @@ MainWindow::MainWindow(GimbalController *gimbal,
     m_systemStatusActive(false),
     m_settingsMenuActive(false),
     m_aboutActive(false),
-    m_trackingActive_cam1(false),
-    m_trackingActive_cam2(false),
-    m_detectionActive_cam1(false),
-    m_detectionActive_cam2(false),
     m_brightnessControlActive(false),
     // Pointers to Managed Widgets (initialize to nullptr)
     m_menuWidget(nullptr),
@@ -90,43 +88,79 @@ MainWindow::MainWindow(GimbalController *gimbal,
 {
     ui->setupUi(this);
 
+    const int cameraCount = m_cameras ? m_cameras->count() : 0;
+    m_cameraViews.resize(static_cast<size_t>(cameraCount));
+    for (int i = 0; i < cameraCount; ++i) {
+        m_cameraViews[static_cast<size_t>(i)].processor = m_cameras->device(i);
+    }
+
     // --- Create OSD Renderers ---
-    // Determine output dimensions (e.g., 960x720 from 4:3 crop)
-    // These should ideally come from config or CameraVideoStreamDevice itself
-    const int outputWidth = 1024;
-    const int outputHeight = 768;
-    m_osdRenderer_day = new OsdRenderer(outputWidth, outputHeight, this); // Parent to main window
-    m_osdRenderer_night = new OsdRenderer(outputWidth, outputHeight, this);
-    // Optionally set initial static text like camera type
-    m_osdRenderer_day->updateCameraType("DAY");
-    m_osdRenderer_night->updateCameraType("THERMAL");
+    // Laid out for the frames the cameras will negotiate for this display; the renderers
+    // follow each frame's own size after that (onDisplaySizeChanged() renegotiates on resize)
+    const QSize displaySize = ui->videoDisplay ? ui->videoDisplay->size() : size();
+    const QSize outputSize = CameraVideoStreamDevice::outputSizeForDisplay(displaySize.width(), displaySize.height());
+    const int outputWidth = outputSize.width();
+    const int outputHeight = outputSize.height();
+    const QStringList arguments = QCoreApplication::arguments();
+
+    // --video-display=raster keeps the QPainter display from the .ui (default: OpenGL)
+    const bool useGlDisplay = !arguments.contains(QStringLiteral("--video-display=raster"));
+
+    // --osd-render-mode=inplace draws the OSD into frames no one else references (default: composite)
+    OsdRenderMode osdRenderMode = arguments.contains(QStringLiteral("--osd-render-mode=inplace"))
+                                      ? OsdRenderMode::InPlace : OsdRenderMode::Composite;
+    // The OpenGL display blends the OSD as its own texture, so the camera frame is never copied
+    if (useGlDisplay && osdRenderMode == OsdRenderMode::Composite) {
+        osdRenderMode = OsdRenderMode::Overlay;
+    }
+
+    if (arguments.contains(QStringLiteral("--osd-renderer=scene"))) {
+        // QGraphicsScene renderers, composed on the GUI thread
+        for (int i = 0; i < cameraCount; ++i) {
+            OsdRenderer *renderer = new OsdRenderer(outputWidth, outputHeight, this); // Parent to main window
+            renderer->updateCameraType(m_cameras->config(i).osdLabel);
+            renderer->setRenderMode(osdRenderMode);
+            m_cameraViews[static_cast<size_t>(i)].osdRenderer = renderer;
+        }
+    } else {
+        // Default: scene-free renderers on one worker thread per camera, the GUI thread only presents
+        startOsdRenderWorkers(outputWidth, outputHeight, osdRenderMode);
+    }
+    startNetworkOutput(arguments);
+    startPictureInPicture(arguments);
 
 
     // --- Connect Signals ---
     if (m_stateModel) {
-        connect(m_stateModel, &SystemStateModel::dataChanged,
-                this, &MainWindow::onSystemStateChanged, Qt::QueuedConnection); // Use Queued for safety
+        // Everything but IMU, device health, radar and status text updates
+        const StateGroups usedGroups = StateGroup::Modes | StateGroup::UiStyle | StateGroup::Optics |
+                                       StateGroup::Zones | StateGroup::GimbalPose | StateGroup::Controls |
+                                       StateGroup::Station | StateGroup::Tracking | StateGroup::Ballistics;
+        connect(m_stateModel, &SystemStateModel::stateGroupsChanged, this, [this, usedGroups](StateGroups changed) {
+            if (changed & usedGroups) onSystemStateChanged(m_stateModel->data());
+        }, Qt::QueuedConnection); // Use Queued for safety
         // Set initial state from model
         m_oldState = m_stateModel->data();
-        m_activeCameraIndex = m_oldState.activeCameraIsDay ? 0 : 1;
+        m_activeCameraIndex = m_oldState.activeCameraIndex;
         m_isDayCameraActive = m_oldState.activeCameraIsDay;
     }
+    updatePictureInPicture();
 
-    // Connect CameraVideoStreamDevice signals to handleFrameData
-    if (m_dayProcessor) {
-        connect(m_dayProcessor, &CameraVideoStreamDevice::frameDataReady,
-                this, &MainWindow::handleFrameData, Qt::QueuedConnection);
-
-    }
-    if (m_nightProcessor) {
-        connect(m_nightProcessor, &CameraVideoStreamDevice::frameDataReady,
-                this, &MainWindow::handleFrameData, Qt::QueuedConnection);
-        /*onnect(m_nightProcessor, &CameraVideoStreamDevice::processingError,
-                this, &MainWindow::handleError, Qt::QueuedConnection); // Connect error/status
-        connect(m_nightProcessor, &CameraVideoStreamDevice::statusUpdate,
-                this, &MainWindow::updateStatus, Qt::QueuedConnection);*/
+    // Coalesced frame wake-ups: onFrameAvailable() takes the newest frame from the processor's mailbox
+    for (const CameraView &view : m_cameraViews) {
+        if (view.processor) {
+            connect(view.processor, &CameraVideoStreamDevice::frameAvailable,
+                    this, &MainWindow::onFrameAvailable, Qt::QueuedConnection);
+        }
     }
 
+    // F9: operator request to keep the last seconds of video and what follows as an event clip
+    QShortcut *recordEventShortcut = new QShortcut(QKeySequence(Qt::Key_F9), this);
+    connect(recordEventShortcut, &QShortcut::activated, this, [this]() { saveRecordingEvent("operator"); });
+    // F10: next camera, including the auxiliary ones the day/night switch does not reach
+    QShortcut *nextCameraShortcut = new QShortcut(QKeySequence(Qt::Key_F10), this);
+    connect(nextCameraShortcut, &QShortcut::activated, this, &MainWindow::selectNextCamera);
+
     connect(m_joystickCtrl, &JoystickController::trackSelectButtonPressed,
     this, &MainWindow::onTrackSelectButtonPressed);
 
@@ -150,6 +184,28 @@ MainWindow::MainWindow(GimbalController *gimbal,
 
     // Set up the camera displays
     setupCameraDisplays();
+
+    // Capture pipelines scale straight to the display size (the only scale on the video path)
+    if (ui->videoDisplay) {
+        if (useGlDisplay) {
+            // Takes the .ui display's place; stacked under it so the buttons stay on top
+            GlVideoDisplayWidget *glDisplay = new GlVideoDisplayWidget(ui->videoDisplay->parentWidget());
+            glDisplay->setObjectName(QStringLiteral("glVideoDisplay"));
+            glDisplay->setGeometry(ui->videoDisplay->geometry());
+            glDisplay->stackUnder(ui->videoDisplay);
+            ui->videoDisplay->hide();
+            glDisplay->show();
+            connect(glDisplay, &GlVideoDisplayWidget::displaySizeChanged,
+                    this, &MainWindow::onDisplaySizeChanged);
+            m_videoSink = glDisplay;
+        } else {
+            connect(ui->videoDisplay, &VideoDisplayWidget::displaySizeChanged,
+                    this, &MainWindow::onDisplaySizeChanged);
+            m_videoSink = ui->videoDisplay;
+        }
+        // No size is passed on here: the display's resize event on show does that, then
+        // videoDisplaySized() lets the pipelines start at that size
+    }
     // Initially show the day camera
     SystemStateData newData;
     onActiveCameraChanged(newData.activeCameraIsDay);
@@ -173,15 +229,11 @@ void MainWindow::initializeUI()
     // Set initial UI state based on active camera
     updateUIForActiveCamera();
 
-    // Ensure the video label exists and maybe set a background/placeholder
-    if (!ui->videoLabel) {
-         qCritical() << "UI setup error: videoLabel is missing!";
-         // Handle error - maybe add a label programmatically?
+    // Ensure the video display exists and show a placeholder until the first frame
+    if (!m_videoSink) {
+         qCritical() << "UI setup error: videoDisplay is missing!";
     } else {
-         // Optional: Set a placeholder color or text
-         ui->videoLabel->setText("Waiting for video signal...");
-         ui->videoLabel->setAlignment(Qt::AlignCenter);
-         // ui->videoLabel->setStyleSheet("background-color: black; color: gray;");
+         m_videoSink->setPlaceholderText("Waiting for video signal...");
     }
 
     // Setup timer (keep if used)
@@ -191,120 +243,308 @@ void MainWindow::initializeUI()
     updateTimer->start();
 }
 
+MainWindow::CameraView *MainWindow::cameraView(int cameraIndex)
+{
+    if (cameraIndex < 0 || cameraIndex >= static_cast<int>(m_cameraViews.size())) {
+        return nullptr;
+    }
+    return &m_cameraViews[static_cast<size_t>(cameraIndex)];
+}
+
+void MainWindow::onFrameAvailable(int cameraIndex)
+{
+    const CameraView *view = cameraView(cameraIndex);
+    CameraVideoStreamDevice *processor = view ? view->processor.data() : nullptr;
+    if (!processor) {
+        return;
+    }
+    // Always drain the mailbox (even for the inactive camera) so the next frame wakes us again.
+    // Frames published while the GUI thread was busy have been replaced by the newest one.
+    FrameData data;
+    if (processor->takeLatestFrame(data)) {
+        data.timestamps.dequeuedNs = FrameTimestamps::nowNs();
+        handleFrameData(std::move(data));
+    }
+}
+
+void MainWindow::onDisplaySizeChanged(const QSize &size)
+{
+    if (size.isEmpty()) {
+        return;
+    }
+    for (const CameraView &view : m_cameraViews) {
+        if (view.processor) view.processor->setDisplaySize(size.width(), size.height());
+    }
+    if (!m_videoDisplaySized) {
+        m_videoDisplaySized = true;
+        emit videoDisplaySized();
+    }
+}
+
 // *** Core Video Update Slot ***
-void MainWindow::handleFrameData(const FrameData &data)
+void MainWindow::handleFrameData(FrameData data)
 {
     // Only process data for the currently selected camera view
     if (data.cameraIndex != m_activeCameraIndex) {
         return; // Ignore data from the non-active processor
     }
+    if (data.baseImage.isNull()) {
+        // Handle null image (e.g., show "No Signal" on the label)
+        if(m_videoSink) m_videoSink->setPlaceholderText(QString("No Signal - Cam %1").arg(data.cameraIndex + 1));
+        return;
+    }
+
+    QElapsedTimer guiTimer;
+    guiTimer.start();
+
+    if (m_networkOutput && !m_networkOutput->config().composited) {
+        m_networkOutput->pushFrame(data.baseImage); // Raw feed: the camera frame before the OSD
+    }
 
-    // Select the correct OSD renderer
-    OsdRenderer *currentRenderer = (data.cameraIndex == 0) ? m_osdRenderer_day : m_osdRenderer_night;
+    // Frame size follows the display: keep the model's aimpoint/gate pixels in the same space
+    if (data.baseImage.size() != m_videoFrameSize) {
+        m_videoFrameSize = data.baseImage.size();
+        m_stateModel->onCameraImageSizeChanged(m_videoFrameSize.width(), m_videoFrameSize.height());
+    }
+    const OsdFrameState osdState = buildOsdFrameState(data);
+    const CameraView *view = cameraView(data.cameraIndex);
+    if (!view) {
+        return;
+    }
+
+    // --- Worker path: compose off the GUI thread, presentOsdFrame() shows the result ---
+    if (view->osdWorker) {
+        view->osdWorker->submit(osdState, std::move(data.baseImage), data.timestamps);
+        m_guiFrameNs += guiTimer.nsecsElapsed();
+        return;
+    }
+
+    // --- Scene path (--osd-renderer=scene): compose here ---
+    OsdRenderer *currentRenderer = view->osdRenderer;
     if (!currentRenderer) {
         // This shouldn't happen if constructor succeeded
         return;
     }
-     if (data.baseImage.isNull()) {
-        // Handle null image (e.g., show "No Signal" on the label)
-        if(ui->videoLabel) ui->videoLabel->setText(QString("No Signal - Cam %1").arg(data.cameraIndex + 1));
+    // One batched, diffing update: only items whose inputs changed are touched.
+    currentRenderer->setFrameSize(data.baseImage.width(), data.baseImage.height());
+    currentRenderer->apply(osdState);
+    const QImage finalImage = currentRenderer->renderOsd(std::move(data.baseImage));
+    FrameTimestamps timestamps = data.timestamps;
+    timestamps.osdDoneNs = FrameTimestamps::nowNs();
+    presentFrame(finalImage, QImage(), data.cameraIndex, timestamps);
+    m_guiFrameNs += guiTimer.nsecsElapsed();
+}
+
+void MainWindow::presentOsdFrame(int cameraIndex, const QImage &image, const QImage &overlay,
+                                 const FrameTimestamps &timestamps)
+{
+    // Frames rendered for the camera we just switched away from are dropped
+    if (cameraIndex != m_activeCameraIndex) {
         return;
     }
+    QElapsedTimer guiTimer;
+    guiTimer.start();
+    presentFrame(image, overlay, cameraIndex, timestamps);
+    m_guiFrameNs += guiTimer.nsecsElapsed();
+}
 
-    // --- Update OSD State ---
-    // (This part is the same as provided in previous answers)
-    currentRenderer->updateMode(data.currentOpMode);
-    currentRenderer->updateMotionMode(data.motionMode);
-    currentRenderer->updateStabilization(data.stabEnabled);
-    currentRenderer->updateLrfDistance(data.lrfDistance);
-    currentRenderer->updateSystemStatus(data.sysCharged, data.sysArmed, data.sysReady);
-    currentRenderer->updateFiringMode(data.fireMode);
-    currentRenderer->updateFov(data.cameraFOV);
-    currentRenderer->updateSpeed(data.speed);
-    currentRenderer->updateAzimuth(data.azimuth);
-    currentRenderer->updateElevation(data.elevation);
-    //currentRenderer->updateTrackingState(data.trackingState);
-
-    currentRenderer->updateColorStyle(m_stateModel->data().colorStyle);
-    bool showTrackingBox =data.trackerInitialized && (data.trackingState != VPI_TRACKING_STATE_LOST);
-    currentRenderer->updateTrackingBox(
-        static_cast<float>(data.trackingBbox.x()),
-        static_cast<float>(data.trackingBbox.y()),
-        static_cast<float>(data.trackingBbox.width()),
-        static_cast<float>(data.trackingBbox.height()) );    // data.trackingEnabled && 
-    //,        showTrackingBox
-
-    if (data.detectionEnabled) { // Only update if detection was run for this frame
-        currentRenderer->updateDetectionBoxes(data.detections);
-    } else {
-        currentRenderer->updateDetectionBoxes({}); // Send empty vector to clear old boxes
-    }
-    currentRenderer->updateZeroingDisplay(data.zeroingModeActive,
-                                          data.zeroingAppliedToBallistics,
-                                          data.zeroingAzimuthOffset,
-                                          data.zeroingElevationOffset);
-        currentRenderer->updateAppliedZeroingOffsets(data.zeroingAppliedToBallistics,
-                                                 data.zeroingAzimuthOffset,
-                                                 data.zeroingElevationOffset);                                      
-    currentRenderer->updateWindageDisplay(data.windageModeActive,
-                                          data.windageAppliedToBallistics,
-                                          data.windageSpeedKnots);                                          
-     currentRenderer->updateZoneWarning(data.isReticleInNoFireZone, data.gimbalStoppedAtNTZLimit);                                     
-    currentRenderer->updateReticleType(m_stateModel->data().reticleType);
-    currentRenderer->updateReticlePosition(data.reticleAimpointImageX_px,
-                                           data.reticleAimpointImageY_px);
-    QRectF acquisitionBox(data.acquisitionBoxX_px, data.acquisitionBoxY_px,
-                          data.acquisitionBoxW_px, data.acquisitionBoxH_px);
-
-    // The old `data.trackingBbox` (a QRect) can be used for the tracked box.
-    // Let's ensure we use QRectF for consistency.
-    QRectF trackedBbox = data.trackingBbox;
-
-    currentRenderer->updateTrackingPhaseDisplay(
-        data.currentTrackingPhase,
-        data.trackerHasValidTarget,
-        acquisitionBox,
-        trackedBbox
-        );
-    // Pass pre-formatted status texts
-    currentRenderer->updateLeadStatusText(data.leadStatusText);
-    currentRenderer->updateCurrentScanNameDisplay(data.currentScanName);
-    /*    // --- Lead Angle Compensation Data ---
-    bool leadAngleCompensationActive = false;      // Master switch for LAC feature
-    LeadAngleStatus currentLeadAngleStatus = LeadAngleStatus::Off;
-    float leadAngleOffsetAz = 0.0f; // Calculated lead offset in Azimuth (degrees/mils)
-    float leadAngleOffsetEl = 0.0f; // Calculated lead offset in Elevation (degrees/mils)
-
-    // Inputs for BallisticsProcessor (these might also be part of target data if tracking)
-    float currentTargetRange = 0.0f; // From LRF or tracking data
-    // Simplified target motion: assume relative angular rates seen by the sensor
-
-    float currentTargetAngularRateEl = 0.0f; // deg/sec or rad/sec
-    float muzzleVelocityMPS = 900.0f; // Example muzzle velocity, adjust as needed*/
-    currentRenderer->updateLeadAngleDisplay(
-        m_stateModel->data().leadAngleCompensationActive,
-        m_stateModel->data().currentLeadAngleStatus,
-        m_stateModel->data().leadAngleOffsetAz,
-        m_stateModel->data().leadAngleOffsetEl);
-
-    // --- Render OSD onto the base image ---
-    QImage finalImage = currentRenderer->renderOsd(data.baseImage);
-
-    // --- Display the final image in the UI Label ---
-    if (!finalImage.isNull() && ui->videoLabel) {
-        // Check if label size is valid before scaling
-        QSize labelSize = ui->videoLabel->size();
-        if (labelSize.isValid() && labelSize.width() > 0 && labelSize.height() > 0) {
-             ui->videoLabel->setPixmap(QPixmap::fromImage(finalImage).scaled(
-                                      labelSize,
-                                      Qt::KeepAspectRatio,
-                                      Qt::SmoothTransformation));
-        } else {
-             // If label size isn't ready yet, set pixmap without scaling
-             ui->videoLabel->setPixmap(QPixmap::fromImage(finalImage));
+void MainWindow::presentFrame(const QImage &finalImage, const QImage &overlay, int cameraIndex, FrameTimestamps timestamps)
+{
+    // --- Hand the final image (and OSD overlay, if separate) to the display, shared and scaled at paint time ---
+    if (!finalImage.isNull() && m_videoSink) {
+        timestamps.presentedNs = FrameTimestamps::nowNs();
+        m_videoSink->updateFrame(finalImage, overlay, timestamps); // Records the latency trail once painted
+        if (m_networkOutput && m_networkOutput->config().composited) {
+            m_networkOutput->pushFrame(finalImage, overlay); // Composed on the output thread, never waits
+        }
+        FrameCopyStats::recordFrame();
+        ++m_guiFrameCount;
+        if (FrameCopyStats::framesPresented() % 300 == 0) {
+            qDebug() << "MainWindow: Bytes copied per frame (GstBuffer -> paint):"
+                     << FrameCopyStats::bytesPerFrame();
+            qDebug() << "MainWindow: GUI-thread time per frame:"
+                     << (m_guiFrameCount > 0 ? m_guiFrameNs / static_cast<qint64>(m_guiFrameCount) / 1000 : 0) << "us";
+            if (m_cameras) {
+                qDebug().noquote() << "MainWindow: Cameras\n" + m_cameras->report();
+            }
+            const CameraView *view = cameraView(cameraIndex);
+            OsdRenderWorker *worker = view ? view->osdWorker : nullptr;
+            if (worker) {
+                qDebug() << "MainWindow: OSD worker cam" << cameraIndex << "queue depth" << worker->queueDepth()
+                         << "rendered" << worker->renderedFrames() << "skipped" << worker->skippedFrames()
+                         << "last render" << worker->lastRenderNs() / 1000 << "us";
+            }
+            if (m_networkOutput) {
+                qDebug().noquote() << "MainWindow: Network output:" << m_networkOutput->takeReport();
+            }
+            qDebug().noquote() << "MainWindow: Frame latency\n" + FrameLatencyStats::report();
+            m_guiFrameNs = 0;
+            m_guiFrameCount = 0;
+        }
+    } else if (m_videoSink) {
+         m_videoSink->setPlaceholderText(QString("Render Error Cam %1").arg(cameraIndex + 1));
+    }
+}
+
+OsdFrameState MainWindow::buildOsdFrameState(const FrameData &data) const
+{
+    const SystemStateData modelData = m_stateModel->data();
+    OsdFrameState osdState;
+    osdState.cameraType = (m_cameras && data.cameraIndex >= 0 && data.cameraIndex < m_cameras->count())
+                              ? m_cameras->config(data.cameraIndex).osdLabel : QString();
+    osdState.mode = data.currentOpMode;
+    osdState.motionMode = data.motionMode;
+    osdState.stabEnabled = data.stabEnabled;
+    osdState.lrfDistance = data.lrfDistance;
+    osdState.sysCharged = data.sysCharged;
+    osdState.sysArmed = data.sysArmed;
+    osdState.sysReady = data.sysReady;
+    osdState.fireMode = data.fireMode;
+    osdState.fov = data.cameraFOV;
+    osdState.speed = data.speed;
+    osdState.leadStatusText = data.leadStatusText;
+    osdState.scanName = data.currentScanName;
+
+    osdState.azimuth = data.azimuth;
+    osdState.elevation = data.elevation;
+    osdState.colorStyle = modelData.colorStyle;
+
+    osdState.trackingBox = QRectF(data.trackingBbox);
+    osdState.trackingPhase = data.currentTrackingPhase;
+    osdState.hasValidLock = data.trackerHasValidTarget;
+    osdState.acquisitionBox = QRectF(data.acquisitionBoxX_px, data.acquisitionBoxY_px,
+                                     data.acquisitionBoxW_px, data.acquisitionBoxH_px);
+    osdState.trackedBox = QRectF(data.trackingBbox);
+    if (data.detectionEnabled) { // Only show boxes if detection was run for this frame
+        osdState.detections = data.detections;
+    }
+
+    osdState.zeroingModeActive = data.zeroingModeActive;
+    osdState.zeroingApplied = data.zeroingAppliedToBallistics;
+    osdState.zeroingAzOffset = data.zeroingAzimuthOffset;
+    osdState.zeroingElOffset = data.zeroingElevationOffset;
+    osdState.windageModeActive = data.windageModeActive;
+    osdState.windageApplied = data.windageAppliedToBallistics;
+    osdState.windageSpeedKnots = data.windageSpeedKnots;
+    osdState.inNoFireZone = data.isReticleInNoFireZone;
+    osdState.inNoTraverseZoneAtLimit = data.gimbalStoppedAtNTZLimit;
+
+    osdState.reticleType = modelData.reticleType;
+    osdState.reticlePosition = QPointF(data.reticleAimpointImageX_px, data.reticleAimpointImageY_px);
+    osdState.leadAngleActive = modelData.leadAngleCompensationActive;
+    osdState.leadAngleStatus = modelData.currentLeadAngleStatus;
+    osdState.leadAngleOffsetAz = modelData.leadAngleOffsetAz;
+    osdState.leadAngleOffsetEl = modelData.leadAngleOffsetEl;
+
+    // Picture-in-picture: the newest inset the paired camera decimated, shared rather than copied
+    if (m_pipCameraIndex >= 0 && m_pipCameraIndex != data.cameraIndex && m_pipCameraIndex < m_cameras->count()) {
+        osdState.pipInset = m_cameras->device(m_pipCameraIndex)->latestInset();
+        if (!osdState.pipInset.isNull()) {
+            osdState.pipPosition = m_pipConfig.insetPosition(data.baseImage.size(), osdState.pipInset.size());
+            osdState.pipLabel = m_cameras->config(m_pipCameraIndex).osdLabel;
+        }
+    }
+
+    return osdState;
+}
+
+void MainWindow::startOsdRenderWorkers(int width, int height, OsdRenderMode mode)
+{
+    for (size_t i = 0; i < m_cameraViews.size(); ++i) {
+        CameraView &view = m_cameraViews[i];
+        view.osdThread = new QThread(this);
+        view.osdThread->setObjectName(QStringLiteral("OsdRender%1").arg(m_cameras->config(static_cast<int>(i)).name));
+
+        // No parent: the worker is moved to its thread and deleted when that finishes
+        view.osdWorker = new OsdRenderWorker(static_cast<int>(i), width, height, mode);
+        view.osdWorker->moveToThread(view.osdThread);
+        connect(view.osdThread, &QThread::finished, view.osdWorker, &QObject::deleteLater);
+        connect(view.osdWorker, &OsdRenderWorker::frameRendered,
+                this, &MainWindow::presentOsdFrame, Qt::QueuedConnection);
+        view.osdThread->start();
+    }
+}
+
+void MainWindow::startNetworkOutput(const QStringList &arguments)
+{
+    // --net-out=<host>:<port> streams the active camera over RTP/UDP, with the OSD unless --net-out-raw;
+    // --net-out-bitrate=<kbit/s> sets the encoder bitrate
+    const QString outputPrefix = QStringLiteral("--net-out=");
+    const QString bitratePrefix = QStringLiteral("--net-out-bitrate=");
+    NetworkVideoOutputConfig config;
+    config.composited = !arguments.contains(QStringLiteral("--net-out-raw"));
+    for (const QString &argument : arguments) {
+        if (argument.startsWith(outputPrefix)) {
+            QString errorMessage;
+            if (!NetworkVideoOutputConfig::fromSpec(argument.mid(outputPrefix.size()), config, &errorMessage)) {
+                qWarning() << errorMessage;
+            }
+        } else if (argument.startsWith(bitratePrefix)) {
+            bool ok = false;
+            const int bitrateKbps = argument.mid(bitratePrefix.size()).toInt(&ok);
+            if (ok && bitrateKbps > 0) {
+                config.bitrateKbps = bitrateKbps;
+            } else {
+                qWarning() << "Ignoring" << argument << "- keeping" << config.bitrateKbps << "kbit/s";
+            }
+        }
+    }
+    if (!config.enabled()) {
+        return;
+    }
+    m_networkOutput.reset(new NetworkVideoOutput(config));
+    m_networkOutput->start();
+}
+
+void MainWindow::startPictureInPicture(const QStringList &arguments)
+{
+    // --pip shows the inactive camera as an inset with the defaults; --pip=<corner>[,size=<%>][,fps=<rate>]
+    const QString pipPrefix = QStringLiteral("--pip=");
+    for (const QString &argument : arguments) {
+        if (argument == QLatin1String("--pip") || argument.startsWith(pipPrefix)) {
+            const QString spec = argument.startsWith(pipPrefix) ? argument.mid(pipPrefix.size()) : QString();
+            QString errorMessage;
+            if (!PictureInPictureConfig::fromSpec(spec, m_pipConfig, &errorMessage)) {
+                qWarning() << errorMessage;
+            }
         }
-    } else if (ui->videoLabel) {
-         ui->videoLabel->setText(QString("Render Error Cam %1").arg(data.cameraIndex + 1));
+    }
+    if (m_pipConfig.enabled) {
+        qInfo() << "MainWindow: Picture-in-picture" << m_pipConfig.toSpec() << "- 1 /"
+                << m_pipConfig.decimationStep() << "of the frame size";
+    }
+}
+
+void MainWindow::updatePictureInPicture()
+{
+    if (!m_pipConfig.enabled || !m_cameras || m_cameras->count() < 2) {
+        return;
+    }
+    // Day and night show each other; an auxiliary camera gets the day camera
+    const int pipIndex = (m_activeCameraIndex == 0) ? 1 : 0;
+    if (pipIndex == m_pipCameraIndex) {
+        return;
+    }
+    if (m_pipCameraIndex >= 0 && m_pipCameraIndex < m_cameras->count()) {
+        m_cameras->device(m_pipCameraIndex)->setInset(0, 0);
+    }
+    // Only produced while that camera is in standby, i.e. not the active one
+    m_cameras->device(pipIndex)->setInset(m_pipConfig.decimationStep(), m_pipConfig.refreshIntervalMs());
+    m_pipCameraIndex = pipIndex;
+}
+
+void MainWindow::stopOsdRenderWorkers()
+{
+    for (const CameraView &view : m_cameraViews) {
+        if (view.osdThread && view.osdThread->isRunning()) {
+            view.osdThread->quit();
+        }
+    }
+    for (CameraView &view : m_cameraViews) {
+        if (view.osdThread && !view.osdThread->wait(1000)) {
+            qWarning() << "OSD render thread" << view.osdThread->objectName() << "did not stop gracefully.";
+        }
+        view.osdWorker = nullptr; // Deleted by its thread's finished signal
     }
 }
 
@@ -313,12 +553,14 @@ void MainWindow::onSystemStateChanged(const SystemStateData &newData)
 {
     // --- Handle Camera Switching ---
     // Check if the active camera flag changed in the model
-    if (m_oldState.activeCameraIsDay != newData.activeCameraIsDay) {
-        qDebug() << "MainWindow: Detected camera switch in state model.";
+    if (m_oldState.activeCameraIsDay != newData.activeCameraIsDay
+        || m_oldState.activeCameraIndex != newData.activeCameraIndex) {
+        qDebug() << "MainWindow: Detected camera switch in state model to Cam" << newData.activeCameraIndex;
         // Update local cache and active index
         m_isDayCameraActive = newData.activeCameraIsDay;
-        m_activeCameraIndex = m_isDayCameraActive ? 0 : 1;
+        m_activeCameraIndex = newData.activeCameraIndex;
         updateUIForActiveCamera(); // Update buttons/labels
+        updatePictureInPicture();
 
         // **Important**: Tracking stop on the *old* camera is now handled
         // by CameraController::onSystemStateChanged reacting to this same signal.
@@ -490,6 +732,11 @@ MainWindow::~MainWindow()
     if (updateTimer && updateTimer->isActive()) {
         updateTimer->stop();
     }
+    stopOsdRenderWorkers();
+    if (m_networkOutput) {
+        m_networkOutput->stop();
+        m_networkOutput->wait();
+    }
 
     delete ui;
 }
@@ -1228,12 +1475,12 @@ void MainWindow::onDownTrackChanged(bool state)
 
 void MainWindow::onTrackSelectButtonPressed()
 {
-    bool* activeTrackingFlagPtr = (m_activeCameraIndex == 0) ? &m_trackingActive_cam1 : &m_trackingActive_cam2;
-    CameraVideoStreamDevice* activeProcessor = (m_activeCameraIndex == 0) ? m_dayProcessor : m_nightProcessor;
+    CameraView *activeView = cameraView(m_activeCameraIndex);
+    CameraVideoStreamDevice* activeProcessor = activeView ? activeView->processor.data() : nullptr;
     if (!activeProcessor) { qWarning() << "Cannot toggle tracking: Active processor is null."; return; }
 
-    *activeTrackingFlagPtr = !(*activeTrackingFlagPtr);
-    bool newState = *activeTrackingFlagPtr;
+    activeView->trackingActive = !activeView->trackingActive;
+    bool newState = activeView->trackingActive;
     qInfo() << "Cam" << m_activeCameraIndex << ":" << (newState ? "Requesting Enable Tracking" : "Requesting Disable Tracking");
     QMetaObject::invokeMethod(activeProcessor, "setTrackingEnabled", Qt::QueuedConnection, Q_ARG(bool, newState));
     updateUIForActiveCamera();
@@ -1379,11 +1626,29 @@ void MainWindow::on_quit_clicked()
 void MainWindow::onAlarmDetected(uint16_t alarmCode, const QString &description)
 {
     qDebug() << "Alarm detected: " << alarmCode << description;
+    // Keep what the operator saw around the alarm (no-op without --record-dir)
+    saveRecordingEvent(QString("alarm_%1").arg(alarmCode));
     // Update UI with alarm information
     // e.g. show alarm code and description in a dialog
     // QMessageBox::warning(this, "Alarm Detected", QString("Alarm %1: %2").arg(alarmCode).arg(description));
 }
 
+void MainWindow::saveRecordingEvent(const QString &reason)
+{
+    for (const CameraView &view : m_cameraViews) {
+        if (view.processor) {
+            view.processor->triggerRecordingEvent(reason);
+        }
+    }
+}
+
+void MainWindow::selectNextCamera()
+{
+    if (m_stateModel && !m_cameraViews.empty()) {
+        m_stateModel->setActiveCameraIndex((m_activeCameraIndex + 1) % static_cast<int>(m_cameraViews.size()));
+    }
+}
+
 void MainWindow::onAlarmCleared()
 {
     qDebug() << "Alarm cleared.";
@@ -1412,12 +1677,12 @@ void MainWindow::on_clear_clicked()
 
 void MainWindow::on_toggleTrackingButton_clicked()
 {
-    bool* activeTrackingFlagPtr = (m_activeCameraIndex == 0) ? &m_trackingActive_cam1 : &m_trackingActive_cam2;
-    CameraVideoStreamDevice* activeProcessor = (m_activeCameraIndex == 0) ? m_dayProcessor : m_nightProcessor;
+    CameraView *activeView = cameraView(m_activeCameraIndex);
+    CameraVideoStreamDevice* activeProcessor = activeView ? activeView->processor.data() : nullptr;
     if (!activeProcessor) { qWarning() << "Cannot toggle tracking: Active processor is null."; return; }
 
-    *activeTrackingFlagPtr = !(*activeTrackingFlagPtr);
-    bool newState = *activeTrackingFlagPtr;
+    activeView->trackingActive = !activeView->trackingActive;
+    bool newState = activeView->trackingActive;
     qInfo() << "Cam" << m_activeCameraIndex << ":" << (newState ? "Requesting Enable Tracking" : "Requesting Disable Tracking");
     QMetaObject::invokeMethod(activeProcessor, "setTrackingEnabled", Qt::QueuedConnection, Q_ARG(bool, newState));
     updateUIForActiveCamera();
@@ -1426,12 +1691,12 @@ void MainWindow::on_toggleTrackingButton_clicked()
 
 void MainWindow::on_detection_clicked()
 {
-    bool* activeDetectionFlagPtr = (m_activeCameraIndex == 0) ? &m_detectionActive_cam1 : &m_detectionActive_cam2;
-    CameraVideoStreamDevice* activeProcessor = (m_activeCameraIndex == 0) ? m_dayProcessor : m_nightProcessor;
+    CameraView *activeView = cameraView(m_activeCameraIndex);
+    CameraVideoStreamDevice* activeProcessor = activeView ? activeView->processor.data() : nullptr;
     if (!activeProcessor) { qWarning() << "Cannot toggle detection: Active processor is null."; return; }
 
-    *activeDetectionFlagPtr = !(*activeDetectionFlagPtr);
-    bool newState = *activeDetectionFlagPtr;
+    activeView->detectionActive = !activeView->detectionActive;
+    bool newState = activeView->detectionActive;
     qInfo() << "Cam" << m_activeCameraIndex << ":" << (newState ? "Requesting Enable Detection" : "Requesting Disable Dtection");
     QMetaObject::invokeMethod(activeProcessor, "setDetectionEnabled", Qt::QueuedConnection, Q_ARG(bool, newState));
     updateUIForActiveCamera();
@@ -3,6 +3,10 @@
 
 #define MAINWINDOW_H
 
+// Standard Library Includes
+#include <memory>
+#include <vector>
+
 // Qt Includes
 #include <QMainWindow>
 #include <QVBoxLayout>
@@ -26,7 +30,10 @@ class JoystickController;
  
 class SystemStateModel;
 class CameraVideoStreamDevice;
+class CameraRegistry;
 class OsdRenderer;
+class OsdRenderWorker;
+class QThread;
 class CustomMenuWidget;
 class SystemStatusWidget;
 class WindageWidget;
@@ -47,6 +54,8 @@ class CameraContainerWidget;
 #include "../ui/cameracontainerwidget.h"
 #include "../devices/cameravideostreamdevice.h" // Includes FrameData
 #include "../devices/osdrenderer.h"
+#include "../devices/networkvideooutput.h"
+#include "../devices/pictureinpicture.h"
 #include "../utils/colorutils.h" // For color style conversions
 // UI Namespace Forward Declaration
 namespace Ui {
@@ -65,8 +74,7 @@ public:
                         CameraController *camera,
                          JoystickController *joystick,
                         SystemStateModel *stateModel,
-                        CameraVideoStreamDevice *dayProcessor,
-                        CameraVideoStreamDevice *nightProcessor,
+                        CameraRegistry *cameras,
                         QWidget *parent = nullptr);
     ~MainWindow() override;
 
@@ -76,6 +84,7 @@ public slots:
 signals:
     // Signals emitted by MainWindow
     void trackSelectButtonPressed(); // Example signal
+    void videoDisplaySized(); // Once, when the display's first resize event has set the capture size
 
 private slots:
     // UI Element Interactions (Buttons, etc.)
@@ -101,7 +110,11 @@ private slots:
 
     // System & Controller Event Handling
     void onCameraControllerStatus(const QString &message);
-    void handleFrameData(const FrameData &data); // From VideoProcessors
+    void onFrameAvailable(int cameraIndex); // From VideoProcessors (coalesced)
+    void onDisplaySizeChanged(const QSize &size); // From the video display
+    void handleFrameData(FrameData data); // Taken by value: the frame is moved on to the OSD renderer
+    void presentOsdFrame(int cameraIndex, const QImage &image, const QImage &overlay,
+                         const FrameTimestamps &timestamps); // From OsdRenderWorkers
     void onActiveCameraChanged(bool isDay);
     void onSystemStateChanged(const SystemStateData &newData);
     void onTrackSelectButtonPressed(); // Connected to signal?
@@ -158,6 +171,15 @@ private:
     QString colorStyleToString(ColorStyle style);
     void setTracklistColorStyle(const QString &style);
     void testBothDisplays(); // Debug/Test method
+    OsdFrameState buildOsdFrameState(const FrameData &data) const;
+    void presentFrame(const QImage &finalImage, const QImage &overlay, int cameraIndex, FrameTimestamps timestamps);
+    void startOsdRenderWorkers(int width, int height, OsdRenderMode mode);
+    void stopOsdRenderWorkers();
+    void saveRecordingEvent(const QString &reason); // Event clip on every camera's recorder
+    void selectNextCamera(); // Cycles through every camera of the registry
+    void startNetworkOutput(const QStringList &arguments);
+    void startPictureInPicture(const QStringList &arguments);
+    void updatePictureInPicture(); // Moves the inset to the camera paired with the active one
 
     // Brightness Control Helpers
     void setBrightness(int percentage);
@@ -174,6 +196,7 @@ private:
     QWidget *m_dayWidgetPlaceholder;
     QWidget *m_nightWidgetPlaceholder;
     VideoDisplayWidget *m_currentDisplayWidget; // Pointer to the active display in the stack
+    VideoFrameSink *m_videoSink = nullptr; // Video output: GlVideoDisplayWidget, or ui->videoDisplay with --video-display=raster
 
     // Controllers
     GimbalController *m_gimbalCtrl;
@@ -186,25 +209,36 @@ private:
     SystemStateModel *m_stateModel;
     SystemStateData m_oldState; // Store previous state
 
-    // Video Processing & OSD
-    QPointer<CameraVideoStreamDevice> m_dayProcessor;
-    QPointer<CameraVideoStreamDevice> m_nightProcessor;
-    QPointer<OsdRenderer> m_osdRenderer_day;
-    QPointer<OsdRenderer> m_osdRenderer_night;
+    // Video Processing & OSD, one view per camera of the registry (index = FrameData::cameraIndex)
+    struct CameraView {
+        QPointer<CameraVideoStreamDevice> processor;
+        QPointer<OsdRenderer> osdRenderer;     // --osd-renderer=scene
+        // Scene-free OSD rendering on one worker thread per camera (default)
+        OsdRenderWorker *osdWorker = nullptr;
+        QThread *osdThread = nullptr;
+        bool trackingActive = false;
+        bool detectionActive = false;
+    };
+    CameraView *cameraView(int cameraIndex); // Null for an unknown index
+    CameraRegistry *m_cameras;
+    std::vector<CameraView> m_cameraViews;
+    qint64 m_guiFrameNs = 0;      // GUI-thread time spent on video frames since the last log line
+    quint64 m_guiFrameCount = 0;  // Frames presented since the last log line
+    QSize m_videoFrameSize;       // Size of the last frame received (negotiated from the display size)
+    bool m_videoDisplaySized = false; // videoDisplaySized() has been emitted
+    std::unique_ptr<NetworkVideoOutput> m_networkOutput; // RTP/UDP copy of the active camera (--net-out=<host>:<port>)
+    PictureInPictureConfig m_pipConfig; // Inactive camera as an inset in the active view (--pip[=<spec>])
+    int m_pipCameraIndex = -1;          // Camera currently producing the inset (-1: none)
 
     // State Flags
     bool m_isDayCameraActive;
-    int m_activeCameraIndex; // 0 for day, 1 for night?
+    int m_activeCameraIndex; // 0 for day, 1 for night, 2+ for auxiliary cameras
     bool m_menuActive;
     bool m_reticleMenuActive;
     bool m_colorMenuActive;
     bool m_systemStatusActive;
     bool m_settingsMenuActive;
     bool m_aboutActive;
-    bool m_trackingActive_cam1;
-    bool m_trackingActive_cam2;
-    bool m_detectionActive_cam1;
-    bool m_detectionActive_cam2;
     bool m_brightnessControlActive;
 
     // Pointers to Managed Widgets (Menus, Dialogs, etc.)
@@ -12,7 +12,7 @@ RadarTargetListWidget::RadarTargetListWidget(SystemStateModel* model, QWidget *p
     initializeUI();
 
     // Connect to the model to receive updates
-    connect(m_stateModel, &SystemStateModel::dataChanged, this, &RadarTargetListWidget::onSystemStateChanged);
+    connect(m_stateModel, &SystemStateModel::radarChanged, this, &RadarTargetListWidget::onRadarChanged);
 }
 
 void RadarTargetListWidget::initializeUI() {
@@ -47,10 +47,10 @@ void RadarTargetListWidget::showEvent(QShowEvent* event) {
     setFocus();
 }
 
-void RadarTargetListWidget::onSystemStateChanged(const SystemStateData& data) {
+void RadarTargetListWidget::onRadarChanged(const QVector<SimpleRadarPlot>& plots, quint32 selectedTrackId) {
     // Only update if the relevant parts of the state have changed
-    if (data.radarPlots != m_currentlyDisplayedPlots || data.selectedRadarTrackId != m_currentlyDisplayedSelectedId) {
-        updateListDisplay(data.radarPlots, data.selectedRadarTrackId);
+    if (plots != m_currentlyDisplayedPlots || selectedTrackId != m_currentlyDisplayedSelectedId) {
+        updateListDisplay(plots, selectedTrackId);
     }
 }
 
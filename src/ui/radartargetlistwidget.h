@@ -30,7 +30,7 @@ protected:
 
 private slots:
     // Listens for changes in the model to update its display
-    void onSystemStateChanged(const SystemStateData& data);
+    void onRadarChanged(const QVector<SimpleRadarPlot>& plots, quint32 selectedTrackId);
 
 private:
     // UI Elements
@@ -16,8 +16,8 @@ SystemStatusWidget::SystemStatusWidget(SystemStateModel *model, QWidget *parent)
     setupUi();
 
     if (m_stateModel) {
-        connect(m_stateModel, &SystemStateModel::dataChanged,
-                this, &SystemStatusWidget::onSystemStateChanged, Qt::QueuedConnection);
+        connect(m_stateModel, &SystemStateModel::stateGroupsChanged,
+                this, &SystemStatusWidget::onStateGroupsChanged, Qt::QueuedConnection);
         //connect(m_stateModel, &SystemStateModel::colorStyleChanged, // Assuming this signal exists
         //        this, &SystemStatusWidget::onColorStyleChanged, Qt::QueuedConnection);
 
@@ -202,8 +202,13 @@ void SystemStatusWidget::setupUi() {
 
 }
 
-void SystemStatusWidget::onSystemStateChanged(const SystemStateData &data) {
-    populateData(data);
+void SystemStatusWidget::onStateGroupsChanged(StateGroups changed) {
+    // Gimbal, LRF, cameras, PLC and alarms; IMU, joystick and radar updates are not shown here
+    const StateGroups shown = StateGroup::GimbalPose | StateGroup::DeviceHealth | StateGroup::Optics |
+                              StateGroup::Ballistics | StateGroup::Station;
+    if (changed & shown) {
+        populateData(m_stateModel->snapshot());
+    }
 }
 
 void SystemStatusWidget::populateData(const SystemStateData &data) {
@@ -36,7 +36,7 @@ protected:
     void closeEvent(QCloseEvent *event) override;
 
 private slots:
-    void onSystemStateChanged(const SystemStateData &data);
+    void onStateGroupsChanged(StateGroups changed);
     void onClearAlarmsClicked();
     //void onColorStyleChanged(const QColor &style); // Keep this
 
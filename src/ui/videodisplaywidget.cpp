@@ -1,13 +1,27 @@
 #include "videodisplaywidget.h"
 
+#include <QResizeEvent>
+
+namespace {
+// Frames negotiated for this widget are a pixel or two smaller after even/4:3 rounding;
+// those are blitted 1:1 instead of being rescaled
+constexpr int NATIVE_SIZE_TOLERANCE_PX = 4;
+} // namespace
+
 
 VideoDisplayWidget::VideoDisplayWidget(QWidget *parent) : QWidget(parent) {
     // Set background color
     setBackgroundRole(QPalette::Base);
     setAutoFillBackground(true);
+    // Every pixel is covered by the frame or the black placeholder
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void VideoDisplayWidget::updateFrame(const QImage& frame, const FrameTimestamps& timestamps) {
+    updateFrame(frame, QImage(), timestamps);
 }
 
-void VideoDisplayWidget::updateFrame(const QImage& frame) {
+void VideoDisplayWidget::updateFrame(const QImage& frame, const QImage& overlay, const FrameTimestamps& timestamps) {
     // Debug before acquiring mutex
     /*qDebug() << "UpdateFrame called on" << objectName() 
              << "with frame:" << frame.width() << "x" << frame.height();*/
@@ -19,8 +33,10 @@ void VideoDisplayWidget::updateFrame(const QImage& frame) {
         return;
     }
     
-    // Create a deep copy to ensure we own the data
-    currentFrame = frame.copy();
+    // Shallow copy: shares the producer's buffer and keeps it alive until the next frame
+    currentFrame = frame;
+    currentOverlay = overlay;
+    currentTimestamps = timestamps;
     
     // Debug after update
     /*qDebug() << objectName() << "frame updated to" 
@@ -30,17 +46,40 @@ void VideoDisplayWidget::updateFrame(const QImage& frame) {
     QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
 }
 
+void VideoDisplayWidget::setPlaceholderText(const QString& text) {
+    {
+        QMutexLocker locker(&frameMutex);
+        currentFrame = QImage();
+        currentOverlay = QImage();
+        currentTimestamps = FrameTimestamps();
+        placeholderText = text;
+    }
+    QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+}
+
+void VideoDisplayWidget::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    emit displaySizeChanged(event->size());
+}
+
 void VideoDisplayWidget::paintEvent(QPaintEvent *) {
     // Debug paint event start
     //qDebug() << "Paint event started on" << objectName();
     
     QPainter painter(this);
     
-    // Get a local copy of the current frame under mutex protection
+    // Take a reference to the current frame under mutex protection (no pixel copy)
     QImage frameToDraw;
+    QImage overlayToDraw;
+    QString placeholder;
+    FrameTimestamps timestamps;
     {
         QMutexLocker locker(&frameMutex);
-        frameToDraw = currentFrame.copy();  // Make another copy for painting
+        frameToDraw = currentFrame;
+        overlayToDraw = currentOverlay;
+        placeholder = placeholderText;
+        timestamps = currentTimestamps;
+        currentTimestamps = FrameTimestamps();
     }
     
     //qDebug() << "PaintEvent in" << objectName() << "- frame:"
@@ -51,22 +90,47 @@ void VideoDisplayWidget::paintEvent(QPaintEvent *) {
         // Draw placeholder
         painter.fillRect(rect(), Qt::black);
         painter.setPen(Qt::white);
-        painter.drawText(rect(), Qt::AlignCenter, "No Signal");
+        painter.drawText(rect(), Qt::AlignCenter, placeholder);
         return;
     }
     
-    // Scale the image to fit the widget while maintaining aspect ratio
-    QImage scaledImage = frameToDraw.scaled(
-        this->size(),
-        Qt::KeepAspectRatio,
-        Qt::SmoothTransformation
-    );
+    // Fit the image into the widget while maintaining aspect ratio
+    QSize targetSize = frameToDraw.size().scaled(size(), Qt::KeepAspectRatio);
+    if (targetSize.width() >= frameToDraw.width() && targetSize.height() >= frameToDraw.height() &&
+        targetSize.width() - frameToDraw.width() <= NATIVE_SIZE_TOLERANCE_PX &&
+        targetSize.height() - frameToDraw.height() <= NATIVE_SIZE_TOLERANCE_PX) {
+        targetSize = frameToDraw.size();
+    }
     
     // Center the image in the widget
-    QPoint centerPoint((width() - scaledImage.width()) / 2,
-                      (height() - scaledImage.height()) / 2);
+    QRect targetRect(QPoint((width() - targetSize.width()) / 2,
+                            (height() - targetSize.height()) / 2),
+                     targetSize);
+    
+    // Clear the letterbox bars only, the frame covers the rest
+    if (targetRect != rect()) {
+        painter.fillRect(rect(), Qt::black);
+    }
     
-    painter.drawImage(centerPoint, scaledImage);
+    if (targetSize == frameToDraw.size()) {
+        // 1:1 blit straight from the shared buffer
+        painter.drawImage(targetRect.topLeft(), frameToDraw);
+    } else {
+        // Let the paint engine scale while blitting instead of allocating a scaled copy
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(targetRect, frameToDraw);
+    }
+
+    // OSD rendered separately (OsdRenderMode::Overlay): blend it over the frame
+    if (!overlayToDraw.isNull()) {
+        painter.drawImage(targetRect, overlayToDraw);
+    }
+
+    // First paint of this frame: close its latency trail
+    if (timestamps.presentedNs > 0) {
+        timestamps.paintedNs = FrameTimestamps::nowNs();
+        FrameLatencyStats::record(timestamps);
+    }
     
     // Draw a border with widget name for debugging
     //painter.setPen(QPen(QColor(200,20,40), 2));
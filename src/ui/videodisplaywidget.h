@@ -5,18 +5,52 @@
 #include <QImage>
 #include <QMutex>
 #include <QPainter>
+#include <QSize>
+#include <QString>
 
-class VideoDisplayWidget : public QWidget {
+#include "../devices/framelatency.h"
+#include "videoframesink.h"
+
+class VideoDisplayWidget : public QWidget, public VideoFrameSink {
     Q_OBJECT
 public:
     explicit VideoDisplayWidget(QWidget *parent = nullptr);
-    void updateFrame(const QImage& frame);
+
+    /**
+     * @brief Stores a shallow reference to the frame and schedules a repaint.
+     *
+     * The frame is shared with its producer (implicitly shared QImage), it is
+     * never copied. Producers must not write into a buffer after handing it over.
+     * If @p timestamps carries a trail, it is completed and recorded in
+     * FrameLatencyStats once the frame has been painted.
+     */
+    void updateFrame(const QImage& frame, const FrameTimestamps& timestamps = FrameTimestamps());
+
+    /**
+     * @brief As above, with @p overlay (if not null) drawn over the frame at paint time.
+     */
+    void updateFrame(const QImage& frame, const QImage& overlay, const FrameTimestamps& timestamps) override;
+
+    /**
+     * @brief Drops the current frame and shows a text placeholder instead.
+     */
+    void setPlaceholderText(const QString& text) override;
+
+signals:
+    /**
+     * @brief Emitted on resize so producers can deliver frames at the display resolution.
+     */
+    void displaySizeChanged(const QSize& size);
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
 private:
     QImage currentFrame;
+    QImage currentOverlay;
+    FrameTimestamps currentTimestamps; // Cleared once recorded, so repaints don't count twice
+    QString placeholderText = "No Signal";
     QMutex frameMutex;
 };
 
@@ -0,0 +1,37 @@
+#ifndef VIDEOFRAMESINK_H
+#define VIDEOFRAMESINK_H
+
+// --- Qt Includes ---
+#include <QImage>
+#include <QString>
+
+// --- Project Includes ---
+#include "../devices/framelatency.h"
+
+/**
+ * @brief What MainWindow presents video frames to.
+ *
+ * Implemented by the QPainter-based VideoDisplayWidget and the OpenGL-based
+ * GlVideoDisplayWidget, so the presentation path does not depend on which one is shown.
+ */
+class VideoFrameSink
+{
+public:
+    virtual ~VideoFrameSink() = default;
+
+    /**
+     * @brief Shows @p frame with @p overlay (may be null) composited on top.
+     *
+     * Both images are shared with their producers, never copied. @p overlay is
+     * premultiplied ARGB at the frame's size. If @p timestamps carries a trail, it is
+     * completed and recorded in FrameLatencyStats once the frame is on screen.
+     */
+    virtual void updateFrame(const QImage &frame, const QImage &overlay, const FrameTimestamps &timestamps) = 0;
+
+    /**
+     * @brief Drops the current frame and shows a text placeholder instead.
+     */
+    virtual void setPlaceholderText(const QString &text) = 0;
+};
+
+#endif // VIDEOFRAMESINK_H
@@ -9,7 +9,7 @@ WindageWidget::WindageWidget(SystemStateModel* model, QWidget *parent)
     setWindowFlags(Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint);
     setMinimumSize(400, 300);  // Add this
     initializeUI();
-    connect(m_stateModel, &SystemStateModel::dataChanged, this, &WindageWidget::onModelStateChanged);
+    connect(m_stateModel, &SystemStateModel::ballisticsChanged, this, &WindageWidget::onModelStateChanged);
 }
 
 void WindageWidget::initializeUI() {
@@ -118,13 +118,13 @@ void WindageWidget::showEvent(QShowEvent *event) {
     // OSD Renderer shows "W" based on model state
 }*/
 
-void WindageWidget::onModelStateChanged(const SystemStateData &data) {
-    if (!data.windageModeActive && m_currentState != WindageState::Instruct_AlignToWind /* or some initial state */) {
+void WindageWidget::onModelStateChanged(const BallisticsState &ballistics) {
+    if (!ballistics.windageModeActive && m_currentState != WindageState::Instruct_AlignToWind /* or some initial state */) {
         // emit windageProcedureFinished();
     }
      // Update our editing value if model changes (e.g. from another source, though unlikely for this UI)
-    // if (m_currentState == WindageState::Set_WindSpeed && m_currentWindSpeedEdit != data.windageSpeedKnots) {
-    //     m_currentWindSpeedEdit = data.windageSpeedKnots;
+    // if (m_currentState == WindageState::Set_WindSpeed && m_currentWindSpeedEdit != ballistics.windageSpeedKnots) {
+    //     m_currentWindSpeedEdit = ballistics.windageSpeedKnots;
     //     updateUI(); // Refresh display
     // }
 }
@@ -45,6 +45,6 @@ private:
     void updateUI();
 
 private slots:
-    void onModelStateChanged(const SystemStateData &data);
+    void onModelStateChanged(const BallisticsState &ballistics);
 };
 #endif // WINDAGEWIDGET_H
@@ -23,7 +23,7 @@ ZeroingWidget::ZeroingWidget(SystemStateModel* model, QWidget *parent)
     initializeUI();
     
     // Connect to model changes
-    connect(m_stateModel, &SystemStateModel::dataChanged, 
+    connect(m_stateModel, &SystemStateModel::ballisticsChanged,
             this, &ZeroingWidget::onModelStateChanged);
 }
 
@@ -157,16 +157,16 @@ void ZeroingWidget::updateUI() {
     // m_stateModel->data().zeroingModeActive / m_stateModel->data().zeroingAppliedToBallistics
 }
 
-void ZeroingWidget::onModelStateChanged(const SystemStateData &data) {
+void ZeroingWidget::onModelStateChanged(const BallisticsState &ballistics) {
     // If zeroing is externally cancelled, or to update displayed offsets if in a fine-tuning state
-    if (!data.zeroingModeActive && m_currentState != ZeroingState::Idle && m_currentState != ZeroingState::Completed) {
+    if (!ballistics.zeroingModeActive && m_currentState != ZeroingState::Idle && m_currentState != ZeroingState::Completed) {
         qDebug() << "Zeroing mode became inactive externally, finishing widget.";
         this->close();
         emit zeroingProcedureFinished();
     }
 
     // If you had a FineTune_Adjustments state, you would update m_statusLabel here
-    // with data.zeroingAzimuthOffset and data.zeroingElevationOffset.
+    // with ballistics.zeroingAzimuthOffset and ballistics.zeroingElevationOffset.
     // For the "Completed" state, updateUI already fetches the final offsets.
 }
 
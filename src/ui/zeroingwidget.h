@@ -54,7 +54,7 @@ private:
     void updateUI();
 
 private slots:
-    void onModelStateChanged(const SystemStateData &data); // To react to zeroing flags
+    void onModelStateChanged(const BallisticsState &ballistics); // To react to zeroing flags
 };
 
 #endif // ZEROINGWIDGET_H
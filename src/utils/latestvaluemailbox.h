@@ -0,0 +1,91 @@
+#ifndef LATESTVALUEMAILBOX_H
+#define LATESTVALUEMAILBOX_H
+
+// --- Standard Library Includes ---
+#include <array>
+#include <atomic>
+#include <utility>
+
+// --- Qt Includes ---
+#include <QtGlobal>
+
+/**
+ * @brief Single-producer / single-consumer mailbox that only keeps the newest value.
+ *
+ * A lock-free triple buffer: the producer writes into its private back slot and swaps
+ * it with the shared middle slot, the consumer swaps the middle slot with its private
+ * front slot. Neither side ever blocks or allocates, and a value the consumer did not
+ * take before the next publish() is overwritten and counted as dropped.
+ *
+ * publish() reports whether the mailbox went from empty to full, so the producer can
+ * send one coalesced wake-up per batch instead of one per value: a consumer that is
+ * woken late still only sees the newest value.
+ *
+ * publish() must only be called from one thread and take() from one (other) thread.
+ * T must be default-constructible and move-assignable.
+ */
+template <typename T>
+class LatestValueMailbox
+{
+public:
+    LatestValueMailbox() = default;
+    LatestValueMailbox(const LatestValueMailbox &) = delete;
+    LatestValueMailbox &operator=(const LatestValueMailbox &) = delete;
+
+    /**
+     * @brief Stores @p value as the newest one. Producer thread only.
+     * @return True if the mailbox was empty, i.e. the consumer needs a wake-up.
+     */
+    bool publish(T &&value)
+    {
+        m_slots[m_back] = std::move(value);
+        const unsigned previous = m_middle.exchange(m_back | DIRTY_BIT, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+        m_produced.fetch_add(1, std::memory_order_relaxed);
+
+        if (previous & DIRTY_BIT) {
+            // The consumer never saw that value: release what it holds right away
+            m_slots[m_back] = T();
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Moves the newest value into @p out. Consumer thread only.
+     * @return False if nothing was published since the last take().
+     */
+    bool take(T &out)
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & DIRTY_BIT)) {
+            return false;
+        }
+        const unsigned previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        out = std::move(m_slots[m_front]);
+        m_slots[m_front] = T(); // Don't keep the consumer's value alive in the mailbox
+        m_taken.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // --- Statistics (thread-safe) ---
+    quint64 producedCount() const { return m_produced.load(std::memory_order_relaxed); }
+    quint64 takenCount() const { return m_taken.load(std::memory_order_relaxed); }
+    quint64 droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr unsigned INDEX_MASK = 0x3;
+    static constexpr unsigned DIRTY_BIT = 0x4; // Middle slot holds a value not taken yet
+
+    std::array<T, 3> m_slots;
+    unsigned m_back = 0;                 // Producer thread only
+    std::atomic<unsigned> m_middle{1};   // Slot index | DIRTY_BIT
+    unsigned m_front = 2;                // Consumer thread only
+
+    std::atomic<quint64> m_produced{0};
+    std::atomic<quint64> m_taken{0};
+    std::atomic<quint64> m_dropped{0};
+};
+
+#endif // LATESTVALUEMAILBOX_H
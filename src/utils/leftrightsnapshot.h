@@ -0,0 +1,97 @@
+#ifndef LEFTRIGHTSNAPSHOT_H
+#define LEFTRIGHTSNAPSHOT_H
+
+// --- Standard Library Includes ---
+#include <array>
+#include <atomic>
+#include <thread>
+
+// --- Qt Includes ---
+#include <QtGlobal>
+
+/**
+ * @brief Single-writer / many-reader snapshot of the latest published value.
+ *
+ * A left-right buffer: two copies of the value, one readers are directed to and one the
+ * writer updates. Readers announce themselves on a read indicator, copy the instance the
+ * writer is not touching and leave, in a fixed number of steps: read() is wait-free and
+ * never sees a half-written value. publish() writes the idle copy, redirects new readers
+ * to it, waits for the readers still on the old copy to leave (they only copy it) and
+ * then brings the old copy up to date.
+ *
+ * Unlike a seqlock, readers never copy memory the writer is changing, so T may hold
+ * implicitly shared Qt types (their reference counts are atomic).
+ *
+ * publish() must only be called from one thread; read() from any number of threads.
+ * T must be default-constructible and copy-assignable.
+ */
+template <typename T>
+class LeftRightSnapshot
+{
+public:
+    LeftRightSnapshot() = default;
+    LeftRightSnapshot(const LeftRightSnapshot &) = delete;
+    LeftRightSnapshot &operator=(const LeftRightSnapshot &) = delete;
+
+    /**
+     * @brief Makes @p value the snapshot readers get. Writer thread only.
+     *
+     * Waits, at most for the length of one read(), for readers on the previous copy.
+     */
+    void publish(const T &value)
+    {
+        const int previous = m_readSide.load(std::memory_order_seq_cst);
+        const int next = 1 - previous;
+        m_instances[next] = value;
+        m_readSide.store(next, std::memory_order_seq_cst);
+
+        // Drain both read indicators, flipping between them, so no reader that chose
+        // the previous instance is still copying it
+        const int previousIndicator = m_indicatorSide.load(std::memory_order_seq_cst);
+        const int nextIndicator = 1 - previousIndicator;
+        waitForReaders(nextIndicator);
+        m_indicatorSide.store(nextIndicator, std::memory_order_seq_cst);
+        waitForReaders(previousIndicator);
+
+        m_instances[previous] = value;
+        m_published.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy of the latest published value. Any thread, wait-free.
+     */
+    T read() const
+    {
+        const int indicator = m_indicatorSide.load(std::memory_order_seq_cst);
+        m_readers[indicator].fetch_add(1, std::memory_order_seq_cst);
+        T value = m_instances[m_readSide.load(std::memory_order_seq_cst)];
+        m_readers[indicator].fetch_sub(1, std::memory_order_release);
+        m_reads.fetch_add(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    // --- Statistics (thread-safe) ---
+    quint64 publishedCount() const { return m_published.load(std::memory_order_relaxed); }
+    quint64 readCount() const { return m_reads.load(std::memory_order_relaxed); }
+    quint64 writerWaitCount() const { return m_writerWaits.load(std::memory_order_relaxed); }
+
+private:
+    void waitForReaders(int indicator)
+    {
+        while (m_readers[indicator].load(std::memory_order_acquire) != 0) {
+            m_writerWaits.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    }
+
+    std::array<T, 2> m_instances;
+    std::atomic<int> m_readSide{0};      // Instance readers copy
+    std::atomic<int> m_indicatorSide{0}; // Read indicator new readers register on
+    mutable std::array<std::atomic<int>, 2> m_readers{};
+
+    std::atomic<quint64> m_published{0};
+    mutable std::atomic<quint64> m_reads{0};
+    std::atomic<quint64> m_writerWaits{0};
+};
+
+#endif // LEFTRIGHTSNAPSHOT_H
@@ -0,0 +1,519 @@
+#include "yuy2converter.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QTextStream>
+
+#include <cstring>
+#include <functional>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+// BT.601 limited range coefficients, scaled by 2^6
+constexpr int COEFF_SHIFT = 6;
+constexpr int COEFF_ROUND = 1 << (COEFF_SHIFT - 1);
+constexpr int COEFF_Y = 75;      // 1.164
+constexpr int COEFF_V_R = 102;   // 1.596
+constexpr int COEFF_V_G = -52;   // -0.813
+constexpr int COEFF_U_G = -25;   // -0.391
+constexpr int COEFF_U_B = 129;   // 2.018
+
+inline uchar clampToByte(int value)
+{
+    value >>= COEFF_SHIFT;
+    return static_cast<uchar>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// Clamps to the int16 range, mirroring the saturating adds of the SIMD kernels
+inline int saturate16(int value)
+{
+    return value < -32768 ? -32768 : (value > 32767 ? 32767 : value);
+}
+
+// Converts one YUY2 macro-pixel (two pixels) - shared by the scalar kernel and SIMD row tails
+inline void convertPair(const uchar *yuyv, uchar *bgra, uchar *bgr)
+{
+    const int u = yuyv[1] - 128;
+    const int v = yuyv[3] - 128;
+    const int rChroma = COEFF_V_R * v;
+    const int gChroma = COEFF_V_G * v + COEFF_U_G * u;
+    const int bChroma = COEFF_U_B * u;
+
+    for (int i = 0; i < 2; ++i) {
+        const int y = COEFF_Y * (yuyv[i * 2] - 16) + COEFF_ROUND;
+        const uchar b = clampToByte(saturate16(y + bChroma));
+        const uchar g = clampToByte(saturate16(y + gChroma));
+        const uchar r = clampToByte(saturate16(y + rChroma));
+        bgra[i * 4 + 0] = b;
+        bgra[i * 4 + 1] = g;
+        bgra[i * 4 + 2] = r;
+        bgra[i * 4 + 3] = 255;
+        if (bgr) {
+            bgr[i * 3 + 0] = b;
+            bgr[i * 3 + 1] = g;
+            bgr[i * 3 + 2] = r;
+        }
+    }
+}
+
+// Converts a single pixel of a YUY2 macro-pixel; @p second selects its second luma sample
+inline void convertPixel(const uchar *yuyv, bool second, uchar *bgra)
+{
+    const int u = yuyv[1] - 128;
+    const int v = yuyv[3] - 128;
+    const int y = COEFF_Y * (yuyv[second ? 2 : 0] - 16) + COEFF_ROUND;
+    bgra[0] = clampToByte(saturate16(y + COEFF_U_B * u));
+    bgra[1] = clampToByte(saturate16(y + COEFF_V_G * v + COEFF_U_G * u));
+    bgra[2] = clampToByte(saturate16(y + COEFF_V_R * v));
+    bgra[3] = 255;
+}
+
+inline void convertRowTail(const uchar *srcRow, uchar *bgraRow, uchar *bgrRow, int xBegin, int width)
+{
+    for (int x = xBegin; x + 1 < width; x += 2) {
+        convertPair(srcRow + x * 2, bgraRow + x * 4, bgrRow ? bgrRow + x * 3 : nullptr);
+    }
+}
+
+#if defined(__SSE2__) && !defined(__AVX2__)
+// Compacts 4 BGRA pixels (16 bytes) into 12 BGR bytes
+inline void storeBgrFromBgra4(__m128i bgra, uchar *bgr)
+{
+#if defined(__SSSE3__)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    alignas(16) uchar packed[16];
+    _mm_store_si128(reinterpret_cast<__m128i *>(packed), _mm_shuffle_epi8(bgra, shuffle));
+    memcpy(bgr, packed, 12);
+#else
+    alignas(16) uchar pixels[16];
+    _mm_store_si128(reinterpret_cast<__m128i *>(pixels), bgra);
+    for (int i = 0; i < 4; ++i) {
+        bgr[i * 3 + 0] = pixels[i * 4 + 0];
+        bgr[i * 3 + 1] = pixels[i * 4 + 1];
+        bgr[i * 3 + 2] = pixels[i * 4 + 2];
+    }
+#endif
+}
+#endif
+
+#if defined(__AVX2__)
+inline void storeBgrFromBgra8(__m256i bgra, uchar *bgr)
+{
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                             0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    alignas(32) uchar packed[32];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(packed), _mm256_shuffle_epi8(bgra, shuffle));
+    memcpy(bgr, packed, 12);
+    memcpy(bgr + 12, packed + 16, 12);
+}
+#endif
+
+/**
+ * @brief Runs one horizontal stripe of a frame on a pool thread.
+ */
+class StripeTask : public QRunnable
+{
+public:
+    StripeTask(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+               uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride, QSemaphore *done)
+        : m_src(src), m_srcStride(srcStride), m_width(width), m_rowBegin(rowBegin), m_rowEnd(rowEnd),
+          m_dstBgra(dstBgra), m_dstStride(dstStride), m_dstBgr(dstBgr), m_bgrStride(bgrStride), m_done(done)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        Yuy2Converter::convertRows(m_src, m_srcStride, m_width, m_rowBegin, m_rowEnd,
+                                   m_dstBgra, m_dstStride, m_dstBgr, m_bgrStride);
+        m_done->release();
+    }
+
+private:
+    const uchar *m_src;
+    int m_srcStride;
+    int m_width;
+    int m_rowBegin;
+    int m_rowEnd;
+    uchar *m_dstBgra;
+    int m_dstStride;
+    uchar *m_dstBgr;
+    int m_bgrStride;
+    QSemaphore *m_done;
+};
+
+} // namespace
+
+// === Constructor / Destructor ===
+
+Yuy2Converter::Yuy2Converter(int threadCount, QThreadPool *pool)
+    : m_threadCount(threadCount > 0 ? threadCount : qBound(1, QThread::idealThreadCount(), 4)),
+    m_pool(pool ? pool : &m_ownPool)
+{
+    // The calling thread always converts one stripe itself
+    m_ownPool.setMaxThreadCount(qMax(1, m_threadCount - 1));
+    m_ownPool.setExpiryTimeout(-1); // Keep workers alive between frames
+    qInfo() << "Yuy2Converter:" << simdPathName() << "kernel," << m_threadCount << "stripe(s) per frame,"
+            << (pool ? "shared" : "own") << "pool of" << m_pool->maxThreadCount() << "worker(s)";
+}
+
+Yuy2Converter::~Yuy2Converter()
+{
+    // convert() waits for its own stripes, so nothing of this converter is left in a shared pool
+    m_ownPool.waitForDone();
+}
+
+QThreadPool *Yuy2Converter::sharedPool()
+{
+    static QThreadPool *pool = []() {
+        QThreadPool *sharedPool = new QThreadPool(); // Never destroyed: converters may outlive static teardown order
+        sharedPool->setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+        sharedPool->setExpiryTimeout(-1);
+        return sharedPool;
+    }();
+    return pool;
+}
+
+// === Public Methods ===
+
+void Yuy2Converter::convert(const uchar *src, int srcStride, int width, int height,
+                            uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride)
+{
+    if (!src || !dstBgra || width <= 0 || height <= 0) {
+        return;
+    }
+
+    const int stripes = qMin(m_threadCount, height);
+    if (stripes <= 1) {
+        convertRows(src, srcStride, width, 0, height, dstBgra, dstStride, dstBgr, bgrStride);
+        return;
+    }
+
+    QSemaphore done;
+    const int rowsPerStripe = (height + stripes - 1) / stripes;
+    int queued = 0;
+    for (int stripe = 1; stripe < stripes; ++stripe) {
+        const int rowBegin = stripe * rowsPerStripe;
+        const int rowEnd = qMin(height, rowBegin + rowsPerStripe);
+        if (rowBegin >= rowEnd) {
+            break;
+        }
+        m_pool->start(new StripeTask(src, srcStride, width, rowBegin, rowEnd,
+                                     dstBgra, dstStride, dstBgr, bgrStride, &done));
+        ++queued;
+    }
+
+    // Stripe 0 on the calling thread while the pool handles the rest
+    convertRows(src, srcStride, width, 0, qMin(height, rowsPerStripe), dstBgra, dstStride, dstBgr, bgrStride);
+    done.acquire(queued);
+}
+
+const char *Yuy2Converter::simdPathName()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+#if defined(__SSSE3__)
+    return "SSE2/SSSE3";
+#else
+    return "SSE2";
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+// === Kernels ===
+
+void Yuy2Converter::convertRowsScalar(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+                                      uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride)
+{
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        convertRowTail(src + row * srcStride,
+                       dstBgra + row * dstStride,
+                       dstBgr ? dstBgr + row * bgrStride : nullptr,
+                       0, width);
+    }
+}
+
+void Yuy2Converter::convertDecimated(const uchar *src, int srcStride, int width, int height, int step,
+                                     uchar *dstBgra, int dstStride)
+{
+    if (step <= 0) {
+        return;
+    }
+    const int outWidth = width / step;
+    const int outHeight = height / step;
+    for (int row = 0; row < outHeight; ++row) {
+        const uchar *srcRow = src + row * step * srcStride;
+        uchar *dstRow = dstBgra + row * dstStride;
+        for (int col = 0; col < outWidth; ++col) {
+            const int x = col * step;
+            convertPixel(srcRow + (x & ~1) * 2, (x & 1) != 0, dstRow + col * 4);
+        }
+    }
+}
+
+#if defined(__AVX2__)
+
+void Yuy2Converter::convertRows(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+                                uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride)
+{
+    const __m256i lowByteMask = _mm256_set1_epi16(0x00FF);
+    const __m256i lowWordMask = _mm256_set1_epi32(0x0000FFFF);
+    const __m256i offsetY = _mm256_set1_epi16(16);
+    const __m256i offsetUV = _mm256_set1_epi16(128);
+    const __m256i coeffY = _mm256_set1_epi16(COEFF_Y);
+    const __m256i coeffVR = _mm256_set1_epi16(COEFF_V_R);
+    const __m256i coeffVG = _mm256_set1_epi16(COEFF_V_G);
+    const __m256i coeffUG = _mm256_set1_epi16(COEFF_U_G);
+    const __m256i coeffUB = _mm256_set1_epi16(COEFF_U_B);
+    const __m256i round = _mm256_set1_epi16(COEFF_ROUND);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alpha = _mm256_set1_epi8(static_cast<char>(0xFF));
+
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        const uchar *srcRow = src + row * srcStride;
+        uchar *bgraRow = dstBgra + row * dstStride;
+        uchar *bgrRow = dstBgr ? dstBgr + row * bgrStride : nullptr;
+
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            // 16 pixels: each 128-bit lane holds 8 pixels (Y0 U0 Y1 V0 ...)
+            const __m256i yuyv = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(srcRow + x * 2));
+            const __m256i y = _mm256_sub_epi16(_mm256_and_si256(yuyv, lowByteMask), offsetY);
+            const __m256i uv = _mm256_srli_epi16(yuyv, 8);
+            __m256i u = _mm256_and_si256(uv, lowWordMask);
+            u = _mm256_sub_epi16(_mm256_or_si256(u, _mm256_slli_epi32(u, 16)), offsetUV);
+            __m256i v = _mm256_srli_epi32(uv, 16);
+            v = _mm256_sub_epi16(_mm256_or_si256(v, _mm256_slli_epi32(v, 16)), offsetUV);
+
+            const __m256i yScaled = _mm256_adds_epi16(_mm256_mullo_epi16(y, coeffY), round);
+            const __m256i r = _mm256_srai_epi16(_mm256_adds_epi16(yScaled, _mm256_mullo_epi16(v, coeffVR)), COEFF_SHIFT);
+            const __m256i g = _mm256_srai_epi16(_mm256_adds_epi16(_mm256_adds_epi16(yScaled, _mm256_mullo_epi16(v, coeffVG)),
+                                                                  _mm256_mullo_epi16(u, coeffUG)), COEFF_SHIFT);
+            const __m256i b = _mm256_srai_epi16(_mm256_adds_epi16(yScaled, _mm256_mullo_epi16(u, coeffUB)), COEFF_SHIFT);
+
+            // Per lane: B0 G0 B1 G1 ... and R0 A R1 A ...
+            const __m256i bg = _mm256_unpacklo_epi8(_mm256_packus_epi16(b, zero), _mm256_packus_epi16(g, zero));
+            const __m256i ra = _mm256_unpacklo_epi8(_mm256_packus_epi16(r, zero), alpha);
+            const __m256i lo = _mm256_unpacklo_epi16(bg, ra); // pixels 0-3 | 8-11
+            const __m256i hi = _mm256_unpackhi_epi16(bg, ra); // pixels 4-7 | 12-15
+            const __m256i first = _mm256_permute2x128_si256(lo, hi, 0x20);  // pixels 0-7
+            const __m256i second = _mm256_permute2x128_si256(lo, hi, 0x31); // pixels 8-15
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(bgraRow + x * 4), first);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(bgraRow + x * 4 + 32), second);
+
+            if (bgrRow) {
+                storeBgrFromBgra8(first, bgrRow + x * 3);
+                storeBgrFromBgra8(second, bgrRow + x * 3 + 24);
+            }
+        }
+        convertRowTail(srcRow, bgraRow, bgrRow, x, width);
+    }
+}
+
+#elif defined(__SSE2__)
+
+void Yuy2Converter::convertRows(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+                                uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride)
+{
+    const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+    const __m128i lowWordMask = _mm_set1_epi32(0x0000FFFF);
+    const __m128i offsetY = _mm_set1_epi16(16);
+    const __m128i offsetUV = _mm_set1_epi16(128);
+    const __m128i coeffY = _mm_set1_epi16(COEFF_Y);
+    const __m128i coeffVR = _mm_set1_epi16(COEFF_V_R);
+    const __m128i coeffVG = _mm_set1_epi16(COEFF_V_G);
+    const __m128i coeffUG = _mm_set1_epi16(COEFF_U_G);
+    const __m128i coeffUB = _mm_set1_epi16(COEFF_U_B);
+    const __m128i round = _mm_set1_epi16(COEFF_ROUND);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        const uchar *srcRow = src + row * srcStride;
+        uchar *bgraRow = dstBgra + row * dstStride;
+        uchar *bgrRow = dstBgr ? dstBgr + row * bgrStride : nullptr;
+
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            // 8 pixels: Y0 U0 Y1 V0 Y2 U1 Y3 V1 ...
+            const __m128i yuyv = _mm_loadu_si128(reinterpret_cast<const __m128i *>(srcRow + x * 2));
+            const __m128i y = _mm_sub_epi16(_mm_and_si128(yuyv, lowByteMask), offsetY);
+            const __m128i uv = _mm_srli_epi16(yuyv, 8);                 // U0 V0 U1 V1 ...
+            __m128i u = _mm_and_si128(uv, lowWordMask);                  // U0 0 U1 0 ...
+            u = _mm_sub_epi16(_mm_or_si128(u, _mm_slli_epi32(u, 16)), offsetUV); // U0 U0 U1 U1 ...
+            __m128i v = _mm_srli_epi32(uv, 16);                          // V0 0 V1 0 ...
+            v = _mm_sub_epi16(_mm_or_si128(v, _mm_slli_epi32(v, 16)), offsetUV); // V0 V0 V1 V1 ...
+
+            const __m128i yScaled = _mm_adds_epi16(_mm_mullo_epi16(y, coeffY), round);
+            const __m128i r = _mm_srai_epi16(_mm_adds_epi16(yScaled, _mm_mullo_epi16(v, coeffVR)), COEFF_SHIFT);
+            const __m128i g = _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yScaled, _mm_mullo_epi16(v, coeffVG)),
+                                                            _mm_mullo_epi16(u, coeffUG)), COEFF_SHIFT);
+            const __m128i b = _mm_srai_epi16(_mm_adds_epi16(yScaled, _mm_mullo_epi16(u, coeffUB)), COEFF_SHIFT);
+
+            const __m128i bg = _mm_unpacklo_epi8(_mm_packus_epi16(b, zero), _mm_packus_epi16(g, zero));
+            const __m128i ra = _mm_unpacklo_epi8(_mm_packus_epi16(r, zero), alpha);
+            const __m128i lo = _mm_unpacklo_epi16(bg, ra); // pixels 0-3
+            const __m128i hi = _mm_unpackhi_epi16(bg, ra); // pixels 4-7
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(bgraRow + x * 4), lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(bgraRow + x * 4 + 16), hi);
+
+            if (bgrRow) {
+                storeBgrFromBgra4(lo, bgrRow + x * 3);
+                storeBgrFromBgra4(hi, bgrRow + x * 3 + 12);
+            }
+        }
+        convertRowTail(srcRow, bgraRow, bgrRow, x, width);
+    }
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+void Yuy2Converter::convertRows(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+                                uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride)
+{
+    const int16x8_t offsetY = vdupq_n_s16(16);
+    const int16x8_t offsetUV = vdupq_n_s16(128);
+    const int16x8_t round = vdupq_n_s16(COEFF_ROUND);
+    const uint8x16_t alpha = vdupq_n_u8(255);
+
+    for (int row = rowBegin; row < rowEnd; ++row) {
+        const uchar *srcRow = src + row * srcStride;
+        uchar *bgraRow = dstBgra + row * dstStride;
+        uchar *bgrRow = dstBgr ? dstBgr + row * bgrStride : nullptr;
+
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            // De-interleave 16 pixels: val[0] = even Y, val[1] = U, val[2] = odd Y, val[3] = V
+            const uint8x8x4_t yuyv = vld4_u8(srcRow + x * 2);
+            const int16x8_t yEven = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(yuyv.val[0])), offsetY);
+            const int16x8_t yOdd = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(yuyv.val[2])), offsetY);
+            const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(yuyv.val[1])), offsetUV);
+            const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(yuyv.val[3])), offsetUV);
+
+            const int16x8_t rChroma = vmulq_n_s16(v, COEFF_V_R);
+            const int16x8_t gChroma = vmlaq_n_s16(vmulq_n_s16(v, COEFF_V_G), u, COEFF_U_G);
+            const int16x8_t bChroma = vmulq_n_s16(u, COEFF_U_B);
+            const int16x8_t yEvenScaled = vmlaq_n_s16(round, yEven, COEFF_Y);
+            const int16x8_t yOddScaled = vmlaq_n_s16(round, yOdd, COEFF_Y);
+
+            // Saturating add, then arithmetic shift with unsigned saturation to 0..255
+            const uint8x8x2_t b = vzip_u8(vqshrun_n_s16(vqaddq_s16(yEvenScaled, bChroma), COEFF_SHIFT),
+                                          vqshrun_n_s16(vqaddq_s16(yOddScaled, bChroma), COEFF_SHIFT));
+            const uint8x8x2_t g = vzip_u8(vqshrun_n_s16(vqaddq_s16(yEvenScaled, gChroma), COEFF_SHIFT),
+                                          vqshrun_n_s16(vqaddq_s16(yOddScaled, gChroma), COEFF_SHIFT));
+            const uint8x8x2_t r = vzip_u8(vqshrun_n_s16(vqaddq_s16(yEvenScaled, rChroma), COEFF_SHIFT),
+                                          vqshrun_n_s16(vqaddq_s16(yOddScaled, rChroma), COEFF_SHIFT));
+
+            uint8x16x4_t bgra;
+            bgra.val[0] = vcombine_u8(b.val[0], b.val[1]);
+            bgra.val[1] = vcombine_u8(g.val[0], g.val[1]);
+            bgra.val[2] = vcombine_u8(r.val[0], r.val[1]);
+            bgra.val[3] = alpha;
+            vst4q_u8(bgraRow + x * 4, bgra);
+
+            if (bgrRow) {
+                uint8x16x3_t bgr;
+                bgr.val[0] = bgra.val[0];
+                bgr.val[1] = bgra.val[1];
+                bgr.val[2] = bgra.val[2];
+                vst3q_u8(bgrRow + x * 3, bgr);
+            }
+        }
+        convertRowTail(srcRow, bgraRow, bgrRow, x, width);
+    }
+}
+
+#else
+
+void Yuy2Converter::convertRows(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+                                uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride)
+{
+    convertRowsScalar(src, srcStride, width, rowBegin, rowEnd, dstBgra, dstStride, dstBgr, bgrStride);
+}
+
+#endif
+
+// === Benchmark ===
+
+QString Yuy2Converter::runBenchmark(int width, int height, int iterations)
+{
+    width &= ~1; // YUY2 needs an even width
+    iterations = qMax(1, iterations);
+
+    // Synthetic frame with full-range values so clamping paths are exercised
+    cv::Mat yuy2(height, width, CV_8UC2);
+    cv::randu(yuy2, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    cv::Mat bgraScalar(height, width, CV_8UC4);
+    cv::Mat bgraSimd(height, width, CV_8UC4);
+    cv::Mat bgrSimd(height, width, CV_8UC3);
+    cv::Mat openCvBgra;
+    cv::Mat openCvBgr;
+
+    QString report;
+    QTextStream out(&report);
+    out << "YUY2 -> BGRA benchmark, " << width << "x" << height << ", " << iterations << " iterations\n";
+
+    auto timeIt = [iterations](const char *label, QTextStream &stream, const std::function<void()> &body) {
+        body(); // Warm-up
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            body();
+        }
+        const double msPerFrame = timer.nsecsElapsed() / 1.0e6 / iterations;
+        stream << QString("  %1 %2 ms/frame\n").arg(label, -40).arg(msPerFrame, 0, 'f', 3);
+    };
+
+    timeIt("OpenCV cvtColor BGRA", out, [&]() {
+        cv::cvtColor(yuy2, openCvBgra, cv::COLOR_YUV2BGRA_YUY2);
+    });
+    timeIt("OpenCV cvtColor BGRA + BGRA2BGR", out, [&]() {
+        cv::cvtColor(yuy2, openCvBgra, cv::COLOR_YUV2BGRA_YUY2);
+        cv::cvtColor(openCvBgra, openCvBgr, cv::COLOR_BGRA2BGR);
+    });
+    timeIt("Scalar reference", out, [&]() {
+        convertRowsScalar(yuy2.data, static_cast<int>(yuy2.step), width, 0, height,
+                          bgraScalar.data, static_cast<int>(bgraScalar.step), nullptr, 0);
+    });
+    const QString simdLabel = QString("%1 single thread").arg(simdPathName());
+    timeIt(simdLabel.toUtf8().constData(), out, [&]() {
+        convertRows(yuy2.data, static_cast<int>(yuy2.step), width, 0, height,
+                    bgraSimd.data, static_cast<int>(bgraSimd.step), nullptr, 0);
+    });
+
+    Yuy2Converter converter;
+    const QString stripedLabel = QString("%1 x%2 stripes").arg(simdPathName()).arg(converter.threadCount());
+    timeIt(stripedLabel.toUtf8().constData(), out, [&]() {
+        converter.convert(yuy2.data, static_cast<int>(yuy2.step), width, height,
+                          bgraSimd.data, static_cast<int>(bgraSimd.step));
+    });
+    const QString stripedBgrLabel = stripedLabel + " + BGR";
+    timeIt(stripedBgrLabel.toUtf8().constData(), out, [&]() {
+        converter.convert(yuy2.data, static_cast<int>(yuy2.step), width, height,
+                          bgraSimd.data, static_cast<int>(bgraSimd.step),
+                          bgrSimd.data, static_cast<int>(bgrSimd.step));
+    });
+    return report;
+}
@@ -0,0 +1,100 @@
+// yuy2converter.h
+#ifndef YUY2CONVERTER_H
+#define YUY2CONVERTER_H
+
+#include <QString>
+#include <QThreadPool>
+#include <QtGlobal>
+
+/**
+ * @brief Striped, multithreaded YUY2 -> BGRA (QImage::Format_ARGB32_Premultiplied) converter.
+ *
+ * The source frame is read exactly once. Each stripe writes the 32-bit BGRA pixels
+ * straight into the destination buffer (typically a pooled QImage) and, when requested,
+ * a packed BGR copy for consumers such as the YOLO detector in the same pass.
+ *
+ * Colour math is BT.601 limited range in 16-bit fixed point (6 fractional bits). The
+ * SIMD kernels (AVX2, SSE2 with optional SSSE3, NEON) and the scalar reference use the
+ * same arithmetic and produce bit-identical output. The kernel is selected at compile
+ * time from the target instruction set (e.g. build with -mavx2 to enable AVX2).
+ */
+class Yuy2Converter
+{
+public:
+    /**
+     * @param threadCount Number of stripes per frame, including the calling thread.
+     *        0 selects min(4, QThread::idealThreadCount()).
+     * @param pool Runs the other stripes, e.g. sharedPool(); null gives the converter a
+     *        pool of its own with threadCount - 1 workers.
+     */
+    explicit Yuy2Converter(int threadCount = 0, QThreadPool *pool = nullptr);
+    ~Yuy2Converter();
+
+    /**
+     * @brief Converts one YUY2 frame.
+     * @param src        YUY2 source (2 bytes per pixel).
+     * @param srcStride  Source bytes per line.
+     * @param width      Frame width in pixels (must be even).
+     * @param height     Frame height in pixels.
+     * @param dstBgra    Destination, 4 bytes per pixel (B, G, R, A=255 in memory).
+     * @param dstStride  Destination bytes per line.
+     * @param dstBgr     Optional packed BGR output (3 bytes per pixel), nullptr to skip.
+     * @param bgrStride  BGR bytes per line.
+     */
+    void convert(const uchar *src, int srcStride, int width, int height,
+                 uchar *dstBgra, int dstStride,
+                 uchar *dstBgr = nullptr, int bgrStride = 0);
+
+    int threadCount() const { return m_threadCount; }
+
+    /**
+     * @brief Converts a row range with the best compiled SIMD kernel (single thread).
+     */
+    static void convertRows(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+                            uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride);
+
+    /**
+     * @brief Scalar reference kernel, bit-exact with convertRows().
+     */
+    static void convertRowsScalar(const uchar *src, int srcStride, int width, int rowBegin, int rowEnd,
+                                  uchar *dstBgra, int dstStride, uchar *dstBgr, int bgrStride);
+
+    /**
+     * @brief Converts every @p step-th pixel of every @p step-th row (nearest sample).
+     *
+     * Produces a (width / step) x (height / step) BGRA image reading only the sampled
+     * pixels, for thumbnails such as the picture-in-picture inset. Same colour math as
+     * convertRowsScalar(); single thread.
+     */
+    static void convertDecimated(const uchar *src, int srcStride, int width, int height, int step,
+                                 uchar *dstBgra, int dstStride);
+
+    /**
+     * @brief Name of the SIMD kernel selected at compile time ("AVX2", "SSE2", "NEON" or "Scalar").
+     */
+    static const char *simdPathName();
+
+    /**
+     * @brief Times the scalar, SIMD and striped kernels against cv::cvtColor on a synthetic frame.
+     *
+     * Timing only; tests/tst_yuy2converter.cpp checks the kernels against each other and OpenCV.
+     * @return Human-readable report.
+     */
+    static QString runBenchmark(int width = 1024, int height = 768, int iterations = 200);
+
+    /**
+     * @brief Process-wide pool for converters of several cameras.
+     *
+     * Sized to QThread::idealThreadCount() - 1 workers, so adding a camera adds stripes
+     * to the same workers instead of another set of threads. The calling thread of each
+     * convert() still runs one stripe itself.
+     */
+    static QThreadPool *sharedPool();
+
+private:
+    int m_threadCount;
+    QThreadPool m_ownPool; // Used when no pool is given
+    QThreadPool *m_pool;   // Runs stripes 1..N-1, stripe 0 runs on the calling thread
+};
+
+#endif // YUY2CONVERTER_H
@@ -0,0 +1,21 @@
+// tests/testmain.cpp
+
+#include <QApplication>
+#include <QtTest>
+
+#include <memory>
+
+#include "testregistry.h"
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    // Non-zero if any registered test class failed
+    int failures = 0;
+    for (const TestRegistry::Factory &factory : TestRegistry::factories()) {
+        std::unique_ptr<QObject> test(factory());
+        failures += QTest::qExec(test.get(), argc, argv);
+    }
+    return failures;
+}
@@ -0,0 +1,36 @@
+// tests/testregistry.h
+#ifndef TESTREGISTRY_H
+#define TESTREGISTRY_H
+
+#include <QObject>
+#include <QVector>
+
+#include <functional>
+#include <utility>
+
+/**
+ * @brief Test classes linked into the tests binary, run in turn by testmain.cpp.
+ *
+ * tests.pro builds every tst_*.cpp into one executable, so each file registers its
+ * class with REGISTER_TEST instead of providing its own QTEST_MAIN.
+ */
+namespace TestRegistry {
+using Factory = std::function<QObject *()>;
+
+inline QVector<Factory> &factories()
+{
+    static QVector<Factory> registered;
+    return registered;
+}
+
+inline bool add(Factory factory)
+{
+    factories().append(std::move(factory));
+    return true;
+}
+} // namespace TestRegistry
+
+#define REGISTER_TEST(TestClass) \
+    static const bool TestClass##Registered = TestRegistry::add([]() -> QObject * { return new TestClass; })
+
+#endif // TESTREGISTRY_H
@@ -66,8 +66,9 @@ INCLUDEPATH += ../src \
 
 # 6. Source Files
 
-# Use files() to find all test source files
-SOURCES += $$files(./tst_*.cpp)
+# Use files() to find all test source files; testmain.cpp runs every registered test class
+SOURCES += $$files(./tst_*.cpp) \
+           testmain.cpp
 
 # --- CORRECTED SECTION ---
 # Use the qmake files() function to correctly expand wildcards
@@ -87,6 +88,7 @@ SOURCES += \
 
 # Headers are good practice for IDEs
 HEADERS += \
+    testregistry.h \
     $$files(../src/controllers/motion_modes/*.h) \
     $$files(../src/controllers/*.h) \
     $$files(../src/models/*.h) \
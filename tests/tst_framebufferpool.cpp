@@ -0,0 +1,125 @@
+// tests/tst_framebufferpool.cpp
+
+#include <QtTest>
+#include <QObject>
+
+#include <utility>
+
+#include "devices/framebufferpool.h"
+#include "devices/osdpainterrenderer.h"
+#include "testregistry.h"
+
+class TestFrameBufferPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void acquiredImageIsSoleReference();
+    void releasedBufferIsReused();
+    void heldBufferIsNotReused();
+    void exhaustedPoolOverflows();
+    void resetKeepsInFlightBufferAlive();
+    void inPlaceRenderPaintsPooledFrame();
+    void inPlaceRenderSkipsSharedFrame();
+};
+
+void TestFrameBufferPool::acquiredImageIsSoleReference()
+{
+    FrameBufferPool pool(64, 48);
+    QImage image = pool.acquire();
+
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.size(), QSize(64, 48));
+    QVERIFY(image.isDetached());
+    const uchar *pixels = image.constBits();
+    image.fill(Qt::red); // Writing does not detach into a copy
+    QCOMPARE(image.constBits(), pixels);
+}
+
+void TestFrameBufferPool::releasedBufferIsReused()
+{
+    FrameBufferPool pool(64, 48, QImage::Format_ARGB32_Premultiplied, 1, 1);
+    const uchar *pixels = nullptr;
+    {
+        const QImage image = pool.acquire();
+        pixels = image.constBits();
+    }
+    const QImage image = pool.acquire();
+    QCOMPARE(image.constBits(), pixels);
+    QCOMPARE(pool.reuseCount(), quint64(2));
+    QCOMPARE(pool.allocationCount(), quint64(1));
+}
+
+void TestFrameBufferPool::heldBufferIsNotReused()
+{
+    FrameBufferPool pool(64, 48, QImage::Format_ARGB32_Premultiplied, 1, 2);
+    const QImage first = pool.acquire();
+    const QImage copy = first; // A consumer still shows the frame
+    const QImage second = pool.acquire();
+
+    QVERIFY(second.constBits() != first.constBits());
+    QCOMPARE(pool.bufferCount(), 2);
+    QVERIFY(!first.isDetached());
+}
+
+void TestFrameBufferPool::exhaustedPoolOverflows()
+{
+    FrameBufferPool pool(64, 48, QImage::Format_ARGB32_Premultiplied, 1, 1);
+    const QImage first = pool.acquire();
+    const QImage second = pool.acquire();
+
+    QVERIFY(!second.isNull());
+    QVERIFY(second.constBits() != first.constBits());
+    QCOMPARE(pool.overflowCount(), quint64(1));
+}
+
+void TestFrameBufferPool::resetKeepsInFlightBufferAlive()
+{
+    QImage image;
+    {
+        FrameBufferPool pool(64, 48);
+        image = pool.acquire();
+        image.fill(Qt::green);
+        pool.reset(32, 24);
+        QCOMPARE(pool.acquire().size(), QSize(32, 24));
+    }
+    // The pool is gone; the image still owns its buffer and frees it on destruction
+    QCOMPARE(image.pixelColor(10, 10), QColor(Qt::green));
+}
+
+void TestFrameBufferPool::inPlaceRenderPaintsPooledFrame()
+{
+    FrameBufferPool pool(320, 240);
+    OsdPainterRenderer renderer(320, 240);
+    renderer.setRenderMode(OsdRenderMode::InPlace);
+
+    QImage frame = pool.acquire();
+    frame.fill(Qt::black);
+    const uchar *pixels = frame.constBits();
+    const QImage rendered = renderer.render(std::move(frame), OsdFrameState());
+
+    QCOMPARE(rendered.constBits(), pixels);
+    QCOMPARE(renderer.inPlaceFallbackCount(), quint64(0));
+}
+
+void TestFrameBufferPool::inPlaceRenderSkipsSharedFrame()
+{
+    FrameBufferPool pool(320, 240);
+    OsdPainterRenderer renderer(320, 240);
+    renderer.setRenderMode(OsdRenderMode::InPlace);
+
+    QImage frame = pool.acquire();
+    frame.fill(Qt::black);
+    const QImage raw = frame; // e.g. the raw network output
+    const QImage rendered = renderer.render(std::move(frame), OsdFrameState());
+
+    QVERIFY(rendered.constBits() != raw.constBits());
+    QCOMPARE(renderer.inPlaceFallbackCount(), quint64(1));
+    QImage black(raw.size(), raw.format());
+    black.fill(Qt::black);
+    QVERIFY(raw == black); // The OSD never reached the shared frame
+}
+
+REGISTER_TEST(TestFrameBufferPool);
+
+#include "tst_framebufferpool.moc"
@@ -11,6 +11,7 @@
 #include "controllers/weaponcontroller.h"
 #include "controllers/cameracontroller.h"
 #include "models/joystickdatamodel.h"
+#include "testregistry.h"
 
 // --- Minimal Mock Definitions ---
 
@@ -335,6 +336,6 @@ void TestJoystickController::testMotionModeCycling()
     QCOMPARE(m_mockStateModel->lastSetMotionMode, MotionMode::Manual);
 }
 
-QTEST_MAIN(TestJoystickController)
+REGISTER_TEST(TestJoystickController);
 
 #include "tst_joystickcontroller.moc"
@@ -0,0 +1,159 @@
+// tests/tst_leftrightsnapshot.cpp
+
+#include <QtTest>
+#include <QObject>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "utils/leftrightsnapshot.h"
+#include "models/systemstatemodel.h"
+#include "testregistry.h"
+
+namespace {
+// Every member derives from the sequence number, so a copy mixing two publishes shows up
+struct Sample {
+    quint32 sequence = 0;
+    double negated = 0.0;
+    QString text = QStringLiteral("0");
+    QVector<int> values;
+};
+
+Sample sampleFor(quint32 sequence)
+{
+    Sample sample;
+    sample.sequence = sequence;
+    sample.negated = -static_cast<double>(sequence);
+    sample.text = QString::number(sequence);
+    sample.values = QVector<int>(static_cast<int>(sequence % 8), static_cast<int>(sequence));
+    return sample;
+}
+
+bool isConsistent(const Sample &sample)
+{
+    if (sample.negated != -static_cast<double>(sample.sequence) || sample.text != QString::number(sample.sequence) ||
+        sample.values.size() != static_cast<int>(sample.sequence % 8)) {
+        return false;
+    }
+    for (int value : sample.values) {
+        if (value != static_cast<int>(sample.sequence)) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+class TestLeftRightSnapshot : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readersNeverSeeTornOrOlderValues();
+    void modelTakesTrackingResultsFromManyThreads();
+};
+
+void TestLeftRightSnapshot::readersNeverSeeTornOrOlderValues()
+{
+    constexpr int readerCount = 4;
+    constexpr quint32 publishes = 200000;
+
+    LeftRightSnapshot<Sample> snapshot;
+    std::atomic<bool> stop{false};
+    std::atomic<quint64> torn{0};
+    std::atomic<quint64> reversed{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < readerCount; ++i) {
+        readers.emplace_back([&]() {
+            quint32 lastSequence = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const Sample sample = snapshot.read();
+                if (!isConsistent(sample)) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (sample.sequence < lastSequence) {
+                    reversed.fetch_add(1, std::memory_order_relaxed);
+                }
+                lastSequence = sample.sequence;
+            }
+        });
+    }
+
+    for (quint32 sequence = 1; sequence <= publishes; ++sequence) {
+        snapshot.publish(sampleFor(sequence));
+    }
+    stop.store(true);
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+
+    QCOMPARE(torn.load(), quint64(0));
+    QCOMPARE(reversed.load(), quint64(0));
+    QCOMPARE(snapshot.publishedCount(), quint64(publishes));
+    QCOMPARE(snapshot.read().sequence, publishes);
+}
+
+void TestLeftRightSnapshot::modelTakesTrackingResultsFromManyThreads()
+{
+    // Capture threads report tracker results concurrently; the model applies them on its
+    // own thread, so its snapshot keeps a single writer while other threads read it
+    constexpr int writerCount = 4;
+    constexpr int readerCount = 2;
+    constexpr int resultsPerWriter = 2000;
+
+    SystemStateModel model;
+    const int activeCamera = model.data().activeCameraIndex;
+
+    // Each result has height == -centerY == centerX and width == centerX + 1
+    auto isConsistentResult = [](const SystemStateData &state) {
+        const float centerX = state.trackedTargetCenterX_px;
+        return centerX == 0.0f ||
+               (state.trackedTargetCenterY_px == -centerX && state.trackedTargetWidth_px == centerX + 1.0f &&
+                state.trackedTargetHeight_px == centerX);
+    };
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> writersDone{0};
+    std::atomic<quint64> torn{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readerCount; ++i) {
+        threads.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (!isConsistentResult(model.snapshot())) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (int writer = 0; writer < writerCount; ++writer) {
+        threads.emplace_back([&, writer]() {
+            for (int i = 1; i <= resultsPerWriter; ++i) {
+                const float value = static_cast<float>(writer * resultsPerWriter + i);
+                // LOST keeps the tracking phase machine in Off without warnings
+                model.updateTrackingResult(activeCamera, false, value, -value, value + 1.0f, value,
+                                           0.0f, 0.0f, VPI_TRACKING_STATE_LOST);
+            }
+            writersDone.fetch_add(1);
+        });
+    }
+
+    while (writersDone.load() < writerCount) {
+        QCoreApplication::processEvents();
+    }
+    QCoreApplication::processEvents(); // Results queued after the last check
+    stop.store(true);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    const SystemStateData state = model.snapshot();
+    QCOMPARE(torn.load(), quint64(0));
+    QVERIFY(state.trackedTargetCenterX_px > 0.0f);
+    QVERIFY(isConsistentResult(state));
+    QVERIFY(state == model.data()); // Everything queued has been applied and published
+}
+
+REGISTER_TEST(TestLeftRightSnapshot);
+
+#include "tst_leftrightsnapshot.moc"
@@ -0,0 +1,127 @@
+// tests/tst_osdrenderers.cpp
+
+#include <QtTest>
+#include <QObject>
+
+#include "devices/osdlayout.h"
+#include "devices/osdpainterrenderer.h"
+#include "devices/osdrenderer.h"
+#include "testregistry.h"
+
+using namespace OsdLayout;
+
+namespace {
+// Reference layout size: anchoredPos() leaves the positions where osdlayout.h puts them
+constexpr int FRAME_WIDTH = REFERENCE_WIDTH;
+constexpr int FRAME_HEIGHT = REFERENCE_HEIGHT;
+
+const QRectF TRACKING_BOX(700, 560, 80, 60); // Clear of the reticle and the text columns
+
+QImage blackFrame()
+{
+    QImage frame(FRAME_WIDTH, FRAME_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+    frame.fill(Qt::black);
+    return frame;
+}
+
+bool differsIn(const QImage &a, const QImage &b, const QRect &region)
+{
+    for (int y = region.top(); y <= region.bottom(); ++y) {
+        for (int x = region.left(); x <= region.right(); ++x) {
+            if (a.pixel(x, y) != b.pixel(x, y)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Whether going from @p before to @p after changes anything in @p region; copies, so the
+// renderers' pooled buffers are not held across the two renders
+bool sceneDraws(const OsdFrameState &before, const OsdFrameState &after, const QRect &region)
+{
+    OsdRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT);
+    renderer.apply(before);
+    const QImage first = renderer.renderOsd(blackFrame()).copy();
+    renderer.apply(after);
+    const QImage second = renderer.renderOsd(blackFrame()).copy();
+    return differsIn(first, second, region);
+}
+
+bool painterDraws(const OsdFrameState &before, const OsdFrameState &after, const QRect &region)
+{
+    OsdPainterRenderer renderer(FRAME_WIDTH, FRAME_HEIGHT);
+    const QImage first = renderer.render(blackFrame(), before).copy();
+    const QImage second = renderer.render(blackFrame(), after).copy();
+    return differsIn(first, second, region);
+}
+} // namespace
+
+class TestOsdRenderers : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void bothRenderersDrawSameItems_data();
+    void bothRenderersDrawSameItems();
+};
+
+void TestOsdRenderers::bothRenderersDrawSameItems_data()
+{
+    QTest::addColumn<OsdFrameState>("after");
+    QTest::addColumn<QRect>("region");
+    QTest::addColumn<bool>("drawn");
+
+    const QPointF leadPos = anchoredPos(POS_ZONE_LAC_TEXT, FRAME_WIDTH, FRAME_HEIGHT);
+    const QRect leadRegion = QRectF(leadPos - QPointF(5, 30), QSizeF(250, 60)).toRect();
+    const QRect trackingRegion = TRACKING_BOX.adjusted(-6, -6, 6, 6).toRect();
+
+    OsdFrameState state;
+    state.leadStatusText = QStringLiteral("LEAD ANGLE LAG");
+    state.leadAngleActive = true;
+    state.leadAngleStatus = LeadAngleStatus::Lag;
+    QTest::newRow("lead status active") << state << leadRegion << true;
+
+    state = OsdFrameState();
+    state.leadStatusText = QStringLiteral("LEAD ANGLE ON");
+    QTest::newRow("lead status text, lead angle off") << state << leadRegion << false;
+
+    state = OsdFrameState();
+    state.trackingBox = TRACKING_BOX;
+    QTest::newRow("tracking box, tracking off") << state << trackingRegion << false;
+
+    state.trackingPhase = TrackingPhase::Acquisition;
+    state.acquisitionBox = TRACKING_BOX;
+    QTest::newRow("tracking box, acquisition") << state << trackingRegion << true;
+
+    state = OsdFrameState();
+    state.trackingBox = TRACKING_BOX;
+    state.trackingPhase = TrackingPhase::Tracking_ActiveLock;
+    state.hasValidLock = true;
+    state.trackedBox = TRACKING_BOX;
+    QTest::newRow("tracking box, active lock") << state << trackingRegion << true;
+
+    state.hasValidLock = false;
+    QTest::newRow("tracking box, lock lost") << state << trackingRegion << false;
+}
+
+void TestOsdRenderers::bothRenderersDrawSameItems()
+{
+    QFETCH(OsdFrameState, after);
+    QFETCH(QRect, region);
+    QFETCH(bool, drawn);
+
+    // Everything else as in the default state, the reticle in the middle of the frame
+    OsdFrameState before;
+    before.reticlePosition = QPointF(FRAME_WIDTH / 2.0, FRAME_HEIGHT / 2.0);
+    after.reticlePosition = before.reticlePosition;
+
+    const bool scene = sceneDraws(before, after, region);
+    const bool painter = painterDraws(before, after, region);
+    QCOMPARE(painter, scene);
+    QCOMPARE(scene, drawn);
+}
+
+REGISTER_TEST(TestOsdRenderers);
+
+#include "tst_osdrenderers.moc"
@@ -0,0 +1,269 @@
+// tests/tst_systemstatedata.cpp
+
+#include <QtTest>
+#include <QObject>
+
+#include <vector>
+
+#include "models/systemstatedata.h"
+#include "models/systemstatemodel.h"
+#include "testregistry.h"
+
+class TestSystemStateData : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void copySharesZoneVectors();
+    void writeToCopyDetaches();
+    void changedFieldsNamesTouchedFields();
+    void equalContentInUnsharedLists();
+    void streamRoundTrip();
+    void streamRejectsOtherSchema();
+    void streamRejectsTruncatedData();
+
+    // Benchmarks: run with -iterations or -callgrind for stable numbers
+    void benchmarkCopyDeepZoneVectors();
+    void benchmarkCopySharedZoneVectors();
+    void benchmarkCopyThenModify();
+    void benchmarkQueuedDataChanged();
+    void benchmarkChangedFields();
+    void benchmarkSerialize();
+    void benchmarkDeserialize();
+
+private:
+    // Snapshot with populated zones, radar plots and status strings
+    static SystemStateData populatedSnapshot(int zoneCount = 32);
+};
+
+SystemStateData TestSystemStateData::populatedSnapshot(int zoneCount)
+{
+    SystemStateData sample;
+    for (int i = 0; i < zoneCount; ++i) {
+        AreaZone area;
+        area.id = i + 1;
+        sample.areaZones.append(area);
+        AutoSectorScanZone sector;
+        sector.id = i + 1;
+        sample.sectorScanZones.append(sector);
+        TargetReferencePoint trp;
+        trp.id = i + 1;
+        sample.targetReferencePoints.append(trp);
+    }
+    for (quint32 i = 0; i < 16; ++i) {
+        sample.radarPlots.append({100 + i, 22.5f * i, 500.0f + 250.0f * i, 180.0f, 5.0f});
+    }
+    sample.weaponSystemStatus = QStringLiteral("WEAPON READY");
+    sample.targetInformation = QStringLiteral("TGT 0103 RNG 2200 M");
+    sample.leadStatusText = QStringLiteral("LEAD ANGLE ON");
+    sample.zeroingStatusText = QStringLiteral("Z");
+    return sample;
+}
+
+void TestSystemStateData::copySharesZoneVectors()
+{
+    const SystemStateData sample = populatedSnapshot();
+    const SystemStateData copy = sample;
+
+    QCOMPARE(copy.areaZones.constData(), sample.areaZones.constData());
+    QCOMPARE(copy.sectorScanZones.constData(), sample.sectorScanZones.constData());
+    QCOMPARE(copy.targetReferencePoints.constData(), sample.targetReferencePoints.constData());
+    QCOMPARE(copy.radarPlots.constData(), sample.radarPlots.constData());
+}
+
+void TestSystemStateData::writeToCopyDetaches()
+{
+    const SystemStateData sample = populatedSnapshot();
+    SystemStateData copy = sample;
+    copy.areaZones[0].isEnabled = !sample.areaZones[0].isEnabled;
+
+    QVERIFY(copy.areaZones.constData() != sample.areaZones.constData());
+    QCOMPARE(copy.areaZones[0].isEnabled, !sample.areaZones[0].isEnabled);
+    QCOMPARE(copy.sectorScanZones.constData(), sample.sectorScanZones.constData());
+}
+
+void TestSystemStateData::changedFieldsNamesTouchedFields()
+{
+    const SystemStateData sample = populatedSnapshot();
+    SystemStateData moved = sample;
+    moved.gimbalAz += 0.01;
+    moved.acquisitionBoxX_px += 1.0f;
+
+    const StateFieldSet changed = moved.changedFields(sample);
+    QCOMPARE(stateFieldNames(changed), QStringList({QStringLiteral("gimbalAz"), QStringLiteral("acquisitionBoxX_px")}));
+    QCOMPARE(stateFieldGroups(changed), StateGroup::GimbalPose | StateGroup::Tracking);
+    QCOMPARE(moved.changedGroups(sample), StateGroup::GimbalPose | StateGroup::Tracking);
+    QVERIFY(!(moved == sample));
+}
+
+void TestSystemStateData::equalContentInUnsharedLists()
+{
+    const SystemStateData sample = populatedSnapshot();
+    SystemStateData unshared = sample;
+    unshared.areaZones.detach();
+    unshared.radarPlots.detach();
+
+    QVERIFY(unshared == sample);
+    QVERIFY(unshared.changedFields(sample).none());
+    QVERIFY(!unshared.changedGroups(sample));
+}
+
+void TestSystemStateData::streamRoundTrip()
+{
+    SystemStateData sample = populatedSnapshot();
+    sample.gimbalAz = 123.25;
+    sample.opMode = OperationalMode::Tracking;
+
+    QByteArray bytes;
+    {
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        out << sample;
+    }
+    SystemStateData decoded;
+    QDataStream in(bytes);
+    in >> decoded;
+
+    QCOMPARE(in.status(), QDataStream::Ok);
+    QVERIFY(in.atEnd());
+    QVERIFY(decoded == sample);
+}
+
+void TestSystemStateData::streamRejectsOtherSchema()
+{
+    QByteArray bytes;
+    {
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        out << populatedSnapshot();
+    }
+    // Same magic, different field table
+    QDataStream patch(&bytes, QIODevice::ReadWrite);
+    patch.skipRawData(sizeof(quint32));
+    patch << (stateSchemaHash() ^ 1u);
+
+    SystemStateData decoded;
+    decoded.gimbalAz = 42.0;
+    QDataStream in(bytes);
+    in >> decoded;
+
+    QCOMPARE(in.status(), QDataStream::ReadCorruptData);
+    QCOMPARE(decoded.gimbalAz, 42.0);
+}
+
+void TestSystemStateData::streamRejectsTruncatedData()
+{
+    QByteArray bytes;
+    {
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        out << populatedSnapshot();
+    }
+    bytes.chop(bytes.size() / 2);
+
+    SystemStateData decoded;
+    decoded.gimbalAz = 42.0;
+    QDataStream in(bytes);
+    in >> decoded;
+
+    QVERIFY(in.status() != QDataStream::Ok);
+    QCOMPARE(decoded.gimbalAz, 42.0);
+}
+
+void TestSystemStateData::benchmarkCopyDeepZoneVectors()
+{
+    // What a queued receiver paid when the zone vectors were std::vector members
+    const SystemStateData sample = populatedSnapshot();
+    QBENCHMARK {
+        SystemStateData copy = sample;
+        std::vector<AreaZone> areas(sample.areaZones.cbegin(), sample.areaZones.cend());
+        std::vector<AutoSectorScanZone> sectors(sample.sectorScanZones.cbegin(), sample.sectorScanZones.cend());
+        std::vector<TargetReferencePoint> trps(sample.targetReferencePoints.cbegin(), sample.targetReferencePoints.cend());
+        Q_UNUSED(sectors);
+        Q_UNUSED(trps);
+        QCOMPARE(copy.areaZones.size(), static_cast<int>(areas.size()));
+    }
+}
+
+void TestSystemStateData::benchmarkCopySharedZoneVectors()
+{
+    const SystemStateData sample = populatedSnapshot();
+    QBENCHMARK {
+        SystemStateData copy = sample;
+        QVERIFY(!copy.areaZones.isEmpty());
+    }
+}
+
+void TestSystemStateData::benchmarkCopyThenModify()
+{
+    // The deep copy still happens, once, in whoever writes to a shared copy
+    const SystemStateData sample = populatedSnapshot();
+    QBENCHMARK {
+        SystemStateData copy = sample;
+        copy.areaZones[0].isEnabled = !copy.areaZones[0].isEnabled;
+        QVERIFY(!copy.areaZones.isEmpty());
+    }
+}
+
+void TestSystemStateData::benchmarkQueuedDataChanged()
+{
+    // End-to-end: emit dataChanged() to queued receivers and drain the event queue
+    constexpr int queuedReceivers = 4;
+    const SystemStateData sample = populatedSnapshot();
+    SystemStateModel model;
+    QObject context;
+    int delivered = 0;
+    for (int i = 0; i < queuedReceivers; ++i) {
+        connect(&model, &SystemStateModel::dataChanged, &context,
+                [&delivered](const SystemStateData &data) { delivered += data.areaZones.isEmpty() ? 0 : 1; },
+                Qt::QueuedConnection);
+    }
+    QCoreApplication::processEvents(); // Drop the notifications queued while constructing the model
+    delivered = 0;
+    int emitted = 0;
+    QBENCHMARK {
+        emit model.dataChanged(sample);
+        QCoreApplication::processEvents();
+        ++emitted;
+    }
+    QCOMPARE(delivered, emitted * queuedReceivers);
+}
+
+void TestSystemStateData::benchmarkChangedFields()
+{
+    const SystemStateData sample = populatedSnapshot();
+    SystemStateData moved = sample;
+    moved.gimbalAz += 0.01;
+    moved.acquisitionBoxX_px += 1.0f;
+    QBENCHMARK {
+        QCOMPARE(moved.changedFields(sample).count(), std::size_t(2));
+    }
+}
+
+void TestSystemStateData::benchmarkSerialize()
+{
+    const SystemStateData sample = populatedSnapshot();
+    QByteArray bytes;
+    QBENCHMARK {
+        bytes.clear();
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        out << sample;
+    }
+    QVERIFY(!bytes.isEmpty());
+}
+
+void TestSystemStateData::benchmarkDeserialize()
+{
+    QByteArray bytes;
+    {
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        out << populatedSnapshot();
+    }
+    SystemStateData decoded;
+    QBENCHMARK {
+        QDataStream in(bytes);
+        in >> decoded;
+    }
+    QCOMPARE(decoded.areaZones.size(), 32);
+}
+
+REGISTER_TEST(TestSystemStateData);
+
+#include "tst_systemstatedata.moc"
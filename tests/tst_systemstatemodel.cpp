@@ -0,0 +1,158 @@
+// tests/tst_systemstatemodel.cpp
+
+#include <QtTest>
+#include <QObject>
+
+#include "models/systemstatemodel.h"
+#include "testregistry.h"
+
+class TestSystemStateModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void groupSubscribersCopyLessThanDataChanged();
+    void disablingCoalescingFlushesNetChange();
+    void disablingCoalescingSkipsUndoneChange();
+
+private:
+    // One second of device traffic: servo and IMU at 100 Hz, PLC42 at 10 Hz, health at 1 Hz
+    static void replayDeviceSecond(SystemStateModel &model);
+};
+
+void TestSystemStateModel::replayDeviceSecond(SystemStateModel &model)
+{
+    for (int tick = 0; tick < 100; ++tick) {
+        SystemStateData data = model.data();
+        data.gimbalAz = data.gimbalAz + 0.1;
+        model.updateData(data);
+        QCoreApplication::processEvents();
+
+        data = model.data();
+        data.imuRollDeg = data.imuRollDeg + 0.01;
+        model.updateData(data);
+        QCoreApplication::processEvents();
+
+        if (tick % 10 == 0) {
+            data = model.data();
+            data.stationInput1 = !data.stationInput1;
+            model.updateData(data);
+            QCoreApplication::processEvents();
+        }
+        if (tick == 0) {
+            data = model.data();
+            data.stationTemperature = data.stationTemperature + 1;
+            model.updateData(data);
+            QCoreApplication::processEvents();
+        }
+    }
+}
+
+void TestSystemStateModel::groupSubscribersCopyLessThanDataChanged()
+{
+    // The groups the gimbal, weapon and camera controllers and the status widget use
+    const QVector<StateGroups> subscribers = {
+        StateGroup::Modes | StateGroup::Zones | StateGroup::Tracking | StateGroup::Optics | StateGroup::GimbalPose,
+        StateGroup::Station | StateGroup::Controls | StateGroup::Modes,
+        StateGroup::Optics | StateGroup::Tracking | StateGroup::Modes,
+        StateGroup::GimbalPose | StateGroup::DeviceHealth | StateGroup::Optics | StateGroup::Ballistics |
+            StateGroup::Station,
+    };
+
+    // Before: every subscriber takes a queued copy of dataChanged()
+    quint64 copiesBefore = 0;
+    quint64 publishesBefore = 0;
+    {
+        SystemStateModel model;
+        QCoreApplication::processEvents();
+        QObject context;
+        for (int i = 0; i < subscribers.size(); ++i) {
+            connect(&model, &SystemStateModel::dataChanged, &context,
+                    [&copiesBefore](const SystemStateData &) { ++copiesBefore; }, Qt::QueuedConnection);
+        }
+        model.setSignalStatsEnabled(true);
+        replayDeviceSecond(model);
+        publishesBefore = model.signalStats().publishes;
+        QCOMPARE(model.signalStats().wholeStateDeliveries, copiesBefore);
+    }
+
+    // After: every subscriber filters stateGroupsChanged() and copies a snapshot on a match
+    quint64 copiesAfter = 0;
+    quint64 wakeupsAfter = 0;
+    quint64 publishesAfter = 0;
+    {
+        SystemStateModel model;
+        QCoreApplication::processEvents();
+        QObject context;
+        for (const StateGroups usedGroups : subscribers) {
+            connect(&model, &SystemStateModel::stateGroupsChanged, &context,
+                    [&, usedGroups](StateGroups changed) {
+                ++wakeupsAfter;
+                if (changed & usedGroups) {
+                    const SystemStateData data = model.snapshot();
+                    Q_UNUSED(data);
+                    ++copiesAfter;
+                }
+            }, Qt::QueuedConnection);
+        }
+        model.setSignalStatsEnabled(true);
+        replayDeviceSecond(model);
+        publishesAfter = model.signalStats().publishes;
+        QCOMPARE(model.signalStats().wholeStateDeliveries, quint64(0));
+        QCOMPARE(model.signalStats().groupDeliveries, wakeupsAfter); // No typed group receivers here
+    }
+
+    qInfo().nospace() << "Per simulated second, " << sizeof(SystemStateData) << " B per copy: before "
+                      << publishesBefore << " publishes, " << copiesBefore << " whole-state copies; after "
+                      << publishesAfter << " publishes, " << wakeupsAfter << " wake-ups, "
+                      << copiesAfter << " snapshot copies";
+
+    QCOMPARE(publishesAfter, publishesBefore);
+    QCOMPARE(copiesBefore, publishesBefore * subscribers.size());
+    QVERIFY(copiesAfter < copiesBefore);
+}
+
+void TestSystemStateModel::disablingCoalescingFlushesNetChange()
+{
+    SystemStateModel model;
+    QCoreApplication::processEvents();
+    model.setCoalescingWindow(1000);
+    QSignalSpy spy(&model, &SystemStateModel::stateGroupsChanged);
+
+    SystemStateData data = model.data();
+    data.gimbalAz = data.gimbalAz + 1.0;
+    model.updateData(data);
+    QCOMPARE(spy.count(), 0); // Waits for the tick
+
+    model.setCoalescingWindow(0);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).value<StateGroups>(), StateGroups(StateGroup::GimbalPose));
+    QCOMPARE(model.snapshot().gimbalAz, data.gimbalAz);
+}
+
+void TestSystemStateModel::disablingCoalescingSkipsUndoneChange()
+{
+    SystemStateModel model;
+    QCoreApplication::processEvents();
+    model.setCoalescingWindow(1000);
+    QSignalSpy spy(&model, &SystemStateModel::stateGroupsChanged);
+    QSignalSpy dataSpy(&model, &SystemStateModel::dataChanged);
+
+    const SystemStateData original = model.data();
+    SystemStateData moved = original;
+    moved.gimbalAz = moved.gimbalAz + 1.0;
+    model.updateData(moved);
+    model.updateData(original);
+
+    model.setCoalescingWindow(0);
+    QCOMPARE(spy.count(), 0);
+    QCOMPARE(dataSpy.count(), 0);
+
+    // Pending count was reset: the next update publishes on its own
+    model.updateData(moved);
+    QCOMPARE(spy.count(), 1);
+}
+
+REGISTER_TEST(TestSystemStateModel);
+
+#include "tst_systemstatemodel.moc"
@@ -0,0 +1,148 @@
+// tests/tst_yuy2converter.cpp
+
+#include <QtTest>
+#include <QObject>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "utils/yuy2converter.h"
+#include "testregistry.h"
+
+class TestYuy2Converter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void simdMatchesScalar_data();
+    void simdMatchesScalar();
+    void stripedMatchesScalar();
+    void bgrSideOutputMatchesBgra();
+    void decimatedSamplesFullFrame();
+    void closeToOpenCv();
+
+private:
+    // Random YUY2 frame; rows are padded so the kernels must honour the stride
+    static cv::Mat randomFrame(int width, int height, const cv::Scalar &low, const cv::Scalar &high);
+    static cv::Mat scalarBgra(const cv::Mat &yuy2, cv::Mat *bgr = nullptr);
+};
+
+cv::Mat TestYuy2Converter::randomFrame(int width, int height, const cv::Scalar &low, const cv::Scalar &high)
+{
+    cv::Mat padded(height, width + 6, CV_8UC2);
+    cv::randu(padded, low, high);
+    return padded.colRange(0, width);
+}
+
+cv::Mat TestYuy2Converter::scalarBgra(const cv::Mat &yuy2, cv::Mat *bgr)
+{
+    cv::Mat bgra(yuy2.rows, yuy2.cols, CV_8UC4);
+    if (bgr) {
+        bgr->create(yuy2.rows, yuy2.cols, CV_8UC3);
+    }
+    Yuy2Converter::convertRowsScalar(yuy2.data, static_cast<int>(yuy2.step), yuy2.cols, 0, yuy2.rows,
+                                     bgra.data, static_cast<int>(bgra.step),
+                                     bgr ? bgr->data : nullptr, bgr ? static_cast<int>(bgr->step) : 0);
+    return bgra;
+}
+
+void TestYuy2Converter::simdMatchesScalar_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    QTest::newRow("1024x768") << 1024 << 768;
+    QTest::newRow("640x480") << 640 << 480;
+    QTest::newRow("tail only") << 14 << 3;
+    QTest::newRow("vector plus tail") << 46 << 5;
+    QTest::newRow("one pair") << 2 << 1;
+}
+
+void TestYuy2Converter::simdMatchesScalar()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    // Full byte range, so the clamping and saturation paths run too
+    const cv::Mat yuy2 = randomFrame(width, height, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::Mat bgrScalar;
+    const cv::Mat bgraScalar = scalarBgra(yuy2, &bgrScalar);
+
+    cv::Mat bgraSimd(height, width, CV_8UC4);
+    cv::Mat bgrSimd(height, width, CV_8UC3);
+    Yuy2Converter::convertRows(yuy2.data, static_cast<int>(yuy2.step), width, 0, height,
+                               bgraSimd.data, static_cast<int>(bgraSimd.step),
+                               bgrSimd.data, static_cast<int>(bgrSimd.step));
+
+    QCOMPARE(cv::norm(bgraSimd, bgraScalar, cv::NORM_INF), 0.0);
+    QCOMPARE(cv::norm(bgrSimd, bgrScalar, cv::NORM_INF), 0.0);
+}
+
+void TestYuy2Converter::stripedMatchesScalar()
+{
+    const int width = 1024;
+    const int height = 766; // Not a multiple of the stripe count
+    const cv::Mat yuy2 = randomFrame(width, height, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::Mat bgrScalar;
+    const cv::Mat bgraScalar = scalarBgra(yuy2, &bgrScalar);
+
+    Yuy2Converter converter(4);
+    cv::Mat bgra(height, width, CV_8UC4);
+    cv::Mat bgr(height, width, CV_8UC3);
+    converter.convert(yuy2.data, static_cast<int>(yuy2.step), width, height,
+                      bgra.data, static_cast<int>(bgra.step), bgr.data, static_cast<int>(bgr.step));
+
+    QCOMPARE(cv::norm(bgra, bgraScalar, cv::NORM_INF), 0.0);
+    QCOMPARE(cv::norm(bgr, bgrScalar, cv::NORM_INF), 0.0);
+}
+
+void TestYuy2Converter::bgrSideOutputMatchesBgra()
+{
+    const cv::Mat yuy2 = randomFrame(640, 480, cv::Scalar::all(0), cv::Scalar::all(256));
+    Yuy2Converter converter;
+    cv::Mat bgra(yuy2.rows, yuy2.cols, CV_8UC4);
+    cv::Mat bgr(yuy2.rows, yuy2.cols, CV_8UC3);
+    converter.convert(yuy2.data, static_cast<int>(yuy2.step), yuy2.cols, yuy2.rows,
+                      bgra.data, static_cast<int>(bgra.step), bgr.data, static_cast<int>(bgr.step));
+
+    cv::Mat bgrFromBgra;
+    cv::cvtColor(bgra, bgrFromBgra, cv::COLOR_BGRA2BGR);
+    QCOMPARE(cv::norm(bgr, bgrFromBgra, cv::NORM_INF), 0.0);
+
+    std::vector<cv::Mat> channels;
+    cv::split(bgra, channels);
+    QCOMPARE(cv::countNonZero(channels[3] != 255), 0);
+}
+
+void TestYuy2Converter::decimatedSamplesFullFrame()
+{
+    const int step = 3;
+    const cv::Mat yuy2 = randomFrame(64, 48, cv::Scalar::all(0), cv::Scalar::all(256));
+    const cv::Mat full = scalarBgra(yuy2);
+
+    cv::Mat decimated(yuy2.rows / step, yuy2.cols / step, CV_8UC4);
+    Yuy2Converter::convertDecimated(yuy2.data, static_cast<int>(yuy2.step), yuy2.cols, yuy2.rows, step,
+                                    decimated.data, static_cast<int>(decimated.step));
+
+    for (int row = 0; row < decimated.rows; ++row) {
+        for (int col = 0; col < decimated.cols; ++col) {
+            QCOMPARE(decimated.at<cv::Vec4b>(row, col), full.at<cv::Vec4b>(row * step, col * step));
+        }
+    }
+}
+
+void TestYuy2Converter::closeToOpenCv()
+{
+    // Nominal BT.601 range; below Y = 16 OpenCV clamps the luma first and the two diverge
+    const cv::Mat yuy2 = randomFrame(640, 480, cv::Scalar(16, 16), cv::Scalar(236, 241));
+    const cv::Mat ours = scalarBgra(yuy2);
+    cv::Mat reference;
+    cv::cvtColor(yuy2, reference, cv::COLOR_YUV2BGRA_YUY2);
+
+    // 6-bit coefficients against OpenCV's 20-bit ones: at most 2 levels apart over the range
+    QVERIFY(cv::norm(ours, reference, cv::NORM_INF) <= 2.0);
+}
+
+REGISTER_TEST(TestYuy2Converter);
+
+#include "tst_yuy2converter.moc"